@@ -0,0 +1,54 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/buffer.h>
+#include "../example_common.h"
+using namespace muda;
+
+void bindless(HostVector<int>& ground_truth, HostVector<int>& res)
+{
+    example_desc(R"(an example for bindless access: every object owns its buffer,
+the viewers of the buffers live in a ViewerTable on the device, the kernel
+takes the table and picks the viewer by handle, instead of capturing one
+viewer per object.)");
+
+    constexpr int Objects = 4;
+    constexpr int Size    = 8;
+
+    std::vector<DeviceBuffer<int>> buffers(Objects);
+    ViewerTable<Dense1D<int>>      table;
+    std::vector<uint32_t>          h_handles;
+    for(auto& buffer : buffers)
+    {
+        buffer.resize(Size, 0);
+        h_handles.push_back(table.add(buffer.viewer()));
+    }
+    // only the dirty slots are uploaded (here: all of them)
+    table.upload();
+
+    DeviceBuffer<uint32_t> handles = h_handles;
+    ParallelFor(32 /*blockDim*/)
+        .apply(Objects * Size /*count*/,
+               [table = table.cviewer(), handles = handles.cviewer()] __device__(int i) mutable
+               {
+                   int  object = i / Size;
+                   auto buffer = table(handles(object));  // copy the viewer out of the table
+                   buffer(i % Size) = object;
+               })
+        .wait();
+
+    for(int k = 0; k < Objects; ++k)
+    {
+        std::vector<int> h;
+        buffers[k].copy_to(h);
+        res.insert(res.end(), h.begin(), h.end());
+        ground_truth.insert(ground_truth.end(), Size, k);
+    }
+}
+
+TEST_CASE("bindless", "[viewer]")
+{
+    HostVector<int> ground_truth, res;
+    bindless(ground_truth, res);
+    REQUIRE(ground_truth == res);
+}
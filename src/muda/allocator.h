@@ -0,0 +1,4 @@
+#pragma once
+#include <muda/allocator/allocator_base.h>
+#include <muda/allocator/memory_resource.h>
+#include <muda/allocator/caching_allocator.h>
@@ -0,0 +1,130 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <cuda_runtime.h>
+#include <muda/muda_def.h>
+
+namespace muda
+{
+class AllocatorStats
+{
+  public:
+    // allocations served from the cache
+    size_t hit_count = 0;
+    // allocations that went to the underlying memory resource
+    size_t miss_count = 0;
+    // bytes handed out to the user and not freed yet
+    size_t in_use_bytes = 0;
+    // bytes kept in the cache, waiting for reuse
+    size_t cached_bytes = 0;
+    // the peak of (in_use_bytes + cached_bytes), the memory we hold from the resource
+    size_t high_water_bytes = 0;
+};
+
+/// <summary>
+/// The interface of a stream-ordered allocator.
+/// `deallocate()` returns false if the pointer is not owned by this allocator,
+/// so the caller can fall back to the raw free function.
+/// </summary>
+class AllocatorBase
+{
+  public:
+    virtual ~AllocatorBase();
+
+    virtual void* allocate(size_t byte_size, cudaStream_t stream) = 0;
+    virtual bool  deallocate(void* ptr, cudaStream_t stream)      = 0;
+    // release cached memory until at most `keep_bytes` stay in the cache
+    virtual void           trim(size_t keep_bytes = 0) = 0;
+    virtual AllocatorStats stats() const               = 0;
+    virtual void           reset_stats()               = 0;
+};
+
+namespace details
+{
+    MUDA_INLINE std::atomic<AllocatorBase*>& device_allocator_slot()
+    {
+        static std::atomic<AllocatorBase*> allocator{nullptr};
+        return allocator;
+    }
+
+    /// <summary>
+    /// ptr -> the allocator that handed it out through Memory::alloc(),
+    /// so Memory::free() goes back to the owner even after its DeviceAllocatorScope ended.
+    /// </summary>
+    class AllocationOwners
+    {
+      public:
+        static AllocationOwners& instance()
+        {
+            static AllocationOwners owners;
+            return owners;
+        }
+
+        void insert(void* ptr, AllocatorBase* owner)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_owners[ptr] = owner;
+        }
+
+        // the owner of `ptr` (and forget it), nullptr if `ptr` is not from an allocator
+        AllocatorBase* erase(void* ptr)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto iter = m_owners.find(ptr);
+            if(iter == m_owners.end())
+                return nullptr;
+            auto owner = iter->second;
+            m_owners.erase(iter);
+            return owner;
+        }
+
+        // forget all the pointers of a dying allocator, they are freed by the raw free function later
+        void erase_all(AllocatorBase* owner)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(auto iter = m_owners.begin(); iter != m_owners.end();)
+                iter = iter->second == owner ? m_owners.erase(iter) : std::next(iter);
+        }
+
+      private:
+        std::mutex                                m_mutex;
+        std::unordered_map<void*, AllocatorBase*> m_owners;
+    };
+}  // namespace details
+
+MUDA_INLINE AllocatorBase::~AllocatorBase()
+{
+    details::AllocationOwners::instance().erase_all(this);
+}
+
+// the allocator used by Memory::alloc()/free() (and so DeviceBuffer, DeviceVar ...)
+// nullptr means cudaMalloc/cudaFree (cudaMallocAsync/cudaFreeAsync) directly
+MUDA_INLINE AllocatorBase* device_allocator()
+{
+    return details::device_allocator_slot().load();
+}
+
+// return the previous allocator
+MUDA_INLINE AllocatorBase* device_allocator(AllocatorBase* allocator)
+{
+    return details::device_allocator_slot().exchange(allocator);
+}
+
+// set the device allocator in a scope, and restore the previous one when leaving
+class DeviceAllocatorScope
+{
+    AllocatorBase* m_previous;
+
+  public:
+    DeviceAllocatorScope(AllocatorBase& allocator)
+        : m_previous(device_allocator(&allocator))
+    {
+    }
+    ~DeviceAllocatorScope() { device_allocator(m_previous); }
+
+    DeviceAllocatorScope(const DeviceAllocatorScope&)            = delete;
+    DeviceAllocatorScope& operator=(const DeviceAllocatorScope&) = delete;
+};
+}  // namespace muda
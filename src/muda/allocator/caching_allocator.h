@@ -0,0 +1,88 @@
+#pragma once
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <muda/allocator/allocator_base.h>
+#include <muda/allocator/memory_resource.h>
+
+namespace muda
+{
+class CachingAllocatorConfig
+{
+  public:
+    // the smallest size class, requests smaller than this are rounded up to it
+    size_t min_bin_bytes = 512;
+    // the largest size class, requests larger than this are not cached
+    size_t max_bin_bytes = size_t{1} << 30;
+    // when the cache grows beyond this, freed blocks go back to the resource directly
+    size_t max_cached_bytes = ~size_t{0};
+};
+
+/// <summary>
+/// A size-class caching allocator.
+/// Requests are rounded up to a power of 2 (the size class),
+/// freed blocks are kept in the cache of their size class, with a fence recorded
+/// on the stream they are freed on:
+///     - a block is reused on the same stream immediately (stream order guarantees safety)
+///     - a block is reused on another stream only after its fence is reached.
+/// Resource requirements:
+///     void* allocate(size_t); void deallocate(void*);
+///     Fence record_fence(cudaStream_t); bool query_fence(Fence);
+///     void wait_fence(Fence); void release_fence(Fence);
+/// </summary>
+template <typename Resource>
+class CachingAllocator : public AllocatorBase
+{
+  public:
+    using Fence = typename Resource::Fence;
+
+    CachingAllocator(const CachingAllocatorConfig& config = {});
+    ~CachingAllocator() override;
+
+    CachingAllocator(const CachingAllocator&)            = delete;
+    CachingAllocator& operator=(const CachingAllocator&) = delete;
+
+    void*          allocate(size_t byte_size, cudaStream_t stream) override;
+    bool           deallocate(void* ptr, cudaStream_t stream) override;
+    void           trim(size_t keep_bytes = 0) override;
+    AllocatorStats stats() const override;
+    void           reset_stats() override;
+
+    // the size class of a request, requests larger than max_bin_bytes get 0 (uncached)
+    size_t bin_bytes(size_t byte_size) const;
+
+    const auto& config() const { return m_config; }
+    Resource&   resource() { return m_resource; }
+
+  private:
+    class Block
+    {
+      public:
+        void*        ptr        = nullptr;
+        size_t       byte_size  = 0;
+        cudaStream_t stream     = nullptr;
+        Fence        fence      = {};
+        bool         has_fence  = false;
+    };
+
+    void* allocate_from_resource(size_t byte_size);
+    void  release_block(Block& block);
+    void  update_high_water();
+
+    CachingAllocatorConfig m_config;
+    Resource               m_resource;
+
+    mutable std::mutex m_mutex;
+    // size class -> cached blocks (the latest freed at the back)
+    std::unordered_map<size_t, std::list<Block>> m_cached_blocks;
+    // ptr -> block in use
+    std::unordered_map<void*, Block> m_live_blocks;
+    AllocatorStats                   m_stats;
+};
+
+using DeviceCachingAllocator = CachingAllocator<CudaMemoryResource>;
+using HostCachingAllocator   = CachingAllocator<HostMemoryResource>;
+}  // namespace muda
+
+#include "details/caching_allocator.inl"
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <muda/exception.h>
+
+namespace muda
+{
+template <typename Resource>
+CachingAllocator<Resource>::CachingAllocator(const CachingAllocatorConfig& config)
+    : m_config(config)
+{
+    MUDA_ASSERT(config.min_bin_bytes > 0 && config.min_bin_bytes <= config.max_bin_bytes,
+                "invalid config, min_bin_bytes=%lld, max_bin_bytes=%lld",
+                (long long)config.min_bin_bytes,
+                (long long)config.max_bin_bytes);
+}
+
+template <typename Resource>
+CachingAllocator<Resource>::~CachingAllocator()
+{
+    trim(0);
+    // blocks still in use are leaked on purpose: ~AllocatorBase() forgets them,
+    // so their owners free them later through the raw free function.
+}
+
+template <typename Resource>
+size_t CachingAllocator<Resource>::bin_bytes(size_t byte_size) const
+{
+    if(byte_size > m_config.max_bin_bytes)
+        return 0;
+    size_t bin = m_config.min_bin_bytes;
+    while(bin < byte_size)
+        bin <<= 1;
+    return bin;
+}
+
+template <typename Resource>
+void* CachingAllocator<Resource>::allocate(size_t byte_size, cudaStream_t stream)
+{
+    if(byte_size == 0)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto bin = bin_bytes(byte_size);
+    if(bin != 0)
+    {
+        auto iter = m_cached_blocks.find(bin);
+        if(iter != m_cached_blocks.end() && !iter->second.empty())
+        {
+            auto& blocks = iter->second;
+            // 1. the latest freed block on the same stream, no fence needed
+            auto found = std::find_if(blocks.rbegin(),
+                                      blocks.rend(),
+                                      [&](const Block& b) { return b.stream == stream; });
+            // 2. any block whose fence is reached
+            if(found == blocks.rend())
+                found = std::find_if(blocks.rbegin(),
+                                     blocks.rend(),
+                                     [&](const Block& b) {
+                                         return !b.has_fence
+                                                || m_resource.query_fence(b.fence);
+                                     });
+
+            if(found != blocks.rend())
+            {
+                Block block = *found;
+                blocks.erase(std::next(found).base());
+
+                if(block.has_fence)
+                    m_resource.release_fence(block.fence);
+                block.has_fence = false;
+                block.stream    = stream;
+
+                m_live_blocks.emplace(block.ptr, block);
+                m_stats.hit_count++;
+                m_stats.cached_bytes -= block.byte_size;
+                m_stats.in_use_bytes += block.byte_size;
+                return block.ptr;
+            }
+        }
+    }
+
+    // miss: go to the resource
+    auto  size = bin != 0 ? bin : byte_size;
+    void* ptr  = allocate_from_resource(size);
+
+    Block block;
+    block.ptr       = ptr;
+    block.byte_size = size;
+    block.stream    = stream;
+    m_live_blocks.emplace(ptr, block);
+
+    m_stats.miss_count++;
+    m_stats.in_use_bytes += size;
+    update_high_water();
+    return ptr;
+}
+
+template <typename Resource>
+bool CachingAllocator<Resource>::deallocate(void* ptr, cudaStream_t stream)
+{
+    if(!ptr)
+        return true;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto iter = m_live_blocks.find(ptr);
+    if(iter == m_live_blocks.end())
+        return false;  // not ours
+
+    Block block = iter->second;
+    m_live_blocks.erase(iter);
+    m_stats.in_use_bytes -= block.byte_size;
+
+    auto cacheable = bin_bytes(block.byte_size) == block.byte_size
+                     && m_stats.cached_bytes + block.byte_size <= m_config.max_cached_bytes;
+
+    // the work queued on `stream` may still use the block
+    block.stream    = stream;
+    block.fence     = m_resource.record_fence(stream);
+    block.has_fence = true;
+
+    if(cacheable)
+    {
+        m_cached_blocks[block.byte_size].push_back(block);
+        m_stats.cached_bytes += block.byte_size;
+    }
+    else
+    {
+        release_block(block);
+    }
+    return true;
+}
+
+template <typename Resource>
+void CachingAllocator<Resource>::trim(size_t keep_bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // release the largest size classes first, they give back the most memory
+    std::vector<size_t> bins;
+    bins.reserve(m_cached_blocks.size());
+    for(auto& [bin, blocks] : m_cached_blocks)
+        bins.push_back(bin);
+    std::sort(bins.begin(), bins.end(), std::greater<size_t>{});
+
+    for(auto bin : bins)
+    {
+        auto& blocks = m_cached_blocks[bin];
+        // release the oldest blocks first
+        while(!blocks.empty() && m_stats.cached_bytes > keep_bytes)
+        {
+            release_block(blocks.front());
+            m_stats.cached_bytes -= blocks.front().byte_size;
+            blocks.pop_front();
+        }
+        if(blocks.empty())
+            m_cached_blocks.erase(bin);
+        if(m_stats.cached_bytes <= keep_bytes)
+            break;
+    }
+}
+
+template <typename Resource>
+AllocatorStats CachingAllocator<Resource>::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+template <typename Resource>
+void CachingAllocator<Resource>::reset_stats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.hit_count        = 0;
+    m_stats.miss_count       = 0;
+    m_stats.high_water_bytes = m_stats.in_use_bytes + m_stats.cached_bytes;
+}
+
+template <typename Resource>
+void* CachingAllocator<Resource>::allocate_from_resource(size_t byte_size)
+{
+    void* ptr = m_resource.allocate(byte_size);
+    if(!ptr && m_stats.cached_bytes > 0)
+    {
+        // out of memory: give the cache back and retry
+        for(auto& [bin, blocks] : m_cached_blocks)
+            for(auto& block : blocks)
+                release_block(block);
+        m_cached_blocks.clear();
+        m_stats.cached_bytes = 0;
+        ptr                  = m_resource.allocate(byte_size);
+    }
+    if(!ptr)
+        throw runtime_error("CachingAllocator: out of memory, request "
+                            + std::to_string(byte_size) + " bytes");
+    return ptr;
+}
+
+template <typename Resource>
+void CachingAllocator<Resource>::release_block(Block& block)
+{
+    if(block.has_fence)
+    {
+        m_resource.wait_fence(block.fence);
+        m_resource.release_fence(block.fence);
+        block.has_fence = false;
+    }
+    m_resource.deallocate(block.ptr);
+}
+
+template <typename Resource>
+void CachingAllocator<Resource>::update_high_water()
+{
+    m_stats.high_water_bytes =
+        std::max(m_stats.high_water_bytes, m_stats.in_use_bytes + m_stats.cached_bytes);
+}
+}  // namespace muda
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+#include <cuda_runtime.h>
+#include <cuda_runtime_api.h>
+#include <muda/check/check_cuda_errors.h>
+
+namespace muda
+{
+/// <summary>
+/// The raw memory and fence source of CachingAllocator (on device).
+/// A fence is recorded on the stream where a block is freed,
+/// the block can be reused on another stream only after the fence is reached.
+/// </summary>
+class CudaMemoryResource
+{
+  public:
+    using Fence = cudaEvent_t;
+
+    CudaMemoryResource() = default;
+    ~CudaMemoryResource()
+    {
+        for(auto e : m_free_fences)
+            checkCudaErrors(cudaEventDestroy(e));
+    }
+
+    CudaMemoryResource(const CudaMemoryResource&)            = delete;
+    CudaMemoryResource& operator=(const CudaMemoryResource&) = delete;
+
+    // return nullptr if out of memory
+    void* allocate(size_t byte_size)
+    {
+        void* ptr = nullptr;
+        auto  err = cudaMalloc(&ptr, byte_size);
+        if(err == cudaErrorMemoryAllocation)
+        {
+            cudaGetLastError();  // clear the error, the caller may retry after trimming
+            return nullptr;
+        }
+        checkCudaErrors(err);
+        return ptr;
+    }
+
+    void deallocate(void* ptr) { checkCudaErrors(cudaFree(ptr)); }
+
+    Fence record_fence(cudaStream_t stream)
+    {
+        cudaEvent_t e = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_fence_mutex);
+            if(!m_free_fences.empty())
+            {
+                e = m_free_fences.back();
+                m_free_fences.pop_back();
+            }
+        }
+        if(!e)
+            checkCudaErrors(cudaEventCreateWithFlags(&e, cudaEventDisableTiming));
+        checkCudaErrors(cudaEventRecord(e, stream));
+        return e;
+    }
+
+    bool query_fence(Fence fence)
+    {
+        auto err = cudaEventQuery(fence);
+        if(err == cudaErrorNotReady)
+            return false;
+        checkCudaErrors(err);
+        return true;
+    }
+
+    void wait_fence(Fence fence) { checkCudaErrors(cudaEventSynchronize(fence)); }
+
+    void release_fence(Fence fence)
+    {
+        std::lock_guard<std::mutex> lock(m_fence_mutex);
+        m_free_fences.push_back(fence);
+    }
+
+  private:
+    std::mutex               m_fence_mutex;
+    std::vector<cudaEvent_t> m_free_fences;
+};
+
+/// <summary>
+/// The host memory counterpart of CudaMemoryResource.
+/// Host memory is not stream ordered, so every fence is reached once it's recorded.
+/// Mainly used to test and profile CachingAllocator without a GPU.
+/// </summary>
+class HostMemoryResource
+{
+  public:
+    using Fence = cudaStream_t;
+
+    void* allocate(size_t byte_size) { return std::malloc(byte_size); }
+    void  deallocate(void* ptr) { std::free(ptr); }
+
+    Fence record_fence(cudaStream_t stream) { return stream; }
+    bool  query_fence(Fence) { return true; }
+    void  wait_fence(Fence) {}
+    void  release_fence(Fence) {}
+};
+}  // namespace muda
@@ -2,6 +2,9 @@
 #include <muda/buffer/device_buffer.h>
 #include <muda/buffer/device_var.h>
 #include <muda/buffer/buffer_launch.h>
+#include <muda/buffer/pinned_buffer.h>
+#include <muda/buffer/buffer_completion.h>
+#include <muda/buffer/viewer_table.h>
 #include <muda/buffer/buffer_view.h>
 #include <muda/buffer/graph_buffer_view.h>
 #include <muda/buffer/var_view.h>
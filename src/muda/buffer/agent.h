@@ -1,4 +1,5 @@
 #pragma once
+#include <muda/buffer/agent/pitched_rows.h>
 #include <muda/buffer/agent/kernel_assign.h>
 #include <muda/buffer/agent/kernel_construct.h>
 #include <muda/buffer/agent/kernel_copy_construct.h>
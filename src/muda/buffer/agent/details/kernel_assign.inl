@@ -1,11 +1,77 @@
+#include <algorithm>
 #include <muda/type_traits/type_label.h>
+#include <muda/launch/launch.h>
 #include <muda/launch/parallel_for.h>
+#include <muda/compute_graph/compute_graph_builder.h>
 #include <muda/buffer/buffer_view.h>
 #include <muda/buffer/buffer_2d_view.h>
 #include <muda/buffer/buffer_3d_view.h>
+#include <muda/buffer/agent/pitched_rows.h>
 
 namespace muda::details::buffer
 {
+// copy the first `words` words of every row, see row_tiled_config
+template <typename Word>
+MUDA_INLINE MUDA_DEVICE void assign_rows(const PitchedRows& dst, const PitchedRows& src, size_t words)
+{
+    for(size_t r = blockIdx.y * blockDim.y + threadIdx.y; r < dst.rows;
+        r += static_cast<size_t>(gridDim.y) * blockDim.y)
+    {
+        auto to   = reinterpret_cast<Word*>(dst.row(r));
+        auto from = reinterpret_cast<const Word*>(src.row(r));
+        for(size_t c = blockIdx.x * blockDim.x + threadIdx.x; c < words;
+            c += static_cast<size_t>(gridDim.x) * blockDim.x)
+            to[c] = from[c];
+    }
+}
+
+// assign the rows of a 2D/3D view, dst and src have the same extent
+template <typename T>
+MUDA_INLINE MUDA_HOST void kernel_assign_rows(
+    int grid_dim, int block_dim, cudaStream_t stream, const PitchedRows& dst, const PitchedRows& src)
+{
+    if(ComputeGraphBuilder::is_phase_none() && dst.empty())
+        return;
+
+    // 0: assign T one by one, otherwise the word size of the vector loads/stores
+    size_t word_bytes = 0;
+    if constexpr(std::is_trivially_copyable_v<T>)
+        word_bytes = std::min(dst.max_word_bytes(), src.max_word_bytes());
+
+    size_t words = word_bytes ? dst.row_bytes / word_bytes : dst.row_bytes / sizeof(T);
+
+    dim3 grid, block;
+    row_tiled_config(grid_dim, block_dim, dst, words, grid, block);
+
+    // the word size is a kernel argument, so all the cases share one kernel (and one graph node)
+    Launch(grid, block, 0, stream)
+        .apply(
+            [dst, src, words, word_bytes] __device__() mutable
+            {
+                switch(word_bytes)
+                {
+                    case 16:
+                        assign_rows<uint4>(dst, src, words);
+                        break;
+                    case 8:
+                        assign_rows<uint2>(dst, src, words);
+                        break;
+                    case 4:
+                        assign_rows<uint32_t>(dst, src, words);
+                        break;
+                    case 2:
+                        assign_rows<uint16_t>(dst, src, words);
+                        break;
+                    case 1:
+                        assign_rows<uint8_t>(dst, src, words);
+                        break;
+                    default:
+                        assign_rows<T>(dst, src, words);
+                        break;
+                }
+            });
+}
+
 // assign 0D
 template <typename T>
 MUDA_INLINE MUDA_HOST void kernel_assign(cudaStream_t stream, VarView<T> dst, CVarView<T> src)
@@ -25,8 +91,8 @@ MUDA_INLINE MUDA_HOST void kernel_assign(int            grid_dim,
                                          CBufferView<T> src)
 {
     ParallelFor(grid_dim, block_dim, 0, stream)
-        .apply(dst.size(),
-               [dst, src] __device__(int i) mutable
+        .apply(static_cast<index_t>(dst.size()),
+               [dst, src] __device__(index_t i) mutable
                { *dst.data(i) = *src.data(i); });
 }
 
@@ -38,10 +104,7 @@ MUDA_INLINE MUDA_HOST void kernel_assign(int              grid_dim,
                                          Buffer2DView<T>  dst,
                                          CBuffer2DView<T> src)
 {
-    ParallelFor(grid_dim, block_dim, 0, stream)
-        .apply(dst.total_size(),
-               [dst, src] __device__(int i) mutable
-               { *dst.data(i) = *src.data(i); });
+    kernel_assign_rows<T>(grid_dim, block_dim, stream, pitched_rows(dst), pitched_rows(src));
 }
 
 // assign 3D
@@ -52,9 +115,6 @@ MUDA_INLINE MUDA_HOST void kernel_assign(int              grid_dim,
                                          Buffer3DView<T>  dst,
                                          CBuffer3DView<T> src)
 {
-    ParallelFor(grid_dim, block_dim, 0, stream)
-        .apply(dst.total_size(),
-               [dst, src] __device__(int i) mutable
-               { *dst.data(i) = *src.data(i); });
+    kernel_assign_rows<T>(grid_dim, block_dim, stream, pitched_rows(dst), pitched_rows(src));
 }
 }  // namespace muda::details::buffer
\ No newline at end of file
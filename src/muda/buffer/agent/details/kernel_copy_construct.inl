@@ -27,8 +27,8 @@ MUDA_INLINE MUDA_HOST void kernel_copy_construct_non_trivial(int grid_dim,
                                                              CBufferView<T>& src)
 {
     ParallelFor(grid_dim, block_dim, 0, stream)
-        .apply(dst.size(),
-               [dst, src] __device__(int i) mutable
+        .apply(static_cast<index_t>(dst.size()),
+               [dst, src] __device__(index_t i) mutable
                { new(dst.data(i)) T(*src.data(i)); });
 }
 
@@ -60,7 +60,7 @@ MUDA_INLINE MUDA_HOST void kernel_copy_construct_non_trivial(int grid_dim,
 {
     ParallelFor(grid_dim, block_dim, 0, stream)
         .apply(dst.total_size(),
-               [dst, src] __device__(int i) mutable
+               [dst, src] __device__(index_t i) mutable
                { new(dst.data(i)) T(*src.data(i)); });
 }
 
@@ -100,7 +100,7 @@ MUDA_INLINE MUDA_HOST void kernel_copy_construct_non_trivial(int grid_dim,
 {
     ParallelFor(grid_dim, block_dim, 0, stream)
         .apply(dst.total_size(),
-               [dst, src] __device__(int i) mutable
+               [dst, src] __device__(index_t i) mutable
                { new(dst.data(i)) T(*src.data(i)); });
 }
 
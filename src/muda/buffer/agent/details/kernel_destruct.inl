@@ -30,8 +30,8 @@ MUDA_INLINE MUDA_HOST void kernel_destruct(int           grid_dim,
         return;
 
     ParallelFor(grid_dim, block_dim, size_t{0}, stream)
-        .apply(static_cast<int>(buffer_view.size()),
-               [buffer_view] __device__(int i) mutable
+        .apply(static_cast<index_t>(buffer_view.size()),
+               [buffer_view] __device__(index_t i) mutable
                { buffer_view.data(i)->~T(); });
 }
 
@@ -48,7 +48,7 @@ MUDA_INLINE MUDA_HOST void kernel_destruct(int             grid_dim,
 
     ParallelFor(grid_dim, block_dim, 0, stream)
         .apply(buffer_view.total_size(),
-               [buffer_view] __device__(int i) mutable
+               [buffer_view] __device__(index_t i) mutable
                { buffer_view.data(i)->~T(); });
 }
 
@@ -65,7 +65,7 @@ MUDA_INLINE MUDA_HOST void kernel_destruct(int             grid_dim,
 
     ParallelFor(grid_dim, block_dim, 0, stream)
         .apply(buffer_view.total_size(),
-               [buffer_view] __device__(int i) mutable
+               [buffer_view] __device__(index_t i) mutable
                { buffer_view.data(i)->~T(); });
 }
 }  // namespace muda::details::buffer
\ No newline at end of file
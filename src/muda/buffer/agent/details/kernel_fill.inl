@@ -1,12 +1,104 @@
+#include <algorithm>
 #include <muda/type_traits/type_label.h>
 #include <muda/launch/memory.h>
+#include <muda/launch/launch.h>
 #include <muda/launch/parallel_for.h>
+#include <muda/compute_graph/compute_graph_builder.h>
 #include <muda/buffer/buffer_view.h>
 #include <muda/buffer/buffer_2d_view.h>
 #include <muda/buffer/buffer_3d_view.h>
+#include <muda/buffer/agent/pitched_rows.h>
 
 namespace muda::details::buffer
 {
+// store `word` to the first `words` words of every row, see row_tiled_config
+template <typename Word>
+MUDA_INLINE MUDA_DEVICE void fill_rows(const PitchedRows& dst, size_t words, const Word& word)
+{
+    for(size_t r = blockIdx.y * blockDim.y + threadIdx.y; r < dst.rows;
+        r += static_cast<size_t>(gridDim.y) * blockDim.y)
+    {
+        auto row = reinterpret_cast<Word*>(dst.row(r));
+        for(size_t c = blockIdx.x * blockDim.x + threadIdx.x; c < words;
+            c += static_cast<size_t>(gridDim.x) * blockDim.x)
+            row[c] = word;
+    }
+}
+
+// fill the rows of a 2D/3D view
+template <typename T>
+MUDA_INLINE MUDA_HOST void kernel_fill_rows(
+    int grid_dim, int block_dim, cudaStream_t stream, const PitchedRows& dst, const T& val)
+{
+    // 0: store T one by one, otherwise the word size of the vector stores
+    size_t word_bytes = 0;
+    // the bytes of val repeated, so the first `word_bytes` bytes are a word of vals
+    uint4 pattern = {};
+
+    if constexpr(std::is_trivially_copyable_v<T>)
+    {
+        word_bytes = dst.max_word_bytes();
+        while(word_bytes % sizeof(T) != 0)
+            word_bytes >>= 1;
+
+        auto bytes = reinterpret_cast<const std::byte*>(&val);
+        auto words = reinterpret_cast<std::byte*>(&pattern);
+        for(size_t i = 0; i < sizeof(pattern); ++i)
+            words[i] = bytes[i % sizeof(T)];
+
+        // every byte of val is the same (e.g. zero): memset.
+        // only on direct launch, a graph node must not change its type on update
+        if(ComputeGraphBuilder::is_phase_none())
+        {
+            if(dst.empty())
+                return;
+
+            bool same_bytes = std::all_of(
+                bytes, bytes + sizeof(T), [&](std::byte b) { return b == bytes[0]; });
+            if(same_bytes && memset_rows(stream, dst, static_cast<char>(bytes[0])))
+                return;
+        }
+    }
+    else
+    {
+        if(ComputeGraphBuilder::is_phase_none() && dst.empty())
+            return;
+    }
+
+    size_t words = word_bytes ? dst.row_bytes / word_bytes : dst.row_bytes / sizeof(T);
+
+    dim3 grid, block;
+    row_tiled_config(grid_dim, block_dim, dst, words, grid, block);
+
+    // the word size is a kernel argument, so all the cases share one kernel (and one graph node)
+    Launch(grid, block, 0, stream)
+        .apply(
+            [dst, words, word_bytes, pattern, val] __device__() mutable
+            {
+                switch(word_bytes)
+                {
+                    case 16:
+                        fill_rows(dst, words, pattern);
+                        break;
+                    case 8:
+                        fill_rows(dst, words, *reinterpret_cast<const uint2*>(&pattern));
+                        break;
+                    case 4:
+                        fill_rows(dst, words, *reinterpret_cast<const uint32_t*>(&pattern));
+                        break;
+                    case 2:
+                        fill_rows(dst, words, *reinterpret_cast<const uint16_t*>(&pattern));
+                        break;
+                    case 1:
+                        fill_rows(dst, words, *reinterpret_cast<const uint8_t*>(&pattern));
+                        break;
+                    default:
+                        fill_rows(dst, words, val);
+                        break;
+                }
+            });
+}
+
 // fill 0D
 template <typename T>
 MUDA_INLINE MUDA_HOST void kernel_fill(cudaStream_t stream, VarView<T> dst, const T& val)
@@ -30,8 +122,8 @@ MUDA_INLINE MUDA_HOST void kernel_fill(
     int grid_dim, int block_dim, cudaStream_t stream, BufferView<T> dst, const T& val)
 {
     ParallelFor(grid_dim, block_dim, 0, stream)
-        .apply(dst.size(),
-               [dst, val] __device__(int i) mutable { *dst.data(i) = val; });
+        .apply(static_cast<index_t>(dst.size()),
+               [dst, val] __device__(index_t i) mutable { *dst.data(i) = val; });
 }
 
 // fill 2D
@@ -39,18 +131,14 @@ template <typename T>
 MUDA_INLINE MUDA_HOST void kernel_fill(
     int grid_dim, int block_dim, cudaStream_t stream, Buffer2DView<T> dst, const T& val)
 {
-    ParallelFor(grid_dim, block_dim, 0, stream)
-        .apply(dst.total_size(),
-               [dst, val] __device__(int i) mutable { *dst.data(i) = val; });
-};
+    kernel_fill_rows(grid_dim, block_dim, stream, pitched_rows(dst), val);
+}
 
 // fill 3D
 template <typename T>
 MUDA_INLINE MUDA_HOST void kernel_fill(
     int grid_dim, int block_dim, cudaStream_t stream, Buffer3DView<T> dst, const T& val)
 {
-    ParallelFor(grid_dim, block_dim, 0, stream)
-        .apply(dst.total_size(),
-               [dst, val] __device__(int i) mutable { *dst.data(i) = val; });
-};
+    kernel_fill_rows(grid_dim, block_dim, stream, pitched_rows(dst), val);
+}
 }  // namespace muda::details::buffer
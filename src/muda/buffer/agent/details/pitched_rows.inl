@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <muda/launch/memory.h>
+#include <muda/buffer/buffer_2d_view.h>
+#include <muda/buffer/buffer_3d_view.h>
+
+namespace muda::details::buffer
+{
+MUDA_INLINE MUDA_GENERIC size_t PitchedRows::max_word_bytes() const MUDA_NOEXCEPT
+{
+    // every row start and the row length must be a multiple of the word
+    auto bits = reinterpret_cast<uintptr_t>(data) | row_bytes;
+    if(height > 1 && rows > 1)
+        bits |= pitch;
+    if(rows > height)
+        bits |= pitch_area;
+
+    size_t word = 16;
+    while(word > 1 && (bits & (word - 1)) != 0)
+        word >>= 1;
+    return word;
+}
+
+template <typename T>
+MUDA_INLINE MUDA_HOST PitchedRows pitched_rows(const Buffer2DViewBase<T>& view) MUDA_NOEXCEPT
+{
+    auto        extent = view.extent();
+    PitchedRows r;
+    r.data       = reinterpret_cast<std::byte*>(const_cast<T*>(view.data(0, 0)));
+    r.row_bytes  = extent.width() * sizeof(T);
+    r.pitch      = view.pitch_bytes();
+    r.height     = extent.height();
+    r.pitch_area = r.pitch * r.height;
+    r.rows       = extent.height();
+    return r;
+}
+
+template <typename T>
+MUDA_INLINE MUDA_HOST PitchedRows pitched_rows(const Buffer3DViewBase<T>& view) MUDA_NOEXCEPT
+{
+    auto        extent = view.extent();
+    PitchedRows r;
+    r.data       = reinterpret_cast<std::byte*>(const_cast<T*>(view.data(0, 0, 0)));
+    r.row_bytes  = extent.width() * sizeof(T);
+    r.pitch      = view.pitch_bytes();
+    r.pitch_area = view.pitch_bytes_area();
+    r.height     = extent.height();
+    r.rows       = extent.height() * extent.depth();
+    return r;
+}
+
+MUDA_INLINE MUDA_HOST bool memset_rows(cudaStream_t stream, const PitchedRows& rows, char value)
+{
+    if(rows.empty())
+        return true;
+
+    // one slice, the pointer already has the offset of the view
+    if(rows.rows <= rows.height)
+    {
+        Memory(stream).set(rows.data, rows.pitch, rows.row_bytes, rows.rows, value);
+        return true;
+    }
+
+    // cudaMemset3D takes the slice pitch as pitch * ysize
+    if(rows.pitch == 0 || rows.pitch_area % rows.pitch != 0)
+        return false;
+
+    auto pitched_ptr = make_cudaPitchedPtr(
+        rows.data, rows.pitch, rows.row_bytes, rows.pitch_area / rows.pitch);
+    auto extent = make_cudaExtent(rows.row_bytes, rows.height, rows.rows / rows.height);
+    Memory(stream).set(pitched_ptr, extent, value);
+    return true;
+}
+
+MUDA_INLINE MUDA_HOST void row_tiled_config(int                grid_dim,
+                                            int                block_dim,
+                                            const PitchedRows& rows,
+                                            size_t             words_per_row,
+                                            dim3&              grid,
+                                            dim3&              block) MUDA_NOEXCEPT
+{
+    MUDA_ASSERT(block_dim > 0, "block_dim should be positive, yours=%d", block_dim);
+
+    // x: the smallest power of 2 covering the row (up to the block size), y: the rows in a block
+    unsigned int x = 1;
+    while(x * 2 <= static_cast<unsigned int>(block_dim) && x < words_per_row)
+        x *= 2;
+    unsigned int y = static_cast<unsigned int>(block_dim) / x;
+
+    constexpr size_t max_grid_x = INT_MAX;
+    constexpr size_t max_grid_y = 65535;
+
+    size_t grid_x = std::clamp<size_t>(words_per_row / x + (words_per_row % x != 0), 1, max_grid_x);
+    size_t grid_y = std::clamp<size_t>(rows.rows / y + (rows.rows % y != 0), 1, max_grid_y);
+    if(grid_dim > 0)
+    {
+        grid_x = std::min<size_t>(grid_x, grid_dim);
+        grid_y = std::clamp<size_t>(grid_dim / grid_x, 1, grid_y);
+    }
+
+    grid  = dim3(static_cast<unsigned int>(grid_x), static_cast<unsigned int>(grid_y));
+    block = dim3(x, y);
+}
+}  // namespace muda::details::buffer
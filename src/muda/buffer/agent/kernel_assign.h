@@ -1,6 +1,7 @@
 #pragma once
 #include <cuda.h>
 #include <muda/buffer/buffer_fwd.h>
+#include <muda/buffer/agent/pitched_rows.h>
 
 namespace muda::details::buffer
 {
@@ -31,6 +32,14 @@ MUDA_HOST void kernel_assign(int              grid_dim,
                              cudaStream_t     stream,
                              Buffer3DView<T>  dst,
                              CBuffer3DView<T> src);
+
+// assign the rows of 2D/3D views with the same extent: 128-bit loads/stores if the alignment allows
+template <typename T>
+MUDA_HOST void kernel_assign_rows(int                grid_dim,
+                                  int                block_dim,
+                                  cudaStream_t       stream,
+                                  const PitchedRows& dst,
+                                  const PitchedRows& src);
 }  // namespace muda::details::buffer
 
 #include "details/kernel_assign.inl"
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <cuda.h>
 #include <muda/buffer/buffer_fwd.h>
+#include <muda/buffer/agent/pitched_rows.h>
 
 namespace muda::details::buffer
 {
@@ -28,6 +29,12 @@ MUDA_HOST void kernel_fill(int             grid_dim,
                            cudaStream_t    stream,
                            Buffer3DView<T> dst,
                            const T&        val);
+
+// fill the rows of a 2D/3D view: 128-bit stores if the alignment allows,
+// memset if every byte of val is the same (direct launch only)
+template <typename T>
+MUDA_HOST void kernel_fill_rows(
+    int grid_dim, int block_dim, cudaStream_t stream, const PitchedRows& dst, const T& val);
 }  // namespace muda::details::buffer
 
 #include "details/kernel_fill.inl"
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include <cuda.h>
+#include <cuda_runtime.h>
+#include <cstddef>
+#include <muda/muda_def.h>
+#include <muda/buffer/buffer_fwd.h>
+
+namespace muda::details::buffer
+{
+/// <summary>
+/// The rows of a 2D/3D buffer view seen as raw bytes: `rows` rows of `row_bytes` contiguous bytes,
+/// row r starts at `data + (r / height) * pitch_area + (r % height) * pitch`.
+///
+/// The fill/copy kernels walk rows instead of flattened elements, so there is no div/mod per element,
+/// and a row is accessed with the widest word (up to 128 bits) its alignment allows.
+/// </summary>
+class PitchedRows
+{
+  public:
+    std::byte* data       = nullptr;  // the first element of the view (offset applied)
+    size_t     row_bytes  = 0;
+    size_t     pitch      = 0;
+    size_t     pitch_area = 0;
+    size_t     height     = 1;  // rows per depth slice
+    size_t     rows       = 0;  // rows in total
+
+    MUDA_GENERIC std::byte* row(size_t r) const MUDA_NOEXCEPT
+    {
+        return data + (r / height) * pitch_area + (r % height) * pitch;
+    }
+
+    MUDA_GENERIC bool empty() const MUDA_NOEXCEPT
+    {
+        return rows == 0 || row_bytes == 0;
+    }
+
+    // the widest word (16, 8, 4, 2 or 1 bytes) every row can be accessed with
+    MUDA_GENERIC size_t max_word_bytes() const MUDA_NOEXCEPT;
+};
+
+template <typename T>
+MUDA_HOST PitchedRows pitched_rows(const Buffer2DViewBase<T>& view) MUDA_NOEXCEPT;
+
+template <typename T>
+MUDA_HOST PitchedRows pitched_rows(const Buffer3DViewBase<T>& view) MUDA_NOEXCEPT;
+
+// cudaMemset2D/3D on the rows, the offset of the view is in `data`.
+// return false if the rows can't be expressed as a pitched pointer (then use a kernel)
+MUDA_HOST bool memset_rows(cudaStream_t stream, const PitchedRows& rows, char value);
+
+// the launch config of a row tiled kernel: x walks the words of a row, y walks the rows.
+// short rows share a block, so the threads are not idle when a row has few words.
+// grid_dim > 0 limits the total blocks (then the kernel strides)
+MUDA_HOST void row_tiled_config(int                grid_dim,
+                                int                block_dim,
+                                const PitchedRows& rows,
+                                size_t             words_per_row,
+                                dim3&              grid,
+                                dim3&              block) MUDA_NOEXCEPT;
+}  // namespace muda::details::buffer
+
+#include "details/pitched_rows.inl"
@@ -0,0 +1,30 @@
+#pragma once
+#include <muda/launch/event.h>
+
+namespace muda
+{
+/// <summary>
+/// BufferCompletion: marks the completion of the work queued on a stream before it,
+/// created by BufferLaunch::completion(), e.g.
+///     auto done = BufferLaunch(stream).copy(pinned.data(), view).completion();
+///     while(!done.is_ready()) { ... }  // or done.wait()
+/// </summary>
+class BufferCompletion
+{
+    Event m_event;
+
+  public:
+    BufferCompletion(cudaStream_t stream);
+
+    // true if the work is done, never blocks
+    bool is_ready() const;
+    // block the host until the work is done
+    void wait() const;
+    // let the following work on `stream` wait for the completion, never blocks the host
+    void when(cudaStream_t stream) const;
+
+    cudaEvent_t event() const { return m_event.viewer(); }
+};
+}  // namespace muda
+
+#include "details/buffer_completion.inl"
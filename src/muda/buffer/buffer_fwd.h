@@ -14,12 +14,18 @@ class BufferView;
 template <typename T>
 class CBufferView;
 
+template <typename T>
+class Buffer2DViewBase;
+
 template <typename T>
 class Buffer2DView;
 
 template <typename T>
 class CBuffer2DView;
 
+template <typename T>
+class Buffer3DViewBase;
+
 template <typename T>
 class Buffer3DView;
 
@@ -32,6 +32,8 @@ template <typename T>
 class CBuffer3DView;
 template <typename T>
 class ComputeGraphVar;
+class PinnedStaging;
+class BufferCompletion;
 
 class BufferLaunch : public LaunchBase<BufferLaunch>
 {
@@ -218,6 +220,24 @@ class BufferLaunch : public LaunchBase<BufferLaunch>
     MUDA_HOST BufferLaunch& copy(ComputeGraphVar<Buffer3DView<T>>& dst,
                                  const ComputeGraphVar<T*>&        src);
 
+    /**********************************************************************************************
+    * 
+    * BufferView Staged Copy: Pageable Host <-> Device
+    * 
+    * The copy goes chunk by chunk through the page-locked staging, the DMA of a chunk overlaps
+    * the host copy of the other. Download returns when `dst` is filled,
+    * upload returns when `src` is consumed (the last chunks may still be in flight).
+    * For the host memory you own, prefer a PinnedBuffer, the copy is then fully asynchronous.
+    * 
+    **********************************************************************************************/
+    template <typename T>
+    MUDA_HOST BufferLaunch& copy(T* dst, CBufferView<T> src, PinnedStaging& staging);
+    template <typename T>
+    MUDA_HOST BufferLaunch& copy(BufferView<T> dst, const T* src, PinnedStaging& staging);
+
+    // mark the completion of the work queued on the stream so far, never blocks
+    MUDA_HOST BufferCompletion completion();
+
     /**********************************************************************************************
     * 
     * BufferView Scatter: Device <- Host
@@ -3,6 +3,7 @@
 #include <cuda_runtime.h>
 #include <cuda_runtime_api.h>
 #include <cinttypes>
+#include <limits>
 #include <muda/type_traits/type_modifier.h>
 #include <muda/viewer/dense/dense_1d.h>
 #include <muda/buffer/buffer_fwd.h>
@@ -57,6 +58,10 @@ class BufferViewBase
 
     MUDA_GENERIC BufferViewBase subview(size_t offset, size_t size = ~0) const MUDA_NOEXCEPT;
     MUDA_GENERIC CDense1D<T> cviewer() const MUDA_NOEXCEPT;
+
+  protected:
+    // the viewers index with index_t
+    MUDA_GENERIC void check_index_range() const MUDA_NOEXCEPT;
 };
 
 template <typename T>
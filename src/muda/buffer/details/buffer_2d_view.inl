@@ -55,7 +55,7 @@ MUDA_GENERIC CDense2D<T> Buffer2DViewBase<T>::cviewer() const MUDA_NOEXCEPT
                        make_int2((int)m_offset.offset_in_height(),
                                  (int)m_offset.offset_in_width()),
                        make_int2((int)m_extent.height(), (int)m_extent.width()),
-                       (int)m_pitch_bytes};
+                       (index_t)m_pitch_bytes};
 }
 
 template <typename T>
@@ -72,7 +72,7 @@ MUDA_GENERIC Dense2D<T> Buffer2DView<T>::viewer() const MUDA_NOEXCEPT
                       make_int2((int)m_offset.offset_in_height(),
                                 (int)m_offset.offset_in_width()),
                       make_int2((int)m_extent.height(), (int)m_extent.width()),
-                      (int)m_pitch_bytes};
+                      (index_t)m_pitch_bytes};
 }
 
 template <typename T>
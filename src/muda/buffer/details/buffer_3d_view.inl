@@ -69,8 +69,8 @@ MUDA_GENERIC CDense3D<T> Buffer3DViewBase<T>::cviewer() const MUDA_NOEXCEPT
                                  m_offset.offset_in_height(),
                                  m_offset.offset_in_width()),
                        make_int3(m_extent.depth(), m_extent.height(), m_extent.width()),
-                       (int)m_pitch_bytes,
-                       (int)m_pitch_bytes_area};
+                       (index_t)m_pitch_bytes,
+                       (index_t)m_pitch_bytes_area};
 }
 
 template <typename T>
@@ -87,8 +87,8 @@ MUDA_GENERIC Dense3D<T> Buffer3DView<T>::viewer() const MUDA_NOEXCEPT
                                 m_offset.offset_in_height(),
                                 m_offset.offset_in_width()),
                       make_int3(m_extent.depth(), m_extent.height(), m_extent.width()),
-                      (int)m_pitch_bytes,
-                      (int)m_pitch_bytes_area};
+                      (index_t)m_pitch_bytes,
+                      (index_t)m_pitch_bytes_area};
 }
 
 template <typename T>
@@ -0,0 +1,24 @@
+#include <muda/check/check_cuda_errors.h>
+
+namespace muda
+{
+MUDA_INLINE BufferCompletion::BufferCompletion(cudaStream_t stream)
+{
+    checkCudaErrors(cudaEventRecord(m_event, stream));
+}
+
+MUDA_INLINE bool BufferCompletion::is_ready() const
+{
+    return m_event.query() == Event::QueryResult::eFinished;
+}
+
+MUDA_INLINE void BufferCompletion::wait() const
+{
+    checkCudaErrors(cudaEventSynchronize(m_event.viewer()));
+}
+
+MUDA_INLINE void BufferCompletion::when(cudaStream_t stream) const
+{
+    checkCudaErrors(cudaStreamWaitEvent(stream, m_event.viewer(), 0));
+}
+}  // namespace muda
@@ -8,6 +8,9 @@
 #include <muda/buffer/graph_buffer_2d_view.h>
 #include <muda/buffer/graph_buffer_3d_view.h>
 
+#include <muda/buffer/pinned_buffer.h>
+#include <muda/buffer/buffer_completion.h>
+
 #include <muda/buffer/agent.h>
 #include <muda/buffer/reshape_nd/nd_reshaper.h>
 
@@ -51,25 +54,19 @@ MUDA_HOST BufferLaunch& BufferLaunch::resize(DeviceBuffer2D<T>& buffer, Extent2D
                   extent,
                   [&](Buffer2DView<T> view)  // construct
                   {
-                      // cudaMemset2D has no offset, so we can't use it here
-
-                      //if constexpr(std::is_trivially_constructible_v<T>)
-                      //{
-                      //    Extent2D extent = view.extent();
-                      //    Memory(m_stream).set(view.data(),
-                      //                         view.pitch_bytes(),
-                      //                         extent.width() * sizeof(T),
-                      //                         extent.height(),
-                      //                         0);
-                      //}
-                      //else
-                      //{
-                      //    static_assert(std::is_constructible_v<T>,
-                      //                  "The type T must be constructible, which means T must have a 0-arg constructor");
-
-                      //    details::buffer::kernel_construct(m_grid_dim, m_block_dim, m_stream, view);
-                      //}
-                      details::buffer::kernel_construct(m_grid_dim, m_block_dim, m_stream, view);
+                      // the view starts at its offset, so cudaMemset2D on the rows works
+                      if constexpr(std::is_trivially_constructible_v<T>)
+                      {
+                          details::buffer::memset_rows(
+                              m_stream, details::buffer::pitched_rows(view), 0);
+                      }
+                      else
+                      {
+                          static_assert(std::is_constructible_v<T>,
+                                        "The type T must be constructible, which means T must have a 0-arg constructor");
+
+                          details::buffer::kernel_construct(m_grid_dim, m_block_dim, m_stream, view);
+                      }
                   });
 }
 
@@ -80,22 +77,22 @@ MUDA_HOST BufferLaunch& BufferLaunch::resize(DeviceBuffer3D<T>& buffer, Extent3D
                   extent,
                   [&](Buffer3DView<T> view)  // construct
                   {
-                      // cudaMemset3D has no offset, so we can't use it here
-
-                      //if constexpr(std::is_trivially_constructible_v<T>)
-                      //{
-                      //    Extent3D       extent      = view.extent();
-                      //    cudaPitchedPtr pitched_ptr = view.cuda_pitched_ptr();
-                      //    Memory(m_stream).set(pitched_ptr, extent.cuda_extent<T>(), 0);
-                      //}
-                      //else
-                      //{
-                      //    static_assert(std::is_constructible_v<T>,
-                      //                  "The type T must be constructible, which means T must have a 0-arg constructor");
-                      //    details::buffer::kernel_construct(m_grid_dim, m_block_dim, m_stream, view);
-                      //
-                      //}
-                      details::buffer::kernel_construct(m_grid_dim, m_block_dim, m_stream, view);
+                      // cudaMemset3D on the rows, or a kernel if the slice pitch is not a
+                      // multiple of the row pitch
+                      if constexpr(std::is_trivially_constructible_v<T>)
+                      {
+                          auto rows = details::buffer::pitched_rows(view);
+                          if(!details::buffer::memset_rows(m_stream, rows, 0))
+                              details::buffer::kernel_fill_rows(
+                                  m_grid_dim, m_block_dim, m_stream, rows, T{});
+                      }
+                      else
+                      {
+                          static_assert(std::is_constructible_v<T>,
+                                        "The type T must be constructible, which means T must have a 0-arg constructor");
+
+                          details::buffer::kernel_construct(m_grid_dim, m_block_dim, m_stream, view);
+                      }
                   });
 }
 
@@ -662,4 +659,76 @@ MUDA_HOST BufferLaunch& BufferLaunch::resize(DeviceBuffer3D<T>& buffer,
         m_grid_dim, m_block_dim, m_stream, buffer, new_extent, std::forward<FConstruct>(fct));
     return *this;
 }
+
+/**********************************************************************************************
+* 
+* BufferView Staged Copy: Pageable Host <-> Device
+* 
+**********************************************************************************************/
+template <typename T>
+MUDA_HOST BufferLaunch& BufferLaunch::copy(T* dst, CBufferView<T> src, PinnedStaging& staging)
+{
+    auto total = src.size() * sizeof(T);
+    auto chunk = staging.chunk_bytes();
+    auto from  = reinterpret_cast<const std::byte*>(src.data());
+    auto to    = reinterpret_cast<std::byte*>(dst);
+
+    // the chunk being downloaded, it is copied to `dst` while the next one is downloading
+    int    pending_slot   = -1;
+    size_t pending_offset = 0;
+    size_t pending_size   = 0;
+    auto   flush          = [&]
+    {
+        if(pending_slot < 0)
+            return;
+        wait_event(staging.event(pending_slot));
+        std::memcpy(to + pending_offset, staging.host(pending_slot), pending_size);
+        pending_slot = -1;
+    };
+
+    int slot = 0;
+    for(size_t offset = 0; offset < total; offset += chunk)
+    {
+        auto size = std::min(chunk, total - offset);
+        // the chunk may still be in use by a previous copy (e.g. an upload with the same staging)
+        wait_event(staging.event(slot));
+        Memory(m_stream).download(staging.host(slot), from + offset, size);
+        record(staging.event(slot));
+
+        flush();
+        pending_slot   = slot;
+        pending_offset = offset;
+        pending_size   = size;
+        slot ^= 1;
+    }
+    flush();
+    return *this;
+}
+
+template <typename T>
+MUDA_HOST BufferLaunch& BufferLaunch::copy(BufferView<T> dst, const T* src, PinnedStaging& staging)
+{
+    auto total = dst.size() * sizeof(T);
+    auto chunk = staging.chunk_bytes();
+    auto from  = reinterpret_cast<const std::byte*>(src);
+    auto to    = reinterpret_cast<std::byte*>(dst.data());
+
+    int slot = 0;
+    for(size_t offset = 0; offset < total; offset += chunk)
+    {
+        auto size = std::min(chunk, total - offset);
+        // the upload from this chunk (two chunks ago) must be done
+        wait_event(staging.event(slot));
+        std::memcpy(staging.host(slot), from + offset, size);
+        Memory(m_stream).upload(to + offset, staging.host(slot), size);
+        record(staging.event(slot));
+        slot ^= 1;
+    }
+    return *this;
+}
+
+MUDA_INLINE MUDA_HOST BufferCompletion BufferLaunch::completion()
+{
+    return BufferCompletion{m_stream};
+}
 }  // namespace muda
\ No newline at end of file
@@ -55,13 +55,23 @@ MUDA_HOST void CBufferView<T>::copy_to(T* host) const
 template <typename T>
 MUDA_GENERIC Dense1D<T> BufferView<T>::viewer() const MUDA_NOEXCEPT
 {
-    return Dense1D<T>{this->m_data, static_cast<int>(m_size)};
+    this->check_index_range();
+    return Dense1D<T>{this->m_data, static_cast<index_t>(this->m_size)};
 }
 
 template <typename T>
 MUDA_GENERIC CDense1D<T> BufferViewBase<T>::cviewer() const MUDA_NOEXCEPT
 {
-    return CDense1D<T>{m_data, static_cast<int>(m_size)};
+    check_index_range();
+    return CDense1D<T>{m_data, static_cast<index_t>(m_size)};
+}
+
+template <typename T>
+MUDA_GENERIC void BufferViewBase<T>::check_index_range() const MUDA_NOEXCEPT
+{
+    MUDA_KERNEL_ASSERT(m_size <= static_cast<size_t>(std::numeric_limits<index_t>::max()),
+                       "BufferView: size = %llu is out of the index range, define MUDA_INDEX_64=1 to view it",
+                       (unsigned long long)m_size);
 }
 }  // namespace muda
 
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cstring>
+#include <muda/check/check_cuda_errors.h>
+#include <muda/launch/launch_base.h>
+
+namespace muda
+{
+template <typename T>
+PinnedBuffer<T>::PinnedBuffer(size_t n)
+{
+    resize(n);
+}
+
+template <typename T>
+PinnedBuffer<T>::PinnedBuffer() = default;
+
+template <typename T>
+PinnedBuffer<T>::PinnedBuffer(const PinnedBuffer<T>& other)
+{
+    reallocate(other.size());
+    std::memcpy(m_data, other.data(), other.size() * sizeof(T));
+    m_size = other.size();
+}
+
+template <typename T>
+PinnedBuffer<T>::PinnedBuffer(PinnedBuffer<T>&& other) MUDA_NOEXCEPT
+    : m_size(other.m_size),
+      m_capacity(other.m_capacity),
+      m_data(other.m_data)
+{
+    other.m_data     = nullptr;
+    other.m_size     = 0;
+    other.m_capacity = 0;
+}
+
+template <typename T>
+PinnedBuffer<T>& PinnedBuffer<T>::operator=(const PinnedBuffer<T>& other)
+{
+    if(this == &other)
+        return *this;
+
+    if(m_capacity < other.size())
+        reallocate(other.size());
+    std::memcpy(m_data, other.data(), other.size() * sizeof(T));
+    m_size = other.size();
+    return *this;
+}
+
+template <typename T>
+PinnedBuffer<T>& PinnedBuffer<T>::operator=(PinnedBuffer<T>&& other) MUDA_NOEXCEPT
+{
+    if(this == &other)
+        return *this;
+
+    if(m_data)
+        checkCudaErrors(cudaFreeHost(m_data));
+
+    m_data     = other.m_data;
+    m_size     = other.m_size;
+    m_capacity = other.m_capacity;
+
+    other.m_data     = nullptr;
+    other.m_size     = 0;
+    other.m_capacity = 0;
+    return *this;
+}
+
+template <typename T>
+PinnedBuffer<T>::PinnedBuffer(const std::vector<T>& host)
+{
+    copy_from(host);
+}
+
+template <typename T>
+PinnedBuffer<T>& PinnedBuffer<T>::operator=(const std::vector<T>& host)
+{
+    copy_from(host);
+    return *this;
+}
+
+template <typename T>
+void PinnedBuffer<T>::copy_to(std::vector<T>& host) const
+{
+    host.resize(size());
+    std::memcpy(host.data(), m_data, size() * sizeof(T));
+}
+
+template <typename T>
+void PinnedBuffer<T>::copy_from(const std::vector<T>& host)
+{
+    if(m_capacity < host.size())
+        reallocate(host.size());
+    std::memcpy(m_data, host.data(), host.size() * sizeof(T));
+    m_size = host.size();
+}
+
+template <typename T>
+void PinnedBuffer<T>::resize(size_t new_size)
+{
+    if(new_size > m_capacity)
+        reallocate(std::max(new_size, m_capacity * 2));
+    if(new_size > m_size)
+        std::memset(m_data + m_size, 0, (new_size - m_size) * sizeof(T));
+    m_size = new_size;
+}
+
+template <typename T>
+void PinnedBuffer<T>::resize(size_t new_size, const T& value)
+{
+    auto old_size = m_size;
+    resize(new_size);
+    if(new_size > old_size)
+        std::fill(m_data + old_size, m_data + new_size, value);
+}
+
+template <typename T>
+void PinnedBuffer<T>::reserve(size_t new_capacity)
+{
+    if(new_capacity > m_capacity)
+        reallocate(new_capacity);
+}
+
+template <typename T>
+void PinnedBuffer<T>::clear()
+{
+    m_size = 0;
+}
+
+template <typename T>
+void PinnedBuffer<T>::shrink_to_fit()
+{
+    if(m_capacity > m_size)
+        reallocate(m_size);
+}
+
+template <typename T>
+void PinnedBuffer<T>::fill(const T& v)
+{
+    std::fill(begin(), end(), v);
+}
+
+template <typename T>
+PinnedBuffer<T>::~PinnedBuffer()
+{
+    if(m_data)
+        checkCudaErrors(cudaFreeHost(m_data));
+}
+
+template <typename T>
+void PinnedBuffer<T>::reallocate(size_t new_capacity)
+{
+    T* new_data = nullptr;
+    if(new_capacity > 0)
+    {
+        checkCudaErrors(cudaMallocHost(&new_data, new_capacity * sizeof(T)));
+        if(m_data)
+            std::memcpy(new_data, m_data, std::min(m_size, new_capacity) * sizeof(T));
+    }
+    if(m_data)
+        checkCudaErrors(cudaFreeHost(m_data));
+
+    m_data     = new_data;
+    m_capacity = new_capacity;
+    m_size     = std::min(m_size, new_capacity);
+}
+
+MUDA_INLINE PinnedStaging::PinnedStaging(size_t chunk_bytes)
+    : m_chunk_bytes(chunk_bytes)
+{
+    for(auto& h : m_host)
+        h.resize(chunk_bytes);
+}
+
+MUDA_INLINE PinnedStaging::~PinnedStaging()
+{
+    // the chunks may still be in use by an upload
+    for(auto& e : m_events)
+        wait_event(e);
+}
+}  // namespace muda
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <muda/check/check_cuda_errors.h>
+#include <muda/launch/parallel_for.h>
+#include <muda/buffer/buffer_launch.h>
+
+namespace muda
+{
+template <typename ViewT>
+ViewerTable<ViewT>::ViewerTable(size_t capacity)
+{
+    m_host.reserve(capacity);
+    m_is_dirty.reserve(capacity);
+    m_is_removed.reserve(capacity);
+    if(capacity > 0)
+        m_table.resize(capacity);
+}
+
+template <typename ViewT>
+ViewerTable<ViewT>::~ViewerTable()
+{
+    // the stages may still be read by the last uploads
+    for(auto& stage : m_stages)
+        checkCudaErrors(cudaEventSynchronize(stage.free));
+}
+
+template <typename ViewT>
+auto ViewerTable<ViewT>::add(const ViewT& view) -> handle_type
+{
+    handle_type handle;
+    if(!m_free.empty())
+    {
+        handle = m_free.back();
+        m_free.pop_back();
+        m_host[handle] = view;
+    }
+    else
+    {
+        MUDA_ASSERT(m_host.size() < invalid_handle, "ViewerTable is full");
+        handle = static_cast<handle_type>(m_host.size());
+        m_host.push_back(view);
+        m_is_dirty.push_back(0);
+        m_is_removed.push_back(0);
+    }
+    m_is_removed[handle] = 0;
+    mark_dirty(handle);
+    return handle;
+}
+
+template <typename ViewT>
+void ViewerTable<ViewT>::set(handle_type handle, const ViewT& view)
+{
+    check_handle(handle);
+    m_host[handle] = view;
+    mark_dirty(handle);
+}
+
+template <typename ViewT>
+void ViewerTable<ViewT>::remove(handle_type handle)
+{
+    check_handle(handle);
+    m_host[handle]       = ViewT{};
+    m_is_removed[handle] = 1;
+    mark_dirty(handle);
+    m_free.push_back(handle);
+}
+
+template <typename ViewT>
+void ViewerTable<ViewT>::clear()
+{
+    m_free.clear();
+    // reversed, so `add()` hands out the small handles first
+    for(size_t i = m_host.size(); i > 0; --i)
+    {
+        auto handle          = static_cast<handle_type>(i - 1);
+        m_host[handle]       = ViewT{};
+        m_is_removed[handle] = 1;
+        mark_dirty(handle);
+        m_free.push_back(handle);
+    }
+}
+
+template <typename ViewT>
+const ViewT& ViewerTable<ViewT>::operator[](handle_type handle) const
+{
+    check_handle(handle);
+    return m_host[handle];
+}
+
+template <typename ViewT>
+void ViewerTable<ViewT>::upload(cudaStream_t stream)
+{
+    // grow geometrically, the uploaded slots are kept, the new ones are empty viewers
+    if(m_table.size() < m_host.size())
+        BufferLaunch(stream).resize(m_table, std::max(m_host.size(), 2 * m_table.size()));
+
+    if(m_dirty.empty())
+        return;
+
+    // the upload before the last one is done in most cases, then this doesn't block
+    auto& stage = m_stages[m_stage];
+    m_stage ^= 1;
+    checkCudaErrors(cudaEventSynchronize(stage.free));
+
+    auto count = m_dirty.size();
+    if(2 * count >= m_host.size())
+    {
+        // most of the table is dirty: one contiguous copy
+        stage.host_values.resize(m_host.size());
+        std::copy(m_host.begin(), m_host.end(), stage.host_values.begin());
+        BufferLaunch(stream).copy(m_table.view(0, m_host.size()), stage.host_values.data());
+    }
+    else
+    {
+        // scattered: copy the (slot, viewer) pairs, then scatter them into the table
+        stage.host_slots.resize(count);
+        stage.host_values.resize(count);
+        for(size_t k = 0; k < count; ++k)
+        {
+            stage.host_slots[k]  = m_dirty[k];
+            stage.host_values[k] = m_host[m_dirty[k]];
+        }
+
+        if(stage.slots.size() < count)
+        {
+            auto size = std::max(count, 2 * stage.slots.size());
+            BufferLaunch(stream).resize(stage.slots, size).resize(stage.values, size);
+        }
+
+        BufferLaunch(stream)
+            .copy(stage.slots.view(0, count), stage.host_slots.data())
+            .copy(stage.values.view(0, count), stage.host_values.data());
+
+        ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+            .apply(static_cast<index_t>(count),
+                   [table  = m_table.viewer().name("viewer_table"),
+                    slots  = stage.slots.cviewer(),
+                    values = stage.values.cviewer()] __device__(index_t i) mutable
+                   { table(slots(i)) = values(i); });
+    }
+    checkCudaErrors(cudaEventRecord(stage.free, stream));
+
+    for(auto handle : m_dirty)
+        m_is_dirty[handle] = 0;
+    m_dirty.clear();
+}
+
+template <typename ViewT>
+void ViewerTable<ViewT>::upload(ComputeGraphVar<BufferView<ViewT>>& var, cudaStream_t stream)
+{
+    upload(stream);
+
+    // the var spans the device capacity: adding slots doesn't change it, a reallocation does
+    auto table = m_table.view();
+    if(!var.is_valid())
+    {
+        var.update(table);
+        return;
+    }
+
+    auto current = var.ceval();
+    if(current.data() != table.data() || current.size() != table.size())
+        var.update(table);
+}
+
+template <typename ViewT>
+CDense1D<ViewT> ViewerTable<ViewT>::cviewer() const MUDA_NOEXCEPT
+{
+    return m_table.cviewer();
+}
+
+template <typename ViewT>
+CBufferView<ViewT> ViewerTable<ViewT>::view() const MUDA_NOEXCEPT
+{
+    return m_table.view();
+}
+
+template <typename ViewT>
+void ViewerTable<ViewT>::check_handle(handle_type handle) const
+{
+    MUDA_ASSERT(handle < m_host.size() && !m_is_removed[handle],
+                "ViewerTable: invalid handle %u (removed or out of range), size = %u",
+                handle,
+                static_cast<uint32_t>(m_host.size()));
+}
+
+template <typename ViewT>
+void ViewerTable<ViewT>::mark_dirty(handle_type handle)
+{
+    if(m_is_dirty[handle])
+        return;
+    m_is_dirty[handle] = 1;
+    m_dirty.push_back(handle);
+}
+}  // namespace muda
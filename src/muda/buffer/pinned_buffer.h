@@ -0,0 +1,108 @@
+#pragma once
+#include <cuda.h>
+#include <cuda_runtime.h>
+#include <cuda_runtime_api.h>
+#include <vector>
+#include <type_traits>
+#include <muda/muda_def.h>
+#include <muda/literal/unit.h>
+#include <muda/launch/event.h>
+
+namespace muda
+{
+/// <summary>
+/// PinnedBuffer: a host buffer in page-locked memory, the interface mirrors DeviceBuffer.
+/// The copies between a PinnedBuffer and the device are truly asynchronous (DMA), e.g.
+///     PinnedBuffer<float3> h(n);
+///     auto done = BufferLaunch(stream).copy(h.data(), positions.view()).completion();
+///     ... // the host goes on
+///     done.wait();
+/// Resizing (or destroying) the buffer while a copy is in flight is undefined,
+/// wait for the copy before.
+/// </summary>
+template <typename T>
+class PinnedBuffer
+{
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+    size_t m_size     = 0;
+    size_t m_capacity = 0;
+    T*     m_data     = nullptr;
+
+  public:
+    using value_type = T;
+
+    PinnedBuffer(size_t n);
+    PinnedBuffer();
+
+    PinnedBuffer(const PinnedBuffer<T>& other);
+    PinnedBuffer(PinnedBuffer&& other) MUDA_NOEXCEPT;
+    PinnedBuffer& operator=(const PinnedBuffer<T>& other);
+    PinnedBuffer& operator=(PinnedBuffer<T>&& other) MUDA_NOEXCEPT;
+
+    PinnedBuffer(const std::vector<T>& host);
+    PinnedBuffer& operator=(const std::vector<T>& host);
+
+    void copy_to(std::vector<T>& host) const;
+    void copy_from(const std::vector<T>& host);
+
+    // the new elements are zero
+    void resize(size_t new_size);
+    void resize(size_t new_size, const T& value);
+    void reserve(size_t new_capacity);
+    void clear();
+    void shrink_to_fit();
+    void fill(const T& v);
+
+    ~PinnedBuffer();
+
+    auto     size() const MUDA_NOEXCEPT { return m_size; }
+    auto     capacity() const MUDA_NOEXCEPT { return m_capacity; }
+    bool     empty() const MUDA_NOEXCEPT { return m_size == 0; }
+    T*       data() MUDA_NOEXCEPT { return m_data; }
+    const T* data() const MUDA_NOEXCEPT { return m_data; }
+
+    T&       operator[](size_t i) MUDA_NOEXCEPT { return m_data[i]; }
+    const T& operator[](size_t i) const MUDA_NOEXCEPT { return m_data[i]; }
+
+    T*       begin() MUDA_NOEXCEPT { return m_data; }
+    T*       end() MUDA_NOEXCEPT { return m_data + m_size; }
+    const T* begin() const MUDA_NOEXCEPT { return m_data; }
+    const T* end() const MUDA_NOEXCEPT { return m_data + m_size; }
+
+  private:
+    void reallocate(size_t new_capacity);
+};
+
+/// <summary>
+/// PinnedStaging: two page-locked chunks to copy between the device and pageable host memory
+/// (e.g. std::vector) in a pipeline, the DMA of a chunk overlaps the host copy of the other.
+/// Keep it alive and reuse it, allocating page-locked memory is expensive.
+/// usage:
+///     PinnedStaging staging;  // 2 x 4MB
+///     BufferLaunch(stream).copy(vec.data(), buffer.view(), staging);
+/// </summary>
+class PinnedStaging
+{
+    size_t                  m_chunk_bytes;
+    PinnedBuffer<std::byte> m_host[2];
+    Event                   m_events[2];
+
+  public:
+    PinnedStaging(size_t chunk_bytes = 4_M);
+    ~PinnedStaging();
+
+    // delete copy
+    PinnedStaging(const PinnedStaging&)            = delete;
+    PinnedStaging& operator=(const PinnedStaging&) = delete;
+
+    size_t chunk_bytes() const MUDA_NOEXCEPT { return m_chunk_bytes; }
+
+    // the page-locked chunk of a slot (0 or 1)
+    std::byte* host(int slot) MUDA_NOEXCEPT { return m_host[slot].data(); }
+    // recorded after the copy from/to the chunk of a slot, wait on it before reusing the chunk
+    Event& event(int slot) MUDA_NOEXCEPT { return m_events[slot]; }
+};
+}  // namespace muda
+
+#include "details/pinned_buffer.inl"
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+#include <muda/muda_def.h>
+#include <muda/launch/event.h>
+#include <muda/buffer/device_buffer.h>
+#include <muda/buffer/pinned_buffer.h>
+#include <muda/buffer/graph_buffer_view.h>
+
+namespace muda
+{
+/// <summary>
+/// ViewerTable: a table of viewers in device memory, addressed by a 32-bit handle (bindless access).
+/// The slots are edited on the host, `upload()` sends only the dirty ones, e.g.
+///     ViewerTable<Dense1D<float>> table;
+///     auto h = table.add(buffer.viewer());
+///     table.upload(stream);
+///     ParallelFor(256, 0, stream)
+///         .apply(n,
+///                [table = table.cviewer(), h] __device__(int i) mutable
+///                {
+///                    auto x = table(h);  // copy the viewer out of the table
+///                    x(i) = 1.0f;
+///                });
+/// With a ComputeGraph, upload through a var: the var spans the device capacity and is only updated
+/// when the table moves in device memory, so adding/editing slots never updates the graph:
+///     auto& var = graph.create_var<BufferView<Dense1D<float>>>("table");
+///     table.upload(var, stream);
+///     ... [table = var.cviewer(), h] __device__(int i) mutable { ... }
+/// The kernels read the table, they don't write it (the host copy would be stale).
+/// </summary>
+template <typename ViewT>
+class ViewerTable
+{
+    static_assert(std::is_trivially_copyable_v<ViewT>, "ViewT must be trivially copyable");
+
+  public:
+    using value_type  = ViewT;
+    using handle_type = uint32_t;
+
+    static constexpr handle_type invalid_handle = ~handle_type{0};
+
+    ViewerTable(size_t capacity = 0);
+    ~ViewerTable();
+
+    // delete copy: the handles belong to one table
+    ViewerTable(const ViewerTable&)            = delete;
+    ViewerTable& operator=(const ViewerTable&) = delete;
+
+    // a new slot (or a removed one reused), uploaded on the next `upload()`
+    handle_type add(const ViewT& view);
+    void        set(handle_type handle, const ViewT& view);
+    // the slot is reset to an empty viewer and its handle may be returned by a later `add()`
+    void remove(handle_type handle);
+    // remove all, the device memory is kept
+    void clear();
+
+    // the host value of a slot (uploaded or not)
+    const ViewT& operator[](handle_type handle) const;
+
+    // the slots, the removed ones included
+    size_t size() const MUDA_NOEXCEPT { return m_host.size(); }
+    // the slots in device memory
+    size_t capacity() const MUDA_NOEXCEPT { return m_table.size(); }
+    size_t dirty_count() const MUDA_NOEXCEPT { return m_dirty.size(); }
+
+    // upload the dirty slots on `stream`, grow the device table if needed
+    void upload(cudaStream_t stream = nullptr);
+    // upload, then point `var` to the device table if it moved (or `var` is not valid yet)
+    void upload(ComputeGraphVar<BufferView<ViewT>>& var, cudaStream_t stream = nullptr);
+
+    // the uploaded table on the device
+    CDense1D<ViewT>    cviewer() const MUDA_NOEXCEPT;
+    CBufferView<ViewT> view() const MUDA_NOEXCEPT;
+
+  private:
+    void check_handle(handle_type handle) const;
+    void mark_dirty(handle_type handle);
+
+    std::vector<ViewT>       m_host;
+    std::vector<char>        m_is_dirty;
+    std::vector<char>        m_is_removed;
+    std::vector<handle_type> m_dirty;
+    std::vector<handle_type> m_free;
+
+    // the table, all `capacity()` slots are constructed
+    DeviceBuffer<ViewT> m_table;
+
+    // the (slot, viewer) pairs of a scattered upload
+    class Stage
+    {
+      public:
+        PinnedBuffer<handle_type> host_slots;
+        PinnedBuffer<ViewT>       host_values;
+        DeviceBuffer<handle_type> slots;
+        DeviceBuffer<ViewT>       values;
+        // recorded after the upload from this stage, it is reused once that is done
+        Event free;
+    };
+    // two stages used in turn, an upload only waits for the one two uploads ago
+    Stage m_stages[2];
+    int   m_stage = 0;
+};
+}  // namespace muda
+
+#include "details/viewer_table.inl"
@@ -8,6 +8,15 @@
 #include <muda/graph/graph.h>
 #include <muda/graph/graph_viewer.h>
 #include <muda/compute_graph/compute_graph_flag.h>
+#include <muda/compute_graph/compute_graph_launch_mode.h>
+#include <muda/compute_graph/compute_graph_stream_schedule.h>
+#include <muda/compute_graph/compute_graph_dependency_builder.h>
+#include <muda/compute_graph/compute_graph_kernel_arg_patch.h>
+#include <muda/compute_graph/compute_graph_exec_cache.h>
+#include <muda/compute_graph/compute_graph_profile.h>
+#include <muda/compute_graph/compute_graph_memory_plan.h>
+#include <muda/compute_graph/compute_graph_fusion.h>
+#include <muda/compute_graph/compute_graph_fused_kernel.h>
 #include <muda/compute_graph/compute_graph_phase.h>
 #include <muda/compute_graph/compute_graph_node_type.h>
 #include <muda/compute_graph/compute_graph_node_id.h>
@@ -32,6 +41,40 @@ namespace details
         LocalVarId           id{};
         ComputeGraphVarBase* var = nullptr;
     };
+    // the argument buffer of a kernel node captured in Building/Updating phase
+    class KernelArgPatchInfo
+    {
+      public:
+        ClosureId                   closure_id;
+        cudaGraphNode_t             node = nullptr;
+        std::shared_ptr<NodeParms>  parms;  // keep the argument buffer alive
+        std::byte*                  arg_data = nullptr;  // nullptr: not patchable
+        size_t                      arg_size = 0;
+        const cudaKernelNodeParams* handle   = nullptr;
+        std::vector<ComputeGraphKernelArgSlot> slots;
+    };
+    // an elementwise ParallelFor captured in Building/Updating phase,
+    // its cuda node is created by the fusion pass
+    class FusionStage
+    {
+      public:
+        ComputeGraphFusionCandidate candidate;
+        FusedStageFn                fn = nullptr;
+        std::vector<std::byte>      callable;
+        // to launch it alone
+        std::shared_ptr<NodeParms>                           parms;
+        std::function<std::shared_ptr<KernelNode>(Graph&)> add_node;
+        KernelArgPatchInfo                                   patch;
+        ComputeGraphNodeBase*                                node = nullptr;
+    };
+    // the kernel node running a group of fused closures
+    class FusedKernel
+    {
+      public:
+        size_t                                                 group = 0;
+        std::shared_ptr<KernelNodeParms<FusedParallelForArgs>> parms;
+        ComputeGraphNodeBase*                                  node = nullptr;
+    };
 }  // namespace details
 
 class ComputeGraph
@@ -104,6 +147,46 @@ class ComputeGraph
     mutable Event::QueryResult m_event_result = Event::QueryResult::eFinished;
     Flags<GraphInstantiateFlagBit> m_flags;
 
+    // multi stream launch
+    size_t                        m_max_stream_count = 4;
+    U<ComputeGraphStreamSchedule> m_stream_schedule;
+    std::vector<Stream>           m_schedule_streams;  // stream 1...n-1, stream 0 is the launch stream
+    std::vector<Event>            m_closure_events;
+    std::vector<Event>            m_join_events;
+    Event                         m_fork_event;
+
+    // incremental update
+    bool                                           m_kernel_arg_patching = false;
+    std::vector<details::KernelArgPatchInfo>       m_kernel_arg_patches;
+    std::unordered_map<NodeId::value_type, size_t> m_kernel_arg_patch_index;
+    std::set<VarId>                                m_dirty_patch_vars;
+
+    // instantiation cache
+    bool                    m_exec_caching = false;
+    ComputeGraphTopologyKey m_topology_key;
+    S<Graph>                m_exec_source_graph;  // the graph m_graph_exec was instantiated from
+
+    // profiling
+    bool                m_profiling         = false;
+    bool                m_profiling_pending = false;
+    std::vector<Event>  m_profile_begin_events;
+    std::vector<Event>  m_profile_end_events;
+    ComputeGraphProfile m_profile;
+
+    // transient memory
+    bool                              m_is_memory_planned = false;
+    std::vector<ComputeGraphVarBase*> m_transient_vars;
+    ComputeGraphMemoryPlan            m_memory_plan;
+    std::byte*                        m_transient_arena = nullptr;
+
+    // kernel fusion
+    bool                                           m_kernel_fusion = false;
+    std::vector<std::vector<details::FusionStage>> m_fusion_stages;
+    ComputeGraphFusionPlan                         m_fusion_plan;
+    std::vector<details::FusedKernel>              m_fused_kernels;
+    std::unordered_map<size_t, size_t>             m_fused_kernel_index;  // group -> fused kernel
+    std::set<size_t>                               m_dirty_fused_kernels;
+
   public:
     ComputeGraph(ComputeGraphVarManager& manager,
                  std::string_view        name = "graph",
@@ -142,6 +225,111 @@ class ComputeGraph
 
     void launch(cudaStream_t s = nullptr) { return launch(false, s); }
 
+    void launch(ComputeGraphLaunchMode mode, cudaStream_t s = nullptr);
+
+    /**************************************************************
+    * 
+    * Multi Stream Launch API
+    * 
+    ***************************************************************/
+
+    // the size of the stream pool used by ComputeGraphLaunchMode::MultiStream (default 4)
+    void max_stream_count(size_t count);
+
+    size_t max_stream_count() const { return m_max_stream_count; }
+
+    // the closure -> stream assignment used by ComputeGraphLaunchMode::MultiStream
+    const ComputeGraphStreamSchedule& stream_schedule();
+
+    /**************************************************************
+    * 
+    * Incremental Update API
+    * 
+    ***************************************************************/
+
+    // When enabled, updating a viewer var (e.g. swapping the buffer behind a Dense1D) only
+    // rewrites the kernel argument slots that captured it, instead of re-running the closures.
+    // All the updated vars are patched in one pass, one cudaGraphExecKernelNodeSetParams per node.
+    // A var is patched only if each of its eval()/ceval() in the closure became exactly one copy in
+    // the kernel arguments; a var whose bytes equal another var's (e.g. x and y bound to the same
+    // buffer), or one with a derived copy in the arguments (subview, renamed viewer ...) re-runs.
+    // Requirement: such a var should not decide the launch config (e.g. `apply(x.eval().dim(), ...)`),
+    // uniform vars (int, float ...) always re-run the closures.
+    // Must be set before the graph is built.
+    void kernel_arg_patching(bool enable);
+
+    bool kernel_arg_patching() const { return m_kernel_arg_patching; }
+
+    // the number of kernel nodes patched by the last update
+    size_t patched_kernel_node_count() const { return m_patched_kernel_node_count; }
+
+    /**************************************************************
+    * 
+    * Instantiation Cache API
+    * 
+    ***************************************************************/
+
+    // When enabled, build() takes an idle GraphExec with the same topology key from
+    // ComputeGraphExecCache::instance() and updates it (cudaGraphExecUpdate) instead of
+    // instantiating a new one. The GraphExec is given back to the cache on destruction.
+    // Must be set before the graph is built.
+    void exec_caching(bool enable);
+
+    bool exec_caching() const { return m_exec_caching; }
+
+    // the structure of the graph (closures, nodes, kernel functions, dependencies)
+    const ComputeGraphTopologyKey& topology_key() const { return m_topology_key; }
+
+    /**************************************************************
+    * 
+    * Profiling API
+    * 
+    ***************************************************************/
+
+    // When enabled, every closure is bracketed by two timing events in all launch modes,
+    // the samples of each launch are accumulated into profile().
+    // Must be set before the graph is built.
+    void profiling(bool enable);
+
+    bool profiling() const { return m_profiling; }
+
+    // waits for the last launch, then returns min/mean/max of each closure and the critical path
+    const ComputeGraphProfile& profile();
+
+    void reset_profile();
+
+    /**************************************************************
+    * 
+    * Transient Memory API
+    * 
+    ***************************************************************/
+
+    // the placement of the transient vars (see ComputeGraphVarManager::create_transient_var)
+    // in the arena of this graph, planned and allocated on the first build/launch/update.
+    // the order of memory_plan().offsets is the order of transient_vars().
+    const ComputeGraphMemoryPlan& memory_plan();
+
+    span<ComputeGraphVarBase* const> transient_vars() const { return m_transient_vars; }
+
+    /**************************************************************
+    * 
+    * Kernel Fusion API
+    * 
+    ***************************************************************/
+
+    // When enabled, neighbouring closures that each contain a single
+    // `ParallelFor(block_dim).elementwise().apply(count, f)` with the same count and block_dim
+    // run as one kernel node, which calls their callables in sequence for each i.
+    // Needs relocatable device code (-rdc=true, as muda is built), without it nothing is fused.
+    // Only affects ComputeGraphLaunchMode::Graph, ignored when profiling.
+    // Must be set before the graph is built.
+    void kernel_fusion(bool enable);
+
+    bool kernel_fusion() const { return m_kernel_fusion; }
+
+    // the closure groups of the last build
+    const ComputeGraphFusionPlan& fusion_plan() const { return m_fusion_plan; }
+
     /**************************************************************
     * 
     * Graph Event Query API
@@ -186,8 +374,40 @@ class ComputeGraph
 
     void serial_launch();
 
+    void multi_stream_launch(cudaStream_t s);
+
     void _update();
 
+    void record_kernel_arg_patch(ComputeGraphNodeBase* node, const details::KernelArgPatchInfo& info);
+
+    void find_kernel_arg_slots(ComputeGraphClosure& closure);
+
+    bool is_kernel_arg_patchable(ClosureId closure_id, VarId var_id) const;
+
+    void patch_kernel_args();
+
+    void build_topology_key();
+
+    std::vector<ComputeGraphNodeBase*> canonical_nodes() const;
+
+    void instantiate();
+
+    void release_exec_to_cache();
+
+    void prepare_profile_events();
+
+    void collect_profile_samples();
+
+    void plan_transient_memory();
+
+    void fuse_kernel_nodes();
+
+    void add_unfused_stage(details::FusionStage& stage);
+
+    void update_fusion_stage(details::FusionStage&& stage);
+
+    void update_fused_kernel_nodes();
+
     void check_vars_valid();
 
     friend class AddNodeProxy;
@@ -229,6 +449,8 @@ class ComputeGraph
     bool m_is_in_capture_func = false;
     // if we have already built the topo, we don't do that again
     bool m_is_topo_built = false;
+
+    size_t m_patched_kernel_node_count = 0;
 };
 }  // namespace muda
 
@@ -5,6 +5,8 @@ namespace muda
 {
 namespace details
 {
+    class KernelArgPatchInfo;
+
     // allow devlopers to access some internal function
     class ComputeGraphAccessor
     {
@@ -28,6 +30,12 @@ namespace details
         *************************************************************************************/
         template <typename T>
         void set_kernel_node(const S<KernelNodeParms<T>>& kernelParms);
+        // an elementwise ParallelFor, may be fused with the neighbouring closures
+        template <typename T, typename F>
+        void set_fusable_kernel_node(const S<KernelNodeParms<T>>& kernelParms,
+                                     const F&                     callable,
+                                     index_t                      count,
+                                     int                          block_dim);
         void set_memcpy_node(void* dst, const void* src, size_t size_bytes, cudaMemcpyKind kind);
         void set_memcpy_node(const cudaMemcpy3DParms& parms);
         void set_memset_node(const cudaMemsetParams& parms);
@@ -51,6 +59,7 @@ namespace details
         cudaStream_t                capture_stream() const;
 
         bool is_topo_built() const { return m_cg.m_is_topo_built; }
+        bool is_kernel_fusion_enabled() const;
 
         /************************************************************************************
         * 
@@ -68,6 +77,9 @@ namespace details
         void add_kernel_node(const S<KernelNodeParms<T>>& kernelParms);
         template <typename T>
         void update_kernel_node(const S<KernelNodeParms<T>>& kernelParms);
+        template <typename T>
+        KernelArgPatchInfo kernel_arg_patch_info(cudaGraphNode_t node,
+                                                 const S<KernelNodeParms<T>>& parms);
 
         void add_memcpy_node(void* dst, const void* src, size_t size_bytes, cudaMemcpyKind kind);
         void update_memcpy_node(void* dst, const void* src, size_t size_bytes, cudaMemcpyKind kind);
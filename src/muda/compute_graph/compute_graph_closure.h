@@ -1,6 +1,7 @@
 #pragma once
 #include <functional>
 #include <map>
+#include <set>
 #include <muda/compute_graph/compute_graph_node_type.h>
 #include <muda/compute_graph/compute_graph_node.h>
 #include <muda/compute_graph/compute_graph_node_id.h>
@@ -60,6 +61,11 @@ class ComputeGraphClosure
 
     std::vector<ComputeGraphNodeBase*> m_graph_nodes;
     void set_deps_range(size_t begin, size_t count);
+
+    // vars which only flow into the kernel arguments of this closure
+    std::set<VarId> m_patchable_vars;
+    // the eval()/ceval() calls of each var in the Building phase
+    std::map<VarId, size_t> m_var_eval_counts;
 };
 }  // namespace muda
 
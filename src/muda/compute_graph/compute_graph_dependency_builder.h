@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <muda/mstl/span.h>
+#include <muda/compute_graph/compute_graph_dependency.h>
+#include <muda/compute_graph/compute_graph_var_usage.h>
+
+namespace muda
+{
+/// <summary>
+/// Build the closure dependencies of a ComputeGraph from the var usages.
+/// Pure host code, closures must be added in launch order.
+///     - RAW: a reader depends on the last writer of the var
+///     - WAR: a writer depends on ALL the readers since the last write (not only the last one)
+///     - WAW: a writer depends on the last writer if no one read the var in between
+/// Edges implied by other edges are removed by `build(..., reduce = true)`.
+/// </summary>
+class ComputeGraphDependencyBuilder
+{
+  public:
+    // [local var index, usage]
+    using VarUsage = std::pair<size_t, ComputeGraphVarUsage>;
+
+    explicit ComputeGraphDependencyBuilder(size_t var_count);
+
+    // closure_id must be the number of closures added before
+    void add_closure(ClosureId closure_id, span<const VarUsage> usages);
+
+    // the number of the edges before the transitive reduction
+    size_t raw_dep_count() const { return m_raw_dep_count; }
+
+    /// <summary>
+    /// output the dependencies, grouped by `to` in closure order.
+    /// </summary>
+    /// <param name="deps">all the dependencies</param>
+    /// <param name="ranges">closure id -> [begin, count) in deps</param>
+    /// <param name="reduce">apply the transitive reduction</param>
+    void build(std::vector<ComputeGraphDependency>&     deps,
+               std::vector<std::pair<size_t, size_t>>& ranges,
+               bool                                    reduce = true) const;
+
+  private:
+    class VarState
+    {
+      public:
+        ClosureId              last_write;
+        std::vector<ClosureId> readers;  // readers since the last write
+    };
+
+    std::vector<VarState>               m_vars;
+    std::vector<std::vector<ClosureId>> m_preds;  // closure id -> direct predecessors
+    size_t                              m_raw_dep_count = 0;
+};
+}  // namespace muda
+
+#include "details/compute_graph_dependency_builder.inl"
@@ -0,0 +1,86 @@
+#pragma once
+#include <cuda_runtime.h>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <memory>
+#include <vector>
+#include <muda/compute_graph/compute_graph_topology_key.h>
+
+namespace muda
+{
+class Graph;
+class GraphExec;
+
+class ComputeGraphExecCacheStats
+{
+  public:
+    size_t hit_count      = 0;
+    size_t miss_count     = 0;
+    size_t eviction_count = 0;
+    size_t cached_count   = 0;  // the number of idle entries in the cache
+};
+
+/// <summary>
+/// A process-wide LRU cache of idle instantiated graphs, keyed by ComputeGraphTopologyKey.
+/// An entry is owned by one ComputeGraph at a time: `acquire()` takes it out of the cache and
+/// `release()` gives it back (usually when the ComputeGraph is destroyed).
+/// When more than `capacity()` entries are idle, the least recently released one is evicted.
+/// </summary>
+template <typename Entry>
+class ComputeGraphExecCacheBase
+{
+  public:
+    explicit ComputeGraphExecCacheBase(size_t capacity = 64)
+        : m_capacity(capacity)
+    {
+    }
+
+    // delete copy
+    ComputeGraphExecCacheBase(const ComputeGraphExecCacheBase&) = delete;
+    ComputeGraphExecCacheBase& operator=(const ComputeGraphExecCacheBase&) = delete;
+
+    static ComputeGraphExecCacheBase& instance();
+
+    // take an entry with the same key out of the cache, counts a hit or a miss
+    std::optional<Entry> acquire(const ComputeGraphTopologyKey& key);
+
+    // put an entry back to the cache, may evict the oldest one
+    void release(const ComputeGraphTopologyKey& key, Entry&& entry);
+
+    void   capacity(size_t capacity);
+    size_t capacity() const;
+
+    // drop all the idle entries
+    void clear();
+
+    ComputeGraphExecCacheStats stats() const;
+    void                       reset_stats();
+
+  private:
+    using Item = std::pair<ComputeGraphTopologyKey, Entry>;
+
+    mutable std::mutex         m_mutex;
+    std::list<Item>            m_items;  // front: the most recently released
+    size_t                     m_capacity;
+    ComputeGraphExecCacheStats m_stats;
+
+    void evict(std::list<Item>& evicted);
+};
+
+/// <summary>
+/// An instantiated graph together with its source graph,
+/// `nodes` are the graph nodes of `graph` in the canonical order of the key.
+/// </summary>
+class ComputeGraphCachedExec
+{
+  public:
+    std::shared_ptr<Graph>       graph;
+    std::shared_ptr<GraphExec>   exec;
+    std::vector<cudaGraphNode_t> nodes;
+};
+
+using ComputeGraphExecCache = ComputeGraphExecCacheBase<ComputeGraphCachedExec>;
+}  // namespace muda
+
+#include "details/compute_graph_exec_cache.inl"
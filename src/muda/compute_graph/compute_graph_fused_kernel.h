@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <muda/muda_def.h>
+#include <muda/muda_config.h>
+#include <muda/check/check_cuda_errors.h>
+#include <muda/launch/kernel_tag.h>
+
+namespace muda
+{
+namespace details
+{
+    // a type-erased elementwise callable: f(i)
+    using FusedStageFn = void (*)(const std::byte* callable, index_t i);
+
+    constexpr size_t max_fused_stages        = 8;
+    constexpr size_t fused_callable_capacity = 3968;
+
+    // the only argument of a fused kernel, 4080 bytes, within the 4KB parameter limit
+    class FusedParallelForArgs
+    {
+      public:
+        index_t               count       = 0;
+        int                   stage_count = 0;
+        FusedStageFn          fns[max_fused_stages]{};
+        uint32_t              offsets[max_fused_stages]{};
+        alignas(16) std::byte data[fused_callable_capacity];
+    };
+
+    template <typename F>
+    constexpr bool is_fusable_callable_v = std::is_invocable_v<F, index_t>
+                                           && std::is_trivially_copyable_v<F>
+                                           && alignof(F) <= 16;
+
+    // the fused kernel calls the stages through device function pointers, which are only valid
+    // in the module they come from. Without relocatable device code every .cu file is a module of
+    // its own, so the fusion is only done with it (ParallelFor falls back to a normal kernel node)
+#ifdef __CUDACC_RDC__
+    constexpr bool kernel_fusion_supported = true;
+#else
+    constexpr bool kernel_fusion_supported = false;
+#endif
+
+    template <typename F>
+    MUDA_DEVICE void fused_stage(const std::byte* callable, index_t i)
+    {
+        // a local copy, just like the kernel parameter of a normal ParallelFor
+        F f = *reinterpret_cast<const F*>(callable);
+        f(i);
+    }
+
+    template <typename F>
+    MUDA_DEVICE FusedStageFn fused_stage_ptr = &fused_stage<F>;
+
+    // the device address of fused_stage<F>, can only be read from a device variable
+    template <typename F>
+    MUDA_HOST FusedStageFn fused_stage_function()
+    {
+        static FusedStageFn fn = []
+        {
+            FusedStageFn f = nullptr;
+            checkCudaErrors(cudaMemcpyFromSymbol(&f, fused_stage_ptr<F>, sizeof(f)));
+            return f;
+        }();
+        return fn;
+    }
+
+    // the argument is read in place (grid constant), `args.data + offset` takes no local copy
+    template <typename UserTag = DefaultTag>
+    MUDA_GLOBAL void fused_parallel_for_kernel(MUDA_GRID_CONSTANT const FusedParallelForArgs args)
+    {
+        auto i = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+        if(i >= args.count)
+            return;
+        // thread i finishes element i of a stage before the next stage,
+        // so elementwise dependencies between the stages hold without any sync
+        for(int s = 0; s < args.stage_count; ++s)
+            args.fns[s](args.data + args.offsets[s], i);
+    }
+}  // namespace details
+}  // namespace muda
@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <muda/muda_config.h>
+#include <muda/mstl/span.h>
+#include <muda/compute_graph/compute_graph_closure_id.h>
+
+namespace muda
+{
+/// <summary>
+/// What the fusion pass knows about the kernel of one closure.
+/// </summary>
+class ComputeGraphFusionCandidate
+{
+  public:
+    // the closure has exactly one node: an elementwise, dynamic-block ParallelFor
+    bool    fusable = false;
+    index_t count   = 0;
+    int     block_dim = 0;
+    size_t callable_bytes     = 0;
+    size_t callable_alignment = 1;
+};
+
+/// <summary>
+/// The result of grouping the closures of a ComputeGraph for kernel fusion.
+/// Pure host data, computed by `ComputeGraphFusionPlan::build()`.
+/// </summary>
+class ComputeGraphFusionPlan
+{
+  public:
+    // groups of consecutive closures, every closure is in exactly one group
+    std::vector<std::vector<ClosureId>> groups;
+    // closure id -> group index
+    std::vector<size_t> group_of;
+    // closure id -> the byte offset of its callable in the fused argument buffer
+    std::vector<size_t> callable_offset;
+
+    bool is_fused(ClosureId id) const { return groups[group_of[id.value()]].size() > 1; }
+
+    // the number of kernel launches saved by fusion
+    size_t saved_launch_count() const { return group_of.size() - groups.size(); }
+
+    /// <summary>
+    /// Greedy grouping in closure order: a closure joins the current group if both are
+    /// fusable, have the same count and block_dim, and the packed callables still fit.
+    /// Only neighbours in the closure order (a topological order) are fused, so merging
+    /// a group into one kernel node never creates a cycle.
+    /// </summary>
+    /// <param name="candidates">one for each closure</param>
+    /// <param name="max_stages">the max number of closures in a group</param>
+    /// <param name="max_callable_bytes">the capacity of the fused argument buffer</param>
+    static ComputeGraphFusionPlan build(span<const ComputeGraphFusionCandidate> candidates,
+                                        size_t max_stages,
+                                        size_t max_callable_bytes);
+};
+}  // namespace muda
+
+#include "details/compute_graph_fusion.inl"
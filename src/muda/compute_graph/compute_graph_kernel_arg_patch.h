@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <muda/mstl/span.h>
+#include <muda/type_traits/type_modifier.h>
+#include <muda/compute_graph/compute_graph_var_id.h>
+
+namespace muda
+{
+/// <summary>
+/// The object representation of a ComputeGraphVar value, used to locate and rewrite
+/// the var inside the argument buffer of a captured kernel node.
+/// Padding bytes (which may not survive a copy) are excluded by `mask`.
+/// </summary>
+class ComputeGraphVarBytes
+{
+  public:
+    std::vector<std::byte> bytes;
+    std::vector<char>      mask;  // 1: value byte, 0: padding byte
+    // the memory the value refers to, [ref_begin, ref_end), e.g. the elements of a viewer
+    uintptr_t ref_begin = 0;
+    uintptr_t ref_end   = 0;
+
+    bool empty() const { return bytes.empty(); }
+
+    // only the viewers (e.g. Dense1D<T>, buffer views, pointers) are patchable,
+    // uniform values (int, float...) usually drive the launch config, which can't be patched.
+    template <typename T>
+    static constexpr bool is_patchable_v = std::is_trivially_copyable_v<T>
+                                           && !is_uniform_viewer_v<T>
+                                           && sizeof(T) >= sizeof(void*);
+
+    template <typename T>
+    static ComputeGraphVarBytes from(const T& value);
+
+    // all the offsets where the value appears in `data`
+    std::vector<size_t> find_in(span<const std::byte> data) const;
+
+    // rewrite the value bytes at `offset` in `data`
+    void patch(span<std::byte> data, size_t offset) const;
+
+    // true if `word` (a pointer-sized word of the kernel arguments) points into the memory of the value,
+    // e.g. the data pointer of a subview or of a renamed copy, which a patch would leave stale
+    bool refers_to(uintptr_t word) const;
+};
+
+/// <summary>
+/// A slot in the kernel argument buffer which holds a copy of a var.
+/// </summary>
+class ComputeGraphKernelArgSlot
+{
+  public:
+    VarId  var_id;
+    size_t offset = 0;
+};
+}  // namespace muda
+
+#include "details/compute_graph_kernel_arg_patch.inl"
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace muda
+{
+enum class ComputeGraphLaunchMode
+{
+    Graph,         // instantiate a cuda graph and launch it
+    SingleStream,  // invoke all the closures in serial on one stream
+    MultiStream,   // invoke the closures eagerly on a stream pool, following the dependencies
+};
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <muda/mstl/span.h>
+#include <muda/compute_graph/compute_graph_dependency.h>
+
+namespace muda
+{
+/// <summary>
+/// A transient buffer to be placed into the arena of a ComputeGraph.
+/// [first, last] is the live interval over the closure order (a topological order).
+/// </summary>
+class ComputeGraphTransientBuffer
+{
+  public:
+    size_t bytes     = 0;
+    size_t alignment = 256;
+    size_t first     = 0;
+    size_t last      = 0;
+};
+
+/// <summary>
+/// The placement of the transient vars of a ComputeGraph in one shared arena.
+/// Pure host data, computed by `ComputeGraphMemoryPlan::build()`.
+/// </summary>
+class ComputeGraphMemoryPlan
+{
+  public:
+    // buffer index -> byte offset in the arena
+    std::vector<size_t> offsets;
+    // the size of the arena
+    size_t arena_bytes = 0;
+    // the memory needed if every buffer had its own allocation (alignment included)
+    size_t unaliased_bytes = 0;
+
+    /// <summary>
+    /// Greedy-by-size packing:
+    ///     1. buffers are placed from the largest to the smallest
+    ///     2. a buffer takes the tightest aligned gap between the already placed buffers whose
+    ///        live intervals overlap with its own, or goes on top of them if no gap fits.
+    /// Buffers with disjoint live intervals may share the same bytes.
+    /// </summary>
+    static ComputeGraphMemoryPlan build(span<const ComputeGraphTransientBuffer> buffers);
+
+    /// <summary>
+    /// The live interval of a buffer used by `users`, safe for concurrent execution:
+    /// the interval is extended until all the later closures are ordered after every user,
+    /// so two buffers with disjoint intervals are never accessed at the same time,
+    /// even if the closures run on different streams or as parallel graph branches.
+    /// </summary>
+    /// <param name="closure_count">the number of closures</param>
+    /// <param name="deps">dependencies, `to` depends on `from`, `from` &lt; `to`</param>
+    /// <param name="users">for each buffer, the closures using it</param>
+    /// <returns>[first, last] of each buffer, a buffer without users gets [0, closure_count - 1]</returns>
+    static std::vector<std::pair<size_t, size_t>> live_intervals(
+        size_t                                 closure_count,
+        span<const ComputeGraphDependency>     deps,
+        span<const std::vector<ClosureId>>     users);
+};
+}  // namespace muda
+
+#include "details/compute_graph_memory_plan.inl"
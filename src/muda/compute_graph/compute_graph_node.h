@@ -6,6 +6,7 @@
 #include <muda/compute_graph/compute_graph_var_usage.h>
 #include <muda/compute_graph/compute_graph_var_id.h>
 #include <muda/compute_graph/compute_graph_fwd.h>
+#include <muda/graph/graph_base.h>
 
 namespace muda
 {
@@ -44,6 +45,13 @@ class ComputeGraphNodeBase
     auto handle() const { return m_cuda_node; }
     void set_handle(cudaGraphNode_t handle) { m_cuda_node = handle; }
     auto is_valid() const { return m_cuda_node; }
+
+    // point to the same node in another (topologically identical) graph
+    virtual void remap_handle(cudaGraphNode_t handle) { set_handle(handle); }
+    static void  set_graph_node_handle(GraphNode& node, cudaGraphNode_t handle)
+    {
+        node.m_handle = handle;
+    }
 };
 
 template <typename NodeT, ComputeGraphNodeType Type>
@@ -56,6 +64,7 @@ class ComputeGraphNode : public ComputeGraphNodeBase
 
     S<NodeT> m_node;
     void     set_node(S<NodeT> node);
+    virtual void remap_handle(cudaGraphNode_t handle) override;
     virtual ~ComputeGraphNode() = default;
 };
 }  // namespace muda
@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <ostream>
+#include <muda/mstl/span.h>
+#include <muda/compute_graph/compute_graph_dependency.h>
+
+namespace muda
+{
+class ComputeGraphClosureTiming
+{
+  public:
+    std::string name;
+    size_t      sample_count = 0;
+    double      min_ms       = 0.0;
+    double      max_ms       = 0.0;
+    double      total_ms     = 0.0;
+
+    double mean_ms() const { return sample_count ? total_ms / sample_count : 0.0; }
+};
+
+/// <summary>
+/// The timing of every closure of a ComputeGraph accumulated over launches,
+/// and the critical path (by mean cost) over the closure dependencies.
+/// Pure host data, filled by ComputeGraph in profiling mode or by hand.
+/// </summary>
+class ComputeGraphProfile
+{
+  public:
+    ComputeGraphProfile() = default;
+    explicit ComputeGraphProfile(std::vector<std::string> closure_names);
+
+    // drop all the samples
+    void reset();
+
+    // one launch, `ms.size()` must be the closure count
+    void add_launch(span<const double> ms);
+    void add_sample(ClosureId closure_id, double ms);
+
+    size_t closure_count() const { return m_timings.size(); }
+    size_t launch_count() const { return m_launch_count; }
+
+    const ComputeGraphClosureTiming& timing(ClosureId closure_id) const;
+    span<const ComputeGraphClosureTiming> timings() const { return m_timings; }
+
+    // the longest (mean cost) path through the dependencies, `to` depends on `from`,
+    // `from` < `to` is required (the closure order is a topological order)
+    void analyze(span<const ComputeGraphDependency> deps);
+
+    const std::vector<ClosureId>& critical_path() const { return m_critical_path; }
+    double critical_path_ms() const { return m_critical_path_ms; }
+    bool   is_on_critical_path(ClosureId closure_id) const;
+    bool   is_on_critical_path(const ComputeGraphDependency& dep) const;
+
+    // "#RRGGBB" from green (cheapest) to red (most expensive) by the mean cost
+    std::string heat_color(ClosureId closure_id) const;
+
+    void to_json(std::ostream& o) const;
+
+  private:
+    std::vector<ComputeGraphClosureTiming> m_timings;
+    size_t                                 m_launch_count = 0;
+    std::vector<ClosureId>                 m_critical_path;
+    std::vector<char>                      m_on_critical_path;
+    double                                 m_critical_path_ms = 0.0;
+};
+}  // namespace muda
+
+#include "details/compute_graph_profile.inl"
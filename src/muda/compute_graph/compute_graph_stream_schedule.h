@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+#include <muda/mstl/span.h>
+#include <muda/compute_graph/compute_graph_dependency.h>
+
+namespace muda
+{
+/// <summary>
+/// The result of scheduling the closures of a ComputeGraph onto a small stream pool.
+/// Pure host data, computed by `ComputeGraphStreamSchedule::build()`.
+/// </summary>
+class ComputeGraphStreamSchedule
+{
+  public:
+    // closure ids in launch order (a topological order)
+    std::vector<ClosureId> order;
+    // closure id -> stream index in [0, stream_count)
+    std::vector<size_t> stream_of;
+    // closure id -> the closures (on other streams) it must wait for before launching.
+    // waits implied by the stream order or by earlier waits are removed.
+    std::vector<std::vector<ClosureId>> waits;
+    // closure id -> whether its completion is waited by any other stream
+    std::vector<bool> need_record;
+    // the number of streams really used (<= max_stream_count)
+    size_t stream_count = 0;
+    // the estimated finish time (in cost unit) of the whole schedule
+    double makespan = 0.0;
+
+    /// <summary>
+    /// Level / critical-path list scheduling:
+    ///     1. the priority of a closure is its bottom level (the longest cost path to a sink)
+    ///     2. ready closures with higher priority are placed first, each on the stream where it
+    ///        can start earliest (a predecessor's stream wins the tie, saving an event wait)
+    ///     3. cross-stream waits are only inserted on real dependency edges, and are dropped if
+    ///        the waiting stream has already synchronized with the predecessor (vector clock).
+    /// </summary>
+    /// <param name="closure_count">the number of closures</param>
+    /// <param name="deps">dependencies, `to` depends on `from`</param>
+    /// <param name="max_stream_count">the size of the stream pool, at least 1</param>
+    /// <param name="costs">estimated cost of each closure, empty means all 1</param>
+    static ComputeGraphStreamSchedule build(size_t closure_count,
+                                            span<const ComputeGraphDependency> deps,
+                                            size_t             max_stream_count,
+                                            span<const double> costs = {});
+};
+}  // namespace muda
+
+#include "details/compute_graph_stream_schedule.inl"
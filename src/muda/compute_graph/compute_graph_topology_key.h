@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <muda/mstl/span.h>
+#include <muda/compute_graph/compute_graph_node_type.h>
+#include <muda/compute_graph/compute_graph_dependency.h>
+
+namespace muda
+{
+/// <summary>
+/// A canonical description of the structure of a ComputeGraph:
+/// closures (in order), their graph nodes (type + kernel function), and the dependencies.
+/// Var bindings and node parameters are not part of the key, so two graphs with the same
+/// key can share one instantiated cuda graph (updated by cudaGraphExecUpdate).
+/// Pure host code.
+/// </summary>
+class ComputeGraphTopologyKey
+{
+  public:
+    // call in closure order
+    void begin_closure();
+    // call in node order of the current closure
+    void add_node(ComputeGraphNodeType type, const void* kernel_func = nullptr);
+    // dependencies between closures, the order doesn't matter
+    void add_deps(span<const ComputeGraphDependency> deps);
+    // the instantiate flags
+    void add_flags(uint64_t flags);
+
+    uint64_t hash() const;
+
+    const std::vector<uint64_t>& words() const;
+
+    friend bool operator==(const ComputeGraphTopologyKey& lhs, const ComputeGraphTopologyKey& rhs)
+    {
+        return lhs.hash() == rhs.hash() && lhs.words() == rhs.words();
+    }
+    friend bool operator!=(const ComputeGraphTopologyKey& lhs, const ComputeGraphTopologyKey& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+  private:
+    enum Tag : uint64_t
+    {
+        Closure = 1,
+        Node,
+        Dep,
+        Flags
+    };
+
+    std::vector<uint64_t>                      m_words;
+    std::vector<std::pair<uint64_t, uint64_t>> m_deps;
+    mutable std::vector<uint64_t>              m_canonical;
+    mutable uint64_t                           m_hash  = 0;
+    mutable bool                               m_dirty = true;
+
+    void finalize() const;
+};
+}  // namespace muda
+
+namespace std
+{
+template <>
+struct hash<muda::ComputeGraphTopologyKey>
+{
+    size_t operator()(const muda::ComputeGraphTopologyKey& key) const noexcept
+    {
+        return static_cast<size_t>(key.hash());
+    }
+};
+}  // namespace std
+
+#include "details/compute_graph_topology_key.inl"
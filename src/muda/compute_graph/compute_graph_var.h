@@ -10,6 +10,7 @@
 #include <muda/compute_graph/compute_graph_var_id.h>
 #include <muda/compute_graph/graphviz_options.h>
 #include <muda/compute_graph/compute_graph_fwd.h>
+#include <muda/compute_graph/compute_graph_kernel_arg_patch.h>
 
 namespace muda
 {
@@ -24,6 +25,7 @@ class ComputeGraphVarBase
     std::string_view   name() const MUDA_NOEXCEPT { return m_name; }
     VarId              var_id() const MUDA_NOEXCEPT { return m_var_id; }
     bool               is_valid() const MUDA_NOEXCEPT { return m_is_valid; }
+    bool is_transient() const MUDA_NOEXCEPT { return m_transient_bytes > 0; }
     void               update();
     Event::QueryResult query();
     bool               is_using();
@@ -62,9 +64,18 @@ class ComputeGraphVarBase
 
     virtual ~ComputeGraphVarBase() = default;
 
+    // the current value for kernel argument patching, empty if not patchable
+    virtual ComputeGraphVarBytes value_bytes() const { return {}; }
 
     void base_update();
 
+    // transient var: the memory is taken from the arena of the graph using it
+    size_t m_transient_count     = 0;
+    size_t m_transient_bytes     = 0;
+    size_t m_transient_alignment = 0;
+    void   bind_transient(std::byte* data);
+    virtual void bind_transient_value(std::byte* data) {}
+
     friend class LaunchCore;
 
     mutable std::set<ClosureId> m_closure_ids;
@@ -129,10 +140,26 @@ class ComputeGraphVar : public ComputeGraphVarBase
     virtual void        graphviz_def(std::ostream& os,
                                      const ComputeGraphGraphvizOptions& options) const override;
 
+  protected:
+    virtual ComputeGraphVarBytes value_bytes() const override;
+    virtual void bind_transient_value(std::byte* data) override;
+
   private:
     RWViewer m_value;
 };
 
+// a viewer constructible from (element*, count) can be a transient var,
+// e.g. BufferView<T>, Dense1D<T>
+template <typename T>
+using transient_element_t = std::remove_pointer_t<decltype(std::declval<T&>().data())>;
+
+template <typename T, typename = void>
+constexpr bool is_transient_viewer_v = false;
+template <typename T>
+constexpr bool is_transient_viewer_v<T, std::void_t<transient_element_t<T>>> =
+    std::is_pointer_v<decltype(std::declval<T&>().data())>
+    && std::is_constructible_v<T, transient_element_t<T>*, size_t>;
+
 // for host memory
 template <typename T>
 struct read_only_viewer<T*>
@@ -34,6 +34,16 @@ class ComputeGraphVarManager
     template <typename T>
     ComputeGraphVar<T>* find_var(std::string_view name);
 
+    // A var whose memory belongs to the graph using it. T must be constructible from
+    // (element*, count), e.g. BufferView<float>. On the first build/launch, the graph places
+    // all its transient vars into one arena, vars with disjoint live intervals share bytes.
+    // So the content is undefined before the first write in each launch, and a transient var
+    // can only be used by one graph.
+    template <typename T>
+    ComputeGraphVar<T>& create_transient_var(std::string_view name,
+                                             size_t           count,
+                                             size_t           alignment = 256);
+
     bool is_using() const;
     void sync() const;
 
@@ -1,6 +1,9 @@
 #include <memory>
+#include <cstring>
+#include <algorithm>
 #include <muda/exception.h>
 #include <muda/debug.h>
+#include <muda/launch/memory.h>
 #include <muda/compute_graph/compute_graph.h>
 #include <muda/compute_graph/compute_graph_builder.h>
 #include <muda/compute_graph/compute_graph_var.h>
@@ -8,6 +11,7 @@
 #include <muda/compute_graph/compute_graph_node.h>
 #include <muda/compute_graph/compute_graph_closure.h>
 #include <muda/compute_graph/compute_graph_accessor.h>
+#include <muda/compute_graph/nodes/compute_graph_kernel_node.h>
 
 namespace muda
 {
@@ -107,9 +111,12 @@ MUDA_INLINE void ComputeGraph::graphviz(std::ostream& o, const ComputeGraphGraph
             dst.second->graphviz_id(o, options);
             o << "->";
             src.second->graphviz_id(o, options);
-            o << "[" << options.arc_style
-              << "]"
-                 "\n";
+            if(options.profile && options.profile->is_on_critical_path(dep))
+                o << "[" << options.critical_path_arc_style << "]\n";
+            else
+                o << "[" << options.arc_style
+                  << "]"
+                     "\n";
         }
     }
     o << "}\n";
@@ -146,7 +153,11 @@ MUDA_INLINE void ComputeGraph::build()
     if(m_graph_exec)
         return;
 
+    plan_transient_memory();
+
     GraphPhaseGuard guard(*this, ComputeGraphPhase::Building);
+    m_fusion_stages.clear();
+    m_fusion_stages.resize(m_closures.size());
     if(!m_is_topo_built)
     {
         m_closure_need_update.clear();
@@ -158,16 +169,330 @@ MUDA_INLINE void ComputeGraph::build()
         m_current_closure_id = ClosureId{i};
         m_allow_access_graph = true;
         m_access_graph_index = 0;
+        m_closures[i].second->m_var_eval_counts.clear();
         m_closures[i].second->operator()();
+        find_kernel_arg_slots(*m_closures[i].second);
     }
+    if(m_kernel_fusion)
+        fuse_kernel_nodes();
     if(!m_is_topo_built)
         build_deps();
     cuda_graph_add_deps();
 
+    instantiate();
+}
+
+MUDA_INLINE void ComputeGraph::instantiate()
+{
+    build_topology_key();
+
+    if(m_exec_caching)
+    {
+        auto cached = ComputeGraphExecCache::instance().acquire(m_topology_key);
+        if(cached && cached->exec->update(m_graph.handle()))
+        {
+            // the exec still refers to the nodes of its source graph
+            auto nodes = canonical_nodes();
+            MUDA_ASSERT(nodes.size() == cached->nodes.size(),
+                        "node count mismatch, cached=%d, this=%d",
+                        (int)cached->nodes.size(),
+                        (int)nodes.size());
+            for(size_t i = 0; i < nodes.size(); ++i)
+                nodes[i]->remap_handle(cached->nodes[i]);
+            for(auto&& [node_id, patch_index] : m_kernel_arg_patch_index)
+                m_kernel_arg_patches[patch_index].node = m_nodes[node_id]->handle();
+
+            m_exec_source_graph = std::move(cached->graph);
+            m_graph_exec        = std::move(cached->exec);
+            m_graph_exec->upload();
+            return;
+        }
+    }
+
     m_graph_exec = m_graph.instantiate(m_flags);
     m_graph_exec->upload();
 }
 
+MUDA_INLINE void ComputeGraph::build_topology_key()
+{
+    m_topology_key = ComputeGraphTopologyKey{};
+    for(auto& [name, closure] : m_closures)
+    {
+        m_topology_key.begin_closure();
+        for(auto node : closure->m_graph_nodes)
+        {
+            const void* func = nullptr;
+            auto iter = m_kernel_arg_patch_index.find(node->node_id().value());
+            if(iter != m_kernel_arg_patch_index.end())
+                func = m_kernel_arg_patches[iter->second].handle->func;
+            m_topology_key.add_node(node->type(), func);
+        }
+    }
+    m_topology_key.add_deps(m_deps);
+    // the fused groups decide which kernel nodes exist
+    for(auto& fused : m_fused_kernels)
+    {
+        auto& group = m_fusion_plan.groups[fused.group];
+        m_topology_key.add_flags((static_cast<uint64_t>(group.front().value()) << 32) | group.size());
+    }
+    // the profiling event nodes change the topology too
+    m_topology_key.add_flags(static_cast<uint64_t>(static_cast<int>(m_flags))
+                             | (m_profiling ? uint64_t{1} << 32 : 0));
+}
+
+MUDA_INLINE std::vector<ComputeGraphNodeBase*> ComputeGraph::canonical_nodes() const
+{
+    std::vector<ComputeGraphNodeBase*> nodes;
+    for(auto& [name, closure] : m_closures)
+        for(auto node : closure->m_graph_nodes)
+            nodes.push_back(node);
+    return nodes;
+}
+
+MUDA_INLINE void ComputeGraph::release_exec_to_cache()
+{
+    if(!m_exec_caching || !m_graph_exec)
+        return;
+
+    ComputeGraphCachedExec cached;
+    cached.exec  = std::move(m_graph_exec);
+    cached.graph = m_exec_source_graph ? std::move(m_exec_source_graph) :
+                                         std::make_shared<Graph>(std::move(m_graph));
+    for(auto node : canonical_nodes())
+        cached.nodes.push_back(node->handle());
+    ComputeGraphExecCache::instance().release(m_topology_key, std::move(cached));
+}
+
+MUDA_INLINE void ComputeGraph::profiling(bool enable)
+{
+    MUDA_ASSERT(!m_graph_exec, "profiling must be set before the graph is built");
+    m_profiling = enable;
+}
+
+MUDA_INLINE const ComputeGraphProfile& ComputeGraph::profile()
+{
+    collect_profile_samples();
+    m_profile.analyze(m_deps);
+    return m_profile;
+}
+
+MUDA_INLINE void ComputeGraph::reset_profile()
+{
+    collect_profile_samples();
+    m_profile.reset();
+}
+
+MUDA_INLINE void ComputeGraph::prepare_profile_events()
+{
+    if(m_profile.closure_count() != m_closures.size())
+    {
+        std::vector<std::string> names;
+        for(auto& [name, closure] : m_closures)
+            names.push_back(name);
+        m_profile = ComputeGraphProfile{std::move(names)};
+    }
+    while(m_profile_begin_events.size() < m_closures.size())
+    {
+        m_profile_begin_events.emplace_back(Event::Bit::eDefault);
+        m_profile_end_events.emplace_back(Event::Bit::eDefault);
+    }
+}
+
+MUDA_INLINE void ComputeGraph::collect_profile_samples()
+{
+    if(!m_profiling_pending)
+        return;
+    m_profiling_pending = false;
+
+    checkCudaErrors(cudaEventSynchronize(m_event));
+    std::vector<double> ms(m_closures.size());
+    for(size_t i = 0; i < m_closures.size(); ++i)
+        ms[i] = Event::elapsed_time(m_profile_begin_events[i], m_profile_end_events[i]);
+    m_profile.add_launch(ms);
+}
+
+MUDA_INLINE const ComputeGraphMemoryPlan& ComputeGraph::memory_plan()
+{
+    plan_transient_memory();
+    return m_memory_plan;
+}
+
+MUDA_INLINE void ComputeGraph::plan_transient_memory()
+{
+    if(m_is_memory_planned)
+        return;
+    topo_build();
+    m_is_memory_planned = true;
+
+    std::vector<std::vector<ClosureId>> users;
+    for(auto&& [local_id, var] : m_related_vars)
+    {
+        if(!var->is_transient())
+            continue;
+        if(var->m_related_closure_infos.size() != 1)
+        {
+            MUDA_ERROR_WITH_LOCATION("transient var[%s] is used by more than one graph",
+                                     var->name().data());
+        }
+        auto& ids = var->m_related_closure_infos[this].closure_ids;
+        m_transient_vars.push_back(var);
+        users.emplace_back(ids.begin(), ids.end());
+    }
+    if(m_transient_vars.empty())
+        return;
+
+    auto intervals = ComputeGraphMemoryPlan::live_intervals(m_closures.size(), m_deps, users);
+
+    std::vector<ComputeGraphTransientBuffer> buffers(m_transient_vars.size());
+    for(size_t i = 0; i < buffers.size(); ++i)
+    {
+        buffers[i].bytes     = m_transient_vars[i]->m_transient_bytes;
+        buffers[i].alignment = m_transient_vars[i]->m_transient_alignment;
+        buffers[i].first     = intervals[i].first;
+        buffers[i].last      = intervals[i].second;
+    }
+    m_memory_plan = ComputeGraphMemoryPlan::build(buffers);
+
+    Memory().alloc(&m_transient_arena, m_memory_plan.arena_bytes, false);
+    for(size_t i = 0; i < m_transient_vars.size(); ++i)
+        m_transient_vars[i]->bind_transient(m_transient_arena + m_memory_plan.offsets[i]);
+}
+
+MUDA_INLINE void ComputeGraph::kernel_fusion(bool enable)
+{
+    MUDA_ASSERT(!m_graph_exec, "kernel_fusion must be set before the graph is built");
+    m_kernel_fusion = enable;
+}
+
+MUDA_INLINE void ComputeGraph::fuse_kernel_nodes()
+{
+    // the profiling events bracket every closure, nothing to fuse
+    std::vector<ComputeGraphFusionCandidate> candidates(m_closures.size());
+    for(size_t i = 0; i < m_closures.size() && !m_profiling; ++i)
+    {
+        auto& stages = m_fusion_stages[i];
+        if(stages.size() == 1 && m_closures[i].second->m_graph_nodes.size() == 1)
+            candidates[i] = stages.front().candidate;
+    }
+    m_fusion_plan = ComputeGraphFusionPlan::build(
+        candidates, details::max_fused_stages, details::fused_callable_capacity);
+
+    m_fused_kernels.clear();
+    m_fused_kernel_index.clear();
+    for(size_t g = 0; g < m_fusion_plan.groups.size(); ++g)
+    {
+        auto& group = m_fusion_plan.groups[g];
+        if(group.size() == 1)
+        {
+            auto& closure = *m_closures[group.front().value()].second;
+            for(auto& stage : m_fusion_stages[group.front().value()])
+                add_unfused_stage(stage);
+            find_kernel_arg_slots(closure);
+            continue;
+        }
+
+        auto& fused = m_fused_kernels.emplace_back();
+        fused.group = g;
+        fused.parms = std::make_shared<KernelNodeParms<details::FusedParallelForArgs>>();
+        m_fused_kernel_index.emplace(g, m_fused_kernels.size() - 1);
+
+        auto& head       = m_fusion_stages[group.front().value()].front();
+        auto& args       = fused.parms->kernelParmData;
+        args.count       = head.candidate.count;
+        args.stage_count = static_cast<int>(group.size());
+        for(size_t k = 0; k < group.size(); ++k)
+        {
+            auto& stage     = m_fusion_stages[group[k].value()].front();
+            auto  offset    = m_fusion_plan.callable_offset[group[k].value()];
+            args.fns[k]     = stage.fn;
+            args.offsets[k] = static_cast<uint32_t>(offset);
+            std::memcpy(args.data + offset, stage.callable.data(), stage.callable.size());
+        }
+
+        auto block_dim = head.candidate.block_dim;
+        fused.parms->func((void*)details::fused_parallel_for_kernel<>);
+        fused.parms->grid_dim(static_cast<unsigned int>(args.count / block_dim + (args.count % block_dim != 0)));
+        fused.parms->block_dim(block_dim);
+        fused.parms->shared_mem_bytes(0);
+        fused.parms->parse([](details::FusedParallelForArgs& a) -> std::vector<void*>
+                           { return {&a}; });
+
+        // the first closure runs the fused kernel, the others get an empty node
+        fused.node = head.node;
+        static_cast<ComputeGraphKernelNode*>(fused.node)->set_node(m_graph.add_kernel_node(fused.parms));
+        for(size_t k = 1; k < group.size(); ++k)
+        {
+            cudaGraphNode_t empty;
+            checkCudaErrors(cudaGraphAddEmptyNode(&empty, m_graph.handle(), nullptr, 0));
+            m_fusion_stages[group[k].value()].front().node->set_handle(empty);
+        }
+    }
+}
+
+MUDA_INLINE void ComputeGraph::add_unfused_stage(details::FusionStage& stage)
+{
+    auto node = static_cast<ComputeGraphKernelNode*>(stage.node);
+    node->set_node(stage.add_node(m_graph));
+    auto info = stage.patch;
+    info.node = node->handle();
+    record_kernel_arg_patch(node, info);
+}
+
+MUDA_INLINE void ComputeGraph::update_fusion_stage(details::FusionStage&& stage)
+{
+    auto  closure_id = current_closure_id();
+    auto& old        = m_fusion_stages[closure_id.value()].front();
+    MUDA_ASSERT(old.fn == stage.fn,
+                "closure[%s] launches another kernel in Updating phase",
+                m_closures[closure_id.value()].first.c_str());
+    old.candidate = stage.candidate;
+    old.callable  = std::move(stage.callable);
+    old.parms     = std::move(stage.parms);
+    m_dirty_fused_kernels.insert(
+        m_fused_kernel_index.at(m_fusion_plan.group_of[closure_id.value()]));
+}
+
+MUDA_INLINE void ComputeGraph::update_fused_kernel_nodes()
+{
+    for(auto index : m_dirty_fused_kernels)
+    {
+        auto& fused = m_fused_kernels[index];
+        auto& group = m_fusion_plan.groups[fused.group];
+        auto& args  = fused.parms->kernelParmData;
+        auto& head  = m_fusion_stages[group.front().value()].front().candidate;
+
+        for(auto id : group)
+        {
+            auto& stage = m_fusion_stages[id.value()].front();
+            if(stage.candidate.count != head.count || stage.candidate.block_dim != head.block_dim)
+            {
+                MUDA_ERROR_WITH_LOCATION(
+                    "closure[%s] is fused with closure[%s], "
+                    "but their count/block_dim differ after updating, "
+                    "update the vars deciding the count together",
+                    m_closures[id.value()].first.c_str(),
+                    m_closures[group.front().value()].first.c_str());
+            }
+            std::memcpy(args.data + m_fusion_plan.callable_offset[id.value()],
+                        stage.callable.data(),
+                        stage.callable.size());
+        }
+        args.count = head.count;
+        fused.parms->grid_dim(static_cast<unsigned int>(
+            head.count / head.block_dim + (head.count % head.block_dim != 0)));
+
+        auto node = static_cast<ComputeGraphKernelNode*>(fused.node);
+        m_graph_exec->set_kernel_node_parms(node->m_node, fused.parms);
+    }
+    m_dirty_fused_kernels.clear();
+}
+
+MUDA_INLINE void ComputeGraph::exec_caching(bool enable)
+{
+    MUDA_ASSERT(!m_graph_exec, "exec_caching must be set before the graph is built");
+    m_exec_caching = enable;
+}
+
 MUDA_INLINE void ComputeGraph::serial_launch()
 {
     GraphPhaseGuard guard(*this, ComputeGraphPhase::SerialLaunching);
@@ -177,8 +502,70 @@ MUDA_INLINE void ComputeGraph::serial_launch()
         // m_current_node_id    = NodeId{i};
         m_current_closure_id = ClosureId{i};
         m_allow_access_graph = false;  // no need to access graph
+        if(m_profiling)
+            checkCudaErrors(cudaEventRecord(m_profile_begin_events[i], m_current_single_stream));
         m_closures[i].second->operator()();
         m_is_capturing = false;
+        if(m_profiling)
+            checkCudaErrors(cudaEventRecord(m_profile_end_events[i], m_current_single_stream));
+    }
+}
+
+MUDA_INLINE void ComputeGraph::multi_stream_launch(cudaStream_t s)
+{
+    auto& schedule = stream_schedule();
+
+    // stream 0 is the launch stream, the others come from the pool
+    while(m_schedule_streams.size() + 1 < schedule.stream_count)
+        m_schedule_streams.emplace_back(Stream::Flag::eNonBlocking);
+    while(m_join_events.size() + 1 < schedule.stream_count)
+        m_join_events.emplace_back();
+    while(m_closure_events.size() < m_closures.size())
+        m_closure_events.emplace_back();
+
+    auto stream_of = [&](size_t k) -> cudaStream_t
+    { return k == 0 ? s : m_schedule_streams[k - 1].viewer(); };
+
+    // fork: the pool streams wait for the work before this launch
+    if(schedule.stream_count > 1)
+    {
+        checkCudaErrors(cudaEventRecord(m_fork_event, s));
+        for(size_t k = 1; k < schedule.stream_count; ++k)
+            checkCudaErrors(cudaStreamWaitEvent(stream_of(k), m_fork_event, 0));
+    }
+
+    {
+        GraphPhaseGuard guard(*this, ComputeGraphPhase::SerialLaunching);
+        for(auto closure_id : schedule.order)
+        {
+            auto i      = closure_id.value();
+            auto stream = stream_of(schedule.stream_of[i]);
+
+            // only wait on the real (and not yet synchronized) dependencies
+            for(auto dep : schedule.waits[i])
+                checkCudaErrors(cudaStreamWaitEvent(stream, m_closure_events[dep.value()], 0));
+
+            m_current_closure_id    = closure_id;
+            m_current_single_stream = stream;
+            m_allow_access_graph    = false;  // no need to access graph
+            if(m_profiling)
+                checkCudaErrors(cudaEventRecord(m_profile_begin_events[i], stream));
+            m_closures[i].second->operator()();
+            m_is_capturing = false;
+            if(m_profiling)
+                checkCudaErrors(cudaEventRecord(m_profile_end_events[i], stream));
+
+            if(schedule.need_record[i])
+                checkCudaErrors(cudaEventRecord(m_closure_events[i], stream));
+        }
+    }
+
+    // join: the launch stream waits for all the pool streams
+    for(size_t k = 1; k < schedule.stream_count; ++k)
+    {
+        auto& join = m_join_events[k - 1];
+        checkCudaErrors(cudaEventRecord(join, stream_of(k)));
+        checkCudaErrors(cudaStreamWaitEvent(s, join, 0));
     }
 }
 
@@ -294,6 +681,9 @@ MUDA_INLINE void ComputeGraph::_update()
 
     GraphPhaseGuard guard(*this, ComputeGraphPhase::Updating);
 
+    // the closures to re-run capture the newest args anyway, patch the others
+    patch_kernel_args();
+
     for(size_t i = 0; i < m_closure_need_update.size(); ++i)
     {
         auto& need_update = m_closure_need_update[i];
@@ -310,10 +700,201 @@ MUDA_INLINE void ComputeGraph::_update()
             need_update = false;
         }
     }
+    update_fused_kernel_nodes();
+    m_need_update = false;
+}
+
+MUDA_INLINE void ComputeGraph::record_kernel_arg_patch(ComputeGraphNodeBase* node,
+                                                       const details::KernelArgPatchInfo& info)
+{
+    auto iter = m_kernel_arg_patch_index.find(node->node_id().value());
+    if(iter == m_kernel_arg_patch_index.end())
+    {
+        m_kernel_arg_patch_index.emplace(node->node_id().value(), m_kernel_arg_patches.size());
+        m_kernel_arg_patches.push_back(info);
+    }
+    else  // re-captured in Updating phase, the slots don't change
+    {
+        auto& patch    = m_kernel_arg_patches[iter->second];
+        patch.parms    = info.parms;
+        patch.arg_data = info.arg_data;
+        patch.arg_size = info.arg_size;
+        patch.handle   = info.handle;
+    }
+}
+
+MUDA_INLINE void ComputeGraph::find_kernel_arg_slots(ComputeGraphClosure& closure)
+{
+    closure.m_patchable_vars.clear();
+
+    // any other node type (memcpy, memset, event, capture) may take the var value directly
+    std::vector<details::KernelArgPatchInfo*> patches;
+    for(auto node : closure.m_graph_nodes)
+    {
+        if(node->type() != ComputeGraphNodeType::KernelNode)
+            return;
+        auto iter = m_kernel_arg_patch_index.find(node->node_id().value());
+        if(iter == m_kernel_arg_patch_index.end())
+            return;
+        auto& patch = m_kernel_arg_patches[iter->second];
+        if(!patch.arg_data)
+            return;
+        patches.push_back(&patch);
+    }
+    for(auto patch : patches)
+        patch->slots.clear();
+
+    class VarSlots
+    {
+      public:
+        VarId                var_id;
+        ComputeGraphVarBytes value;
+        // (patch index, offset)
+        std::vector<std::pair<size_t, size_t>> slots;
+        bool                                   patchable = true;
+    };
+
+    std::vector<VarSlots> vars;
+    for(auto&& [var_id, usage] : closure.var_usages())
+    {
+        auto var   = m_related_vars[m_global_to_local_var_id[var_id].value()].var;
+        auto value = var->value_bytes();
+        if(value.empty())
+            continue;
+
+        VarSlots& v = vars.emplace_back();
+        v.var_id    = var_id;
+        v.value     = std::move(value);
+        for(size_t p = 0; p < patches.size(); ++p)
+        {
+            auto data = span<const std::byte>{patches[p]->arg_data, patches[p]->arg_size};
+            for(auto offset : v.value.find_in(data))
+                v.slots.emplace_back(p, offset);
+        }
+
+        // each eval()/ceval() must end up as exactly one copy in the arguments,
+        // otherwise the value is also used on the host (e.g. the launch config) or a copy is missed
+        auto evals  = closure.m_var_eval_counts.find(var_id);
+        v.patchable = !v.slots.empty() && evals != closure.m_var_eval_counts.end()
+                      && evals->second == v.slots.size();
+    }
+
+    auto overlap = [](const VarSlots& a, size_t i, const VarSlots& b, size_t j)
+    {
+        auto [pa, oa] = a.slots[i];
+        auto [pb, ob] = b.slots[j];
+        return pa == pb && oa < ob + b.value.bytes.size() && ob < oa + a.value.bytes.size();
+    };
+
+    // two vars with equal (or overlapping) bytes, e.g. x and y bound to the same buffer:
+    // their slots can't be told apart, patching one would rewrite the other
+    for(size_t a = 0; a < vars.size(); ++a)
+        for(size_t b = a + 1; b < vars.size(); ++b)
+            for(size_t i = 0; i < vars[a].slots.size(); ++i)
+                for(size_t j = 0; j < vars[b].slots.size(); ++j)
+                    if(overlap(vars[a], i, vars[b], j))
+                    {
+                        vars[a].patchable = false;
+                        vars[b].patchable = false;
+                    }
+
+    // a copy derived from a var (a subview, a renamed viewer ...) doesn't match its bytes,
+    // but points into its memory, it would go stale if only the var slots were patched
+    for(size_t p = 0; p < patches.size(); ++p)
+    {
+        auto data = patches[p]->arg_data;
+        auto size = patches[p]->arg_size;
+        for(size_t offset = 0; offset + sizeof(uintptr_t) <= size; offset += alignof(uintptr_t))
+        {
+            auto in_slot = [&](const VarSlots& v)
+            {
+                return std::any_of(v.slots.begin(),
+                                   v.slots.end(),
+                                   [&](const std::pair<size_t, size_t>& slot)
+                                   {
+                                       return slot.first == p && offset >= slot.second
+                                              && offset < slot.second + v.value.bytes.size();
+                                   });
+            };
+            if(std::any_of(vars.begin(), vars.end(), in_slot))
+                continue;
+
+            uintptr_t word;
+            std::memcpy(&word, data + offset, sizeof(word));
+            for(auto& v : vars)
+                if(v.value.refers_to(word))
+                    v.patchable = false;
+        }
+    }
+
+    for(auto& v : vars)
+    {
+        if(!v.patchable)
+            continue;
+        for(auto [p, offset] : v.slots)
+            patches[p]->slots.push_back(ComputeGraphKernelArgSlot{v.var_id, offset});
+        closure.m_patchable_vars.insert(v.var_id);
+    }
+}
+
+MUDA_INLINE bool ComputeGraph::is_kernel_arg_patchable(ClosureId closure_id, VarId var_id) const
+{
+    if(!m_kernel_arg_patching || !m_graph_exec)
+        return false;
+    auto& patchable = m_closures[closure_id.value()].second->m_patchable_vars;
+    return patchable.find(var_id) != patchable.end();
+}
+
+MUDA_INLINE void ComputeGraph::patch_kernel_args()
+{
+    m_patched_kernel_node_count = 0;
+    if(m_dirty_patch_vars.empty())
+        return;
+
+    std::map<VarId, ComputeGraphVarBytes> values;
+    for(auto var_id : m_dirty_patch_vars)
+    {
+        auto var = m_related_vars[m_global_to_local_var_id[var_id].value()].var;
+        values.emplace(var_id, var->value_bytes());
+    }
+    m_dirty_patch_vars.clear();
+
+    for(auto& patch : m_kernel_arg_patches)
+    {
+        if(m_closure_need_update[patch.closure_id.value()])
+            continue;
+
+        bool dirty = false;
+        auto data  = span<std::byte>{patch.arg_data, patch.arg_size};
+        for(auto& slot : patch.slots)
+        {
+            auto iter = values.find(slot.var_id);
+            if(iter == values.end())
+                continue;
+            iter->second.patch(data, slot.offset);
+            dirty = true;
+        }
+
+        // all the vars of a node are patched with one call
+        if(dirty)
+        {
+            checkCudaErrors(cudaGraphExecKernelNodeSetParams(
+                m_graph_exec->handle(), patch.node, patch.handle));
+            ++m_patched_kernel_node_count;
+        }
+    }
+}
+
+MUDA_INLINE void ComputeGraph::kernel_arg_patching(bool enable)
+{
+    MUDA_ASSERT(!m_graph_exec, "kernel_arg_patching must be set before the graph is built");
+    m_kernel_arg_patching = enable;
 }
 
 MUDA_INLINE ComputeGraph::~ComputeGraph()
 {
+    release_exec_to_cache();
+
     for(auto var_info : m_related_vars)
         var_info.var->remove_related_closure_infos(this);
 
@@ -324,6 +905,9 @@ MUDA_INLINE ComputeGraph::~ComputeGraph()
 
     for(auto& [name, closure] : m_closures)
         delete closure;
+
+    if(m_transient_arena)
+        Memory().free(m_transient_arena, false);
 }
 
 MUDA_INLINE void ComputeGraph::emplace_related_var(ComputeGraphVarBase* var)
@@ -364,33 +948,74 @@ MUDA_INLINE ComputeGraph::AddNodeProxy ComputeGraph::create_node(std::string_vie
 MUDA_INLINE void ComputeGraph::update()
 {
     m_allow_node_adding = false;
+    plan_transient_memory();
     check_vars_valid();
     _update();
 }
 
 MUDA_INLINE void ComputeGraph::launch(bool single_stream, cudaStream_t s)
+{
+    launch(single_stream ? ComputeGraphLaunchMode::SingleStream : ComputeGraphLaunchMode::Graph,
+           s);
+}
+
+MUDA_INLINE void ComputeGraph::launch(ComputeGraphLaunchMode mode, cudaStream_t s)
 {
     m_allow_node_adding = false;
-    if(single_stream)
+    plan_transient_memory();
+    if(m_profiling)
     {
-        m_current_single_stream = s;
-        serial_launch();
+        collect_profile_samples();  // the events will be recorded again
+        prepare_profile_events();
     }
-    else
+    switch(mode)
     {
-        check_vars_valid();
-        build();
-        _update();
-        m_graph_exec->launch(s);
+        case ComputeGraphLaunchMode::SingleStream: {
+            m_current_single_stream = s;
+            serial_launch();
+        }
+        break;
+        case ComputeGraphLaunchMode::MultiStream: {
+            check_vars_valid();
+            multi_stream_launch(s);
+        }
+        break;
+        default: {
+            check_vars_valid();
+            build();
+            _update();
+            m_graph_exec->launch(s);
+        }
+        break;
     }
     m_event_result = Event::QueryResult::eNotReady;
     checkCudaErrors(cudaEventRecord(m_event, s));
+    m_profiling_pending = m_profiling;
 #if MUDA_CHECK_ON
     if(Debug::is_debug_sync_all())
         checkCudaErrors(cudaStreamSynchronize(s));
 #endif
 }
 
+MUDA_INLINE void ComputeGraph::max_stream_count(size_t count)
+{
+    MUDA_ASSERT(count > 0, "max_stream_count must be > 0");
+    if(count != m_max_stream_count)
+        m_stream_schedule.reset();
+    m_max_stream_count = count;
+}
+
+MUDA_INLINE const ComputeGraphStreamSchedule& ComputeGraph::stream_schedule()
+{
+    if(!m_stream_schedule)
+    {
+        topo_build();
+        m_stream_schedule = std::make_unique<ComputeGraphStreamSchedule>(
+            ComputeGraphStreamSchedule::build(m_closures.size(), m_deps, m_max_stream_count));
+    }
+    return *m_stream_schedule;
+}
+
 MUDA_INLINE Event::QueryResult ComputeGraph::query() const
 {
     if(m_event_result == Event::QueryResult::eNotReady)
@@ -406,90 +1031,6 @@ MUDA_INLINE Event::QueryResult ComputeGraph::query() const
  ********************************************************************************/
 namespace muda
 {
-namespace details
-{
-    MUDA_INLINE void process_node(std::vector<ComputeGraph::Dependency>& deps,
-                                  std::vector<ClosureId>& last_read_or_write_nodes,
-                                  std::vector<ClosureId>& last_write_nodes,
-                                  ComputeGraphClosure&    closure,
-                                  const std::vector<std::pair<LocalVarId, ComputeGraphVarUsage>>& local_var_usage,
-                                  uint64_t& dep_begin,
-                                  uint64_t& dep_count)
-    {
-        auto is_read_write = [](ComputeGraphVarUsage usage)
-        { return usage == ComputeGraphVarUsage::ReadWrite; };
-        auto is_read_only = [](ComputeGraphVarUsage usage)
-        { return usage == ComputeGraphVarUsage::Read; };
-
-        std::unordered_set<ClosureId> unique_deps;
-
-        for(auto& [local_var_id, usage] : local_var_usage)
-        {
-            // if this is a written resource,
-            // this should depend on any write and read before it
-            // to get newest data or to avoid data corruption
-            if(is_read_write(usage))
-            {
-                auto dst_nid = last_read_or_write_nodes[local_var_id.value()];
-                if(dst_nid.is_valid())
-                {
-                    // the last accessing node reads or writes this resrouce, so I should depend on it
-                    if(unique_deps.find(dst_nid) == unique_deps.end())
-                    {
-                        // record this dependency
-                        unique_deps.insert(dst_nid);
-                    }
-                }
-            }
-            // if this is a read resource,
-            // this should depend on any write before it
-            // to get newest data
-            // but it has no need to depend on any read before it
-            else if(is_read_only(usage))
-            {
-                auto dst_nid = last_write_nodes[local_var_id.value()];
-                if(dst_nid.is_valid())
-                {
-                    // the last accessing node writes this resrouce, so I should depend on it
-                    if(unique_deps.find(dst_nid) == unique_deps.end())
-                    {
-                        // record this dependency
-                        unique_deps.insert(dst_nid);
-                    }
-                }
-            }
-        }
-
-        auto current_closure_id = closure.clousure_id();
-
-        // set up res node map with pair [res, node]
-        for(auto& [local_var_id, usage] : local_var_usage)
-        {
-            // if this is a write resource,
-            // the latter read/write kernel should depend on this
-            // to get the newest data.
-            if(is_read_write(usage))
-            {
-                last_read_or_write_nodes[local_var_id.value()] = current_closure_id;
-                last_write_nodes[local_var_id.value()] = current_closure_id;
-            }
-            // if this is a read resource,
-            // the latter write kernel should depend on this
-            // to avoid data corruption.
-            else if(is_read_only(usage))
-            {
-                last_read_or_write_nodes[local_var_id.value()] = current_closure_id;
-            }
-        }
-
-        // add dependencies to deps
-        dep_begin = deps.size();
-        for(auto dep : unique_deps)
-            deps.emplace_back(ComputeGraph::Dependency{dep, current_closure_id});
-        dep_count = unique_deps.size();
-    }
-}  // namespace details
-
 MUDA_INLINE void ComputeGraph::cuda_graph_add_deps()
 {
     std::vector<cudaGraphNode_t> froms;
@@ -517,48 +1058,97 @@ MUDA_INLINE void ComputeGraph::cuda_graph_add_deps()
     }
 
 
+    // profiling: begin_event -> closure -> end_event, and the deps go to begin_event
+    std::vector<cudaGraphNode_t> closure_entries(m_closures.size());
+    for(size_t i = 0; i < m_closures.size(); ++i)
+        closure_entries[i] = m_closures[i].second->m_graph_nodes.front()->handle();
+    if(m_profiling)
+    {
+        prepare_profile_events();
+        for(size_t i = 0; i < m_closures.size(); ++i)
+        {
+            auto& nodes = m_closures[i].second->m_graph_nodes;
+            auto  begin = m_graph.add_event_record_node(m_profile_begin_events[i]);
+            auto  end   = m_graph.add_event_record_node(m_profile_end_events[i]);
+            froms.emplace_back(begin->handle());
+            tos.emplace_back(nodes.front()->handle());
+            froms.emplace_back(nodes.back()->handle());
+            tos.emplace_back(end->handle());
+            closure_entries[i] = begin->handle();
+        }
+    }
+
+    // kernel fusion: a group runs in the kernel node of its first closure,
+    // the empty nodes of the other closures wait for it and take over their outgoing deps
+    for(auto& fused : m_fused_kernels)
+    {
+        auto& group = m_fusion_plan.groups[fused.group];
+        for(size_t k = 1; k < group.size(); ++k)
+        {
+            auto member = m_closures[group[k].value()].second->m_graph_nodes.front();
+            froms.emplace_back(fused.node->handle());
+            tos.emplace_back(member->handle());
+            closure_entries[group[k].value()] = closure_entries[group.front().value()];
+        }
+    }
+
     for(auto dep : m_deps)
     {
+        if(!m_fused_kernels.empty()
+           && m_fusion_plan.group_of[dep.from.value()] == m_fusion_plan.group_of[dep.to.value()])
+            continue;  // inside a fused group
         auto from = m_closures[dep.from.value()].second->m_graph_nodes.back();
-        auto to   = m_closures[dep.to.value()].second->m_graph_nodes.front();
         froms.emplace_back(from->handle());
-        tos.emplace_back(to->handle());
+        tos.emplace_back(closure_entries[dep.to.value()]);
     };
 
+    if(!m_fused_kernels.empty())  // the redirected deps may be duplicated
+    {
+        std::vector<std::pair<cudaGraphNode_t, cudaGraphNode_t>> edges;
+        for(size_t i = 0; i < froms.size(); ++i)
+            edges.emplace_back(froms[i], tos[i]);
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        froms.clear();
+        tos.clear();
+        for(auto [from, to] : edges)
+        {
+            froms.push_back(from);
+            tos.push_back(to);
+        }
+    }
+
     checkCudaErrors(cudaGraphAddDependencies(
         m_graph.handle(), froms.data(), tos.data(), froms.size()));
 }
 
 MUDA_INLINE void ComputeGraph::build_deps()
 {
-    m_deps.clear();
-    auto local_var_count = m_related_vars.size();
-
-    // map: var_id -> node_id, uint64_t{-1} means no write node yet
-    auto last_write_nodes = std::vector<ClosureId>(local_var_count, ClosureId{});
-    // map: var_id -> node_id, uint64_t{-1} means no read node yet
-    auto last_read_or_write_nodes = std::vector<ClosureId>(local_var_count, ClosureId{});
+    ComputeGraphDependencyBuilder builder{m_related_vars.size()};
 
     // process all nodes
+    std::vector<ComputeGraphDependencyBuilder::VarUsage> local_var_usage;
     for(size_t i = 0u; i < m_closures.size(); i++)
     {
         auto& [name, closure] = m_closures[i];
 
         // map global var id to local var id
-        std::vector<std::pair<details::LocalVarId, ComputeGraphVarUsage>> local_var_usage;
+        local_var_usage.clear();
         local_var_usage.reserve(closure->var_usages().size());
         for(auto&& [var_id, usage] : closure->var_usages())
         {
             auto local_id = m_global_to_local_var_id[var_id];
-            local_var_usage.emplace_back(local_id, usage);
+            local_var_usage.emplace_back(local_id.value(), usage);
         }
-
-        size_t dep_begin, dep_count;
-        details::process_node(
-            m_deps, last_read_or_write_nodes, last_write_nodes, *closure, local_var_usage, dep_begin, dep_count);
-        closure->set_deps_range(dep_begin, dep_count);
+        builder.add_closure(closure->clousure_id(), local_var_usage);
     }
 
+    // full WAR sets + transitive reduction
+    std::vector<std::pair<size_t, size_t>> ranges;
+    builder.build(m_deps, ranges);
+    for(size_t i = 0u; i < m_closures.size(); i++)
+        m_closures[i].second->set_deps_range(ranges[i].first, ranges[i].second);
+
     m_is_topo_built = true;
 }
 }  // namespace muda
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <muda/compute_graph/compute_graph.h>
 #include <muda/compute_graph/nodes/compute_graph_kernel_node.h>
 #include <muda/compute_graph/nodes/compute_graph_catpure_node.h>
@@ -65,9 +67,95 @@ namespace details
             if(ComputeGraphBuilder::current_phase() == ComputeGraphPhase::Building)
             {
                 kernel_node->set_node(g.add_kernel_node(parms));
+                m_cg.record_kernel_arg_patch(
+                    kernel_node, kernel_arg_patch_info(kernel_node->m_node->handle(), parms));
             }
         });
     }
+
+    MUDA_INLINE bool ComputeGraphAccessor::is_kernel_fusion_enabled() const
+    {
+        return m_cg.m_kernel_fusion && !m_cg.m_profiling;
+    }
+
+    template <typename T, typename F>
+    MUDA_INLINE void ComputeGraphAccessor::set_fusable_kernel_node(
+        const S<KernelNodeParms<T>>& parms, const F& callable, index_t count, int block_dim)
+    {
+        auto phase = ComputeGraphBuilder::current_phase();
+        if(!is_kernel_fusion_enabled()
+           || (phase != ComputeGraphPhase::Building && phase != ComputeGraphPhase::Updating))
+        {
+            set_kernel_node(parms);
+            return;
+        }
+
+        FusionStage stage;
+        stage.candidate.fusable            = true;
+        stage.candidate.count              = count;
+        stage.candidate.block_dim          = block_dim;
+        stage.candidate.callable_bytes     = sizeof(F);
+        stage.candidate.callable_alignment = alignof(F);
+        stage.fn = fused_stage_function<F>();
+        stage.callable.resize(sizeof(F));
+        std::memcpy(stage.callable.data(), &callable, sizeof(F));
+        stage.parms = parms;
+
+        if(phase == ComputeGraphPhase::Building)
+        {
+            access_graph(
+                [&](Graph& g)
+                {
+                    auto kernel_node = get_or_create_node<ComputeGraphKernelNode>(
+                        [&]
+                        {
+                            return new ComputeGraphKernelNode(NodeId{m_cg.m_nodes.size()},
+                                                              m_cg.current_access_index());
+                        });
+                    // the cuda node is created by ComputeGraph::fuse_kernel_nodes()
+                    stage.add_node = [parms](Graph& g) { return g.add_kernel_node(parms); };
+                    stage.patch    = kernel_arg_patch_info(nullptr, parms);
+                    stage.node     = kernel_node;
+                    m_cg.m_fusion_stages[m_cg.current_closure_id().value()].push_back(
+                        std::move(stage));
+                });
+        }
+        else if(m_cg.m_fusion_plan.is_fused(m_cg.current_closure_id()))
+        {
+            m_cg.update_fusion_stage(std::move(stage));
+        }
+        else
+        {
+            update_kernel_node(parms);
+        }
+    }
+
+    template <typename T>
+    MUDA_INLINE KernelArgPatchInfo ComputeGraphAccessor::kernel_arg_patch_info(
+        cudaGraphNode_t node, const S<KernelNodeParms<T>>& parms)
+    {
+        KernelArgPatchInfo info;
+        info.closure_id = m_cg.current_closure_id();
+        info.node       = node;
+        info.parms      = parms;
+        info.handle     = parms->handle();
+
+        // only patchable if all the arguments live in the parameter data
+        auto begin    = reinterpret_cast<std::byte*>(&parms->kernelParmData);
+        auto end      = begin + sizeof(T);
+        auto in_range = [&](void* arg)
+        {
+            auto p = reinterpret_cast<std::byte*>(arg);
+            return p >= begin && p < end;
+        };
+        if(std::all_of(parms->args().begin(), parms->args().end(), in_range))
+        {
+            info.arg_data = begin;
+            info.arg_size = sizeof(T);
+        }
+        return info;
+    }
+
     template <typename T>
     MUDA_INLINE void ComputeGraphAccessor::update_kernel_node(const S<KernelNodeParms<T>>& kernelParms)
     {
@@ -77,6 +165,8 @@ namespace details
                 const auto& [name, closure] = current_closure();
                 auto kernel_node = current_node<ComputeGraphKernelNode>();
                 g_exec.set_kernel_node_parms(kernel_node->m_node, kernelParms);
+                m_cg.record_kernel_arg_patch(
+                    kernel_node, kernel_arg_patch_info(kernel_node->m_node->handle(), kernelParms));
             });
     }
 
@@ -469,9 +559,13 @@ namespace details
     }
     MUDA_INLINE void ComputeGraphAccessor::set_var_usage(VarId id, ComputeGraphVarUsage usage)
     {
-        auto& dst_usage = current_closure().second->m_var_usages[id];
+        auto  closure   = current_closure().second;
+        auto& dst_usage = closure->m_var_usages[id];
         if(dst_usage < usage)
             dst_usage = usage;
+        // every eval is expected to end up as one copy in the kernel arguments (kernel arg patching)
+        if(ComputeGraphBuilder::current_phase() == ComputeGraphPhase::Building)
+            ++closure->m_var_eval_counts[id];
     }
 
 }  // namespace details
@@ -1,5 +1,7 @@
 #include <muda/compute_graph/compute_graph_var_manager.h>
 #include <muda/compute_graph/compute_graph.h>
+#include <muda/compute_graph/compute_graph_profile.h>
+#include <cstdio>
 
 namespace muda
 {
@@ -29,6 +31,13 @@ MUDA_INLINE void ComputeGraphClosure::graphviz_def(std::ostream& o,
     {
         graphviz_id(o, options);
     }
+    auto profile = options.profile;
+    if(profile && clousure_id().value() < profile->closure_count())
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.3f", profile->timing(clousure_id()).mean_ms());
+        o << "\\n" << buf << " ms";
+    }
     if(options.show_all_graph_nodes_in_a_closure)
     {
 
@@ -50,6 +59,8 @@ MUDA_INLINE void ComputeGraphClosure::graphviz_def(std::ostream& o,
     {
         o << options.node_style;
     }
+    if(profile && clousure_id().value() < profile->closure_count())
+        o << "fillcolor=\"" << profile->heat_color(clousure_id()) << "\",";
     o << "]";
 }
 
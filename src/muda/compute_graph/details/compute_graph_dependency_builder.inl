@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdint>
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+MUDA_INLINE ComputeGraphDependencyBuilder::ComputeGraphDependencyBuilder(size_t var_count)
+    : m_vars(var_count)
+{
+}
+
+MUDA_INLINE void ComputeGraphDependencyBuilder::add_closure(ClosureId closure_id,
+                                                            span<const VarUsage> usages)
+{
+    MUDA_ASSERT(closure_id.value() == m_preds.size(),
+                "closures must be added in order, expected %d, got %d",
+                (int)m_preds.size(),
+                (int)closure_id.value());
+
+    auto& preds = m_preds.emplace_back();
+
+    auto depend_on = [&](ClosureId id)
+    {
+        if(!id.is_valid() || id == closure_id)
+            return;
+        if(std::find(preds.begin(), preds.end(), id) == preds.end())
+            preds.push_back(id);
+    };
+
+    for(auto& [var, usage] : usages)
+    {
+        auto& state = m_vars[var];
+        if(usage == ComputeGraphVarUsage::ReadWrite)
+        {
+            // WAR: wait for every reader, they have already waited for the last writer
+            if(!state.readers.empty())
+                for(auto reader : state.readers)
+                    depend_on(reader);
+            else  // WAW
+                depend_on(state.last_write);
+        }
+        else if(usage == ComputeGraphVarUsage::Read)
+        {
+            // RAW
+            depend_on(state.last_write);
+        }
+    }
+
+    for(auto& [var, usage] : usages)
+    {
+        auto& state = m_vars[var];
+        if(usage == ComputeGraphVarUsage::ReadWrite)
+        {
+            state.last_write = closure_id;
+            state.readers.clear();
+        }
+        else if(usage == ComputeGraphVarUsage::Read)
+        {
+            state.readers.push_back(closure_id);
+        }
+    }
+
+    m_raw_dep_count += preds.size();
+}
+
+MUDA_INLINE void ComputeGraphDependencyBuilder::build(std::vector<ComputeGraphDependency>& deps,
+                                                      std::vector<std::pair<size_t, size_t>>& ranges,
+                                                      bool reduce) const
+{
+    auto closure_count = m_preds.size();
+    deps.clear();
+    deps.reserve(m_raw_dep_count);
+    ranges.assign(closure_count, {0, 0});
+
+    // ancestors[i] is a bitset of all the closures i (transitively) depends on
+    auto words = (closure_count + 63) / 64;
+    std::vector<uint64_t> ancestors(reduce ? closure_count * words : 0, 0);
+    auto ancestor_row = [&](size_t i) { return ancestors.data() + i * words; };
+    auto test         = [](const uint64_t* row, size_t j)
+    { return (row[j / 64] >> (j % 64)) & 1; };
+
+    std::vector<ClosureId> sorted_preds;
+    for(size_t i = 0; i < closure_count; ++i)
+    {
+        ranges[i].first = deps.size();
+
+        if(!reduce)
+        {
+            for(auto pred : m_preds[i])
+                deps.push_back(ComputeGraphDependency{pred, ClosureId{i}});
+            ranges[i].second = deps.size() - ranges[i].first;
+            continue;
+        }
+
+        // closures only depend on earlier closures, so the closure order is a topological order.
+        // visit the latest predecessor first: an earlier one reachable from it is redundant.
+        sorted_preds = m_preds[i];
+        std::sort(sorted_preds.begin(),
+                  sorted_preds.end(),
+                  [](ClosureId a, ClosureId b) { return a.value() > b.value(); });
+
+        auto row = ancestor_row(i);
+        for(auto pred : sorted_preds)
+        {
+            auto p = pred.value();
+            if(test(row, p))
+                continue;  // implied by another edge
+
+            deps.push_back(ComputeGraphDependency{pred, ClosureId{i}});
+            row[p / 64] |= uint64_t{1} << (p % 64);
+            auto pred_row = ancestor_row(p);
+            for(size_t w = 0; w < words; ++w)
+                row[w] |= pred_row[w];
+        }
+        // keep the edges of a closure in ascending order
+        std::sort(deps.begin() + ranges[i].first,
+                  deps.end(),
+                  [](const ComputeGraphDependency& a, const ComputeGraphDependency& b)
+                  { return a.from.value() < b.from.value(); });
+        ranges[i].second = deps.size() - ranges[i].first;
+    }
+}
+}  // namespace muda
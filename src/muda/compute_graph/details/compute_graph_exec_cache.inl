@@ -0,0 +1,96 @@
+namespace muda
+{
+template <typename Entry>
+MUDA_INLINE ComputeGraphExecCacheBase<Entry>& ComputeGraphExecCacheBase<Entry>::instance()
+{
+    static ComputeGraphExecCacheBase cache;
+    return cache;
+}
+
+template <typename Entry>
+MUDA_INLINE std::optional<Entry> ComputeGraphExecCacheBase<Entry>::acquire(const ComputeGraphTopologyKey& key)
+{
+    std::lock_guard lock{m_mutex};
+    for(auto iter = m_items.begin(); iter != m_items.end(); ++iter)
+    {
+        if(iter->first == key)
+        {
+            std::optional<Entry> ret{std::move(iter->second)};
+            m_items.erase(iter);
+            ++m_stats.hit_count;
+            m_stats.cached_count = m_items.size();
+            return ret;
+        }
+    }
+    ++m_stats.miss_count;
+    return std::nullopt;
+}
+
+template <typename Entry>
+MUDA_INLINE void ComputeGraphExecCacheBase<Entry>::release(const ComputeGraphTopologyKey& key,
+                                                           Entry&& entry)
+{
+    std::list<Item> evicted;  // destroyed outside the lock
+    {
+        std::lock_guard lock{m_mutex};
+        m_items.emplace_front(key, std::move(entry));
+        evict(evicted);
+    }
+}
+
+template <typename Entry>
+MUDA_INLINE void ComputeGraphExecCacheBase<Entry>::capacity(size_t capacity)
+{
+    std::list<Item> evicted;
+    {
+        std::lock_guard lock{m_mutex};
+        m_capacity = capacity;
+        evict(evicted);
+    }
+}
+
+template <typename Entry>
+MUDA_INLINE size_t ComputeGraphExecCacheBase<Entry>::capacity() const
+{
+    std::lock_guard lock{m_mutex};
+    return m_capacity;
+}
+
+template <typename Entry>
+MUDA_INLINE void ComputeGraphExecCacheBase<Entry>::clear()
+{
+    std::list<Item> evicted;
+    {
+        std::lock_guard lock{m_mutex};
+        evicted.swap(m_items);
+        m_stats.cached_count = 0;
+    }
+}
+
+template <typename Entry>
+MUDA_INLINE ComputeGraphExecCacheStats ComputeGraphExecCacheBase<Entry>::stats() const
+{
+    std::lock_guard lock{m_mutex};
+    return m_stats;
+}
+
+template <typename Entry>
+MUDA_INLINE void ComputeGraphExecCacheBase<Entry>::reset_stats()
+{
+    std::lock_guard lock{m_mutex};
+    auto            cached_count = m_stats.cached_count;
+    m_stats                      = {};
+    m_stats.cached_count         = cached_count;
+}
+
+template <typename Entry>
+MUDA_INLINE void ComputeGraphExecCacheBase<Entry>::evict(std::list<Item>& evicted)
+{
+    while(m_items.size() > m_capacity)
+    {
+        evicted.splice(evicted.end(), m_items, std::prev(m_items.end()));
+        ++m_stats.eviction_count;
+    }
+    m_stats.cached_count = m_items.size();
+}
+}  // namespace muda
@@ -0,0 +1,47 @@
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+MUDA_INLINE ComputeGraphFusionPlan ComputeGraphFusionPlan::build(span<const ComputeGraphFusionCandidate> candidates,
+                                                                 size_t max_stages,
+                                                                 size_t max_callable_bytes)
+{
+    MUDA_ASSERT(max_stages > 0, "max_stages must be > 0");
+
+    ComputeGraphFusionPlan plan;
+    plan.group_of.resize(candidates.size(), 0);
+    plan.callable_offset.resize(candidates.size(), 0);
+
+    auto align_up = [](size_t x, size_t a) { return (x + a - 1) / a * a; };
+
+    size_t used_bytes = 0;
+    for(size_t i = 0; i < candidates.size(); ++i)
+    {
+        auto& c = candidates[i];
+
+        bool join = false;
+        if(c.fusable && !plan.groups.empty())
+        {
+            auto& group = plan.groups.back();
+            auto& head  = candidates[group.front().value()];
+            join        = head.fusable && head.count == c.count
+                   && head.block_dim == c.block_dim && group.size() < max_stages
+                   && align_up(used_bytes, c.callable_alignment) + c.callable_bytes
+                          <= max_callable_bytes;
+        }
+
+        if(!join)
+        {
+            plan.groups.emplace_back();
+            used_bytes = 0;
+        }
+
+        auto offset = align_up(used_bytes, c.callable_alignment);
+        plan.groups.back().push_back(ClosureId{i});
+        plan.group_of[i]        = plan.groups.size() - 1;
+        plan.callable_offset[i] = offset;
+        used_bytes              = offset + c.callable_bytes;
+    }
+    return plan;
+}
+}  // namespace muda
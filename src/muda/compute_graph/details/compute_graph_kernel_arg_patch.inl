@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+namespace details
+{
+    template <typename T, typename = void>
+    constexpr bool has_data_and_size_v = false;
+    template <typename T>
+    constexpr bool has_data_and_size_v<T, std::void_t<decltype(std::declval<const T&>().data()),
+                                                      decltype(std::declval<const T&>().size())>> =
+        std::is_pointer_v<decltype(std::declval<const T&>().data())>;
+
+    template <typename T, typename = void>
+    constexpr bool has_data_and_total_size_v = false;
+    template <typename T>
+    constexpr bool has_data_and_total_size_v<
+        T,
+        std::void_t<decltype(std::declval<const T&>().data()), decltype(std::declval<const T&>().total_size())>> =
+        std::is_pointer_v<decltype(std::declval<const T&>().data())>;
+
+    // the elements a value refers to: a pointer, or a viewer with data() and size()/total_size()
+    template <typename T>
+    void var_ref_range(const T& value, uintptr_t& begin, uintptr_t& end)
+    {
+        if constexpr(std::is_pointer_v<T>)
+        {
+            begin = reinterpret_cast<uintptr_t>(value);
+            end   = begin + 1;
+        }
+        else if constexpr(has_data_and_size_v<T> || has_data_and_total_size_v<T>)
+        {
+            using E = std::remove_pointer_t<decltype(value.data())>;
+            size_t count;
+            if constexpr(has_data_and_size_v<T>)
+                count = static_cast<size_t>(value.size());
+            else
+                count = static_cast<size_t>(value.total_size());
+            begin = reinterpret_cast<uintptr_t>(value.data());
+            end   = begin + std::max<size_t>(count, 1) * sizeof(E);
+        }
+    }
+}  // namespace details
+
+template <typename T>
+MUDA_INLINE ComputeGraphVarBytes ComputeGraphVarBytes::from(const T& value)
+{
+    ComputeGraphVarBytes ret;
+    if constexpr(is_patchable_v<T>)
+    {
+        // copy the value into two buffers with different backgrounds,
+        // the bytes which don't agree are padding
+        alignas(T) std::byte zeros[sizeof(T)];
+        alignas(T) std::byte ones[sizeof(T)];
+        std::memset(zeros, 0x00, sizeof(T));
+        std::memset(ones, 0xFF, sizeof(T));
+        new(zeros) T(value);
+        new(ones) T(value);
+
+        ret.bytes.assign(zeros, zeros + sizeof(T));
+        ret.mask.resize(sizeof(T));
+        for(size_t i = 0; i < sizeof(T); ++i)
+            ret.mask[i] = zeros[i] == ones[i];
+
+        details::var_ref_range(value, ret.ref_begin, ret.ref_end);
+    }
+    return ret;
+}
+
+MUDA_INLINE std::vector<size_t> ComputeGraphVarBytes::find_in(span<const std::byte> data) const
+{
+    std::vector<size_t> offsets;
+    auto                size = bytes.size();
+    if(size == 0 || data.size() < size)
+        return offsets;
+
+    for(size_t offset = 0; offset + size <= data.size(); ++offset)
+    {
+        bool match = true;
+        for(size_t i = 0; i < size && match; ++i)
+            match = !mask[i] || data[offset + i] == bytes[i];
+        if(match)
+        {
+            offsets.push_back(offset);
+            offset += size - 1;  // copies don't overlap
+        }
+    }
+    return offsets;
+}
+
+MUDA_INLINE void ComputeGraphVarBytes::patch(span<std::byte> data, size_t offset) const
+{
+    MUDA_ASSERT(offset + bytes.size() <= data.size(),
+                "patch out of range, offset=%d, size=%d, data size=%d",
+                (int)offset,
+                (int)bytes.size(),
+                (int)data.size());
+    for(size_t i = 0; i < bytes.size(); ++i)
+        if(mask[i])
+            data[offset + i] = bytes[i];
+}
+
+MUDA_INLINE bool ComputeGraphVarBytes::refers_to(uintptr_t word) const
+{
+    // a null pointer refers to nothing
+    return ref_begin != 0 && word >= ref_begin && word < ref_end;
+}
+}  // namespace muda
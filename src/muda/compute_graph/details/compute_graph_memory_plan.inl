@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+namespace details
+{
+    MUDA_INLINE size_t align_up(size_t x, size_t alignment)
+    {
+        return (x + alignment - 1) / alignment * alignment;
+    }
+}  // namespace details
+
+MUDA_INLINE ComputeGraphMemoryPlan ComputeGraphMemoryPlan::build(span<const ComputeGraphTransientBuffer> buffers)
+{
+    ComputeGraphMemoryPlan plan;
+    plan.offsets.resize(buffers.size(), 0);
+
+    for(auto& b : buffers)
+    {
+        MUDA_ASSERT(b.alignment > 0, "alignment must be > 0");
+        MUDA_ASSERT(b.first <= b.last, "invalid live interval [%d, %d]", (int)b.first, (int)b.last);
+        plan.unaliased_bytes = details::align_up(plan.unaliased_bytes, b.alignment) + b.bytes;
+    }
+
+    std::vector<size_t> order(buffers.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](size_t a, size_t b) { return buffers[a].bytes > buffers[b].bytes; });
+
+    // (offset, end) of the placed buffers living at the same time as the current one
+    std::vector<std::pair<size_t, size_t>> occupied;
+    std::vector<size_t>                    placed;
+    placed.reserve(buffers.size());
+
+    for(auto i : order)
+    {
+        auto& b = buffers[i];
+
+        occupied.clear();
+        for(auto j : placed)
+        {
+            auto& other = buffers[j];
+            if(other.first <= b.last && b.first <= other.last)
+                occupied.emplace_back(plan.offsets[j], plan.offsets[j] + other.bytes);
+        }
+        std::sort(occupied.begin(), occupied.end());
+
+        // tightest gap
+        size_t best      = ~size_t{0};
+        size_t best_fit  = ~size_t{0};
+        size_t gap_begin = 0;
+        for(auto [offset, end] : occupied)
+        {
+            auto candidate = details::align_up(gap_begin, b.alignment);
+            if(candidate + b.bytes <= offset && offset - candidate - b.bytes < best_fit)
+            {
+                best     = candidate;
+                best_fit = offset - candidate - b.bytes;
+            }
+            gap_begin = std::max(gap_begin, end);
+        }
+        if(best == ~size_t{0})  // on top
+            best = details::align_up(gap_begin, b.alignment);
+
+        plan.offsets[i]  = best;
+        plan.arena_bytes = std::max(plan.arena_bytes, best + b.bytes);
+        placed.push_back(i);
+    }
+    return plan;
+}
+
+MUDA_INLINE std::vector<std::pair<size_t, size_t>> ComputeGraphMemoryPlan::live_intervals(
+    size_t closure_count, span<const ComputeGraphDependency> deps, span<const std::vector<ClosureId>> users)
+{
+    std::vector<std::pair<size_t, size_t>> intervals(users.size());
+    if(closure_count == 0)
+        return intervals;
+
+    // ancestors[i] is a bitset of all the closures i (transitively) depends on
+    auto words = (closure_count + 63) / 64;
+    std::vector<uint64_t> ancestors(closure_count * words, 0);
+    auto ancestor_row = [&](size_t i) { return ancestors.data() + i * words; };
+    auto test         = [](const uint64_t* row, size_t j)
+    { return (row[j / 64] >> (j % 64)) & 1; };
+
+    std::vector<std::vector<size_t>> preds(closure_count);
+    for(auto dep : deps)
+    {
+        MUDA_ASSERT(dep.from.value() < dep.to.value(),
+                    "dependencies must follow the closure order");
+        preds[dep.to.value()].push_back(dep.from.value());
+    }
+    for(size_t i = 0; i < closure_count; ++i)
+    {
+        auto row = ancestor_row(i);
+        for(auto p : preds[i])
+        {
+            row[p / 64] |= uint64_t{1} << (p % 64);
+            auto pred_row = ancestor_row(p);
+            for(size_t w = 0; w < words; ++w)
+                row[w] |= pred_row[w];
+        }
+    }
+
+    for(size_t b = 0; b < users.size(); ++b)
+    {
+        auto& u = users[b];
+        if(u.empty())
+        {
+            intervals[b] = {0, closure_count - 1};
+            continue;
+        }
+
+        size_t first = closure_count;
+        size_t last  = 0;
+        for(auto id : u)
+        {
+            first = std::min(first, id.value());
+            last  = std::max(last, id.value());
+        }
+
+        // the latest closure that may run concurrently with one of the users
+        for(size_t k = closure_count - 1; k > last; --k)
+        {
+            auto row = ancestor_row(k);
+            bool after_all =
+                std::all_of(u.begin(), u.end(), [&](ClosureId id) { return test(row, id.value()); });
+            if(!after_all)
+            {
+                last = k;
+                break;
+            }
+        }
+        intervals[b] = {first, last};
+    }
+    return intervals;
+}
+}  // namespace muda
@@ -23,4 +23,12 @@ MUDA_INLINE void ComputeGraphNode<NodeT, Type>::set_node(S<NodeT> node)
     m_node = node;
     set_handle(m_node->handle());
 }
+
+template <typename NodeT, ComputeGraphNodeType Type>
+MUDA_INLINE void ComputeGraphNode<NodeT, Type>::remap_handle(cudaGraphNode_t handle)
+{
+    if(m_node)  // nullptr: an empty node standing for a fused closure
+        set_graph_node_handle(*m_node, handle);
+    set_handle(handle);
+}
 }  // namespace muda
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cstdio>
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+MUDA_INLINE ComputeGraphProfile::ComputeGraphProfile(std::vector<std::string> closure_names)
+{
+    m_timings.resize(closure_names.size());
+    for(size_t i = 0; i < closure_names.size(); ++i)
+        m_timings[i].name = std::move(closure_names[i]);
+    m_on_critical_path.resize(m_timings.size(), 0);
+}
+
+MUDA_INLINE void ComputeGraphProfile::reset()
+{
+    for(auto& timing : m_timings)
+    {
+        auto name   = std::move(timing.name);
+        timing      = ComputeGraphClosureTiming{};
+        timing.name = std::move(name);
+    }
+    m_launch_count = 0;
+    m_critical_path.clear();
+    std::fill(m_on_critical_path.begin(), m_on_critical_path.end(), 0);
+    m_critical_path_ms = 0.0;
+}
+
+MUDA_INLINE void ComputeGraphProfile::add_launch(span<const double> ms)
+{
+    MUDA_ASSERT(ms.size() == m_timings.size(),
+                "sample count mismatch, expected %d, got %d",
+                (int)m_timings.size(),
+                (int)ms.size());
+    for(size_t i = 0; i < ms.size(); ++i)
+        add_sample(ClosureId{i}, ms[i]);
+    ++m_launch_count;
+}
+
+MUDA_INLINE void ComputeGraphProfile::add_sample(ClosureId closure_id, double ms)
+{
+    auto& timing = m_timings[closure_id.value()];
+    if(timing.sample_count == 0)
+    {
+        timing.min_ms = ms;
+        timing.max_ms = ms;
+    }
+    else
+    {
+        timing.min_ms = std::min(timing.min_ms, ms);
+        timing.max_ms = std::max(timing.max_ms, ms);
+    }
+    timing.total_ms += ms;
+    ++timing.sample_count;
+}
+
+MUDA_INLINE const ComputeGraphClosureTiming& ComputeGraphProfile::timing(ClosureId closure_id) const
+{
+    return m_timings[closure_id.value()];
+}
+
+MUDA_INLINE void ComputeGraphProfile::analyze(span<const ComputeGraphDependency> deps)
+{
+    auto n = m_timings.size();
+    m_critical_path.clear();
+    m_on_critical_path.assign(n, 0);
+    m_critical_path_ms = 0.0;
+    if(n == 0)
+        return;
+
+    std::vector<std::vector<size_t>> preds(n);
+    for(auto& dep : deps)
+    {
+        MUDA_ASSERT(dep.from.value() < dep.to.value(),
+                    "dependency (%d->%d) is against the closure order",
+                    (int)dep.from.value(),
+                    (int)dep.to.value());
+        preds[dep.to.value()].push_back(dep.from.value());
+    }
+
+    // longest path ending at each closure
+    std::vector<double> finish(n, 0.0);
+    std::vector<size_t> prev(n, ~size_t{0});
+    for(size_t i = 0; i < n; ++i)
+    {
+        double start = 0.0;
+        for(auto pred : preds[i])
+        {
+            if(finish[pred] > start)
+            {
+                start   = finish[pred];
+                prev[i] = pred;
+            }
+        }
+        finish[i] = start + m_timings[i].mean_ms();
+    }
+
+    auto last = static_cast<size_t>(std::max_element(finish.begin(), finish.end()) - finish.begin());
+    m_critical_path_ms = finish[last];
+    for(auto i = last; i != ~size_t{0}; i = prev[i])
+    {
+        m_critical_path.push_back(ClosureId{i});
+        m_on_critical_path[i] = 1;
+    }
+    std::reverse(m_critical_path.begin(), m_critical_path.end());
+}
+
+MUDA_INLINE bool ComputeGraphProfile::is_on_critical_path(ClosureId closure_id) const
+{
+    return closure_id.value() < m_on_critical_path.size()
+           && m_on_critical_path[closure_id.value()];
+}
+
+MUDA_INLINE bool ComputeGraphProfile::is_on_critical_path(const ComputeGraphDependency& dep) const
+{
+    for(size_t i = 1; i < m_critical_path.size(); ++i)
+        if(m_critical_path[i - 1] == dep.from && m_critical_path[i] == dep.to)
+            return true;
+    return false;
+}
+
+MUDA_INLINE std::string ComputeGraphProfile::heat_color(ClosureId closure_id) const
+{
+    double max_mean = 0.0;
+    for(auto& timing : m_timings)
+        max_mean = std::max(max_mean, timing.mean_ms());
+    double t = max_mean > 0.0 ? timing(closure_id).mean_ms() / max_mean : 0.0;
+
+    // #D5E8D4 (cold) -> #F8CECC (hot)
+    auto lerp = [&](int a, int b) { return static_cast<int>(a + (b - a) * t + 0.5); };
+    char buf[8];
+    std::snprintf(buf, sizeof(buf), "#%02X%02X%02X", lerp(0xD5, 0xF8), lerp(0xE8, 0xCE), lerp(0xD4, 0xCC));
+    return buf;
+}
+
+MUDA_INLINE void ComputeGraphProfile::to_json(std::ostream& o) const
+{
+    auto escape = [&](std::string_view s)
+    {
+        for(auto c : s)
+        {
+            if(c == '"' || c == '\\')
+                o << '\\' << c;
+            else if(static_cast<unsigned char>(c) < 0x20)
+                o << ' ';
+            else
+                o << c;
+        }
+    };
+
+    o << "{\n";
+    o << "  \"launch_count\": " << m_launch_count << ",\n";
+    o << "  \"closures\": [\n";
+    for(size_t i = 0; i < m_timings.size(); ++i)
+    {
+        auto& timing = m_timings[i];
+        o << "    {\"id\": " << i << ", \"name\": \"";
+        escape(timing.name);
+        o << "\", \"samples\": " << timing.sample_count       //
+          << ", \"min_ms\": " << timing.min_ms                //
+          << ", \"mean_ms\": " << timing.mean_ms()            //
+          << ", \"max_ms\": " << timing.max_ms                //
+          << ", \"critical\": " << (m_on_critical_path.size() > i && m_on_critical_path[i] ? "true" : "false")
+          << "}";
+        o << (i + 1 < m_timings.size() ? ",\n" : "\n");
+    }
+    o << "  ],\n";
+    o << "  \"critical_path\": [";
+    for(size_t i = 0; i < m_critical_path.size(); ++i)
+        o << (i ? ", " : "") << m_critical_path[i].value();
+    o << "],\n";
+    o << "  \"critical_path_ms\": " << m_critical_path_ms << "\n";
+    o << "}\n";
+}
+}  // namespace muda
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <muda/tools/debug_log.h>
+#include <muda/exception.h>
+
+namespace muda
+{
+MUDA_INLINE ComputeGraphStreamSchedule ComputeGraphStreamSchedule::build(
+    size_t closure_count, span<const ComputeGraphDependency> deps, size_t max_stream_count, span<const double> costs)
+{
+    MUDA_ASSERT(max_stream_count > 0, "max_stream_count must be > 0");
+    MUDA_ASSERT(costs.empty() || costs.size() == closure_count,
+                "costs.size() must be 0 or closure_count");
+
+    ComputeGraphStreamSchedule s;
+    s.stream_of.resize(closure_count, 0);
+    s.waits.resize(closure_count);
+    s.need_record.resize(closure_count, false);
+    s.order.reserve(closure_count);
+    if(closure_count == 0)
+        return s;
+
+    auto cost = [&](size_t i) { return costs.empty() ? 1.0 : costs[i]; };
+
+    std::vector<std::vector<size_t>> preds(closure_count);
+    std::vector<std::vector<size_t>> succs(closure_count);
+    for(auto dep : deps)
+    {
+        preds[dep.to.value()].push_back(dep.from.value());
+        succs[dep.from.value()].push_back(dep.to.value());
+    }
+
+    // topological order (Kahn)
+    std::vector<size_t> in_degree(closure_count);
+    std::vector<size_t> topo;
+    topo.reserve(closure_count);
+    for(size_t i = 0; i < closure_count; ++i)
+    {
+        in_degree[i] = preds[i].size();
+        if(in_degree[i] == 0)
+            topo.push_back(i);
+    }
+    for(size_t k = 0; k < topo.size(); ++k)
+        for(auto succ : succs[topo[k]])
+            if(--in_degree[succ] == 0)
+                topo.push_back(succ);
+    if(topo.size() != closure_count)
+        throw logic_error("ComputeGraphStreamSchedule: the dependencies contain a cycle");
+
+    // bottom level: the critical path from a closure to the end
+    std::vector<double> bottom_level(closure_count, 0.0);
+    for(auto iter = topo.rbegin(); iter != topo.rend(); ++iter)
+    {
+        double max_succ = 0.0;
+        for(auto succ : succs[*iter])
+            max_succ = std::max(max_succ, bottom_level[succ]);
+        bottom_level[*iter] = cost(*iter) + max_succ;
+    }
+
+    // list scheduling
+    auto lower_priority = [&](size_t a, size_t b)
+    {
+        // higher bottom level first, then insertion order to keep it deterministic
+        if(bottom_level[a] != bottom_level[b])
+            return bottom_level[a] < bottom_level[b];
+        return a > b;
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(lower_priority)> ready(lower_priority);
+
+    for(size_t i = 0; i < closure_count; ++i)
+    {
+        in_degree[i] = preds[i].size();
+        if(in_degree[i] == 0)
+            ready.push(i);
+    }
+
+    std::vector<double> finish(closure_count, 0.0);
+    std::vector<double> stream_free(max_stream_count, 0.0);
+    std::vector<bool>   stream_used(max_stream_count, false);
+
+    // vector clocks for wait elimination:
+    // stream_clock[k][j] = how many closures on stream j are known finished by stream k
+    // position[i] = 1-based position of closure i on its stream
+    std::vector<std::vector<size_t>> stream_clock(
+        max_stream_count, std::vector<size_t>(max_stream_count, 0));
+    std::vector<std::vector<size_t>> closure_clock(closure_count);
+    std::vector<size_t>              position(closure_count, 0);
+
+    while(!ready.empty())
+    {
+        auto i = ready.top();
+        ready.pop();
+
+        double earliest = 0.0;
+        for(auto pred : preds[i])
+            earliest = std::max(earliest, finish[pred]);
+
+        // choose the stream where it starts earliest
+        size_t best       = 0;
+        double best_start = std::numeric_limits<double>::max();
+        bool   best_is_pred_stream = false;
+        for(size_t k = 0; k < max_stream_count; ++k)
+        {
+            auto start = std::max(earliest, stream_free[k]);
+            auto is_pred_stream =
+                std::any_of(preds[i].begin(),
+                            preds[i].end(),
+                            [&](size_t pred) { return s.stream_of[pred] == k; });
+            if(start < best_start || (start == best_start && is_pred_stream && !best_is_pred_stream))
+            {
+                best                = k;
+                best_start          = start;
+                best_is_pred_stream = is_pred_stream;
+            }
+        }
+
+        s.stream_of[i]    = best;
+        stream_used[best] = true;
+        finish[i]         = best_start + cost(i);
+        stream_free[best] = finish[i];
+        s.makespan        = std::max(s.makespan, finish[i]);
+
+        // waits, the latest predecessor first: waiting for it may cover older ones
+        auto sorted_preds = preds[i];
+        std::sort(sorted_preds.begin(),
+                  sorted_preds.end(),
+                  [&](size_t a, size_t b) { return finish[a] > finish[b]; });
+
+        auto& clock = stream_clock[best];
+        for(auto pred : sorted_preds)
+        {
+            auto pred_stream = s.stream_of[pred];
+            if(clock[pred_stream] >= position[pred])
+                continue;  // already synchronized
+            s.waits[i].push_back(ClosureId{pred});
+            s.need_record[pred] = true;
+            auto& pred_clock    = closure_clock[pred];
+            for(size_t k = 0; k < max_stream_count; ++k)
+                clock[k] = std::max(clock[k], pred_clock[k]);
+        }
+        position[i]    = ++clock[best];
+        closure_clock[i] = clock;
+
+        s.order.push_back(ClosureId{i});
+
+        for(auto succ : succs[i])
+            if(--in_degree[succ] == 0)
+                ready.push(succ);
+    }
+
+    s.stream_count = std::count(stream_used.begin(), stream_used.end(), true);
+
+    // compact the used streams to [0, stream_count)
+    std::vector<size_t> remap(max_stream_count, 0);
+    for(size_t k = 0, used = 0; k < max_stream_count; ++k)
+        if(stream_used[k])
+            remap[k] = used++;
+    for(auto& k : s.stream_of)
+        k = remap[k];
+
+    return s;
+}
+}  // namespace muda
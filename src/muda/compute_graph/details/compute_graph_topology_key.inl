@@ -0,0 +1,77 @@
+#include <algorithm>
+
+namespace muda
+{
+MUDA_INLINE void ComputeGraphTopologyKey::begin_closure()
+{
+    m_words.push_back(Tag::Closure);
+    m_dirty = true;
+}
+
+MUDA_INLINE void ComputeGraphTopologyKey::add_node(ComputeGraphNodeType type, const void* kernel_func)
+{
+    m_words.push_back(Tag::Node);
+    m_words.push_back(static_cast<uint64_t>(type));
+    m_words.push_back(reinterpret_cast<uint64_t>(kernel_func));
+    m_dirty = true;
+}
+
+MUDA_INLINE void ComputeGraphTopologyKey::add_deps(span<const ComputeGraphDependency> deps)
+{
+    for(auto& dep : deps)
+        m_deps.emplace_back(dep.from.value(), dep.to.value());
+    m_dirty = true;
+}
+
+MUDA_INLINE void ComputeGraphTopologyKey::add_flags(uint64_t flags)
+{
+    m_words.push_back(Tag::Flags);
+    m_words.push_back(flags);
+    m_dirty = true;
+}
+
+MUDA_INLINE uint64_t ComputeGraphTopologyKey::hash() const
+{
+    finalize();
+    return m_hash;
+}
+
+MUDA_INLINE const std::vector<uint64_t>& ComputeGraphTopologyKey::words() const
+{
+    finalize();
+    return m_canonical;
+}
+
+MUDA_INLINE void ComputeGraphTopologyKey::finalize() const
+{
+    if(!m_dirty)
+        return;
+
+    // canonical order of the dependencies: sorted and unique
+    auto deps = m_deps;
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+
+    m_canonical = m_words;
+    m_canonical.reserve(m_words.size() + deps.size() * 3);
+    for(auto [from, to] : deps)
+    {
+        m_canonical.push_back(Tag::Dep);
+        m_canonical.push_back(from);
+        m_canonical.push_back(to);
+    }
+
+    // FNV-1a over the bytes of the words
+    uint64_t h = 14695981039346656037ull;
+    for(auto word : m_canonical)
+    {
+        for(int i = 0; i < 8; ++i)
+        {
+            h ^= (word >> (i * 8)) & 0xFF;
+            h *= 1099511628211ull;
+        }
+    }
+    m_hash  = h;
+    m_dirty = false;
+}
+}  // namespace muda
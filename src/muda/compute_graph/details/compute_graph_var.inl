@@ -11,11 +11,25 @@ MUDA_INLINE void ComputeGraphVarBase::base_update()
     {
         graph->m_need_update = true;
         for(auto& id : info.closure_ids)
-            graph->m_closure_need_update[id.value()] = true;
+        {
+            // if the var only flows into the kernel arguments of this closure,
+            // just patch the arguments instead of re-running the closure
+            if(graph->is_kernel_arg_patchable(id, var_id()))
+                graph->m_dirty_patch_vars.insert(var_id());
+            else
+                graph->m_closure_need_update[id.value()] = true;
+        }
     }
     m_is_valid = true;
 }
 
+MUDA_INLINE void ComputeGraphVarBase::bind_transient(std::byte* data)
+{
+    MUDA_ASSERT(is_transient(), "var[%s] is not transient", name().data());
+    bind_transient_value(data);
+    m_is_valid = true;
+}
+
 MUDA_INLINE void ComputeGraphVarBase::base_building_eval()
 {
     _building_eval(ComputeGraphVarUsage::ReadWrite);
@@ -173,6 +187,19 @@ MUDA_INLINE ComputeGraphVar<T>& ComputeGraphVar<T>::operator=(const RWViewer& vi
     return *this;
 }
 
+template <typename T>
+MUDA_INLINE ComputeGraphVarBytes ComputeGraphVar<T>::value_bytes() const
+{
+    return ComputeGraphVarBytes::from(m_value);
+}
+
+template <typename T>
+MUDA_INLINE void ComputeGraphVar<T>::bind_transient_value(std::byte* data)
+{
+    if constexpr(is_transient_viewer_v<T>)
+        m_value = T(reinterpret_cast<transient_element_t<T>*>(data), m_transient_count);
+}
+
 template <typename T>
 MUDA_INLINE void ComputeGraphVar<T>::graphviz_def(std::ostream& o,
                                                   const ComputeGraphGraphvizOptions& options) const
@@ -39,6 +39,24 @@ MUDA_INLINE ComputeGraphVar<T>& ComputeGraphVarManager::create_var(std::string_v
     m_vars_map.emplace(name, ptr);
     return *ptr;
 }
+template <typename T>
+MUDA_INLINE ComputeGraphVar<T>& ComputeGraphVarManager::create_transient_var(std::string_view name,
+                                                                             size_t count,
+                                                                             size_t alignment)
+{
+    static_assert(is_transient_viewer_v<T>,
+                  "a transient var must be constructible from (element*, count), e.g. BufferView<T>");
+    MUDA_ASSERT(count > 0, "var[%s]: count must be > 0", name.data());
+    MUDA_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0,
+                "var[%s]: alignment must be a power of 2",
+                name.data());
+    auto& var                 = create_var<T>(name);
+    var.m_transient_count     = count;
+    var.m_transient_bytes     = count * sizeof(transient_element_t<T>);
+    var.m_transient_alignment = std::max(alignment, alignof(transient_element_t<T>));
+    return var;
+}
+
 template <typename T>
 MUDA_INLINE ComputeGraphVar<T>* ComputeGraphVarManager::find_var(std::string_view name)
 {
@@ -2,6 +2,8 @@
 #include <string>
 namespace muda
 {
+class ComputeGraphProfile;
+
 class ComputeGraphGraphvizOptions
 {
   public:
@@ -11,6 +13,10 @@ class ComputeGraphGraphvizOptions
     bool show_all_graph_nodes_in_a_closure = false;
     int  graph_id                          = 0;
 
+    // if set, closures are labeled with the mean cost and colored from green (cheap) to red (expensive),
+    // the arcs on the critical path are highlighted
+    const ComputeGraphProfile* profile = nullptr;
+
     // styles
     std::string node_style =
         R"(shape="egg", color="#82B366", style="filled", fillcolor="#D5E8D4",)";
@@ -27,6 +33,8 @@ class ComputeGraphGraphvizOptions
 
     std::string arc_style = R"(color="#82B366", )";
 
+    std::string critical_path_arc_style = R"(color="#B85450", penwidth=3, )";
+
     std::string event_style =
         R"(shape="rectangle", color="#8E44AD", style="filled,rounded", fillcolor="#BB8FCE",)";
 
@@ -1,4 +1,10 @@
 #pragma once
+#include <array>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <muda/launch/launch_base.h>
 #include <muda/buffer.h>
 #include <muda/container.h>
@@ -7,19 +13,221 @@
 
 namespace muda
 {
+namespace details
+{
+    // the per channel arguments of a multi-channel cub algorithm, e.g. num_levels[NUM_ACTIVE_CHANNELS]
+    template <typename T>
+    struct CubTempSizeKeySpan
+    {
+        const T* data;
+        int      size;
+    };
+
+    // the max values of a CubTempSizeKey: the device, the scalar arguments and the per channel
+    // arguments (a count and at most 4 channels for cub)
+    constexpr int cub_temp_size_key_capacity = 16;
+
+    // the key of a cub problem: the current device, then the arguments the temp storage size
+    // depends on (item counts, bit ranges, histogram levels ...).
+    // the full values are kept inline and compared, the hash only picks the bucket
+    struct CubTempSizeKey
+    {
+        std::array<uint64_t, cub_temp_size_key_capacity> values{};
+        int                                              size = 0;
+
+        MUDA_HOST void push_back(uint64_t v)
+        {
+            MUDA_ASSERT(size < cub_temp_size_key_capacity,
+                        "CubTempSizeKey: more than %d values",
+                        cub_temp_size_key_capacity);
+            values[size++] = v;
+        }
+
+        bool operator==(const CubTempSizeKey& other) const MUDA_NOEXCEPT
+        {
+            return size == other.size
+                   && std::equal(values.begin(), values.begin() + size, other.values.begin());
+        }
+    };
+
+    struct CubTempSizeKeyHash
+    {
+        size_t operator()(const CubTempSizeKey& key) const MUDA_NOEXCEPT
+        {
+            uint64_t h = 0;
+            for(int i = 0; i < key.size; ++i)  // boost::hash_combine
+                h ^= key.values[i] + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    template <typename T>
+    MUDA_HOST void cub_temp_size_key_append(CubTempSizeKey& key, const T& v)
+    {
+        key.push_back(static_cast<uint64_t>(v));
+    }
+
+    template <typename T>
+    MUDA_HOST void cub_temp_size_key_append(CubTempSizeKey& key, const CubTempSizeKeySpan<T>& v)
+    {
+        key.push_back(static_cast<uint64_t>(v.size));
+        for(int i = 0; i < v.size; ++i)
+            key.push_back(static_cast<uint64_t>(v.data[i]));
+    }
+
+    template <typename... Args>
+    MUDA_HOST CubTempSizeKey cub_temp_size_key(const Args&... args)
+    {
+        int device = 0;
+        checkCudaErrors(cudaGetDevice(&device));
+        CubTempSizeKey key;
+        key.push_back(static_cast<uint64_t>(device));
+        (cub_temp_size_key_append(key, args), ...);
+        return key;
+    }
+
+    // the temp storage sizes of a cub algorithm (one instance per wrapper instantiation),
+    // so the size query is done once per problem, not once per call
+    class CubTempSizeCache
+    {
+        std::shared_mutex                                              m_mutex;
+        std::unordered_map<CubTempSizeKey, size_t, CubTempSizeKeyHash> m_sizes;
+
+      public:
+        template <typename FQuery>  // FQuery: size_t()
+        MUDA_HOST size_t get(const CubTempSizeKey& key, FQuery&& query)
+        {
+            {
+                std::shared_lock lock{m_mutex};
+                auto             it = m_sizes.find(key);
+                if(it != m_sizes.end())
+                    return it->second;
+            }
+            auto             size = query();
+            std::unique_lock lock{m_mutex};
+            m_sizes.emplace(key, size);
+            return size;
+        }
+    };
+
+    // the temp storage of the cub wrappers called without a buffer, one arena per stream.
+    // the work on a stream is ordered, so the calls on the same stream can share it.
+    // the arenas are kept until they are released (see cub_scratch_release)
+    class CubScratch
+    {
+        std::mutex                                                                 m_mutex;
+        std::unordered_map<cudaStream_t, std::unique_ptr<DeviceBuffer<std::byte>>> m_arenas;
+
+        MUDA_HOST static CubScratch& instance()
+        {
+            // never destroyed, the arenas not released are freed with the context at exit
+            static auto* scratch = new CubScratch{};
+            return *scratch;
+        }
+
+        MUDA_HOST static void free_arena(cudaStream_t stream, DeviceBuffer<std::byte>& arena)
+        {
+            if(arena.data())
+                BufferLaunch(stream).free(arena).wait();
+        }
+
+      public:
+        // a temp storage of at least `size` bytes for the work on `stream`
+        MUDA_HOST static std::byte* reserve(cudaStream_t stream, size_t size)
+        {
+            auto& scratch = instance();
+
+            DeviceBuffer<std::byte>* arena = nullptr;
+            {
+                std::lock_guard lock{scratch.m_mutex};
+                auto&           ptr = scratch.m_arenas[stream];
+                if(!ptr)
+                    ptr = std::make_unique<DeviceBuffer<std::byte>>();
+                arena = ptr.get();
+            }
+
+            if(arena->capacity() < size)
+            {
+                // grow geometrically, the content is scratch, nothing to keep
+                BufferLaunch(stream)
+                    .clear(*arena)  //
+                    .reserve(*arena, std::max(size, arena->capacity() * 2));
+            }
+            return arena->data();
+        }
+
+        // free the arena of `stream`, after waiting for the work on it
+        MUDA_HOST static void release(cudaStream_t stream)
+        {
+            auto&                                    scratch = instance();
+            std::unique_ptr<DeviceBuffer<std::byte>> arena;
+            {
+                std::lock_guard lock{scratch.m_mutex};
+                auto            it = scratch.m_arenas.find(stream);
+                if(it == scratch.m_arenas.end())
+                    return;
+                arena = std::move(it->second);
+                scratch.m_arenas.erase(it);
+            }
+            free_arena(stream, *arena);
+        }
+
+        // free the arenas of all streams
+        MUDA_HOST static void release_all()
+        {
+            auto& scratch = instance();
+            std::unordered_map<cudaStream_t, std::unique_ptr<DeviceBuffer<std::byte>>> arenas;
+            {
+                std::lock_guard lock{scratch.m_mutex};
+                arenas.swap(scratch.m_arenas);
+            }
+            for(auto& [stream, arena] : arenas)
+                free_arena(stream, *arena);
+        }
+
+        // the streams holding an arena
+        MUDA_HOST static size_t arena_count()
+        {
+            auto&           scratch = instance();
+            std::lock_guard lock{scratch.m_mutex};
+            return scratch.m_arenas.size();
+        }
+    };
+}  // namespace details
+
+// free the scratch temp storage of the cub calls without a buffer on `stream`, e.g. before
+// destroying the stream. It is allocated again by the next such call on the stream.
+MUDA_INLINE MUDA_HOST void cub_scratch_release(cudaStream_t stream)
+{
+    details::CubScratch::release(stream);
+}
+
+// free the scratch temp storage of all streams
+MUDA_INLINE MUDA_HOST void cub_scratch_release_all()
+{
+    details::CubScratch::release_all();
+}
+
 template <typename Derive>
 class CubWrapper : public LaunchBase<Derive>
 {
   protected:
+    // the buffer only grows (geometrically), so a smaller request costs nothing
     void prepare_buffer(DeviceVector<std::byte>& buf, size_t reqSize)
     {
         // details::set_stream_check(buf, this->stream());
-        buf.resize(reqSize);
+        if(buf.size() < reqSize)
+            buf.resize(std::max(reqSize, buf.size() * 2));
     }
 
     void prepare_buffer(DeviceBuffer<std::byte>& buf, size_t reqSize)
     {
-        BufferLaunch(m_stream).resize(buf, reqSize);
+        if(buf.size() < reqSize)
+        {
+            BufferLaunch(m_stream)
+                .clear(buf)  //
+                .resize(buf, std::max(reqSize, buf.size() * 2));
+        }
     }
 
   public:
@@ -1,12 +1,26 @@
 // don't place #pragma once at the beginning of this file
 // because it should be inserted in multiple files
 
-#define MUDA_CUB_WRAPPER_IMPL(x)                                               \
+// size_key: details::cub_temp_size_key(...) of the arguments the temp storage size depends on,
+// the size query is cached per (wrapper instantiation, size_key)
+#define MUDA_CUB_WRAPPER_QUERY_TEMP_SIZE(x, size_key)                          \
     cudaStream_t _stream            = this->stream();                          \
     size_t       temp_storage_bytes = 0;                                       \
     void*        d_temp_storage     = nullptr;                                 \
                                                                                \
-    checkCudaErrors(x);                                                        \
+    static details::CubTempSizeCache _temp_size_cache;                         \
+    temp_storage_bytes = _temp_size_cache.get(size_key,                        \
+                                              [&]                              \
+                                              {                                \
+                                                  size_t temp_storage_bytes = 0; \
+                                                  checkCudaErrors(x);          \
+                                                  return temp_storage_bytes;   \
+                                              });                              \
+    /* a null temp storage means a query to cub */                             \
+    temp_storage_bytes = std::max<size_t>(temp_storage_bytes, 1);
+
+#define MUDA_CUB_WRAPPER_IMPL(x, size_key)                                     \
+    MUDA_CUB_WRAPPER_QUERY_TEMP_SIZE(x, size_key)                              \
                                                                                \
     prepare_buffer(external_buffer, temp_storage_bytes);                       \
     d_temp_storage = (void*)external_buffer.data();                            \
@@ -15,6 +29,16 @@
                                                                                \
     return *this;
 
+// no user buffer, the temp storage is the scratch arena of the stream
+#define MUDA_CUB_WRAPPER_SCRATCH_IMPL(x, size_key)                             \
+    MUDA_CUB_WRAPPER_QUERY_TEMP_SIZE(x, size_key)                              \
+                                                                               \
+    d_temp_storage = (void*)details::CubScratch::reserve(_stream, temp_storage_bytes); \
+                                                                               \
+    checkCudaErrors(x);                                                        \
+                                                                               \
+    return *this;
+
 #define MUDA_CUB_WRAPPER_FOR_COMPUTE_GRAPH_IMPL(x)                                                        \
     std::string_view name{__func__};                                                                      \
     ComputeGraphBuilder::invoke_phase_actions(                                                            \
@@ -32,4 +56,4 @@
             ComputeGraphBuilder::capture(                                                                 \
                 name, [&](cudaStream_t _stream) { checkCudaErrors(x); });                                 \
         });                                                                                               \
-    return *this;
\ No newline at end of file
+    return *this;
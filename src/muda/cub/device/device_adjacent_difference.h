@@ -33,7 +33,8 @@ class DeviceAdjacentDifference : public CubWrapper<DeviceAdjacentDifference>
                                                bool debug_synchronous = false)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceAdjacentDifference::SubtractLeftCopy(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename RandomAccessIteratorT, typename DifferenceOpT = cub::Difference>
@@ -44,7 +45,8 @@ class DeviceAdjacentDifference : public CubWrapper<DeviceAdjacentDifference>
                                            bool debug_synchronous      = false)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceAdjacentDifference::SubtractLeft(
-            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous));
+            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename DifferenceOpT = cub::Difference>
@@ -56,7 +58,8 @@ class DeviceAdjacentDifference : public CubWrapper<DeviceAdjacentDifference>
                                                 bool debug_synchronous = false)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceAdjacentDifference::SubtractRightCopy(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename RandomAccessIteratorT, typename DifferenceOpT = cub::Difference>
@@ -67,7 +70,8 @@ class DeviceAdjacentDifference : public CubWrapper<DeviceAdjacentDifference>
                                             bool debug_synchronous      = false)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceAdjacentDifference::SubtractRight(
-            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous));
+            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
     }
 
     // DeviceBuffer:
@@ -82,7 +86,8 @@ class DeviceAdjacentDifference : public CubWrapper<DeviceAdjacentDifference>
                                                bool debug_synchronous = false)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceAdjacentDifference::SubtractLeftCopy(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename RandomAccessIteratorT, typename DifferenceOpT = cub::Difference>
@@ -93,7 +98,8 @@ class DeviceAdjacentDifference : public CubWrapper<DeviceAdjacentDifference>
                                            bool debug_synchronous      = false)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceAdjacentDifference::SubtractLeft(
-            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous));
+            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename DifferenceOpT = cub::Difference>
@@ -105,7 +111,8 @@ class DeviceAdjacentDifference : public CubWrapper<DeviceAdjacentDifference>
                                                 bool debug_synchronous = false)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceAdjacentDifference::SubtractRightCopy(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename RandomAccessIteratorT, typename DifferenceOpT = cub::Difference>
@@ -116,7 +123,57 @@ class DeviceAdjacentDifference : public CubWrapper<DeviceAdjacentDifference>
                                             bool debug_synchronous      = false)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceAdjacentDifference::SubtractRight(
-            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous));
+            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
+    }
+
+    // Scratch:
+
+    
+    template <typename InputIteratorT, typename OutputIteratorT, typename DifferenceOpT = cub::Difference>
+    DeviceAdjacentDifference& SubtractLeftCopy(InputIteratorT  d_in,
+                                               OutputIteratorT d_out,
+                                               int             num_items,
+                                               DifferenceOpT   difference_op = {},
+                                               bool            debug_synchronous = false)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceAdjacentDifference::SubtractLeftCopy(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename RandomAccessIteratorT, typename DifferenceOpT = cub::Difference>
+    DeviceAdjacentDifference& SubtractLeft(RandomAccessIteratorT d_in,
+                                           int                   num_items,
+                                           DifferenceOpT         difference_op = {},
+                                           bool                  debug_synchronous = false)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceAdjacentDifference::SubtractLeft(
+            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename InputIteratorT, typename OutputIteratorT, typename DifferenceOpT = cub::Difference>
+    DeviceAdjacentDifference& SubtractRightCopy(InputIteratorT  d_in,
+                                                OutputIteratorT d_out,
+                                                int             num_items,
+                                                DifferenceOpT   difference_op = {},
+                                                bool            debug_synchronous = false)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceAdjacentDifference::SubtractRightCopy(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename RandomAccessIteratorT, typename DifferenceOpT = cub::Difference>
+    DeviceAdjacentDifference& SubtractRight(RandomAccessIteratorT d_in,
+                                            int                   num_items,
+                                            DifferenceOpT         difference_op = {},
+                                            bool                  debug_synchronous = false)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceAdjacentDifference::SubtractRight(
+            d_temp_storage, temp_storage_bytes, d_in, num_items, difference_op, _stream, debug_synchronous),
+            details::cub_temp_size_key(num_items));
     }
 
     // Origin:
@@ -38,7 +38,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                                   upper_level,
                                                                   num_samples,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_levels, num_samples));
     }
 
     // HistogramEven (single channel, 2D input)
@@ -64,7 +65,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                                   num_rows,
                                                                   row_stride_bytes,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_levels, num_row_samples, num_rows));
     }
 
     // MultiHistogramEven (multiple channels, 1D input)
@@ -86,7 +88,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                                        upper_level,
                                                                        num_pixels,
                                                                        _stream,
-                                                                       false));
+                                                                       false),
+                              details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_pixels));
     }
 
     // MultiHistogramEven (multiple channels, 2D input)
@@ -113,7 +116,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                      num_rows,
                                                      row_stride_bytes,
                                                      _stream,
-                                                     false));
+                                                     false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_row_pixels, num_rows));
     }
 
     // HistogramRange (single channel, 1D input)
@@ -126,7 +130,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                     OffsetT                  num_samples)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceHistogram::HistogramRange(
-            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_samples, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_samples, _stream, false),
+            details::cub_temp_size_key(num_levels, num_samples));
     }
 
     // HistogramRange (single channel, 2D input)
@@ -150,7 +155,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                                    num_rows,
                                                                    row_stride_bytes,
                                                                    _stream,
-                                                                   false));
+                                                                   false),
+                              details::cub_temp_size_key(num_levels, num_row_samples, num_rows));
     }
 
     // MultiHistogramRange (multiple channels, 1D input)
@@ -163,7 +169,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                          OffsetT num_pixels)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceHistogram::MultiHistogramRange(
-            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_pixels, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_pixels, _stream, false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_pixels));
     }
 
     // MultiHistogramRange (multiple channels, 2D input)
@@ -188,7 +195,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                       num_rows,
                                                       row_stride_bytes,
                                                       _stream,
-                                                      false));
+                                                      false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_row_pixels, num_rows));
     }
 
     // DeviceBuffer:
@@ -212,7 +220,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                                   upper_level,
                                                                   num_samples,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_levels, num_samples));
     }
 
     // HistogramEven (single channel, 2D input)
@@ -238,7 +247,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                                   num_rows,
                                                                   row_stride_bytes,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_levels, num_row_samples, num_rows));
     }
 
     // MultiHistogramEven (multiple channels, 1D input)
@@ -260,7 +270,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                                        upper_level,
                                                                        num_pixels,
                                                                        _stream,
-                                                                       false));
+                                                                       false),
+                              details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_pixels));
     }
 
     // MultiHistogramEven (multiple channels, 2D input)
@@ -287,7 +298,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                      num_rows,
                                                      row_stride_bytes,
                                                      _stream,
-                                                     false));
+                                                     false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_row_pixels, num_rows));
     }
 
     // HistogramRange (single channel, 1D input)
@@ -300,7 +312,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                     OffsetT                  num_samples)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceHistogram::HistogramRange(
-            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_samples, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_samples, _stream, false),
+            details::cub_temp_size_key(num_levels, num_samples));
     }
 
     // HistogramRange (single channel, 2D input)
@@ -324,7 +337,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                                    num_rows,
                                                                    row_stride_bytes,
                                                                    _stream,
-                                                                   false));
+                                                                   false),
+                              details::cub_temp_size_key(num_levels, num_row_samples, num_rows));
     }
 
     // MultiHistogramRange (multiple channels, 1D input)
@@ -337,7 +351,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                          OffsetT num_pixels)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceHistogram::MultiHistogramRange(
-            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_pixels, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_pixels, _stream, false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_pixels));
     }
 
     // MultiHistogramRange (multiple channels, 2D input)
@@ -362,7 +377,182 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                                       num_rows,
                                                       row_stride_bytes,
                                                       _stream,
-                                                      false));
+                                                      false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_row_pixels, num_rows));
+    }
+
+    // Scratch:
+
+    // HistogramEven (single channel, 1D input)
+    template <typename SampleIteratorT, typename CounterT, typename LevelT, typename OffsetT>
+    DeviceHistogram& HistogramEven(SampleIteratorT d_samples,
+                                   CounterT*       d_histogram,
+                                   int             num_levels,
+                                   LevelT          lower_level,
+                                   LevelT          upper_level,
+                                   OffsetT         num_samples)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceHistogram::HistogramEven(d_temp_storage,
+                                                                          temp_storage_bytes,
+                                                                          d_samples,
+                                                                          d_histogram,
+                                                                          num_levels,
+                                                                          lower_level,
+                                                                          upper_level,
+                                                                          num_samples,
+                                                                          _stream,
+                                                                          false),
+                                      details::cub_temp_size_key(num_levels, num_samples));
+    }
+
+    // HistogramEven (single channel, 2D input)
+    template <typename SampleIteratorT, typename CounterT, typename LevelT, typename OffsetT>
+    DeviceHistogram& HistogramEven(SampleIteratorT d_samples,
+                                   CounterT*       d_histogram,
+                                   int             num_levels,
+                                   LevelT          lower_level,
+                                   LevelT          upper_level,
+                                   OffsetT         num_row_samples,
+                                   OffsetT         num_rows,
+                                   size_t          row_stride_bytes)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceHistogram::HistogramEven(d_temp_storage,
+                                                                          temp_storage_bytes,
+                                                                          d_samples,
+                                                                          d_histogram,
+                                                                          num_levels,
+                                                                          lower_level,
+                                                                          upper_level,
+                                                                          num_row_samples,
+                                                                          num_rows,
+                                                                          row_stride_bytes,
+                                                                          _stream,
+                                                                          false),
+                                      details::cub_temp_size_key(num_levels, num_row_samples, num_rows));
+    }
+
+    // MultiHistogramEven (multiple channels, 1D input)
+    template <int NUM_CHANNELS, int NUM_ACTIVE_CHANNELS, typename SampleIteratorT, typename CounterT, typename LevelT, typename OffsetT>
+    DeviceHistogram& MultiHistogramEven(SampleIteratorT d_samples,
+                                        CounterT*       d_histogram[NUM_ACTIVE_CHANNELS],
+                                        int             num_levels[NUM_ACTIVE_CHANNELS],
+                                        LevelT          lower_level[NUM_ACTIVE_CHANNELS],
+                                        LevelT          upper_level[NUM_ACTIVE_CHANNELS],
+                                        OffsetT         num_pixels)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceHistogram::MultiHistogramEven(d_temp_storage,
+                                                                               temp_storage_bytes,
+                                                                               d_samples,
+                                                                               d_histogram,
+                                                                               num_levels,
+                                                                               lower_level,
+                                                                               upper_level,
+                                                                               num_pixels,
+                                                                               _stream,
+                                                                               false),
+                                      details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_pixels));
+    }
+
+    // MultiHistogramEven (multiple channels, 2D input)
+    template <int NUM_CHANNELS, int NUM_ACTIVE_CHANNELS, typename SampleIteratorT, typename CounterT, typename LevelT, typename OffsetT>
+    DeviceHistogram& MultiHistogramEven(SampleIteratorT d_samples,
+                                        CounterT*       d_histogram[NUM_ACTIVE_CHANNELS],
+                                        int             num_levels[NUM_ACTIVE_CHANNELS],
+                                        LevelT          lower_level[NUM_ACTIVE_CHANNELS],
+                                        LevelT          upper_level[NUM_ACTIVE_CHANNELS],
+                                        OffsetT         num_row_pixels,
+                                        OffsetT         num_rows,
+                                        size_t          row_stride_bytes)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(
+            cub::DeviceHistogram::MultiHistogramEven(d_temp_storage,
+                                                     temp_storage_bytes,
+                                                     d_samples,
+                                                     d_histogram,
+                                                     num_levels,
+                                                     lower_level,
+                                                     upper_level,
+                                                     num_row_pixels,
+                                                     num_rows,
+                                                     row_stride_bytes,
+                                                     _stream,
+                                                     false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_row_pixels, num_rows));
+    }
+
+    // HistogramRange (single channel, 1D input)
+    template <typename SampleIteratorT, typename CounterT, typename LevelT, typename OffsetT>
+    DeviceHistogram& HistogramRange(SampleIteratorT d_samples,
+                                    CounterT*       d_histogram,
+                                    int             num_levels,
+                                    LevelT*         d_levels,
+                                    OffsetT         num_samples)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceHistogram::HistogramRange(
+            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_samples, _stream, false),
+            details::cub_temp_size_key(num_levels, num_samples));
+    }
+
+    // HistogramRange (single channel, 2D input)
+    template <typename SampleIteratorT, typename CounterT, typename LevelT, typename OffsetT>
+    DeviceHistogram& HistogramRange(SampleIteratorT d_samples,
+                                    CounterT*       d_histogram,
+                                    int             num_levels,
+                                    LevelT*         d_levels,
+                                    OffsetT         num_row_samples,
+                                    OffsetT         num_rows,
+                                    size_t          row_stride_bytes)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceHistogram::HistogramRange(d_temp_storage,
+                                                                           temp_storage_bytes,
+                                                                           d_samples,
+                                                                           d_histogram,
+                                                                           num_levels,
+                                                                           d_levels,
+                                                                           num_row_samples,
+                                                                           num_rows,
+                                                                           row_stride_bytes,
+                                                                           _stream,
+                                                                           false),
+                                      details::cub_temp_size_key(num_levels, num_row_samples, num_rows));
+    }
+
+    // MultiHistogramRange (multiple channels, 1D input)
+    template <int NUM_CHANNELS, int NUM_ACTIVE_CHANNELS, typename SampleIteratorT, typename CounterT, typename LevelT, typename OffsetT>
+    DeviceHistogram& MultiHistogramRange(SampleIteratorT d_samples,
+                                         CounterT*       d_histogram[NUM_ACTIVE_CHANNELS],
+                                         int             num_levels[NUM_ACTIVE_CHANNELS],
+                                         LevelT*         d_levels[NUM_ACTIVE_CHANNELS],
+                                         OffsetT         num_pixels)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceHistogram::MultiHistogramRange(
+            d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_pixels, _stream, false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_pixels));
+    }
+
+    // MultiHistogramRange (multiple channels, 2D input)
+    template <int NUM_CHANNELS, int NUM_ACTIVE_CHANNELS, typename SampleIteratorT, typename CounterT, typename LevelT, typename OffsetT>
+    DeviceHistogram& MultiHistogramRange(SampleIteratorT d_samples,
+                                         CounterT*       d_histogram[NUM_ACTIVE_CHANNELS],
+                                         int             num_levels[NUM_ACTIVE_CHANNELS],
+                                         LevelT*         d_levels[NUM_ACTIVE_CHANNELS],
+                                         OffsetT         num_row_pixels,
+                                         OffsetT         num_rows,
+                                         size_t          row_stride_bytes)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(
+            cub::DeviceHistogram::MultiHistogramRange(d_temp_storage,
+                                                      temp_storage_bytes,
+                                                      d_samples,
+                                                      d_histogram,
+                                                      num_levels,
+                                                      d_levels,
+                                                      num_row_pixels,
+                                                      num_rows,
+                                                      row_stride_bytes,
+                                                      _stream,
+                                                      false),
+            details::cub_temp_size_key(details::CubTempSizeKeySpan<int>{num_levels, NUM_ACTIVE_CHANNELS}, num_row_pixels, num_rows));
     }
 
     // Origin:
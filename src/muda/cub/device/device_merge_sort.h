@@ -26,7 +26,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                CompareOpT               compare_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::SortPairs(
-            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyInputIteratorT, typename ValueInputIteratorT, typename KeyIteratorT, typename ValueIteratorT, typename OffsetT, typename CompareOpT>
@@ -47,7 +48,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                                                   num_items,
                                                                   compare_op,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyIteratorT, typename OffsetT, typename CompareOpT>
@@ -57,7 +59,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                               CompareOpT               compare_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::SortKeys(
-            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyInputIteratorT, typename KeyIteratorT, typename OffsetT, typename CompareOpT>
@@ -74,7 +77,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                                                  num_items,
                                                                  compare_op,
                                                                  _stream,
-                                                                 false));
+                                                                 false),
+                              details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyIteratorT, typename ValueIteratorT, typename OffsetT, typename CompareOpT>
@@ -85,7 +89,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                      CompareOpT               compare_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::StableSortPairs(
-            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyIteratorT, typename OffsetT, typename CompareOpT>
@@ -95,7 +100,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                     CompareOpT               compare_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::StableSortKeys(
-            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     // DeviceBuffer:
@@ -108,7 +114,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                CompareOpT               compare_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::SortPairs(
-            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyInputIteratorT, typename ValueInputIteratorT, typename KeyIteratorT, typename ValueIteratorT, typename OffsetT, typename CompareOpT>
@@ -129,7 +136,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                                                   num_items,
                                                                   compare_op,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyIteratorT, typename OffsetT, typename CompareOpT>
@@ -139,7 +147,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                               CompareOpT               compare_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::SortKeys(
-            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyInputIteratorT, typename KeyIteratorT, typename OffsetT, typename CompareOpT>
@@ -156,7 +165,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                                                  num_items,
                                                                  compare_op,
                                                                  _stream,
-                                                                 false));
+                                                                 false),
+                              details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyIteratorT, typename ValueIteratorT, typename OffsetT, typename CompareOpT>
@@ -167,7 +177,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                      CompareOpT               compare_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::StableSortPairs(
-            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeyIteratorT, typename OffsetT, typename CompareOpT>
@@ -177,7 +188,90 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                     CompareOpT               compare_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::StableSortKeys(
-            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    // Scratch:
+
+    template <typename KeyIteratorT, typename ValueIteratorT, typename OffsetT, typename CompareOpT>
+    DeviceMergeSort& SortPairs(KeyIteratorT   d_keys,
+                               ValueIteratorT d_items,
+                               OffsetT        num_items,
+                               CompareOpT     compare_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceMergeSort::SortPairs(
+            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeyInputIteratorT, typename ValueInputIteratorT, typename KeyIteratorT, typename ValueIteratorT, typename OffsetT, typename CompareOpT>
+    DeviceMergeSort& SortPairsCopy(KeyInputIteratorT   d_input_keys,
+                                   ValueInputIteratorT d_input_items,
+                                   KeyIteratorT        d_output_keys,
+                                   ValueIteratorT      d_output_items,
+                                   OffsetT             num_items,
+                                   CompareOpT          compare_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceMergeSort::SortPairsCopy(d_temp_storage,
+                                                                          temp_storage_bytes,
+                                                                          d_input_keys,
+                                                                          d_input_items,
+                                                                          d_output_keys,
+                                                                          d_output_items,
+                                                                          num_items,
+                                                                          compare_op,
+                                                                          _stream,
+                                                                          false),
+                                      details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeyIteratorT, typename OffsetT, typename CompareOpT>
+    DeviceMergeSort& SortKeys(KeyIteratorT d_keys,
+                              OffsetT      num_items,
+                              CompareOpT   compare_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceMergeSort::SortKeys(
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeyInputIteratorT, typename KeyIteratorT, typename OffsetT, typename CompareOpT>
+    DeviceMergeSort& SortKeysCopy(KeyInputIteratorT d_input_keys,
+                                  KeyIteratorT      d_output_keys,
+                                  OffsetT           num_items,
+                                  CompareOpT        compare_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceMergeSort::SortKeysCopy(d_temp_storage,
+                                                                         temp_storage_bytes,
+                                                                         d_input_keys,
+                                                                         d_output_keys,
+                                                                         num_items,
+                                                                         compare_op,
+                                                                         _stream,
+                                                                         false),
+                                      details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeyIteratorT, typename ValueIteratorT, typename OffsetT, typename CompareOpT>
+    DeviceMergeSort& StableSortPairs(KeyIteratorT   d_keys,
+                                     ValueIteratorT d_items,
+                                     OffsetT        num_items,
+                                     CompareOpT     compare_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceMergeSort::StableSortPairs(
+            d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeyIteratorT, typename OffsetT, typename CompareOpT>
+    DeviceMergeSort& StableSortKeys(KeyIteratorT d_keys,
+                                    OffsetT      num_items,
+                                    CompareOpT   compare_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceMergeSort::StableSortKeys(
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     // Origin:
@@ -27,7 +27,8 @@ class DevicePartition : public CubWrapper<DevicePartition>
                              int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DevicePartition::Flagged(
-            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT, typename SelectOp>
@@ -39,7 +40,8 @@ class DevicePartition : public CubWrapper<DevicePartition>
                         SelectOp                 select_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DevicePartition::If(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename FirstOutputIteratorT, typename SecondOutputIteratorT, typename UnselectedOutputIteratorT, typename NumSelectedIteratorT, typename SelectFirstPartOp, typename SelectSecondPartOp>
@@ -64,7 +66,8 @@ class DevicePartition : public CubWrapper<DevicePartition>
                                                        select_first_part_op,
                                                        select_second_part_op,
                                                        _stream,
-                                                       false));
+                                                       false),
+                              details::cub_temp_size_key(num_items));
     }
 
     // DeviceBuffer:
@@ -78,7 +81,8 @@ class DevicePartition : public CubWrapper<DevicePartition>
                              int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DevicePartition::Flagged(
-            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT, typename SelectOp>
@@ -90,7 +94,8 @@ class DevicePartition : public CubWrapper<DevicePartition>
                         SelectOp                 select_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DevicePartition::If(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename FirstOutputIteratorT, typename SecondOutputIteratorT, typename UnselectedOutputIteratorT, typename NumSelectedIteratorT, typename SelectFirstPartOp, typename SelectSecondPartOp>
@@ -115,7 +120,59 @@ class DevicePartition : public CubWrapper<DevicePartition>
                                                        select_first_part_op,
                                                        select_second_part_op,
                                                        _stream,
-                                                       false));
+                                                       false),
+                              details::cub_temp_size_key(num_items));
+    }
+
+    // Scratch:
+
+    template <typename InputIteratorT, typename FlagIterator, typename OutputIteratorT, typename NumSelectedIteratorT>
+    DevicePartition& Flagged(InputIteratorT       d_in,
+                             FlagIterator         d_flags,
+                             OutputIteratorT      d_out,
+                             NumSelectedIteratorT d_num_selected_out,
+                             int                  num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DevicePartition::Flagged(
+            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT, typename SelectOp>
+    DevicePartition& If(InputIteratorT       d_in,
+                        OutputIteratorT      d_out,
+                        NumSelectedIteratorT d_num_selected_out,
+                        int                  num_items,
+                        SelectOp             select_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DevicePartition::If(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename InputIteratorT, typename FirstOutputIteratorT, typename SecondOutputIteratorT, typename UnselectedOutputIteratorT, typename NumSelectedIteratorT, typename SelectFirstPartOp, typename SelectSecondPartOp>
+    DevicePartition& If(InputIteratorT            d_in,
+                        FirstOutputIteratorT      d_first_part_out,
+                        SecondOutputIteratorT     d_second_part_out,
+                        UnselectedOutputIteratorT d_unselected_out,
+                        NumSelectedIteratorT      d_num_selected_out,
+                        int                       num_items,
+                        SelectFirstPartOp         select_first_part_op,
+                        SelectSecondPartOp        select_second_part_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DevicePartition::If(d_temp_storage,
+                                                               temp_storage_bytes,
+                                                               d_in,
+                                                               d_first_part_out,
+                                                               d_second_part_out,
+                                                               d_unselected_out,
+                                                               d_num_selected_out,
+                                                               num_items,
+                                                               select_first_part_op,
+                                                               select_second_part_op,
+                                                               _stream,
+                                                               false),
+                                      details::cub_temp_size_key(num_items));
     }
 
     // Origin:
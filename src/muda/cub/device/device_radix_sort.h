@@ -43,7 +43,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                                               num_items,
                                                               begin_bit,
                                                               end_bit,
-                                                              _stream));
+                                                              _stream),
+                              details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename ValueT, typename NumItemsT>
@@ -55,7 +56,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairs(
-            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename ValueT, typename NumItemsT>
@@ -69,7 +71,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                          int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairsDescending(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, d_values_in, d_values_out, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, d_values_in, d_values_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename ValueT, typename NumItemsT>
@@ -81,7 +84,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                          int end_bit   = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairsDescending(
-            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename NumItemsT>
@@ -93,7 +97,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                               int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeys(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename NumItemsT>
@@ -104,7 +109,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                               int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeys(
-            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename NumItemsT>
@@ -116,7 +122,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                         int         end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeysDescending(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename NumItemsT>
@@ -127,7 +134,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                         int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeysDescending(
-            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     // DeviceBuffer:
@@ -151,7 +159,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                                               num_items,
                                                               begin_bit,
                                                               end_bit,
-                                                              _stream));
+                                                              _stream),
+                              details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename ValueT, typename NumItemsT>
@@ -163,7 +172,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairs(
-            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename ValueT, typename NumItemsT>
@@ -177,7 +187,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                          int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairsDescending(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, d_values_in, d_values_out, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, d_values_in, d_values_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename ValueT, typename NumItemsT>
@@ -189,7 +200,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                          int end_bit   = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairsDescending(
-            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename NumItemsT>
@@ -201,7 +213,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                               int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeys(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename NumItemsT>
@@ -212,7 +225,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                               int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeys(
-            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename NumItemsT>
@@ -224,7 +238,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                         int         end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeysDescending(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     template <typename KeyT, typename NumItemsT>
@@ -235,7 +250,116 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                         int end_bit = sizeof(KeyT) * 8)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeysDescending(
-            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream));
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
+    }
+
+    // Scratch:
+
+    template <typename KeyT, typename ValueT, typename NumItemsT>
+    DeviceRadixSort& SortPairs(const KeyT*   d_keys_in,
+                               KeyT*         d_keys_out,
+                               const ValueT* d_values_in,
+                               ValueT*       d_values_out,
+                               NumItemsT     num_items,
+                               int           begin_bit = 0,
+                               int           end_bit = sizeof(KeyT) * 8)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRadixSort::SortPairs(d_temp_storage,
+                                                                      temp_storage_bytes,
+                                                                      d_keys_in,
+                                                                      d_keys_out,
+                                                                      d_values_in,
+                                                                      d_values_out,
+                                                                      num_items,
+                                                                      begin_bit,
+                                                                      end_bit,
+                                                                      _stream),
+                                      details::cub_temp_size_key(num_items, begin_bit, end_bit));
+    }
+
+    template <typename KeyT, typename ValueT, typename NumItemsT>
+    DeviceRadixSort& SortPairs(cub::DoubleBuffer<KeyT>&   d_keys,
+                               cub::DoubleBuffer<ValueT>& d_values,
+                               NumItemsT                  num_items,
+                               int                        begin_bit = 0,
+                               int                        end_bit = sizeof(KeyT) * 8)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRadixSort::SortPairs(
+            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
+    }
+
+    template <typename KeyT, typename ValueT, typename NumItemsT>
+    DeviceRadixSort& SortPairsDescending(const KeyT*   d_keys_in,
+                                         KeyT*         d_keys_out,
+                                         const ValueT* d_values_in,
+                                         ValueT*       d_values_out,
+                                         NumItemsT     num_items,
+                                         int           begin_bit = 0,
+                                         int           end_bit = sizeof(KeyT) * 8)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRadixSort::SortPairsDescending(
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, d_values_in, d_values_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
+    }
+
+    template <typename KeyT, typename ValueT, typename NumItemsT>
+    DeviceRadixSort& SortPairsDescending(cub::DoubleBuffer<KeyT>&   d_keys,
+                                         cub::DoubleBuffer<ValueT>& d_values,
+                                         NumItemsT                  num_items,
+                                         int                        begin_bit = 0,
+                                         int                        end_bit = sizeof(KeyT) * 8)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRadixSort::SortPairsDescending(
+            d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
+    }
+
+    template <typename KeyT, typename NumItemsT>
+    DeviceRadixSort& SortKeys(const KeyT* d_keys_in,
+                              KeyT*       d_keys_out,
+                              NumItemsT   num_items,
+                              int         begin_bit = 0,
+                              int         end_bit = sizeof(KeyT) * 8)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRadixSort::SortKeys(
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
+    }
+
+    template <typename KeyT, typename NumItemsT>
+    DeviceRadixSort& SortKeys(cub::DoubleBuffer<KeyT>& d_keys,
+                              NumItemsT                num_items,
+                              int                      begin_bit = 0,
+                              int                      end_bit = sizeof(KeyT) * 8)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRadixSort::SortKeys(
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
+    }
+
+    template <typename KeyT, typename NumItemsT>
+    DeviceRadixSort& SortKeysDescending(const KeyT* d_keys_in,
+                                        KeyT*       d_keys_out,
+                                        NumItemsT   num_items,
+                                        int         begin_bit = 0,
+                                        int         end_bit = sizeof(KeyT) * 8)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRadixSort::SortKeysDescending(
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
+    }
+
+    template <typename KeyT, typename NumItemsT>
+    DeviceRadixSort& SortKeysDescending(cub::DoubleBuffer<KeyT>& d_keys,
+                                        NumItemsT                num_items,
+                                        int                      begin_bit = 0,
+                                        int                      end_bit = sizeof(KeyT) * 8)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRadixSort::SortKeysDescending(
+            d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream),
+            details::cub_temp_size_key(num_items, begin_bit, end_bit));
     }
 
     // Origin:
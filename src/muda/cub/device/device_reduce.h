@@ -27,7 +27,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                          T                        init)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Reduce(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, reduction_op, init, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, reduction_op, init, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT>
@@ -37,7 +38,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                       int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Sum(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -48,7 +50,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                       int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Min(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -59,7 +62,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                          int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::ArgMin(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -71,7 +75,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
     {
 
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Max(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -82,7 +87,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                          int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::ArgMax(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename UniqueOutputIteratorT, typename ValuesInputIteratorT, typename AggregatesOutputIteratorT, typename NumRunsOutputIteratorT, typename ReductionOpT>
@@ -103,7 +109,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                                                              d_aggregates_out,
                                                              d_num_runs_out,
                                                              reduction_op,
-                                                             num_items));
+                                                             num_items),
+                              details::cub_temp_size_key(num_items));
     }
 
     // DeviceBuffer:
@@ -117,7 +124,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                          T                        init)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Reduce(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, reduction_op, init, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, reduction_op, init, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT>
@@ -127,7 +135,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                       int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Sum(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -138,7 +147,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                       int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Min(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -149,7 +159,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                          int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::ArgMin(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -161,7 +172,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
     {
 
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Max(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -172,7 +184,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                          int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::ArgMax(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename UniqueOutputIteratorT, typename ValuesInputIteratorT, typename AggregatesOutputIteratorT, typename NumRunsOutputIteratorT, typename ReductionOpT>
@@ -193,7 +206,98 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                                                              d_aggregates_out,
                                                              d_num_runs_out,
                                                              reduction_op,
-                                                             num_items));
+                                                             num_items),
+                              details::cub_temp_size_key(num_items));
+    }
+
+    // Scratch:
+
+    template <typename InputIteratorT, typename OutputIteratorT, typename ReductionOpT, typename T>
+    DeviceReduce& Reduce(InputIteratorT  d_in,
+                         OutputIteratorT d_out,
+                         int             num_items,
+                         ReductionOpT    reduction_op,
+                         T               init)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceReduce::Reduce(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, reduction_op, init, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename InputIteratorT, typename OutputIteratorT>
+    DeviceReduce& Sum(InputIteratorT  d_in,
+                      OutputIteratorT d_out,
+                      int             num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceReduce::Sum(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+
+    template <typename InputIteratorT, typename OutputIteratorT>
+    DeviceReduce& Min(InputIteratorT  d_in,
+                      OutputIteratorT d_out,
+                      int             num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceReduce::Min(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+
+    template <typename InputIteratorT, typename OutputIteratorT>
+    DeviceReduce& ArgMin(InputIteratorT  d_in,
+                         OutputIteratorT d_out,
+                         int             num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceReduce::ArgMin(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+
+    template <typename InputIteratorT, typename OutputIteratorT>
+    DeviceReduce& Max(InputIteratorT  d_in,
+                      OutputIteratorT d_out,
+                      int             num_items)
+    {
+
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceReduce::Max(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+
+    template <typename InputIteratorT, typename OutputIteratorT>
+    DeviceReduce& ArgMax(InputIteratorT  d_in,
+                         OutputIteratorT d_out,
+                         int             num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceReduce::ArgMax(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeysInputIteratorT, typename UniqueOutputIteratorT, typename ValuesInputIteratorT, typename AggregatesOutputIteratorT, typename NumRunsOutputIteratorT, typename ReductionOpT>
+    DeviceReduce& ReduceByKey(KeysInputIteratorT        d_keys_in,
+                              UniqueOutputIteratorT     d_unique_out,
+                              ValuesInputIteratorT      d_values_in,
+                              AggregatesOutputIteratorT d_aggregates_out,
+                              NumRunsOutputIteratorT    d_num_runs_out,
+                              ReductionOpT              reduction_op,
+                              int                       num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceReduce::ReduceByKey(d_temp_storage,
+                                                                     temp_storage_bytes,
+                                                                     d_keys_in,
+                                                                     d_unique_out,
+                                                                     d_values_in,
+                                                                     d_aggregates_out,
+                                                                     d_num_runs_out,
+                                                                     reduction_op,
+                                                                     num_items),
+                                      details::cub_temp_size_key(num_items));
     }
 
     // Origin:
@@ -27,7 +27,8 @@ class DeviceRunLengthEncode : public CubWrapper<DeviceRunLengthEncode>
                                   int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRunLengthEncode::Encode(
-            d_temp_storage, temp_storage_bytes, d_in, d_unique_out, d_counts_out, d_num_runs_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_unique_out, d_counts_out, d_num_runs_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OffsetsOutputIteratorT, typename LengthsOutputIteratorT, typename NumRunsOutputIteratorT>
@@ -39,7 +40,8 @@ class DeviceRunLengthEncode : public CubWrapper<DeviceRunLengthEncode>
                                           int                    num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRunLengthEncode::NonTrivialRuns(
-            d_temp_storage, temp_storage_bytes, d_in, d_offsets_out, d_lengths_out, d_num_runs_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_offsets_out, d_lengths_out, d_num_runs_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     // DeviceBuffer:
@@ -53,7 +55,8 @@ class DeviceRunLengthEncode : public CubWrapper<DeviceRunLengthEncode>
                                   int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRunLengthEncode::Encode(
-            d_temp_storage, temp_storage_bytes, d_in, d_unique_out, d_counts_out, d_num_runs_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_unique_out, d_counts_out, d_num_runs_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OffsetsOutputIteratorT, typename LengthsOutputIteratorT, typename NumRunsOutputIteratorT>
@@ -65,7 +68,34 @@ class DeviceRunLengthEncode : public CubWrapper<DeviceRunLengthEncode>
                                           int                    num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRunLengthEncode::NonTrivialRuns(
-            d_temp_storage, temp_storage_bytes, d_in, d_offsets_out, d_lengths_out, d_num_runs_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_offsets_out, d_lengths_out, d_num_runs_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    // Scratch:
+
+    template <typename InputIteratorT, typename UniqueOutputIteratorT, typename LengthsOutputIteratorT, typename NumRunsOutputIteratorT>
+    DeviceRunLengthEncode& Encode(InputIteratorT         d_in,
+                                  UniqueOutputIteratorT  d_unique_out,
+                                  LengthsOutputIteratorT d_counts_out,
+                                  NumRunsOutputIteratorT d_num_runs_out,
+                                  int                    num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRunLengthEncode::Encode(
+            d_temp_storage, temp_storage_bytes, d_in, d_unique_out, d_counts_out, d_num_runs_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename InputIteratorT, typename OffsetsOutputIteratorT, typename LengthsOutputIteratorT, typename NumRunsOutputIteratorT>
+    DeviceRunLengthEncode& NonTrivialRuns(InputIteratorT         d_in,
+                                          OffsetsOutputIteratorT d_offsets_out,
+                                          LengthsOutputIteratorT d_lengths_out,
+                                          NumRunsOutputIteratorT d_num_runs_out,
+                                          int                    num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceRunLengthEncode::NonTrivialRuns(
+            d_temp_storage, temp_storage_bytes, d_in, d_offsets_out, d_lengths_out, d_num_runs_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     // Origin:
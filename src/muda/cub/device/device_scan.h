@@ -34,7 +34,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                              int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveSum(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -47,7 +48,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                               int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveScan(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, init_value, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, init_value, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -58,7 +60,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                              int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveSum(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename ScanOpT>
@@ -69,7 +72,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                               int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveScan(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename EqualityOpT = cub::Equality>
@@ -81,7 +85,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                   EqualityOpT equality_op = EqualityOpT())
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveSumByKey(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename ScanOpT, typename InitValueT, typename EqualityOpT = cub::Equality>
@@ -104,7 +109,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                                                   num_items,
                                                                   equality_op,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename EqualityOpT = cub::Equality>
@@ -116,7 +122,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                   EqualityOpT equality_op = EqualityOpT())
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveSumByKey(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename ScanOpT, typename EqualityOpT = cub::Equality>
@@ -137,7 +144,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                                                   num_items,
                                                                   equality_op,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_items));
     }
 
     // DeviceBuffer:
@@ -149,7 +157,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                              int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveSum(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -162,7 +171,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                               int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveScan(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, init_value, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, init_value, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
 
@@ -173,7 +183,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                              int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveSum(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename ScanOpT>
@@ -184,7 +195,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                               int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveScan(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename EqualityOpT = cub::Equality>
@@ -196,7 +208,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                   EqualityOpT equality_op = EqualityOpT())
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveSumByKey(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename ScanOpT, typename InitValueT, typename EqualityOpT = cub::Equality>
@@ -219,7 +232,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                                                   num_items,
                                                                   equality_op,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename EqualityOpT = cub::Equality>
@@ -231,7 +245,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                   EqualityOpT equality_op = EqualityOpT())
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveSumByKey(
-            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename ScanOpT, typename EqualityOpT = cub::Equality>
@@ -252,7 +267,123 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                                                   num_items,
                                                                   equality_op,
                                                                   _stream,
-                                                                  false));
+                                                                  false),
+                              details::cub_temp_size_key(num_items));
+    }
+
+    // Scratch:
+
+    template <typename InputIteratorT, typename OutputIteratorT>
+    DeviceScan& ExclusiveSum(InputIteratorT  d_in,
+                             OutputIteratorT d_out,
+                             int             num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceScan::ExclusiveSum(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+
+    template <typename InputIteratorT, typename OutputIteratorT, typename ScanOpT, typename InitValueT>
+    DeviceScan& ExclusiveScan(InputIteratorT  d_in,
+                              OutputIteratorT d_out,
+                              ScanOpT         scan_op,
+                              InitValueT      init_value,
+                              int             num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceScan::ExclusiveScan(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, init_value, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+
+    template <typename InputIteratorT, typename OutputIteratorT>
+    DeviceScan& InclusiveSum(InputIteratorT  d_in,
+                             OutputIteratorT d_out,
+                             int             num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceScan::InclusiveSum(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename InputIteratorT, typename OutputIteratorT, typename ScanOpT>
+    DeviceScan& InclusiveScan(InputIteratorT  d_in,
+                              OutputIteratorT d_out,
+                              ScanOpT         scan_op,
+                              int             num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceScan::InclusiveScan(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename EqualityOpT = cub::Equality>
+    DeviceScan& ExclusiveSumByKey(KeysInputIteratorT    d_keys_in,
+                                  ValuesInputIteratorT  d_values_in,
+                                  ValuesOutputIteratorT d_values_out,
+                                  int                   num_items,
+                                  EqualityOpT           equality_op = EqualityOpT())
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceScan::ExclusiveSumByKey(
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename ScanOpT, typename InitValueT, typename EqualityOpT = cub::Equality>
+    DeviceScan& ExclusiveScanByKey(KeysInputIteratorT    d_keys_in,
+                                   ValuesInputIteratorT  d_values_in,
+                                   ValuesOutputIteratorT d_values_out,
+                                   ScanOpT               scan_op,
+                                   InitValueT            init_value,
+                                   int                   num_items,
+                                   EqualityOpT           equality_op = EqualityOpT())
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceScan::ExclusiveScanByKey(d_temp_storage,
+                                                                          temp_storage_bytes,
+                                                                          d_keys_in,
+                                                                          d_values_in,
+                                                                          d_values_out,
+                                                                          scan_op,
+                                                                          init_value,
+                                                                          num_items,
+                                                                          equality_op,
+                                                                          _stream,
+                                                                          false),
+                                      details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename EqualityOpT = cub::Equality>
+    DeviceScan& InclusiveSumByKey(KeysInputIteratorT    d_keys_in,
+                                  ValuesInputIteratorT  d_values_in,
+                                  ValuesOutputIteratorT d_values_out,
+                                  int                   num_items,
+                                  EqualityOpT           equality_op = EqualityOpT())
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceScan::InclusiveSumByKey(
+            d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename KeysInputIteratorT, typename ValuesInputIteratorT, typename ValuesOutputIteratorT, typename ScanOpT, typename EqualityOpT = cub::Equality>
+    DeviceScan& InclusiveScanByKey(KeysInputIteratorT    d_keys_in,
+                                   ValuesInputIteratorT  d_values_in,
+                                   ValuesOutputIteratorT d_values_out,
+                                   ScanOpT               scan_op,
+                                   int                   num_items,
+                                   EqualityOpT           equality_op = EqualityOpT())
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceScan::InclusiveScanByKey(d_temp_storage,
+                                                                          temp_storage_bytes,
+                                                                          d_keys_in,
+                                                                          d_values_in,
+                                                                          d_values_out,
+                                                                          scan_op,
+                                                                          num_items,
+                                                                          equality_op,
+                                                                          _stream,
+                                                                          false),
+                                      details::cub_temp_size_key(num_items));
     }
 
     // Origin:
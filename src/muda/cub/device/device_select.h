@@ -27,7 +27,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                           int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::Flagged(
-            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT, typename SelectOp>
@@ -39,7 +40,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                      SelectOp                 select_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::If(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT>
@@ -50,7 +52,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                          int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::Unique(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 #if 0
     template <typename KeyInputIteratorT, typename ValueInputIteratorT, typename KeyOutputIteratorT, typename ValueOutputIteratorT, typename NumSelectedIteratorT>
@@ -71,7 +74,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                                                              d_num_selected_out,
                                                              num_items,
                                                              _stream,
-                                                             false));
+                                                             false),
+                              details::cub_temp_size_key(num_items));
     }
 #endif
 
@@ -86,7 +90,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                           int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::Flagged(
-            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT, typename SelectOp>
@@ -98,7 +103,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                      SelectOp                 select_op)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::If(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 
     template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT>
@@ -109,7 +115,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                          int                      num_items)
     {
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::Unique(
-            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, _stream, false));
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
     }
 #if 0
     template <typename KeyInputIteratorT, typename ValueInputIteratorT, typename KeyOutputIteratorT, typename ValueOutputIteratorT, typename NumSelectedIteratorT>
@@ -130,7 +137,67 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                                                              d_num_selected_out,
                                                              num_items,
                                                              _stream,
-                                                             false));
+                                                             false),
+                              details::cub_temp_size_key(num_items));
+    }
+#endif
+
+    // Scratch:
+
+    template <typename InputIteratorT, typename FlagIterator, typename OutputIteratorT, typename NumSelectedIteratorT>
+    DeviceSelect& Flagged(InputIteratorT       d_in,
+                          FlagIterator         d_flags,
+                          OutputIteratorT      d_out,
+                          NumSelectedIteratorT d_num_selected_out,
+                          int                  num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceSelect::Flagged(
+            d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT, typename SelectOp>
+    DeviceSelect& If(InputIteratorT       d_in,
+                     OutputIteratorT      d_out,
+                     NumSelectedIteratorT d_num_selected_out,
+                     int                  num_items,
+                     SelectOp             select_op)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceSelect::If(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+
+    template <typename InputIteratorT, typename OutputIteratorT, typename NumSelectedIteratorT>
+    DeviceSelect& Unique(InputIteratorT       d_in,
+                         OutputIteratorT      d_out,
+                         NumSelectedIteratorT d_num_selected_out,
+                         int                  num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceSelect::Unique(
+            d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, _stream, false),
+            details::cub_temp_size_key(num_items));
+    }
+#if 0
+    template <typename KeyInputIteratorT, typename ValueInputIteratorT, typename KeyOutputIteratorT, typename ValueOutputIteratorT, typename NumSelectedIteratorT>
+    DeviceSelect& UniqueByKey(KeyInputIteratorT    d_keys_in,
+                              ValueInputIteratorT  d_values_in,
+                              KeyOutputIteratorT   d_keys_out,
+                              ValueOutputIteratorT d_values_out,
+                              NumSelectedIteratorT d_num_selected_out,
+                              int                  num_items)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceSelect::UniqueByKey(d_temp_storage,
+                                                                     temp_storage_bytes,
+                                                                     d_keys_in,
+                                                                     d_values_in,
+                                                                     d_keys_out,
+                                                                     d_values_out,
+                                                                     d_num_selected_out,
+                                                                     num_items,
+                                                                     _stream,
+                                                                     false),
+                                      details::cub_temp_size_key(num_items));
     }
 #endif
 
@@ -40,7 +40,8 @@ class DeviceSpmv : public CubWrapper<DeviceSpmv>
                                                      num_cols,
                                                      num_nonzeros,
                                                      _stream,
-                                                     false));
+                                                     false),
+                              details::cub_temp_size_key(num_rows, num_cols, num_nonzeros));
     }
 
     // DeviceBuffer:
@@ -67,7 +68,35 @@ class DeviceSpmv : public CubWrapper<DeviceSpmv>
                                                      num_cols,
                                                      num_nonzeros,
                                                      _stream,
-                                                     false));
+                                                     false),
+                              details::cub_temp_size_key(num_rows, num_cols, num_nonzeros));
+    }
+
+    // Scratch:
+
+    template <typename ValueT>
+    DeviceSpmv& CsrMV(const ValueT* d_values,
+                      const int*    d_row_offsets,
+                      const int*    d_column_indices,
+                      const ValueT* d_vector_x,
+                      ValueT*       d_vector_y,
+                      int           num_rows,
+                      int           num_cols,
+                      int           num_nonzeros)
+    {
+        MUDA_CUB_WRAPPER_SCRATCH_IMPL(cub::DeviceSpmv::CsrMV(d_temp_storage,
+                                                             temp_storage_bytes,
+                                                             d_values,
+                                                             d_row_offsets,
+                                                             d_column_indices,
+                                                             d_vector_x,
+                                                             d_vector_y,
+                                                             num_rows,
+                                                             num_cols,
+                                                             num_nonzeros,
+                                                             _stream,
+                                                             false),
+                                      details::cub_temp_size_key(num_rows, num_cols, num_nonzeros));
     }
 
     // Origin:
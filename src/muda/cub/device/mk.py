@@ -24,7 +24,8 @@ class $CLASS_NAME$ : public CubWrapper<$CLASS_NAME$>
     {
         MUDA_CUB_WRAPPER_IMPL(cub::$CLASS_NAME$::ExampleFunction(
             d_temp_storage, temp_storage_bytes, 
-            d_in, d_out, num_items, m_stream, false));
+            d_in, d_out, num_items, m_stream, false),
+            details::cub_temp_size_key(num_items));
     }
     
 /*
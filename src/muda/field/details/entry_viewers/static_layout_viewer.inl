@@ -0,0 +1,217 @@
+/*******************************************************************************
+ 
+                            Static Layout Viewer
+
+ the layout, the shape, the element size (sizeof(T)) and the innermost array size
+ are all template parameters, so the addressing has no division/modulo and no
+ runtime shape/element size loads:
+    AoSoA: outer = i >> log2(InnermostArraySize), inner = i & (InnermostArraySize - 1)
+
+*******************************************************************************/
+
+namespace muda
+{
+namespace details
+{
+    constexpr bool field_is_power_of_two(uint32_t x)
+    {
+        return x != 0 && (x & (x - 1)) == 0;
+    }
+
+    constexpr uint32_t field_log2(uint32_t x)
+    {
+        uint32_t r = 0;
+        while(x >>= 1)
+            ++r;
+        return r;
+    }
+
+    template <typename T, FieldEntryLayout Layout, int M, int N, uint32_t InnermostArraySize>
+    class StaticFieldEntryViewerBase : public FieldEntryViewerBase
+    {
+        static_assert(Layout == FieldEntryLayout::AoS || Layout == FieldEntryLayout::SoA
+                          || Layout == FieldEntryLayout::AoSoA,
+                      "StaticFieldEntryViewer needs a compile-time layout (AoS/SoA/AoSoA)");
+        static_assert(Layout != FieldEntryLayout::AoSoA || field_is_power_of_two(InnermostArraySize),
+                      "InnermostArraySize must be a power of 2");
+
+      public:
+        MUDA_GENERIC StaticFieldEntryViewerBase() {}
+
+        MUDA_GENERIC StaticFieldEntryViewerBase(std::byte*                buffer,
+                                                const FieldEntryBaseData& info,
+                                                details::StringPointer    name_ptr)
+            : FieldEntryViewerBase(buffer, info, name_ptr)
+        {
+        }
+
+        MUDA_GENERIC StaticFieldEntryViewerBase(const FieldEntryViewerBase& base)
+            : FieldEntryViewerBase{base}
+        {
+        }
+
+      protected:
+        constexpr static uint32_t InnermostShift = field_log2(InnermostArraySize);
+
+        // j: the column major component index
+        MUDA_GENERIC std::byte* static_elem_addr(int i, int j) const
+        {
+            MUDA_KERNEL_ASSERT(i < count(),
+                               "FieldEntry[%s:%s]: count indexing out of range, size=%d, index=%d",
+                               kernel_name(),
+                               name(),
+                               count(),
+                               i);
+            MUDA_KERNEL_ASSERT(j < M * N,
+                               "FieldEntry[%s:%s]: component indexing out of range, shape=(%d,%d), index=%d",
+                               kernel_name(),
+                               name(),
+                               M,
+                               N,
+                               j);
+
+            auto u = static_cast<uint32_t>(i);
+            if constexpr(Layout == FieldEntryLayout::AoSoA)
+            {
+                auto outer = u >> InnermostShift;
+                auto inner = u & (InnermostArraySize - 1);
+                return m_buffer + outer * m_info.struct_stride + m_info.offset_in_struct
+                       + sizeof(T) * (InnermostArraySize * j + inner);
+            }
+            else if constexpr(Layout == FieldEntryLayout::SoA)
+            {
+                return m_buffer + m_info.offset_in_struct
+                       + m_info.elem_count_based_stride * j + sizeof(T) * u;
+            }
+            else
+            {
+                return m_buffer + m_info.struct_stride * u + m_info.offset_in_struct
+                       + sizeof(T) * j;
+            }
+        }
+
+        MUDA_GENERIC std::byte* static_elem_addr(int i, int row_index, int col_index) const
+        {
+            MUDA_KERNEL_ASSERT(row_index < M && col_index < N,
+                               "FieldEntry[%s:%s]: component indexing out of range, shape=(%d,%d), index=(%d,%d)",
+                               kernel_name(),
+                               name(),
+                               M,
+                               N,
+                               row_index,
+                               col_index);
+            // column major
+            return static_elem_addr(i, col_index * M + row_index);
+        }
+
+        // the distance (in T) between two neighbouring components of an element
+        MUDA_GENERIC int component_stride() const
+        {
+            if constexpr(Layout == FieldEntryLayout::AoSoA)
+                return static_cast<int>(InnermostArraySize);
+            else if constexpr(Layout == FieldEntryLayout::SoA)
+                return static_cast<int>(m_info.elem_count_based_stride / sizeof(T));
+            else
+                return 1;
+        }
+    };
+}  // namespace details
+
+template <typename T, FieldEntryLayout Layout, int M, int N, uint32_t InnermostArraySize = 32>
+class CStaticFieldEntryViewer
+    : public details::StaticFieldEntryViewerBase<T, Layout, M, N, InnermostArraySize>
+{
+    using Base = details::StaticFieldEntryViewerBase<T, Layout, M, N, InnermostArraySize>;
+    friend class FieldEntry<T, Layout, M, N>;
+
+  public:
+    using Base::Base;
+
+    MUDA_GENERIC CStaticFieldEntryViewer(const std::byte*          buffer,
+                                         const FieldEntryBaseData& info,
+                                         details::StringPointer    name_ptr)
+        : Base(const_cast<std::byte*>(buffer), info, name_ptr)
+    {
+    }
+
+    // scalar: the element, vector/matrix: the map info of the element
+    MUDA_GENERIC decltype(auto) operator()(int i) const
+    {
+        if constexpr(M == 1 && N == 1)
+        {
+            return this->template cast<T>(this->static_elem_addr(i, 0));
+        }
+        else
+        {
+            auto begin = &this->template cast<T>(this->static_elem_addr(i, 0));
+            auto inner = this->component_stride();
+            return CMatrixMapInfo<T, M, N>{begin, N == 1 ? 0 : inner * M, inner};
+        }
+    }
+
+    MUDA_GENERIC const T& operator()(int i, int comp) const
+    {
+        static_assert(N == 1, "(i, comp) is for vector entries");
+        return this->template cast<T>(this->static_elem_addr(i, comp));
+    }
+
+    MUDA_GENERIC const T& operator()(int i, int row_index, int col_index) const
+    {
+        return this->template cast<T>(this->static_elem_addr(i, row_index, col_index));
+    }
+
+    MUDA_GENERIC const T& x(int i) const { return (*this)(i, 0); }
+    MUDA_GENERIC const T& y(int i) const { return (*this)(i, 1); }
+    MUDA_GENERIC const T& z(int i) const { return (*this)(i, 2); }
+    MUDA_GENERIC const T& w(int i) const { return (*this)(i, 3); }
+};
+
+template <typename T, FieldEntryLayout Layout, int M, int N, uint32_t InnermostArraySize = 32>
+class StaticFieldEntryViewer
+    : public details::StaticFieldEntryViewerBase<T, Layout, M, N, InnermostArraySize>
+{
+    using Base = details::StaticFieldEntryViewerBase<T, Layout, M, N, InnermostArraySize>;
+    friend class FieldEntry<T, Layout, M, N>;
+
+  public:
+    using Base::Base;
+
+    operator CStaticFieldEntryViewer<T, Layout, M, N, InnermostArraySize>() const
+    {
+        return CStaticFieldEntryViewer<T, Layout, M, N, InnermostArraySize>{
+            static_cast<const FieldEntryViewerBase&>(*this)};
+    }
+
+    // scalar: the element, vector/matrix: the map info of the element
+    MUDA_GENERIC decltype(auto) operator()(int i) const
+    {
+        if constexpr(M == 1 && N == 1)
+        {
+            return const_cast<T&>(this->template cast<T>(this->static_elem_addr(i, 0)));
+        }
+        else
+        {
+            auto begin = &this->template cast<T>(this->static_elem_addr(i, 0));
+            auto inner = this->component_stride();
+            return MatrixMapInfo<T, M, N>{const_cast<T*>(begin), N == 1 ? 0 : inner * M, inner};
+        }
+    }
+
+    MUDA_GENERIC T& operator()(int i, int comp) const
+    {
+        static_assert(N == 1, "(i, comp) is for vector entries");
+        return const_cast<T&>(this->template cast<T>(this->static_elem_addr(i, comp)));
+    }
+
+    MUDA_GENERIC T& operator()(int i, int row_index, int col_index) const
+    {
+        return const_cast<T&>(
+            this->template cast<T>(this->static_elem_addr(i, row_index, col_index)));
+    }
+
+    MUDA_GENERIC T& x(int i) const { return (*this)(i, 0); }
+    MUDA_GENERIC T& y(int i) const { return (*this)(i, 1); }
+    MUDA_GENERIC T& z(int i) const { return (*this)(i, 2); }
+    MUDA_GENERIC T& w(int i) const { return (*this)(i, 3); }
+};
+}  // namespace muda
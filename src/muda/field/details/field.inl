@@ -1,4 +1,6 @@
 #include <muda/field/sub_field.h>
+#include <muda/field/field_checkpoint.h>
+#include <muda/buffer/pinned_buffer.h>
 
 namespace muda
 {
@@ -25,4 +27,45 @@ MUDA_INLINE SubField& muda::Field::operator[](std::string_view name)
 }
 
 MUDA_INLINE Field::~Field() {}
-}  // namespace muda
\ No newline at end of file
+
+MUDA_INLINE void Field::checkpoint(const std::string& path, cudaStream_t stream, size_t chunk_bytes)
+{
+    auto built_count = std::count_if(m_sub_fields.begin(),
+                                     m_sub_fields.end(),
+                                     [](const U<SubField>& s) { return s->m_is_built; });
+
+    FieldCheckpointWriter writer{path, static_cast<uint32_t>(built_count)};
+    // a device chunk and two pinned host chunks, so the copy of a chunk overlaps the file io
+    // of the previous one
+    DeviceBuffer<std::byte> device_chunk(chunk_bytes);
+    PinnedStaging           staging{chunk_bytes};
+    for(auto& sub_field : m_sub_fields)
+    {
+        if(sub_field->m_is_built)
+            sub_field->checkpoint(writer, staging, device_chunk.view(), stream);
+    }
+}
+
+MUDA_INLINE void Field::restore(const std::string& path, cudaStream_t stream, size_t chunk_bytes)
+{
+    FieldCheckpointReader reader{path};
+
+    // the checkpoint may be written with larger chunks
+    size_t staging_bytes = chunk_bytes;
+    for(auto& saved : reader.sub_fields())
+        for(auto& entry : saved.entries)
+            for(auto& chunk : entry.chunks)
+                staging_bytes = std::max<size_t>(staging_bytes, chunk.size);
+
+    DeviceBuffer<std::byte> device_chunk(staging_bytes);
+    PinnedStaging           staging{staging_bytes};
+    for(auto& saved : reader.sub_fields())
+    {
+        auto iter = m_name_to_index.find(saved.name);
+        if(iter == m_name_to_index.end())
+            continue;
+        m_sub_fields[iter->second]->restore(reader, saved, staging, device_chunk.view(), stream);
+    }
+    Launch(stream).wait();
+}
+}  // namespace muda
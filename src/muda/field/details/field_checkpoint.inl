@@ -0,0 +1,231 @@
+#include <cstring>
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+namespace details
+{
+    constexpr size_t field_checkpoint_align(size_t size)
+    {
+        return (size + 15) / 16 * 16;
+    }
+}  // namespace details
+
+MUDA_INLINE FieldCheckpointWriter::FieldCheckpointWriter(const std::string& path, uint32_t sub_field_count)
+    : m_file(path, std::ios::binary | std::ios::trunc)
+{
+    if(!m_file)
+        MUDA_ERROR_WITH_LOCATION("FieldCheckpointWriter: can't open %s", path.c_str());
+
+    details::FieldCheckpointHeader header;
+    header.sub_field_count = sub_field_count;
+    write(&header, sizeof(header));
+}
+
+MUDA_INLINE FieldCheckpointWriter::~FieldCheckpointWriter()
+{
+    close();
+}
+
+MUDA_INLINE void FieldCheckpointWriter::begin_sub_field(std::string_view     name,
+                                                        FieldEntryLayoutInfo layout_info,
+                                                        uint64_t             count,
+                                                        uint32_t             entry_count)
+{
+    MUDA_ASSERT(m_entry_written == m_entry.count,
+                "FieldCheckpointWriter: entry[%s] is incomplete, %llu/%llu elements written",
+                m_entry.name.c_str(),
+                (unsigned long long)m_entry_written,
+                (unsigned long long)m_entry.count);
+
+    details::FieldCheckpointSubFieldHeader header;
+    header.name_size            = static_cast<uint32_t>(name.size());
+    header.entry_count          = entry_count;
+    header.layout               = static_cast<uint32_t>(layout_info.layout());
+    header.innermost_array_size = layout_info.innermost_array_size();
+    header.count                = count;
+    write(&header, sizeof(header));
+    write_name(name);
+}
+
+MUDA_INLINE void FieldCheckpointWriter::begin_entry(const FieldCheckpointEntryInfo& info)
+{
+    MUDA_ASSERT(m_entry_written == m_entry.count,
+                "FieldCheckpointWriter: entry[%s] is incomplete, %llu/%llu elements written",
+                m_entry.name.c_str(),
+                (unsigned long long)m_entry_written,
+                (unsigned long long)m_entry.count);
+
+    details::FieldCheckpointEntryHeader header;
+    header.name_size      = static_cast<uint32_t>(info.name.size());
+    header.type           = static_cast<uint32_t>(info.type);
+    header.elem_byte_size = info.elem_byte_size;
+    header.shape_x        = info.shape.x;
+    header.shape_y        = info.shape.y;
+    header.count          = info.count;
+    write(&header, sizeof(header));
+    write_name(info.name);
+
+    m_entry         = info;
+    m_entry_written = 0;
+}
+
+MUDA_INLINE void FieldCheckpointWriter::write_chunk(uint64_t first, uint64_t count, const void* data, size_t size)
+{
+    MUDA_ASSERT(first == m_entry_written && first + count <= m_entry.count,
+                "FieldCheckpointWriter: entry[%s] chunks must be written in order, expected first=%llu, yours=%llu",
+                m_entry.name.c_str(),
+                (unsigned long long)m_entry_written,
+                (unsigned long long)first);
+    MUDA_ASSERT(size == count * m_entry.elem_total_byte_size(),
+                "FieldCheckpointWriter: entry[%s] chunk size mismatch",
+                m_entry.name.c_str());
+
+    details::FieldCheckpointChunkHeader header;
+    header.first = first;
+    header.count = count;
+    header.size  = size;
+    write(&header, sizeof(header));
+    write(data, size);
+    pad();
+    m_entry_written += count;
+}
+
+MUDA_INLINE void FieldCheckpointWriter::close()
+{
+    if(!m_file.is_open())
+        return;
+    m_file.close();
+}
+
+MUDA_INLINE void FieldCheckpointWriter::write(const void* data, size_t size)
+{
+    m_file.write(static_cast<const char*>(data), size);
+    if(!m_file)
+        MUDA_ERROR_WITH_LOCATION("FieldCheckpointWriter: write failed");
+    m_written += size;
+}
+
+MUDA_INLINE void FieldCheckpointWriter::write_name(std::string_view name)
+{
+    write(name.data(), name.size());
+    pad();
+}
+
+MUDA_INLINE void FieldCheckpointWriter::pad()
+{
+    static const char zeros[16] = {};
+    write(zeros, details::field_checkpoint_align(m_written) - m_written);
+}
+
+MUDA_INLINE const FieldCheckpointEntry* FieldCheckpointSubField::find_entry(std::string_view name) const
+{
+    for(auto& e : entries)
+        if(e.info.name == name)
+            return &e;
+    return nullptr;
+}
+
+MUDA_INLINE FieldCheckpointReader::FieldCheckpointReader(const std::string& path)
+    : m_file(path, std::ios::binary)
+    , m_path(path)
+{
+    if(!m_file)
+        MUDA_ERROR_WITH_LOCATION("FieldCheckpointReader: can't open %s", path.c_str());
+
+    details::FieldCheckpointHeader header;
+    read(&header, sizeof(header));
+    if(std::memcmp(header.magic, details::FieldCheckpointHeader{}.magic, sizeof(header.magic)) != 0)
+        MUDA_ERROR_WITH_LOCATION("FieldCheckpointReader: %s is not a field checkpoint", path.c_str());
+    if(header.version != details::field_checkpoint_version)
+        MUDA_ERROR_WITH_LOCATION("FieldCheckpointReader: unsupported version %u in %s",
+                                 header.version,
+                                 path.c_str());
+
+    m_sub_fields.resize(header.sub_field_count);
+    for(auto& sub_field : m_sub_fields)
+    {
+        details::FieldCheckpointSubFieldHeader sub_header;
+        read(&sub_header, sizeof(sub_header));
+        if(std::memcmp(sub_header.magic, "SUBF", 4) != 0)
+            MUDA_ERROR_WITH_LOCATION("FieldCheckpointReader: broken sub field header in %s",
+                                     path.c_str());
+
+        sub_field.name  = read_name(sub_header.name_size);
+        sub_field.count = sub_header.count;
+        sub_field.layout_info =
+            FieldEntryLayoutInfo{static_cast<FieldEntryLayout>(sub_header.layout),
+                                 sub_header.innermost_array_size};
+
+        sub_field.entries.resize(sub_header.entry_count);
+        for(auto& entry : sub_field.entries)
+        {
+            details::FieldCheckpointEntryHeader entry_header;
+            read(&entry_header, sizeof(entry_header));
+            if(std::memcmp(entry_header.magic, "ENTR", 4) != 0)
+                MUDA_ERROR_WITH_LOCATION("FieldCheckpointReader: broken entry header in %s",
+                                         path.c_str());
+
+            auto& info          = entry.info;
+            info.name           = read_name(entry_header.name_size);
+            info.type           = static_cast<FieldEntryType>(entry_header.type);
+            info.elem_byte_size = entry_header.elem_byte_size;
+            info.shape.x        = entry_header.shape_x;
+            info.shape.y        = entry_header.shape_y;
+            info.count          = entry_header.count;
+
+            // chunks until all the elements are covered, skip the data
+            uint64_t covered = 0;
+            while(covered < info.count)
+            {
+                details::FieldCheckpointChunkHeader chunk_header;
+                read(&chunk_header, sizeof(chunk_header));
+                if(std::memcmp(chunk_header.magic, "CHNK", 4) != 0 || chunk_header.first != covered)
+                    MUDA_ERROR_WITH_LOCATION("FieldCheckpointReader: broken chunk of entry[%s] in %s",
+                                             info.name.c_str(),
+                                             path.c_str());
+
+                FieldCheckpointChunk chunk;
+                chunk.first       = chunk_header.first;
+                chunk.count       = chunk_header.count;
+                chunk.size        = chunk_header.size;
+                chunk.file_offset = static_cast<uint64_t>(m_file.tellg());
+                entry.chunks.push_back(chunk);
+
+                m_file.seekg(details::field_checkpoint_align(chunk.size), std::ios::cur);
+                covered += chunk.count;
+            }
+        }
+    }
+}
+
+MUDA_INLINE auto FieldCheckpointReader::find_sub_field(std::string_view name) const
+    -> const FieldCheckpointSubField*
+{
+    for(auto& s : m_sub_fields)
+        if(s.name == name)
+            return &s;
+    return nullptr;
+}
+
+MUDA_INLINE void FieldCheckpointReader::read_chunk(const FieldCheckpointChunk& chunk, void* dst)
+{
+    m_file.seekg(chunk.file_offset);
+    read(dst, chunk.size);
+}
+
+MUDA_INLINE void FieldCheckpointReader::read(void* data, size_t size)
+{
+    m_file.read(static_cast<char*>(data), size);
+    if(!m_file)
+        MUDA_ERROR_WITH_LOCATION("FieldCheckpointReader: %s is truncated", m_path.c_str());
+}
+
+MUDA_INLINE std::string FieldCheckpointReader::read_name(uint32_t size)
+{
+    std::string name(size, '\0');
+    read(name.data(), size);
+    m_file.seekg(details::field_checkpoint_align(size) - size, std::ios::cur);
+    return name;
+}
+}  // namespace muda
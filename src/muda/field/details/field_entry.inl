@@ -20,4 +20,38 @@ CFieldEntryViewer<T, Layout, M, N> muda::FieldEntry<T, Layout, M, N>::cviewer()
     MUDA_ASSERT(m_field.data_buffer() != nullptr, "Resize the field before you use it!");
     return CFieldEntryViewer<T, Layout, M, N>{m_field.data_buffer(), m_info, m_name_ptr};
 }
+
+template <typename T, FieldEntryLayout Layout, int M, int N>
+template <uint32_t InnermostArraySize>
+void FieldEntry<T, Layout, M, N>::check_static_layout() const
+{
+    static_assert(Layout == FieldEntryLayout::AoS || Layout == FieldEntryLayout::SoA
+                      || Layout == FieldEntryLayout::AoSoA,
+                  "static viewer needs a compile-time layout, build the field with builder<Layout>()");
+    MUDA_ASSERT(m_field.data_buffer() != nullptr, "Resize the field before you use it!");
+    MUDA_ASSERT(Layout != FieldEntryLayout::AoSoA
+                    || layout_info().innermost_array_size() == InnermostArraySize,
+                "FieldEntry[%s]: InnermostArraySize mismatch, static=%d, field=%d",
+                name().data(),
+                (int)InnermostArraySize,
+                (int)layout_info().innermost_array_size());
+}
+
+template <typename T, FieldEntryLayout Layout, int M, int N>
+template <uint32_t InnermostArraySize>
+StaticFieldEntryViewer<T, Layout, M, N, InnermostArraySize> FieldEntry<T, Layout, M, N>::static_viewer()
+{
+    check_static_layout<InnermostArraySize>();
+    return StaticFieldEntryViewer<T, Layout, M, N, InnermostArraySize>{
+        m_field.data_buffer(), m_info, m_name_ptr};
+}
+
+template <typename T, FieldEntryLayout Layout, int M, int N>
+template <uint32_t InnermostArraySize>
+CStaticFieldEntryViewer<T, Layout, M, N, InnermostArraySize> FieldEntry<T, Layout, M, N>::cstatic_viewer() const
+{
+    check_static_layout<InnermostArraySize>();
+    return CStaticFieldEntryViewer<T, Layout, M, N, InnermostArraySize>{
+        m_field.data_buffer(), m_info, m_name_ptr};
+}
 }  // namespace muda
\ No newline at end of file
@@ -0,0 +1,51 @@
+namespace muda
+{
+namespace details
+{
+    // dst[i] = src[index[i]] for every entry of a sub field in one pass, i in [0, count).
+    // src and dst share the layout (`infos`), only the buffers differ.
+    // d_count: the count on the device (<= count) if not null
+    MUDA_INLINE MUDA_HOST void field_gather(CBufferView<FieldEntryBaseData> infos,
+                                            const std::byte*                src,
+                                            std::byte*                      dst,
+                                            CBufferView<int>                index,
+                                            int                             count,
+                                            cudaStream_t                    stream,
+                                            const int*                      d_count = nullptr)
+    {
+        if(count == 0 || infos.size() == 0)
+            return;
+
+        ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+            .apply(count,
+                   [infos = infos.cviewer(),
+                    index = index.cviewer(),
+                    src   = const_cast<std::byte*>(src),
+                    dst,
+                    d_count] __device__(int i) mutable
+                   {
+                       if(d_count && i >= *d_count)
+                           return;
+                       auto from = index(i);
+                       for(int k = 0; k < infos.dim(); ++k)
+                       {
+                           const auto& info = infos(k);
+                           FieldRelayoutAccessor s{src, info, {}};
+                           FieldRelayoutAccessor d{dst, info, {}};
+
+                           int comp_bytes = info.shape.x * info.shape.y * info.elem_byte_size;
+                           if(info.elem_byte_size % sizeof(uint32_t) == 0)
+                           {
+                               for(int w = 0; w < comp_bytes / sizeof(uint32_t); ++w)
+                                   *d.word_addr<uint32_t>(i, w) = *s.word_addr<uint32_t>(from, w);
+                           }
+                           else
+                           {
+                               for(int w = 0; w < comp_bytes; ++w)
+                                   *d.word_addr<std::byte>(i, w) = *s.word_addr<std::byte>(from, w);
+                           }
+                       }
+                   });
+    }
+}  // namespace details
+}  // namespace muda
@@ -0,0 +1,58 @@
+#include <algorithm>
+
+namespace muda
+{
+MUDA_INLINE FieldLayoutAutotuner::FieldLayoutAutotuner(SubField& sub_field, cudaStream_t stream)
+    : m_sub_field(sub_field)
+    , m_stream(stream)
+    , m_candidates{FieldEntryLayoutInfo{FieldEntryLayout::AoS},
+                   FieldEntryLayoutInfo{FieldEntryLayout::SoA},
+                   FieldEntryLayoutInfo{FieldEntryLayout::AoSoA, 32}}
+{
+}
+
+MUDA_INLINE FieldLayoutAutotuner& FieldLayoutAutotuner::candidates(std::vector<FieldEntryLayoutInfo> layouts)
+{
+    MUDA_ASSERT(!layouts.empty(), "FieldLayoutAutotuner: no candidate layout");
+    m_candidates = std::move(layouts);
+    return *this;
+}
+
+MUDA_INLINE FieldLayoutAutotuner& FieldLayoutAutotuner::repeat(int count)
+{
+    MUDA_ASSERT(count > 0, "FieldLayoutAutotuner: repeat count must be > 0, yours=%d", count);
+    m_repeat = count;
+    return *this;
+}
+
+template <typename F>
+FieldEntryLayoutInfo FieldLayoutAutotuner::tune(F&& access)
+{
+    m_results.clear();
+    m_results.reserve(m_candidates.size());
+
+    Event begin{Event::Bit::eDefault};
+    Event end{Event::Bit::eDefault};
+
+    for(auto& layout : m_candidates)
+    {
+        m_sub_field.relayout(layout, m_stream);
+
+        // warmup
+        access(m_stream);
+
+        Launch(m_stream).record(begin);
+        for(int i = 0; i < m_repeat; ++i)
+            access(m_stream);
+        Launch(m_stream).record(end).wait();
+
+        m_results.push_back({layout, Event::elapsed_time(begin, end) / m_repeat});
+    }
+
+    auto best = std::min_element(m_results.begin(),
+                                 m_results.end(),
+                                 [](const Result& a, const Result& b) { return a.ms < b.ms; });
+    m_sub_field.relayout(best->layout, m_stream);
+    return best->layout;
+}
+}  // namespace muda
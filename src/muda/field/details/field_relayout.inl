@@ -0,0 +1,175 @@
+#include <cstring>
+
+namespace muda
+{
+namespace details
+{
+    // runtime addressing of a field entry, whatever its layout is
+    class FieldRelayoutAccessor : public FieldEntryViewerBase
+    {
+      public:
+        using FieldEntryViewerBase::FieldEntryViewerBase;
+
+        // j: the column major component index
+        MUDA_GENERIC std::byte* comp_addr(int i, int j) const
+        {
+            auto row = j % static_cast<int>(m_info.shape.x);
+            auto col = j / static_cast<int>(m_info.shape.x);
+            switch(layout())
+            {
+                case FieldEntryLayout::AoSoA:
+                    return aosoa_elem_addr(i, row, col);
+                case FieldEntryLayout::AoS:
+                    return aos_elem_addr(i, row, col);
+                case FieldEntryLayout::SoA:
+                    return soa_elem_addr(i, row, col);
+                default:
+                    MUDA_KERNEL_ERROR_WITH_LOCATION("No impl yet");
+                    return nullptr;
+            }
+        }
+
+        // w: the word index in the element, Word is the unit of the copy
+        template <typename Word>
+        MUDA_GENERIC Word* word_addr(int i, int w) const
+        {
+            int words_per_comp = elem_byte_size() / sizeof(Word);
+            return reinterpret_cast<Word*>(comp_addr(i, w / words_per_comp)) + w % words_per_comp;
+        }
+    };
+
+    // a tile is FieldRelayoutTileSize elements of an entry
+    constexpr int FieldRelayoutTileSize = 32;
+    // the max byte size of an element that can be staged in shared memory
+    constexpr int FieldRelayoutMaxElemBytes = 256;
+
+    // copy the elements [src_begin, src_begin + count) of src to [dst_begin, dst_begin + count) of dst
+    template <typename Word>
+    MUDA_HOST void field_relayout_entry(const FieldRelayoutAccessor& src,
+                                        int                          src_begin,
+                                        const FieldRelayoutAccessor& dst,
+                                        int                          dst_begin,
+                                        int                          count,
+                                        cudaStream_t                 stream)
+    {
+        if(count == 0)
+            return;
+
+        int words = src.shape().x * src.shape().y * src.elem_byte_size() / sizeof(Word);
+
+        if(words * sizeof(Word) > FieldRelayoutMaxElemBytes)
+        {
+            // too large to stage, copy word by word, element index is the fastest
+            ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+                .apply(count * words,
+                       [src, dst, src_begin, dst_begin, count] __device__(int t) mutable
+                       {
+                           int i = t % count;
+                           int w = t / count;
+                           *dst.word_addr<Word>(dst_begin + i, w) =
+                               *src.word_addr<Word>(src_begin + i, w);
+                       });
+            return;
+        }
+
+        constexpr int Tile  = FieldRelayoutTileSize;
+        constexpr int Pitch = Tile + 1;  // avoid bank conflicts
+        int  grid_dim = (count + Tile - 1) / Tile;
+        bool src_aos  = src.layout() == FieldEntryLayout::AoS;
+        bool dst_aos  = dst.layout() == FieldEntryLayout::AoS;
+
+        // tiled transpose: load the tile in the order that is coalesced for the source layout,
+        // store it in the order that is coalesced for the destination layout
+        Launch(grid_dim, LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+            .apply(
+                [src, dst, src_begin, dst_begin, count, words, src_aos, dst_aos] __device__() mutable
+                {
+                    __shared__ uint32_t smem[FieldRelayoutMaxElemBytes / sizeof(uint32_t) * Pitch];
+                    auto tile = reinterpret_cast<Word*>(smem);
+
+                    int base  = blockIdx.x * Tile;
+                    int total = Tile * words;
+
+                    // AoS: the words of an element are contiguous, SoA/AoSoA: the elements of a word are
+                    auto walk = [words](int t, bool aos, int& e, int& w)
+                    {
+                        if(aos)
+                        {
+                            e = t / words;
+                            w = t % words;
+                        }
+                        else
+                        {
+                            e = t % Tile;
+                            w = t / Tile;
+                        }
+                    };
+
+                    for(int t = threadIdx.x; t < total; t += blockDim.x)
+                    {
+                        int e, w;
+                        walk(t, src_aos, e, w);
+                        if(base + e < count)
+                            tile[w * Pitch + e] = *src.word_addr<Word>(src_begin + base + e, w);
+                    }
+                    __syncthreads();
+                    for(int t = threadIdx.x; t < total; t += blockDim.x)
+                    {
+                        int e, w;
+                        walk(t, dst_aos, e, w);
+                        if(base + e < count)
+                            *dst.word_addr<Word>(dst_begin + base + e, w) = tile[w * Pitch + e];
+                    }
+                });
+    }
+
+    MUDA_INLINE MUDA_HOST void field_relayout_entry(const FieldRelayoutAccessor& src,
+                                                    int                          src_begin,
+                                                    const FieldRelayoutAccessor& dst,
+                                                    int                          dst_begin,
+                                                    int                          count,
+                                                    cudaStream_t                 stream)
+    {
+        if(src.elem_byte_size() % sizeof(uint32_t) == 0)
+            field_relayout_entry<uint32_t>(src, src_begin, dst, dst_begin, count, stream);
+        else
+            field_relayout_entry<std::byte>(src, src_begin, dst, dst_begin, count, stream);
+    }
+
+    MUDA_INLINE MUDA_HOST void field_relayout_entry(const FieldRelayoutAccessor& src,
+                                                    const FieldRelayoutAccessor& dst,
+                                                    cudaStream_t                 stream)
+    {
+        field_relayout_entry(src, 0, dst, 0, src.count(), stream);
+    }
+
+    // the same copy on the host, for the buffers in host memory
+    MUDA_INLINE MUDA_HOST void field_relayout_entry_host(const FieldRelayoutAccessor& src,
+                                                         int                          src_begin,
+                                                         const FieldRelayoutAccessor& dst,
+                                                         int                          dst_begin,
+                                                         int                          count)
+    {
+        int comp_count = src.shape().x * src.shape().y;
+        for(int j = 0; j < comp_count; ++j)
+            for(int i = 0; i < count; ++i)
+                std::memcpy(dst.comp_addr(dst_begin + i, j),
+                            src.comp_addr(src_begin + i, j),
+                            src.elem_byte_size());
+    }
+
+    // an entry packed as (component major) arrays: comp0[count], comp1[count], ...
+    // it is the layout independent format of the field checkpoint
+    MUDA_INLINE MUDA_HOST FieldEntryBaseData field_packed_entry_info(const FieldEntryBaseData& info,
+                                                                     uint32_t count)
+    {
+        FieldEntryBaseData packed      = info;
+        packed.layout_info             = FieldEntryLayoutInfo{FieldEntryLayout::SoA};
+        packed.elem_count              = count;
+        packed.offset_in_struct        = 0;
+        packed.offset_in_base_struct   = 0;
+        packed.elem_count_based_stride = info.elem_byte_size * count;
+        return packed;
+    }
+}  // namespace details
+}  // namespace muda
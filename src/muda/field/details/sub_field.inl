@@ -5,6 +5,14 @@
 #include <muda/field/sub_field/soa_sub_field.h>
 #include <muda/field/sub_field/aos_sub_field.h>
 #include <muda/type_traits/type_label.h>
+#include <optional>
+#include <muda/field/field_checkpoint.h>
+#include <muda/buffer/pinned_buffer.h>
+#include <muda/cub/device/device_radix_sort.h>
+#include <muda/cub/device/device_select.h>
+#include <muda/cub/device/device_scan.h>
+#include "field_relayout.inl"
+#include "field_gather.inl"
 namespace muda
 {
 MUDA_INLINE SubField::SubField(Field& field, std::string_view name)
@@ -13,7 +21,14 @@ MUDA_INLINE SubField::SubField(Field& field, std::string_view name)
 {
 }
 
-MUDA_INLINE SubField::~SubField() {}
+MUDA_INLINE SubField::~SubField()
+{
+    if(m_h_emit_count)
+    {
+        wait_event(m_emit_event);
+        checkCudaErrors(cudaFreeHost(m_h_emit_count));
+    }
+}
 
 template <FieldEntryLayout Layout>
 MUDA_INLINE FieldBuilder<Layout> SubField::builder(FieldEntryLayoutInfo layout)
@@ -26,31 +41,36 @@ MUDA_INLINE FieldBuilder<Layout> SubField::builder(FieldEntryLayoutInfo layout)
     {
         m_interface = std::make_unique<SubFieldImpl<Layout>>(m_field);
         m_interface->m_layout_info = layout;
+        m_is_runtime_layout        = false;
         return FieldBuilder<Layout>{*this, layout};
     }
 }
 
 MUDA_INLINE FieldBuilder<FieldEntryLayout::RuntimeLayout> SubField::builder(FieldEntryLayoutInfo layout)
+{
+    m_interface                = create_interface(m_field, layout);
+    m_interface->m_layout_info = layout;
+    m_is_runtime_layout        = true;
+    return FieldBuilder<FieldEntryLayout::RuntimeLayout>{*this, layout};
+}
+
+MUDA_INLINE auto SubField::create_interface(Field& field, FieldEntryLayoutInfo layout)
+    -> U<SubFieldInterface>
 {
     switch(layout.layout())
     {
         case FieldEntryLayout::AoSoA:
-            m_interface = std::make_unique<SubFieldImpl<FieldEntryLayout::AoSoA>>(m_field);
-            break;
+            return std::make_unique<SubFieldImpl<FieldEntryLayout::AoSoA>>(field);
         case FieldEntryLayout::SoA:
-            m_interface = std::make_unique<SubFieldImpl<FieldEntryLayout::SoA>>(m_field);
-            break;
+            return std::make_unique<SubFieldImpl<FieldEntryLayout::SoA>>(field);
         case FieldEntryLayout::AoS:
-            m_interface = std::make_unique<SubFieldImpl<FieldEntryLayout::AoS>>(m_field);
-            break;
+            return std::make_unique<SubFieldImpl<FieldEntryLayout::AoS>>(field);
         default:
             MUDA_ERROR_WITH_LOCATION("Invalid layout type");
-            break;
+            return nullptr;
     }
-
-    m_interface->m_layout_info = layout;
-    return FieldBuilder<FieldEntryLayout::RuntimeLayout>{*this, layout};
 }
+
 template <typename T, FieldEntryLayout Layout, int M, int N>
 auto SubField::create_entry(std::string_view     name,
                             FieldEntryLayoutInfo layout,
@@ -119,10 +139,443 @@ MUDA_INLINE size_t SubField::size() const
     return m_interface ? m_interface->m_num_elements : 0;
 }
 
-MUDA_INLINE void SubField::resize(size_t num_elements)
+MUDA_INLINE size_t SubField::capacity() const
+{
+    return m_interface ? m_interface->m_capacity : 0;
+}
+
+MUDA_INLINE void SubField::resize(size_t num_elements, cudaStream_t stream)
 {
     MUDA_ASSERT(m_is_built, "Field is not built yet!")
-    m_interface->resize(num_elements);
-    m_interface->m_num_elements = num_elements;
+    // the explicit size wins over a pending device count
+    m_emit_pending          = false;
+    m_emit_read_back_queued = false;
+    m_interface->resize(num_elements, stream);
+}
+
+MUDA_INLINE void SubField::reserve(size_t capacity, cudaStream_t stream)
+{
+    MUDA_ASSERT(m_is_built, "Field is not built yet!")
+    m_interface->reserve(capacity, stream);
+}
+
+MUDA_INLINE void SubField::shrink_to_fit(cudaStream_t stream)
+{
+    MUDA_ASSERT(m_is_built, "Field is not built yet!")
+    m_interface->shrink_to_fit(stream);
+}
+
+MUDA_INLINE FieldEntryLayoutInfo SubField::layout_info() const
+{
+    return m_interface ? m_interface->m_layout_info : FieldEntryLayoutInfo{};
+}
+
+MUDA_INLINE void SubField::relayout(FieldEntryLayoutInfo layout, cudaStream_t stream)
+{
+    MUDA_ASSERT(m_is_built, "Field is not built yet!");
+    auto& src = *m_interface;
+    MUDA_ASSERT(m_is_runtime_layout || layout.layout() == src.m_layout_info.layout(),
+                "SubField[%s]: the layout is fixed at compile time, build it with builder(layout_info) to relayout",
+                m_name.c_str());
+    if(layout == src.m_layout_info)
+        return;
+
+    auto old_interface = std::move(m_interface);
+    m_interface        = create_interface(m_field, layout);
+    auto& dst          = *m_interface;
+
+    std::vector<FieldEntryBaseData> src_infos;
+    src_infos.reserve(src.m_entries.size());
+    for(auto& e : src.m_entries)
+    {
+        src_infos.push_back(e->m_info);
+        e->m_info.layout_info = layout;
+    }
+
+    dst.m_entries       = std::move(src.m_entries);
+    dst.m_name_to_index = std::move(src.m_name_to_index);
+    dst.m_layout_info   = layout;
+    dst.m_build_options = src.m_build_options;
+    dst.build();
+    // a zeroed buffer of the same capacity, nothing is copied because dst is empty
+    dst.reallocate(src.m_capacity, stream);
+    dst.resize(src.m_num_elements, stream);
+
+    for(size_t i = 0; i < dst.m_entries.size(); ++i)
+    {
+        auto& e = dst.m_entries[i];
+        details::FieldRelayoutAccessor from{src.m_data_buffer, src_infos[i], e->m_name_ptr};
+        details::FieldRelayoutAccessor to{dst.m_data_buffer, e->m_info, e->m_name_ptr};
+        details::field_relayout_entry(from, to, stream);
+    }
+
+    // release the old buffer in the stream order, don't block the host
+    if(src.m_data_buffer)
+    {
+        dst.retire_data_buffer(src.m_data_buffer, stream);
+        src.m_data_buffer = nullptr;
+    }
+    std::move(src.m_retired_buffers.begin(),
+              src.m_retired_buffers.end(),
+              std::back_inserter(dst.m_retired_buffers));
+    src.m_retired_buffers.clear();
+}
+
+MUDA_INLINE void SubField::gather(CBufferView<int> index, size_t count, cudaStream_t stream, const int* d_count)
+{
+    auto& impl = *m_interface;
+
+    std::vector<FieldEntryBaseData> infos;
+    infos.reserve(impl.m_entries.size());
+    for(auto& e : impl.m_entries)
+        infos.push_back(e->m_info);
+    BufferLaunch(stream)
+        .resize(m_gather_infos, infos.size())
+        .copy(m_gather_infos.view(), infos.data());
+
+    // the capacity (so the layout) is kept, the old buffer is retired in the stream order
+    impl.reallocate_data_buffer(impl.m_data_buffer_size,
+                                stream,
+                                [&](std::byte* old_ptr, size_t, std::byte* new_ptr, size_t)
+                                {
+                                    details::field_gather(m_gather_infos.view(),
+                                                          old_ptr,
+                                                          new_ptr,
+                                                          index,
+                                                          static_cast<int>(count),
+                                                          stream,
+                                                          d_count);
+                                });
+    impl.resize(count, stream);
+}
+
+MUDA_INLINE void SubField::permute(CBufferView<int> perm, cudaStream_t stream)
+{
+    MUDA_ASSERT(m_is_built, "Field is not built yet!");
+    sync_size();
+    MUDA_ASSERT(perm.size() == size(),
+                "SubField[%s]: perm.size()=%llu mismatches the size=%llu",
+                m_name.c_str(),
+                (unsigned long long)perm.size(),
+                (unsigned long long)size());
+    gather(perm, size(), stream);
+}
+
+template <typename KeyT>
+MUDA_INLINE void SubField::sort_by_key(BufferView<KeyT> keys, cudaStream_t stream, int begin_bit, int end_bit)
+{
+    MUDA_ASSERT(m_is_built, "Field is not built yet!");
+    sync_size();
+    MUDA_ASSERT(keys.size() == size(),
+                "SubField[%s]: keys.size()=%llu mismatches the size=%llu",
+                m_name.c_str(),
+                (unsigned long long)keys.size(),
+                (unsigned long long)size());
+
+    auto n = static_cast<int>(size());
+    if(n == 0)
+        return;
+
+    // [0, n): iota, [n, 2n): the permutation
+    BufferLaunch(stream).resize(m_reorder_index, 2 * n);
+    BufferLaunch(stream).resize(m_reorder_keys, n * sizeof(KeyT));
+    auto iota        = m_reorder_index.view(0, n);
+    auto perm        = m_reorder_index.view(n, n);
+    auto sorted_keys = reinterpret_cast<KeyT*>(m_reorder_keys.data());
+
+    ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+        .apply(n, [iota = iota.viewer()] __device__(int i) mutable { iota(i) = i; });
+
+    DeviceRadixSort(stream).SortPairs(m_reorder_temp_storage,
+                                      keys.data(),
+                                      sorted_keys,
+                                      iota.data(),
+                                      perm.data(),
+                                      n,
+                                      begin_bit,
+                                      end_bit);
+    Memory(stream).transfer(keys.data(), sorted_keys, n * sizeof(KeyT));
+
+    gather(perm, n, stream);
+}
+
+MUDA_INLINE size_t SubField::compact(CBufferView<int> mask, cudaStream_t stream)
+{
+    MUDA_ASSERT(m_is_built, "Field is not built yet!");
+    sync_size();
+    MUDA_ASSERT(mask.size() == size(),
+                "SubField[%s]: mask.size()=%llu mismatches the size=%llu",
+                m_name.c_str(),
+                (unsigned long long)mask.size(),
+                (unsigned long long)size());
+
+    auto n = static_cast<int>(size());
+    if(n == 0)
+        return 0;
+
+    // [0, n): iota, [n, 2n): the selected indices, [2n]: the selected count
+    BufferLaunch(stream).resize(m_reorder_index, 2 * n + 1);
+    auto iota     = m_reorder_index.view(0, n);
+    auto selected = m_reorder_index.view(n, n);
+    auto count    = m_reorder_index.view(2 * n, 1);
+
+    ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+        .apply(n, [iota = iota.viewer()] __device__(int i) mutable { iota(i) = i; });
+
+    DeviceSelect(stream).Flagged(
+        m_reorder_temp_storage, iota.data(), mask.data(), selected.data(), count.data(), n);
+
+    int h_count = 0;
+    Memory(stream).download(&h_count, count.data(), sizeof(int));
+    wait_stream(stream);
+
+    if(h_count != n)
+        gather(selected, h_count, stream);
+    return h_count;
+}
+
+MUDA_INLINE SubFieldEmitter SubField::begin_emit(size_t max_emit, cudaStream_t stream)
+{
+    MUDA_ASSERT(m_is_built, "Field is not built yet!");
+    auto& impl = *m_interface;
+
+    // the device count is the truth from now on, until it is read back
+    if(!m_emit_pending)
+    {
+        BufferLaunch(stream)
+            .resize(m_emit_count, 1)
+            .fill(m_emit_count.view(), static_cast<int>(impl.m_num_elements));
+        m_emit_pending = true;
+    }
+    m_emit_read_back_queued = false;
+
+    // the upper bound, the elements up to the old upper bound are kept if the buffer grows
+    auto bound = impl.m_num_elements + max_emit;
+    impl.resize(bound, stream);
+    BufferLaunch(stream).resize(m_dead, impl.m_capacity);
+
+    return SubFieldEmitter{m_emit_count.data(), m_dead.data(), static_cast<int>(bound)};
+}
+
+MUDA_INLINE void SubField::end_emit(cudaStream_t stream)
+{
+    if(!m_emit_pending)
+        return;
+    read_back_emit_count(stream);
+}
+
+MUDA_INLINE CBufferView<int> SubField::compact_dead(cudaStream_t stream)
+{
+    MUDA_ASSERT(m_is_built, "Field is not built yet!");
+    auto& impl = *m_interface;
+    auto  n    = static_cast<int>(impl.m_num_elements);
+
+    if(!m_emit_pending)
+    {
+        BufferLaunch(stream).resize(m_emit_count, 1).fill(m_emit_count.view(), n);
+        m_emit_pending = true;
+    }
+    BufferLaunch(stream).resize(m_dead, impl.m_capacity);
+    BufferLaunch(stream).resize(m_old_to_new, n);
+    if(n == 0)
+    {
+        read_back_emit_count(stream);
+        return m_old_to_new.view();
+    }
+
+    // [0, n): keep flags, [n, 2n): new-to-old
+    BufferLaunch(stream).resize(m_reorder_index, 2 * n);
+    auto keep       = m_reorder_index.view(0, n);
+    auto new_to_old = m_reorder_index.view(n, n);
+    auto d_count    = m_emit_count.data();
+
+    ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+        .apply(n,
+               [keep = keep.viewer(), dead = m_dead.cviewer(), d_count] __device__(int i) mutable
+               { keep(i) = i < *d_count && !dead(i); });
+
+    DeviceScan(stream).ExclusiveSum(m_reorder_temp_storage, keep.data(), m_old_to_new.data(), n);
+
+    ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+        .apply(n,
+               [keep       = keep.cviewer(),
+                old_to_new = m_old_to_new.viewer(),
+                new_to_old = new_to_old.viewer(),
+                d_count,
+                n] __device__(int i) mutable
+               {
+                   auto k = keep(i);
+                   auto j = old_to_new(i);
+                   if(k)
+                       new_to_old(j) = i;
+                   if(i == n - 1)
+                       *d_count = j + k;
+                   old_to_new(i) = k ? j : -1;
+               });
+
+    gather(new_to_old, n, stream, d_count);
+    Memory(stream).set(m_dead.data(), m_dead.size() * sizeof(int), 0);
+    read_back_emit_count(stream);
+    return m_old_to_new.view();
+}
+
+MUDA_INLINE bool SubField::poll_size()
+{
+    if(!m_emit_pending)
+        return true;
+    if(!m_emit_read_back_queued || m_emit_event.query() == Event::QueryResult::eNotReady)
+        return false;
+
+    m_interface->resize(*m_h_emit_count, nullptr);
+    m_emit_pending          = false;
+    m_emit_read_back_queued = false;
+    return true;
+}
+
+MUDA_INLINE size_t SubField::sync_size()
+{
+    if(!m_emit_pending)
+        return size();
+    MUDA_ASSERT(m_emit_read_back_queued,
+                "SubField[%s]: call end_emit() before sync_size()",
+                m_name.c_str());
+    wait_event(m_emit_event);
+    poll_size();
+    return size();
+}
+
+MUDA_INLINE void SubField::read_back_emit_count(cudaStream_t stream)
+{
+    if(!m_h_emit_count)
+        checkCudaErrors(cudaMallocHost(&m_h_emit_count, sizeof(int)));
+    Memory(stream).download(m_h_emit_count, m_emit_count.data(), sizeof(int));
+    Launch(stream).record(m_emit_event);
+    m_emit_read_back_queued = true;
+}
+
+namespace details
+{
+    // the element count of a checkpoint chunk of the entry
+    MUDA_INLINE uint32_t field_checkpoint_chunk_count(const FieldEntryBaseData& info, size_t chunk_bytes)
+    {
+        auto elem_total_byte_size = info.elem_byte_size * info.shape.x * info.shape.y;
+        MUDA_ASSERT(elem_total_byte_size <= chunk_bytes,
+                    "FieldCheckpoint: chunk_bytes=%llu is less than an element (%u bytes)",
+                    (unsigned long long)chunk_bytes,
+                    elem_total_byte_size);
+        return static_cast<uint32_t>(chunk_bytes / elem_total_byte_size);
+    }
+}  // namespace details
+
+MUDA_INLINE void SubField::checkpoint(FieldCheckpointWriter& writer,
+                                      PinnedStaging&         staging,
+                                      BufferView<std::byte>  device_chunk,
+                                      cudaStream_t           stream)
+{
+    sync_size();
+    auto& entries = m_interface->m_entries;
+    auto  count   = size();
+    writer.begin_sub_field(m_name,
+                           m_interface->m_layout_info,
+                           count,
+                           static_cast<uint32_t>(entries.size()));
+
+    // the chunk being downloaded, it is written to the file while the next one is downloading
+    struct Pending
+    {
+        int      slot;
+        uint64_t first;
+        uint64_t count;
+        size_t   size;
+    };
+    std::optional<Pending> pending;
+    auto                   write_pending = [&]
+    {
+        if(!pending)
+            return;
+        wait_event(staging.event(pending->slot));
+        writer.write_chunk(pending->first, pending->count, staging.host(pending->slot), pending->size);
+        pending.reset();
+    };
+
+    int slot = 0;
+    for(auto& e : entries)
+    {
+        write_pending();
+
+        FieldCheckpointEntryInfo info;
+        info.name           = e->m_name;
+        info.type           = e->m_info.type;
+        info.elem_byte_size = e->m_info.elem_byte_size;
+        info.shape          = e->m_info.shape;
+        info.count          = count;
+        writer.begin_entry(info);
+
+        details::FieldRelayoutAccessor src{m_interface->m_data_buffer, e->m_info, e->m_name_ptr};
+        size_t chunk_count = details::field_checkpoint_chunk_count(e->m_info, staging.chunk_bytes());
+        for(size_t first = 0; first < count; first += chunk_count)
+        {
+            auto chunk  = std::min(chunk_count, count - first);
+            auto packed = details::field_packed_entry_info(e->m_info, chunk);
+            details::FieldRelayoutAccessor dst{device_chunk.data(), packed, e->m_name_ptr};
+            details::field_relayout_entry(src, first, dst, 0, chunk, stream);
+
+            auto bytes = chunk * info.elem_total_byte_size();
+            // the host chunk of this slot is already written (two chunks ago)
+            Memory(stream).download(staging.host(slot), device_chunk.data(), bytes);
+            Launch(stream).record(staging.event(slot));
+
+            write_pending();
+            pending = Pending{slot, first, chunk, bytes};
+            slot ^= 1;
+        }
+    }
+    write_pending();
+}
+
+MUDA_INLINE void SubField::restore(FieldCheckpointReader&         reader,
+                                   const FieldCheckpointSubField& saved,
+                                   PinnedStaging&                 staging,
+                                   BufferView<std::byte>          device_chunk,
+                                   cudaStream_t                   stream)
+{
+    MUDA_ASSERT(m_is_built, "SubField[%s]: build it before restoring", m_name.c_str());
+    resize(saved.count, stream);
+
+    int slot = 0;
+    for(auto& saved_entry : saved.entries)
+    {
+        auto& info = saved_entry.info;
+        auto  e    = find_entry(info.name);
+        if(!e)
+            continue;
+
+        MUDA_ASSERT(e->m_info.type == info.type && e->m_info.elem_byte_size == info.elem_byte_size
+                        && e->m_info.shape.x == info.shape.x && e->m_info.shape.y == info.shape.y,
+                    "SubField[%s]: entry[%s] mismatches the checkpoint, elem_byte_size=%u/%u, shape=(%u,%u)/(%u,%u)",
+                    m_name.c_str(),
+                    info.name.c_str(),
+                    e->m_info.elem_byte_size,
+                    info.elem_byte_size,
+                    e->m_info.shape.x,
+                    e->m_info.shape.y,
+                    info.shape.x,
+                    info.shape.y);
+
+        details::FieldRelayoutAccessor dst{m_interface->m_data_buffer, e->m_info, e->m_name_ptr};
+        for(auto& chunk : saved_entry.chunks)
+        {
+            // the upload from this host chunk (two chunks ago) must be done
+            wait_event(staging.event(slot));
+            reader.read_chunk(chunk, staging.host(slot));
+            Memory(stream).upload(device_chunk.data(), staging.host(slot), chunk.size);
+            Launch(stream).record(staging.event(slot));
+
+            auto packed = details::field_packed_entry_info(e->m_info, chunk.count);
+            details::FieldRelayoutAccessor src{device_chunk.data(), packed, e->m_name_ptr};
+            details::field_relayout_entry(src, 0, dst, chunk.first, chunk.count, stream);
+            slot ^= 1;
+        }
+    }
 }
-}  // namespace muda
\ No newline at end of file
+}  // namespace muda
@@ -0,0 +1,54 @@
+#include <device_atomic_functions.h>
+#include <muda/tools/warp_reserve.h>
+
+namespace muda
+{
+MUDA_INLINE MUDA_DEVICE int SubFieldEmitter::append(int n)
+{
+    MUDA_KERNEL_ASSERT(m_count, "SubFieldEmitter[%s:%s]: not initialized", name(), kernel_name());
+
+    // never let the count exceed the capacity, so a rejected request leaves no hole
+    auto try_reserve = [this](int size) -> int
+    {
+        int old = *static_cast<volatile int*>(m_count);
+        int assumed;
+        do
+        {
+            assumed = old;
+            if(assumed + size > m_capacity)
+                return -1;
+            old = atomicCAS(m_count, assumed, assumed + size);
+        } while(assumed != old);
+        return old;
+    };
+
+    return details::warp_aggregated_reserve(m_count, n, -1, try_reserve);
+}
+
+MUDA_INLINE MUDA_DEVICE void SubFieldEmitter::kill(int i)
+{
+    MUDA_KERNEL_ASSERT(i >= 0 && i < m_capacity,
+                       "SubFieldEmitter[%s:%s]: index out of range, capacity=%d, index=%d",
+                       name(),
+                       kernel_name(),
+                       m_capacity,
+                       i);
+    m_dead[i] = 1;
+}
+
+MUDA_INLINE MUDA_DEVICE bool SubFieldEmitter::is_dead(int i) const
+{
+    MUDA_KERNEL_ASSERT(i >= 0 && i < m_capacity,
+                       "SubFieldEmitter[%s:%s]: index out of range, capacity=%d, index=%d",
+                       name(),
+                       kernel_name(),
+                       m_capacity,
+                       i);
+    return m_dead[i] != 0;
+}
+
+MUDA_INLINE MUDA_DEVICE int SubFieldEmitter::count() const
+{
+    return *static_cast<volatile int*>(m_count);
+}
+}  // namespace muda
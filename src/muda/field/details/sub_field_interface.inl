@@ -3,37 +3,102 @@ namespace muda
 MUDA_INLINE SubFieldInterface::~SubFieldInterface()
 {
     if(m_data_buffer)
-        Memory().free(m_data_buffer).wait();
+        retire_data_buffer(m_data_buffer, nullptr);
+    free_retired_buffers(true);
 };
 
-template <typename F>
-void SubFieldInterface::resize_data_buffer(size_t size, F&& func)
+MUDA_INLINE void SubFieldInterface::resize(size_t num_elements, cudaStream_t stream)
 {
-    if(m_data_buffer == nullptr)
+    if(num_elements > m_capacity)
+        reallocate(grown_capacity(num_elements), stream);
+
+    m_num_elements = num_elements;
+    for(auto& e : m_entries)
     {
-        Memory().alloc(&m_data_buffer, size).set(m_data_buffer, size, 0).wait();
-        m_data_buffer_size = size;
+        e->m_info.elem_count = num_elements;
     }
-    else if(size > m_data_buffer_size)
+}
+
+MUDA_INLINE void SubFieldInterface::reserve(size_t capacity, cudaStream_t stream)
+{
+    if(capacity > m_capacity)
+        reallocate(capacity, stream);
+}
+
+MUDA_INLINE void SubFieldInterface::shrink_to_fit(cudaStream_t stream)
+{
+    if(m_capacity > m_num_elements)
+        reallocate(m_num_elements, stream);
+}
+
+MUDA_INLINE size_t SubFieldInterface::grown_capacity(size_t num_elements) const
+{
+    auto factor = std::max(build_options().growth_factor, 1.0f);
+    auto grown  = static_cast<size_t>(static_cast<double>(m_capacity) * factor);
+    return std::max(grown, num_elements);
+}
+
+template <typename F>
+void SubFieldInterface::reallocate_data_buffer(size_t size, cudaStream_t stream, F&& func)
+{
+    // the buffers retired by the former reallocations may be done by now
+    free_retired_buffers(false);
+
+    auto old_ptr  = m_data_buffer;
+    auto old_size = m_data_buffer_size;
+
+    std::byte* new_ptr = nullptr;
+    if(size > 0)
     {
-        auto old_ptr       = m_data_buffer;
-        auto old_size      = m_data_buffer_size;
-        m_data_buffer_size = size;
-        Memory().alloc(&m_data_buffer, size);
-        func(old_ptr, old_size, m_data_buffer, size);
-        Memory().free(old_ptr).wait();
+        Memory(stream).alloc(&new_ptr, size);
+        if(old_ptr)
+            func(old_ptr, old_size, new_ptr, size);
+        else
+            Memory(stream).set(new_ptr, size, 0);
     }
+
+    if(old_ptr)
+        retire_data_buffer(old_ptr, stream);
+
+    m_data_buffer      = new_ptr;
+    m_data_buffer_size = size;
+}
+
+MUDA_INLINE void SubFieldInterface::copy_reallocate_data_buffer(size_t size, cudaStream_t stream)
+{
+    reallocate_data_buffer(size,
+                           stream,
+                           [stream](std::byte* old_ptr, size_t old_size, std::byte* new_ptr, size_t new_size)
+                           {
+                               auto copy_size = std::min(old_size, new_size);
+                               Memory(stream)
+                                   .set(new_ptr + copy_size, new_size - copy_size, 0)  // set the new memory to 0
+                                   .transfer(new_ptr, old_ptr, copy_size);  // copy the old memory to the new memory
+                           });
+}
+
+MUDA_INLINE void SubFieldInterface::retire_data_buffer(std::byte* ptr, cudaStream_t stream)
+{
+    RetiredBuffer retired{ptr, Event{}};
+    Launch(stream).record(retired.event);
+    m_retired_buffers.push_back(std::move(retired));
 }
 
-MUDA_INLINE void SubFieldInterface::copy_resize_data_buffer(size_t size)
+MUDA_INLINE void SubFieldInterface::free_retired_buffers(bool wait)
 {
-    resize_data_buffer(size,
-                       [](std::byte* old_ptr, size_t old_size, std::byte* new_ptr, size_t new_size)
-                       {
-                           Memory()
-                               .set(new_ptr + old_size, new_size - old_size, 0)  // set the new memory to 0
-                               .transfer(new_ptr, old_ptr, old_size);  // copy the old memory to the new memory
-                       });
+    auto it = std::remove_if(m_retired_buffers.begin(),
+                             m_retired_buffers.end(),
+                             [wait](RetiredBuffer& b)
+                             {
+                                 if(wait)
+                                     wait_event(b.event);
+                                 else if(b.event.query() == Event::QueryResult::eNotReady)
+                                     return false;
+                                 // nothing is using the buffer anymore
+                                 Memory().free(b.ptr);
+                                 return true;
+                             });
+    m_retired_buffers.erase(it, m_retired_buffers.end());
 }
 
 MUDA_INLINE uint32_t SubFieldInterface::round_up(uint32_t x, uint32_t n)
@@ -51,4 +116,4 @@ MUDA_INLINE uint32_t SubFieldInterface::align(uint32_t offset,
     return round_up(offset, alignment);
 }
 
-}  // namespace muda
\ No newline at end of file
+}  // namespace muda
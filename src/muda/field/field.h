@@ -38,6 +38,20 @@ class Field
     
     // create or find a subfield
     SubField& operator[](std::string_view name);
+
+    /// <summary>
+    /// Save all the built subfields to a checkpoint file (see FieldCheckpointWriter), the data is
+    /// stored independent of the layout. The device to host copy of a chunk overlaps the file
+    /// write of the previous one through two pinned staging chunks of `chunk_bytes`.
+    /// </summary>
+    void checkpoint(const std::string& path, cudaStream_t stream = nullptr, size_t chunk_bytes = 64_M);
+    /// <summary>
+    /// Load a checkpoint into the subfields of the same names. They must be built already, the
+    /// entries are matched by name and must have the same type/shape/element size, the layout
+    /// may differ. The subfields are resized to the saved size, the subfields and entries not in
+    /// the checkpoint are left untouched. Returns when the data is on the device.
+    /// </summary>
+    void restore(const std::string& path, cudaStream_t stream = nullptr, size_t chunk_bytes = 64_M);
 };
 }  // namespace muda
 
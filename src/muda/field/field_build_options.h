@@ -7,5 +7,7 @@ class FieldBuildOptions
   public:
     uint32_t min_alignment = sizeof(int);  // bytes
     uint32_t max_alignment = sizeof(std::max_align_t);
+    // when a resize exceeds the capacity, the capacity grows to max(size, capacity * growth_factor)
+    float growth_factor = 1.5f;
 };
 }  // namespace muda
\ No newline at end of file
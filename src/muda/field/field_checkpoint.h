@@ -0,0 +1,180 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <muda/mstl/span.h>
+#include <muda/field/field_entry_type.h>
+#include <muda/field/field_entry_layout.h>
+
+namespace muda
+{
+namespace details
+{
+    // checkpoint file layout (host byte order), every section is 16 bytes aligned:
+    //  FieldCheckpointHeader
+    //  {
+    //      FieldCheckpointSubFieldHeader, name
+    //      {
+    //          FieldCheckpointEntryHeader, name
+    //          { FieldCheckpointChunkHeader, data } ... (until the chunks cover all the elements)
+    //      } ...
+    //  } ...
+    // the data of a chunk is the elements [first, first + count) of an entry, packed component
+    // by component (column major): comp0[count], comp1[count], ..., whatever the layout in memory is.
+    constexpr uint32_t field_checkpoint_version = 1;
+
+    class FieldCheckpointHeader
+    {
+      public:
+        char     magic[8]        = {'M', 'U', 'D', 'A', 'F', 'L', 'D', '\0'};
+        uint32_t version         = field_checkpoint_version;
+        uint32_t sub_field_count = 0;
+        uint64_t reserved        = 0;
+        uint64_t reserved1       = 0;
+    };
+
+    class FieldCheckpointSubFieldHeader
+    {
+      public:
+        char     magic[4]             = {'S', 'U', 'B', 'F'};
+        uint32_t name_size            = 0;  // followed by the name, padded to 16 bytes
+        uint32_t entry_count          = 0;
+        uint32_t layout               = 0;  // FieldEntryLayout when saved, informative
+        uint32_t innermost_array_size = 0;
+        uint32_t reserved             = 0;
+        uint64_t count                = 0;
+    };
+
+    class FieldCheckpointEntryHeader
+    {
+      public:
+        char     magic[4]       = {'E', 'N', 'T', 'R'};
+        uint32_t name_size      = 0;  // followed by the name, padded to 16 bytes
+        uint32_t type           = 0;  // FieldEntryType
+        uint32_t elem_byte_size = 0;
+        uint32_t shape_x        = 0;
+        uint32_t shape_y        = 0;
+        uint64_t count          = 0;
+    };
+
+    class FieldCheckpointChunkHeader
+    {
+      public:
+        char     magic[4] = {'C', 'H', 'N', 'K'};
+        uint32_t reserved = 0;
+        uint64_t first    = 0;  // the first element
+        uint64_t count    = 0;  // element count
+        uint64_t size     = 0;  // byte size of the data, followed by the data, padded to 16 bytes
+    };
+}  // namespace details
+
+class FieldCheckpointEntryInfo
+{
+  public:
+    std::string    name;
+    FieldEntryType type           = FieldEntryType::None;
+    uint32_t       elem_byte_size = 0;
+    uint2          shape          = {0, 0};
+    uint64_t       count          = 0;
+
+    uint64_t comp_count() const { return uint64_t{shape.x} * shape.y; }
+    // the byte size of one element with all its components
+    uint64_t elem_total_byte_size() const { return comp_count() * elem_byte_size; }
+};
+
+/// <summary>
+/// FieldCheckpointWriter: writes the checkpoint format, host only.
+/// Field::checkpoint() drives it, it can also be fed by host buffers directly.
+/// usage:
+///     FieldCheckpointWriter w("state.mudafield", 1);
+///     w.begin_sub_field("particle", layout_info, N, 1);
+///     w.begin_entry(info);
+///     w.write_chunk(0, N, packed_data, packed_size);
+/// </summary>
+class FieldCheckpointWriter
+{
+  public:
+    FieldCheckpointWriter(const std::string& path, uint32_t sub_field_count);
+    ~FieldCheckpointWriter();
+
+    // delete copy
+    FieldCheckpointWriter(const FieldCheckpointWriter&)            = delete;
+    FieldCheckpointWriter& operator=(const FieldCheckpointWriter&) = delete;
+
+    void begin_sub_field(std::string_view     name,
+                         FieldEntryLayoutInfo layout_info,
+                         uint64_t             count,
+                         uint32_t             entry_count);
+    void begin_entry(const FieldCheckpointEntryInfo& info);
+    // data: the packed elements [first, first + count) of the current entry
+    void write_chunk(uint64_t first, uint64_t count, const void* data, size_t size);
+
+    void close();
+
+  private:
+    void write(const void* data, size_t size);
+    void write_name(std::string_view name);
+    void pad();
+
+    std::ofstream m_file;
+    size_t        m_written = 0;
+    // the current entry
+    FieldCheckpointEntryInfo m_entry;
+    uint64_t                 m_entry_written = 0;
+};
+
+class FieldCheckpointChunk
+{
+  public:
+    uint64_t first       = 0;
+    uint64_t count       = 0;
+    uint64_t size        = 0;
+    uint64_t file_offset = 0;  // of the data
+};
+
+class FieldCheckpointEntry
+{
+  public:
+    FieldCheckpointEntryInfo          info;
+    std::vector<FieldCheckpointChunk> chunks;
+};
+
+class FieldCheckpointSubField
+{
+  public:
+    std::string                       name;
+    FieldEntryLayoutInfo              layout_info;
+    uint64_t                          count = 0;
+    std::vector<FieldCheckpointEntry> entries;
+
+    const FieldCheckpointEntry* find_entry(std::string_view name) const;
+};
+
+/// <summary>
+/// FieldCheckpointReader: reads the metadata of a checkpoint when opened, the chunk data
+/// is read on demand, so a checkpoint larger than the host memory can be restored.
+/// Host only.
+/// </summary>
+class FieldCheckpointReader
+{
+  public:
+    explicit FieldCheckpointReader(const std::string& path);
+
+    span<const FieldCheckpointSubField> sub_fields() const { return m_sub_fields; }
+    const FieldCheckpointSubField*      find_sub_field(std::string_view name) const;
+
+    // read the packed data of a chunk, dst must hold chunk.size bytes
+    void read_chunk(const FieldCheckpointChunk& chunk, void* dst);
+
+  private:
+    void read(void* data, size_t size);
+    std::string read_name(uint32_t size);
+
+    std::ifstream                        m_file;
+    std::string                          m_path;
+    std::vector<FieldCheckpointSubField> m_sub_fields;
+};
+}  // namespace muda
+
+#include "details/field_checkpoint.inl"
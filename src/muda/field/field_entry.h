@@ -83,6 +83,21 @@ class FieldEntry : public FieldEntryBase
     }
     FieldEntryViewer<T, Layout, M, N>  viewer();
     CFieldEntryViewer<T, Layout, M, N> cviewer() const;
+
+    /// <summary>
+    /// A viewer whose layout, shape, element size and AoSoA innermost array size are
+    /// template parameters, so the element address needs no runtime division.
+    /// The entry must be built with a compile-time Layout (AoS/SoA/AoSoA), and
+    /// InnermostArraySize must match the layout info the field was built with.
+    /// </summary>
+    template <uint32_t InnermostArraySize = 32>
+    StaticFieldEntryViewer<T, Layout, M, N, InnermostArraySize> static_viewer();
+    template <uint32_t InnermostArraySize = 32>
+    CStaticFieldEntryViewer<T, Layout, M, N, InnermostArraySize> cstatic_viewer() const;
+
+  private:
+    template <uint32_t InnermostArraySize>
+    void check_static_layout() const;
 };
 
 template <typename T, FieldEntryLayout Layout>
@@ -41,6 +41,15 @@ class FieldEntryLayoutInfo
 
     MUDA_GENERIC FieldEntryLayoutInfo() MUDA_NOEXCEPT {}
 
+    MUDA_GENERIC bool operator==(const FieldEntryLayoutInfo& rhs) const MUDA_NOEXCEPT
+    {
+        return m_layout == rhs.m_layout && m_innermost_array_size == rhs.m_innermost_array_size;
+    }
+    MUDA_GENERIC bool operator!=(const FieldEntryLayoutInfo& rhs) const MUDA_NOEXCEPT
+    {
+        return !(*this == rhs);
+    }
+
   private:
     Layout   m_layout               = Layout::AoSoA;
     uint32_t m_innermost_array_size = 32;
@@ -65,10 +65,15 @@ template <typename T, FieldEntryLayout Layout, int M, int N>
 class FieldEntryViewer;
 template <typename T, FieldEntryLayout Layout, int M, int N>
 class CFieldEntryViewer;
+template <typename T, FieldEntryLayout Layout, int M, int N, uint32_t InnermostArraySize>
+class StaticFieldEntryViewer;
+template <typename T, FieldEntryLayout Layout, int M, int N, uint32_t InnermostArraySize>
+class CStaticFieldEntryViewer;
 // implementation is in details/entry_viewers/ ...
 
 }  // namespace muda
 
 #include "details/field_entry_viewer.inl"
 #include "details/entry_viewers/compile_time_layout_viewer.inl"
-#include "details/entry_viewers/runtime_layout_viewer.inl"
\ No newline at end of file
+#include "details/entry_viewers/runtime_layout_viewer.inl"
+#include "details/entry_viewers/static_layout_viewer.inl"
\ No newline at end of file
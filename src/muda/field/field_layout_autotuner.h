@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <muda/field/sub_field.h>
+#include <muda/launch/event.h>
+
+namespace muda
+{
+/// <summary>
+/// Time a user provided access pattern under several layouts and keep the fastest one.
+/// The subfield must be built with a runtime layout (builder(layout_info)).
+/// usage:
+///     FieldLayoutAutotuner tuner{particle};
+///     auto best = tuner.tune([&](cudaStream_t s)
+///     {
+///         // create the viewers inside, they are invalidated by every relayout
+///         ParallelFor(256, 0, s).apply(N, [x = x.viewer()] __device__(int i) mutable { ... });
+///     });
+/// </summary>
+class FieldLayoutAutotuner
+{
+  public:
+    struct Result
+    {
+        FieldEntryLayoutInfo layout;
+        float                ms;  // average time of one access
+    };
+
+    FieldLayoutAutotuner(SubField& sub_field, cudaStream_t stream = nullptr);
+
+    // the layouts to try, default: AoS, SoA, AoSoA(32)
+    FieldLayoutAutotuner& candidates(std::vector<FieldEntryLayoutInfo> layouts);
+    // the number of timed runs for each layout (after one warmup run)
+    FieldLayoutAutotuner& repeat(int count);
+
+    /// <summary>
+    /// Relayout the subfield to every candidate, time `access` and leave the subfield in the
+    /// fastest layout.
+    /// </summary>
+    /// <param name="access">void(cudaStream_t stream), launch the kernels to be timed on `stream`</param>
+    /// <returns>the fastest layout</returns>
+    template <typename F>
+    FieldEntryLayoutInfo tune(F&& access);
+
+    const std::vector<Result>& results() const { return m_results; }
+
+  private:
+    SubField&                         m_sub_field;
+    cudaStream_t                      m_stream;
+    std::vector<FieldEntryLayoutInfo> m_candidates;
+    int                               m_repeat = 10;
+    std::vector<Result>               m_results;
+};
+}  // namespace muda
+
+#include "details/field_layout_autotuner.inl"
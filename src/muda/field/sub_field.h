@@ -6,6 +6,8 @@
 #include <muda/field/field_entry_type.h>
 #include <muda/field/field_builder.h>
 #include <muda/field/sub_field_interface.h>
+#include <muda/field/field_entry_base_data.h>
+#include <muda/field/sub_field_emitter.h>
 
 namespace muda
 {
@@ -13,6 +15,10 @@ class Field;
 class FieldEntryBase;
 template <typename T, FieldEntryLayout Layout, int M, int N>
 class FieldEntry;
+class FieldCheckpointWriter;
+class FieldCheckpointReader;
+class FieldCheckpointSubField;
+class PinnedStaging;
 
 class SubField
 {
@@ -23,8 +29,26 @@ class SubField
     std::string          m_name;
     U<SubFieldInterface> m_interface;
     bool                 m_is_built = false;
+    // built by builder(layout_info), the entries address the data by a runtime layout
+    bool m_is_runtime_layout = false;
     std::byte* data_buffer() const { return m_interface->m_data_buffer; }
 
+    // scratch of permute/sort_by_key/compact
+    DeviceBuffer<FieldEntryBaseData> m_gather_infos;
+    DeviceBuffer<int>                m_reorder_index;
+    DeviceBuffer<std::byte>          m_reorder_keys;
+    DeviceBuffer<std::byte>          m_reorder_temp_storage;
+
+    // device-side emission, see begin_emit()
+    DeviceBuffer<int> m_emit_count;  // the element count on the device
+    DeviceBuffer<int> m_dead;        // tombstones of the killed elements
+    DeviceBuffer<int> m_old_to_new;
+    int*              m_h_emit_count = nullptr;  // pinned, the read back count
+    Event             m_emit_event;
+    // size() is an upper bound until the device count is read back
+    bool m_emit_pending = false;
+    bool m_emit_read_back_queued = false;
+
 
     FieldEntryBase* find_entry(std::string_view name) const;
 
@@ -38,8 +62,71 @@ class SubField
     std::string_view name() const { return m_name; }
 
     size_t size() const;
+    size_t capacity() const;
     size_t num_entries() const { return m_interface->m_entries.size(); }
-    void   resize(size_t num_elements);
+    /// <summary>
+    /// Stream-ordered resize, the host is never blocked. When `num_elements` exceeds the
+    /// capacity, the buffer grows geometrically (see FieldBuildOptions::growth_factor), the
+    /// old elements are copied on `stream` and the old buffer is freed after the copy is done.
+    /// Note: the elements beyond the old size are zero only if they are newly allocated.
+    /// </summary>
+    void resize(size_t num_elements, cudaStream_t stream = nullptr);
+    // make sure the field can hold `capacity` elements without reallocation
+    void reserve(size_t capacity, cudaStream_t stream = nullptr);
+    // release the unused capacity
+    void shrink_to_fit(cudaStream_t stream = nullptr);
+
+    FieldEntryLayoutInfo layout_info() const;
+    /// <summary>
+    /// Convert the data to another layout (or another innermost array size) on `stream`.
+    /// The layout of a subfield built with a compile-time layout can't be changed, only its
+    /// innermost array size (AoSoA) can. The viewers created before are invalid afterwards.
+    /// </summary>
+    void relayout(FieldEntryLayoutInfo layout, cudaStream_t stream = nullptr);
+
+    /// <summary>
+    /// Reorder all the entries in one pass: new[i] = old[perm[i]], perm.size() == size().
+    /// The data is gathered into a new buffer on `stream`, the viewers created before are invalid afterwards.
+    /// </summary>
+    void permute(CBufferView<int> perm, cudaStream_t stream = nullptr);
+    /// <summary>
+    /// Stable sort the elements by `keys` (radix sort), keys.size() == size(), the keys are sorted in place.
+    /// e.g. sort the particles by their cell index to improve the locality of P2G/G2P.
+    /// </summary>
+    template <typename KeyT>
+    void sort_by_key(BufferView<KeyT> keys,
+                     cudaStream_t     stream    = nullptr,
+                     int              begin_bit = 0,
+                     int              end_bit   = sizeof(KeyT) * 8);
+    /// <summary>
+    /// Keep the elements whose mask is non-zero (the order is kept), mask.size() == size().
+    /// The new size is read back to the host, so it waits for `stream`.
+    /// </summary>
+    /// <returns>the new size</returns>
+    size_t compact(CBufferView<int> mask, cudaStream_t stream = nullptr);
+
+    /// <summary>
+    /// Begin a device-side emission of at most `max_emit` elements, the capacity grows if needed.
+    /// The kernels on `stream` append/kill elements through the returned emitter.
+    /// The count lives on the device: until it is read back (end_emit() + poll_size()/sync_size()),
+    /// size() is an upper bound, the size before plus all the max_emit, which is also the range
+    /// the entry viewers accept. Emissions can be chained without reading back the count.
+    /// The host is never blocked.
+    /// </summary>
+    SubFieldEmitter begin_emit(size_t max_emit, cudaStream_t stream = nullptr);
+    // queue the asynchronous read back of the device count
+    void end_emit(cudaStream_t stream = nullptr);
+    /// <summary>
+    /// Remove the killed elements on `stream` (the order is kept), the count stays on the device
+    /// and is read back asynchronously like end_emit().
+    /// </summary>
+    /// <returns>the old-to-new index map (-1: removed) of the elements before the compaction,
+    /// valid until the next call</returns>
+    CBufferView<int> compact_dead(cudaStream_t stream = nullptr);
+    // update size() if the device count is read back, never blocks, returns true if size() is exact
+    bool poll_size();
+    // wait for the device count, returns the exact size
+    size_t sync_size();
 
     template <FieldEntryLayout Layout>
     FieldBuilder<Layout> builder(FieldEntryLayoutInfo layout = FieldEntryLayoutInfo{Layout});
@@ -88,6 +175,24 @@ class SubField
                                               uint2                shape);
 
     void build(const FieldBuildOptions& options);
+
+    // gather the first `count` elements by `index` into a new buffer, then resize to `count`,
+    // d_count: the element count on the device (<= count) if not null
+    void gather(CBufferView<int> index, size_t count, cudaStream_t stream, const int* d_count = nullptr);
+    void read_back_emit_count(cudaStream_t stream);
+
+    static U<SubFieldInterface> create_interface(Field& field, FieldEntryLayoutInfo layout);
+
+    // staging: the pinned host chunks, device_chunk: the packed device chunk of the same size
+    void checkpoint(FieldCheckpointWriter& writer,
+                    PinnedStaging&         staging,
+                    BufferView<std::byte>  device_chunk,
+                    cudaStream_t           stream);
+    void restore(FieldCheckpointReader&         reader,
+                 const FieldCheckpointSubField& saved,
+                 PinnedStaging&                 staging,
+                 BufferView<std::byte>          device_chunk,
+                 cudaStream_t                   stream);
 };
 }  // namespace muda
 
@@ -33,12 +33,9 @@ MUDA_INLINE void SubFieldImpl<FieldEntryLayout::AoS>::build()
     }
 }
 
-MUDA_INLINE void SubFieldImpl<FieldEntryLayout::AoS>::resize(size_t num_elements)
+MUDA_INLINE void SubFieldImpl<FieldEntryLayout::AoS>::reallocate(size_t capacity, cudaStream_t stream)
 {
-    copy_resize_data_buffer(m_struct_stride * num_elements);
-    for(auto& e : m_entries)
-    {
-        e->m_info.elem_count = num_elements;
-    }
+    copy_reallocate_data_buffer(m_struct_stride * capacity, stream);
+    m_capacity = capacity;
 }
 }  // namespace muda
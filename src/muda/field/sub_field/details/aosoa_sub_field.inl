@@ -46,13 +46,14 @@ MUDA_INLINE void SubFieldImpl<FieldEntryLayout::AoSoA>::build()
     }
 }
 
-MUDA_INLINE void SubFieldImpl<FieldEntryLayout::AoSoA>::resize(size_t num_elements)
+MUDA_INLINE void SubFieldImpl<FieldEntryLayout::AoSoA>::reallocate(size_t capacity, cudaStream_t stream)
 {
-    size_t outer_size = round_up(num_elements, m_layout_info.innermost_array_size());
-    copy_resize_data_buffer(outer_size * m_struct_stride);
-    for(auto& e : m_entries)
-    {
-        e->m_info.elem_count = num_elements;
-    }
+    auto   innermost_array_size = m_layout_info.innermost_array_size();
+    size_t rounded_capacity     = round_up(capacity, innermost_array_size);
+    if(rounded_capacity == m_capacity)
+        return;
+    size_t outer_size = rounded_capacity / innermost_array_size;
+    copy_reallocate_data_buffer(outer_size * m_struct_stride, stream);
+    m_capacity = rounded_capacity;
 }
 }  // namespace muda
@@ -65,21 +65,22 @@ MUDA_INLINE void SubFieldImpl<FieldEntryLayout::SoA>::build()
 
 namespace details
 {
-    void soa_map_copy(BufferView<SoACopyMap> copy_maps,
-                      size_t                 base_strcut_stride,
-                      uint32_t               base,
-                      uint32_t               old_count_of_base,
-                      uint32_t               new_count_of_base,
-                      std::byte*             old_ptr,
-                      std::byte*             new_ptr)
+    // copy the first `copy_count_of_base` base arrays of every component column
+    MUDA_INLINE void soa_map_copy(BufferView<SoACopyMap> copy_maps,
+                                  cudaStream_t           stream,
+                                  uint32_t               base,
+                                  uint32_t               old_count_of_base,
+                                  uint32_t               new_count_of_base,
+                                  uint32_t               copy_count_of_base,
+                                  std::byte*             old_ptr,
+                                  std::byte*             new_ptr)
     {
-        auto rounded_old_count = old_count_of_base * base;
-        Memory().set(new_ptr, new_count_of_base * base_strcut_stride, 0).wait();
-        ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE)
-            .apply(old_count_of_base * base,
+        auto rounded_copy_count = copy_count_of_base * base;
+        ParallelFor(LIGHT_WORKLOAD_BLOCK_SIZE, 0, stream)
+            .apply(rounded_copy_count,
                    [old_ptr,
                     new_ptr,
-                    rounded_old_count,
+                    rounded_copy_count,
                     old_count_of_base,
                     new_count_of_base,
                     copy_maps = copy_maps.viewer()] __device__(int i) mutable
@@ -87,7 +88,6 @@ namespace details
                        for(int j = 0; j < copy_maps.dim(); ++j)
                        {
                            auto map = copy_maps(j);
-                           auto total_byte = rounded_old_count * map.elem_byte_size;  // the total byte
 
                            auto old_offset_in_struct =
                                map.offset_in_base_struct * old_count_of_base;
@@ -97,7 +97,7 @@ namespace details
 
                            for(int k = 0; k < map.elem_byte_size; ++k)
                            {
-                               auto begin  = rounded_old_count * k;
+                               auto begin  = rounded_copy_count * k;
                                auto offset = begin + i;
 
                                auto old_offset = old_offset_in_struct + offset;
@@ -107,38 +107,47 @@ namespace details
                                new_ptr[new_offset] = old_ptr[old_offset];
                            }
                        }
-                   })
-            .wait();
+                   });
     }
 }  // namespace details
 
-MUDA_INLINE void SubFieldImpl<FieldEntryLayout::SoA>::resize(size_t num_elements)
+MUDA_INLINE void SubFieldImpl<FieldEntryLayout::SoA>::reallocate(size_t capacity, cudaStream_t stream)
 {
+    // the SoA layout depends on the capacity, not on the element count
     auto base              = m_build_options.max_alignment;
-    auto old_count_of_base = (m_num_elements + base - 1) / base;
-    auto new_count_of_base = (num_elements + base - 1) / base;
-    auto rounded_new_count = base * new_count_of_base;
-    m_struct_stride        = m_base_struct_stride * new_count_of_base;
+    auto old_count_of_base = static_cast<uint32_t>(m_capacity / base);
+    auto new_count_of_base = static_cast<uint32_t>((capacity + base - 1) / base);
+    auto rounded_capacity  = base * new_count_of_base;
+    if(rounded_capacity == m_capacity)
+        return;
 
+    auto used_count_of_base = static_cast<uint32_t>((m_num_elements + base - 1) / base);
+    auto copy_count_of_base = std::min(used_count_of_base, new_count_of_base);
+    m_struct_stride         = m_base_struct_stride * new_count_of_base;
 
     for(auto& e : m_entries)
     {
         e->m_info.struct_stride = m_struct_stride;
         e->m_info.offset_in_struct = e->m_info.offset_in_base_struct * new_count_of_base;
-        e->m_info.elem_count_based_stride = e->m_info.elem_byte_size * rounded_new_count;
-        e->m_info.elem_count = num_elements;
+        e->m_info.elem_count_based_stride = e->m_info.elem_byte_size * rounded_capacity;
     }
 
-    resize_data_buffer(m_struct_stride,
-                       [&](std::byte* old_ptr, size_t old_size, std::byte* new_ptr, size_t new_size)
-                       {
-                           details::soa_map_copy(m_copy_map_buffer,
-                                                 m_base_struct_stride,
-                                                 base,
-                                                 old_count_of_base,
-                                                 new_count_of_base,
-                                                 old_ptr,
-                                                 new_ptr);
-                       });
+    reallocate_data_buffer(m_struct_stride,
+                           stream,
+                           [&](std::byte* old_ptr, size_t old_size, std::byte* new_ptr, size_t new_size)
+                           {
+                               Memory(stream).set(new_ptr, new_size, 0);
+                               if(copy_count_of_base == 0)
+                                   return;
+                               details::soa_map_copy(m_copy_map_buffer,
+                                                     stream,
+                                                     base,
+                                                     old_count_of_base,
+                                                     new_count_of_base,
+                                                     copy_count_of_base,
+                                                     old_ptr,
+                                                     new_ptr);
+                           });
+    m_capacity = rounded_capacity;
 }
 }  // namespace muda
@@ -24,7 +24,7 @@ class SubFieldImpl<FieldEntryLayout::SoA> : public SubFieldInterface
 
   protected:
     virtual void build() override;
-    virtual void resize(size_t num_elements) override;
+    virtual void reallocate(size_t capacity, cudaStream_t stream) override;
 
   public:
     using SubFieldInterface::SubFieldInterface;
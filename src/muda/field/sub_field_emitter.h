@@ -0,0 +1,53 @@
+#pragma once
+#include <muda/muda_def.h>
+#include <muda/viewer/viewer_base.h>
+
+namespace muda
+{
+/// <summary>
+/// SubFieldEmitter: appends and kills the elements of a SubField inside a kernel.
+/// Created by SubField::begin_emit(max_emit), see it for the life cycle.
+/// usage:
+///     auto emitter = particle.begin_emit(max_emit, stream);
+///     ParallelFor(256, 0, stream).apply(N, [emitter, pos = pos.viewer()] __device__(int i) mutable
+///     {
+///         if(should_die(i)) emitter.kill(i);
+///         if(should_spawn(i))
+///             if(auto j = emitter.append(); j >= 0) pos(j) = ...;
+///     });
+///     particle.end_emit(stream);
+/// </summary>
+class SubFieldEmitter : public ViewerBase
+{
+    MUDA_VIEWER_COMMON_NAME(SubFieldEmitter);
+
+    int* m_count    = nullptr;
+    int* m_dead     = nullptr;
+    int  m_capacity = 0;
+
+  public:
+    MUDA_GENERIC SubFieldEmitter() = default;
+    MUDA_GENERIC SubFieldEmitter(int* count, int* dead, int capacity) MUDA_NOEXCEPT
+        : m_count(count)
+        , m_dead(dead)
+        , m_capacity(capacity)
+    {
+    }
+
+    /// <summary>
+    /// Reserve `n` contiguous elements, the lanes of a warp appending to the same field
+    /// are aggregated into one atomic operation.
+    /// </summary>
+    /// <returns>the index of the first element, or -1 if the emit capacity is exceeded</returns>
+    MUDA_DEVICE int append(int n = 1);
+    // mark the element dead, it is removed by SubField::compact_dead()
+    MUDA_DEVICE void kill(int i);
+    MUDA_DEVICE bool is_dead(int i) const;
+    // the current element count, including the dead ones
+    MUDA_DEVICE int count() const;
+    // the max element count in this emission
+    MUDA_GENERIC int capacity() const { return m_capacity; }
+};
+}  // namespace muda
+
+#include "details/sub_field_emitter.inl"
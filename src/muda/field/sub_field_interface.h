@@ -5,6 +5,7 @@
 #include <vector>
 #include <unordered_map>
 #include <muda/mstl/span.h>
+#include <muda/launch/event.h>
 
 namespace muda
 {
@@ -26,19 +27,38 @@ class SubFieldInterface
     FieldBuildOptions                       m_build_options;
     std::unordered_map<std::string, size_t> m_name_to_index;
     size_t                                  m_num_elements     = 0;
+    size_t                                  m_capacity         = 0;
     uint32_t                                m_struct_stride    = ~0;
     std::byte*                              m_data_buffer      = nullptr;
     size_t                                  m_data_buffer_size = 0;
 
-    virtual void                build()                     = 0;
-    virtual void                resize(size_t num_elements) = 0;
+    // a replaced buffer is freed once the work queued before the replacement is done
+    struct RetiredBuffer
+    {
+        std::byte* ptr;
+        Event      event;
+    };
+    std::vector<RetiredBuffer> m_retired_buffers;
+
+    virtual void build() = 0;
+    // reallocate the data buffer to hold `capacity` elements (capacity >= m_num_elements),
+    // keep the first m_num_elements and update the entries, all on `stream`
+    virtual void reallocate(size_t capacity, cudaStream_t stream) = 0;
+
+    void resize(size_t num_elements, cudaStream_t stream);
+    void reserve(size_t capacity, cudaStream_t stream);
+    void shrink_to_fit(cudaStream_t stream);
+    size_t grown_capacity(size_t num_elements) const;
+
     const FieldEntryLayoutInfo& layout_info() const { return m_layout_info; }
     const FieldBuildOptions& build_options() const { return m_build_options; }
     size_t                   num_elements() const { return m_num_elements; }
 
-    void copy_resize_data_buffer(size_t size);
+    void copy_reallocate_data_buffer(size_t size, cudaStream_t stream);
     template <typename F>  // F: void(std::byte* old_ptr, size_t old_size, std::byte* new_ptr, size_t new_size)
-    void resize_data_buffer(size_t size, F&& func);
+    void reallocate_data_buffer(size_t size, cudaStream_t stream, F&& func);
+    void retire_data_buffer(std::byte* ptr, cudaStream_t stream);
+    void free_retired_buffers(bool wait);
 
     static uint32_t round_up(uint32_t total, uint32_t N);
     static uint32_t align(uint32_t offset, uint32_t size, uint32_t min_alignment, uint32_t max_alignment);
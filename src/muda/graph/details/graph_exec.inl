@@ -33,6 +33,25 @@ MUDA_INLINE void GraphExec::launch(cudaStream_t stream)
     checkCudaErrors(cudaGraphLaunch(m_handle, stream));
 }
 
+MUDA_INLINE bool GraphExec::update(cudaGraph_t graph)
+{
+#if CUDART_VERSION >= 12000
+    cudaGraphExecUpdateResultInfo info;
+    auto error = cudaGraphExecUpdate(m_handle, graph, &info);
+#else
+    cudaGraphNode_t           error_node;
+    cudaGraphExecUpdateResult result;
+    auto error = cudaGraphExecUpdate(m_handle, graph, &error_node, &result);
+#endif
+    if(error == cudaErrorGraphExecUpdateFailure)
+    {
+        cudaGetLastError();  // clear the error
+        return false;
+    }
+    checkCudaErrors(error);
+    return true;
+}
+
 template <typename T>
 void GraphExec::set_kernel_node_parms(S<KernelNode> node, const S<KernelNodeParms<T>>& new_parms)
 {
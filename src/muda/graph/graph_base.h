@@ -30,6 +30,7 @@ class GraphNode
 
   public:
     friend class GraphExec;
+    friend class ComputeGraphNodeBase;
     GraphNode()
         : m_handle(nullptr)
     {
@@ -33,6 +33,10 @@ class GraphExec
 
     void launch(cudaStream_t stream = nullptr);
 
+    // update all the node parameters from a graph with the same topology (cudaGraphExecUpdate),
+    // return false if the topology doesn't match
+    bool update(cudaGraph_t graph);
+
     template <typename T>
     void set_kernel_node_parms(S<KernelNode> node, const S<KernelNodeParms<T>>& new_parms);
 
@@ -41,6 +41,7 @@ class KernelNodeParms : public NodeParms
     auto shared_mem_bytes() { return m_parms.sharedMemBytes; }
     void shared_mem_bytes(unsigned int v) { m_parms.sharedMemBytes = v; }
     auto kernel_params() { return m_parms.kernelParams; }
+    const std::vector<void*>& args() const { return m_args; }
     void kernel_params(const std::vector<void*>& v)
     {
         m_args               = v;
@@ -3,5 +3,9 @@
 #include <muda/launch/event.h>
 #include <muda/launch/launch.h>
 #include <muda/launch/parallel_for.h>
+#include <muda/launch/auto_block.h>
 #include <muda/launch/memory.h>
-#include <muda/launch/host_call.h>
\ No newline at end of file
+#include <muda/launch/host_call.h>
+#include <muda/launch/host_thread_pool.h>
+#include <muda/launch/host_parallel_for.h>
+#include <muda/launch/host_launch.h>
@@ -0,0 +1,132 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <muda/launch/occupancy_oracle.h>
+
+namespace muda
+{
+/// <summary>
+/// Let ParallelFor/Launch pick the block size reaching the max occupancy of the concrete
+/// kernel instantiation, instead of a hand-picked one (e.g. LIGHT_WORKLOAD_BLOCK_SIZE).
+/// usage:
+///     ParallelFor(AutoBlock{}).apply(N, [=] __device__(int i) mutable { ... });
+///     // with dynamic shared memory depending on the block size
+///     ParallelFor(AutoBlock{[](int block_size) { return block_size * sizeof(float); }})
+///         .apply(N, ...);
+/// </summary>
+class AutoBlock
+{
+  public:
+    explicit AutoBlock(int block_size_limit = 0)
+        : block_size_limit(block_size_limit)
+    {
+    }
+
+    explicit AutoBlock(std::function<size_t(int)> shared_mem_bytes, int block_size_limit = 0)
+        : block_size_limit(block_size_limit)
+        , shared_mem_bytes(std::move(shared_mem_bytes))
+    {
+    }
+
+    // the max block size, 0 means no limit
+    int block_size_limit = 0;
+    // block size -> dynamic shared memory bytes, empty means none.
+    // the suggested block size is cached per kernel, this is evaluated on every launch.
+    std::function<size_t(int)> shared_mem_bytes;
+
+    // the dynamic shared memory bytes of a launch with `block_size`
+    size_t dynamic_shared_mem_bytes(int block_size) const
+    {
+        return shared_mem_bytes ? shared_mem_bytes(block_size) : 0;
+    }
+};
+
+// the cached part of a launch config, the dynamic shared memory comes from the AutoBlock of each launch
+class AutoBlockConfig
+{
+  public:
+    int block_size    = 0;
+    int min_grid_size = 0;
+    // the max dynamic shared memory of a block of `block_size`
+    size_t max_shared_mem_bytes = 0;
+};
+
+class AutoBlockStats
+{
+  public:
+    size_t hit_count    = 0;
+    size_t miss_count   = 0;
+    size_t cached_count = 0;
+};
+
+/// <summary>
+/// A thread-safe cache of AutoBlockConfig, keyed by (device, kernel function pointer, policy).
+/// The oracle is only asked on the first launch of a kernel. Only whether a policy has a shared
+/// memory callback is part of the key, so the callback itself is never cached: it is checked
+/// against the cached block size on every launch, and if it needs more shared memory than a
+/// block of that size can get, the oracle is asked again for this launch (not cached).
+/// Oracle requirements:
+///     int device();
+///     OccupancySuggestion suggest(const void* func,
+///                                 const std::function&lt;size_t(int)&gt;&amp; shared_mem_bytes,
+///                                 int block_size_limit);
+///     size_t available_shared_mem_bytes(const void* func, int block_size);
+/// </summary>
+template <typename Oracle>
+class AutoBlockCache
+{
+  public:
+    AutoBlockCache() = default;
+
+    AutoBlockCache(const AutoBlockCache&)            = delete;
+    AutoBlockCache& operator=(const AutoBlockCache&) = delete;
+
+    // the process-wide cache used by ParallelFor and Launch
+    static AutoBlockCache& instance();
+
+    AutoBlockConfig select(const void* func, const AutoBlock& policy);
+
+    void           clear();
+    AutoBlockStats stats() const;
+    void           reset_stats();
+
+    Oracle& oracle() { return m_oracle; }
+
+  private:
+    AutoBlockConfig query(const void* func, const AutoBlock& policy);
+
+    class Key
+    {
+      public:
+        int         device           = 0;
+        const void* func             = nullptr;
+        int         block_size_limit = 0;
+        bool        has_shared_mem   = false;
+
+        friend bool operator==(const Key& lhs, const Key& rhs)
+        {
+            return lhs.device == rhs.device && lhs.func == rhs.func
+                   && lhs.block_size_limit == rhs.block_size_limit
+                   && lhs.has_shared_mem == rhs.has_shared_mem;
+        }
+    };
+
+    class KeyHash
+    {
+      public:
+        size_t operator()(const Key& key) const noexcept;
+    };
+
+    Oracle                                            m_oracle;
+    mutable std::shared_mutex                         m_mutex;
+    std::unordered_map<Key, AutoBlockConfig, KeyHash> m_configs;
+    std::atomic<size_t>                               m_hit_count  = 0;
+    std::atomic<size_t>                               m_miss_count = 0;
+};
+
+using DeviceAutoBlockCache = AutoBlockCache<CudaOccupancyOracle>;
+}  // namespace muda
+
+#include "details/auto_block.inl"
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <mutex>
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+template <typename Oracle>
+MUDA_INLINE AutoBlockCache<Oracle>& AutoBlockCache<Oracle>::instance()
+{
+    static AutoBlockCache cache;
+    return cache;
+}
+
+template <typename Oracle>
+MUDA_INLINE size_t AutoBlockCache<Oracle>::KeyHash::operator()(const Key& key) const noexcept
+{
+    auto h = std::hash<const void*>{}(key.func);
+    h ^= std::hash<int>{}(key.device) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    h ^= std::hash<int>{}(key.block_size_limit * 2 + key.has_shared_mem)
+         + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    return h;
+}
+
+template <typename Oracle>
+MUDA_INLINE AutoBlockConfig AutoBlockCache<Oracle>::select(const void* func, const AutoBlock& policy)
+{
+    MUDA_ASSERT(func, "kernel function is nullptr");
+    MUDA_ASSERT(policy.block_size_limit >= 0, "block_size_limit must be >= 0");
+
+    // another shared memory callback of the kernel may need more than the cached block size leaves
+    auto fits = [&](const AutoBlockConfig& config)
+    {
+        return policy.dynamic_shared_mem_bytes(config.block_size) <= config.max_shared_mem_bytes;
+    };
+
+    Key key{m_oracle.device(), func, policy.block_size_limit, static_cast<bool>(policy.shared_mem_bytes)};
+    {
+        std::shared_lock lock(m_mutex);
+        auto             iter = m_configs.find(key);
+        if(iter != m_configs.end() && fits(iter->second))
+        {
+            ++m_hit_count;
+            return iter->second;
+        }
+    }
+
+    std::unique_lock lock(m_mutex);
+    auto             iter = m_configs.find(key);
+    if(iter != m_configs.end())
+    {
+        if(fits(iter->second))  // another thread got it first
+        {
+            ++m_hit_count;
+            return iter->second;
+        }
+        ++m_miss_count;
+        return query(func, policy);
+    }
+    ++m_miss_count;
+
+    auto config = query(func, policy);
+    m_configs.emplace(key, config);
+    return config;
+}
+
+template <typename Oracle>
+MUDA_INLINE AutoBlockConfig AutoBlockCache<Oracle>::query(const void* func, const AutoBlock& policy)
+{
+    auto suggestion = m_oracle.suggest(func, policy.shared_mem_bytes, policy.block_size_limit);
+    MUDA_ASSERT(suggestion.block_size > 0,
+                "the occupancy oracle suggests an invalid block size %d",
+                suggestion.block_size);
+
+    AutoBlockConfig config;
+    config.block_size = suggestion.block_size;
+    if(policy.block_size_limit > 0)
+        config.block_size = std::min(config.block_size, policy.block_size_limit);
+    config.min_grid_size        = std::max(suggestion.min_grid_size, 1);
+    config.max_shared_mem_bytes = m_oracle.available_shared_mem_bytes(func, config.block_size);
+
+    MUDA_ASSERT(policy.dynamic_shared_mem_bytes(config.block_size) <= config.max_shared_mem_bytes,
+                "AutoBlock: %llu bytes of dynamic shared memory don't fit a block of %d threads (max %llu)",
+                (unsigned long long)policy.dynamic_shared_mem_bytes(config.block_size),
+                config.block_size,
+                (unsigned long long)config.max_shared_mem_bytes);
+    return config;
+}
+
+template <typename Oracle>
+MUDA_INLINE void AutoBlockCache<Oracle>::clear()
+{
+    std::unique_lock lock(m_mutex);
+    m_configs.clear();
+}
+
+template <typename Oracle>
+MUDA_INLINE AutoBlockStats AutoBlockCache<Oracle>::stats() const
+{
+    std::shared_lock lock(m_mutex);
+    AutoBlockStats   s;
+    s.hit_count    = m_hit_count;
+    s.miss_count   = m_miss_count;
+    s.cached_count = m_configs.size();
+    return s;
+}
+
+template <typename Oracle>
+MUDA_INLINE void AutoBlockCache<Oracle>::reset_stats()
+{
+    m_hit_count  = 0;
+    m_miss_count = 0;
+}
+}  // namespace muda
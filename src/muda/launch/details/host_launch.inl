@@ -0,0 +1,111 @@
+#include <muda/type_traits/always.h>
+
+namespace muda
+{
+namespace details
+{
+    template <typename F>
+    MUDA_HOST void host_invoke_with_range(F& f, unsigned int x, unsigned int y, unsigned int z)
+    {
+        // keep the same dispatch as generic_kernel_with_range
+        if constexpr(std::is_invocable_v<F, int2>)
+        {
+            f(int2{static_cast<int>(x), static_cast<int>(y)});
+        }
+        else if constexpr(std::is_invocable_v<F, int3>)
+        {
+            f(int3{static_cast<int>(x), static_cast<int>(y), static_cast<int>(z)});
+        }
+        else if constexpr(std::is_invocable_v<F, uint1>)
+        {
+            f(uint1{x});
+        }
+        else if constexpr(std::is_invocable_v<F, uint2>)
+        {
+            f(uint2{x, y});
+        }
+        else if constexpr(std::is_invocable_v<F, uint3>)
+        {
+            f(uint3{x, y, z});
+        }
+        else if constexpr(std::is_invocable_v<F, dim3>)
+        {
+            f(dim3{x, y, z});
+        }
+        else
+        {
+            static_assert(always_false_v<F>,
+                          "invalid callable, it should be:"
+                          "void (int2) or"
+                          "void (int3) or"
+                          "void (uint1) or"
+                          "void (uint2) or"
+                          "void (uint3) or"
+                          "void (dim3)");
+        }
+    }
+}  // namespace details
+
+template <typename F, typename UserTag>
+MUDA_HOST HostLaunch& HostLaunch::apply(const dim3& active_dim, F&& f)
+{
+    using CallableType = raw_type_t<F>;
+
+    MUDA_ASSERT(m_block_dim.x > 0 && m_block_dim.y > 0 && m_block_dim.z > 0,
+                "block_dim should be non-zero");
+
+    auto grid_dim    = calculate_grid_dim(active_dim);
+    auto block_count = static_cast<int>(grid_dim.x * grid_dim.y * grid_dim.z);
+    auto block_dim   = m_block_dim;
+
+    CallableType callable = std::forward<F>(f);
+
+    m_pool->parallel_for_blocks(
+        block_count,
+        [&](int block_i)
+        {
+            CallableType local = callable;
+
+            // flat block index -> blockIdx
+            unsigned int bx = block_i % grid_dim.x;
+            unsigned int by = (block_i / grid_dim.x) % grid_dim.y;
+            unsigned int bz = block_i / (grid_dim.x * grid_dim.y);
+
+            for(unsigned int tz = 0; tz < block_dim.z; ++tz)
+            {
+                auto z = bz * block_dim.z + tz;
+                if(z >= active_dim.z)
+                    break;
+                for(unsigned int ty = 0; ty < block_dim.y; ++ty)
+                {
+                    auto y = by * block_dim.y + ty;
+                    if(y >= active_dim.y)
+                        break;
+                    for(unsigned int tx = 0; tx < block_dim.x; ++tx)
+                    {
+                        auto x = bx * block_dim.x + tx;
+                        if(x >= active_dim.x)
+                            break;
+                        details::host_invoke_with_range(local, x, y, z);
+                    }
+                }
+            }
+        });
+    return *this;
+}
+
+template <typename F, typename UserTag>
+MUDA_HOST HostLaunch& HostLaunch::apply(const dim3& active_dim, F&& f, Tag<UserTag>)
+{
+    return apply<F, UserTag>(active_dim, std::forward<F>(f));
+}
+
+MUDA_INLINE dim3 HostLaunch::calculate_grid_dim(const dim3& active_dim) const MUDA_NOEXCEPT
+{
+    dim3 ret;
+    ret.x = (active_dim.x + m_block_dim.x - 1) / m_block_dim.x;
+    ret.y = (active_dim.y + m_block_dim.y - 1) / m_block_dim.y;
+    ret.z = (active_dim.z + m_block_dim.z - 1) / m_block_dim.z;
+    return ret;
+}
+}  // namespace muda
@@ -0,0 +1,121 @@
+#include <muda/type_traits/always.h>
+#include <limits>
+
+namespace muda
+{
+template <typename F, typename UserTag>
+MUDA_HOST HostParallelFor& HostParallelFor::apply(index_t count, F&& f)
+{
+    using CallableType = raw_type_t<F>;
+    static_assert(std::is_invocable_v<CallableType, index_t>
+                      || std::is_invocable_v<CallableType, ParallelForDetails>,
+                  "f must be void (int) or void (ParallelForDetails)");
+
+    check_input(count);
+    if(count <= 0)
+        return *this;
+
+    // every block gets its own copy, just like the kernel parameter on device
+    CallableType callable = std::forward<F>(f);
+    if(m_grid_dim <= 0)
+        invoke_dynamic_blocks(count, callable);
+    else
+        invoke_grid_stride_loop(count, callable);
+    return *this;
+}
+
+template <typename F, typename UserTag>
+MUDA_HOST HostParallelFor& HostParallelFor::apply(index_t count, F&& f, Tag<UserTag>)
+{
+    return apply<F, UserTag>(count, std::forward<F>(f));
+}
+
+template <typename F>
+MUDA_HOST void HostParallelFor::invoke_dynamic_blocks(index_t count, F& f)
+{
+    auto block_dim = m_block_dim;
+    auto grid_dim  = ParallelFor::round_up_blocks(count, block_dim);
+    MUDA_ASSERT(grid_dim <= std::numeric_limits<int>::max(),
+                "HostParallelFor: count=%lld needs %lld blocks of %d threads, use a grid-stride loop",
+                (long long)count,
+                (long long)grid_dim,
+                block_dim);
+
+    m_pool->parallel_for_blocks(
+        static_cast<int>(grid_dim),
+        [&](int block_i)
+        {
+            F       callable = f;
+            index_t begin    = static_cast<index_t>(block_i) * block_dim;
+            // count - begin > 0, so no overflow
+            auto end = begin + std::min<index_t>(block_dim, count - begin);
+            for(index_t i = begin; i < end; ++i)
+            {
+                if constexpr(std::is_invocable_v<F, index_t>)
+                {
+                    callable(i);
+                }
+                else
+                {
+                    ParallelForDetails details{ParallelForType::DynamicBlocks, i, count};
+                    details.m_active_num_in_block = static_cast<int>(end - begin);
+                    details.m_is_final_block      = block_i == grid_dim - 1;
+                    callable(details);
+                }
+            }
+        });
+}
+
+template <typename F>
+MUDA_HOST void HostParallelFor::invoke_grid_stride_loop(index_t count, F& f)
+{
+    auto    block_dim = m_block_dim;
+    auto    grid_dim  = m_grid_dim;
+    index_t grid_size = static_cast<index_t>(grid_dim) * block_dim;
+    auto    round     = count / grid_size + (count % grid_size != 0);
+
+    m_pool->parallel_for_blocks(
+        grid_dim,
+        [&](int block_i)
+        {
+            F callable = f;
+            // the same visiting order as grid_stride_loop_kernel of one block
+            for(index_t j = 0; j < round; ++j)
+            {
+                // j * grid_size < count, check before adding the block offset to avoid overflow
+                index_t block_offset = static_cast<index_t>(block_i) * block_dim;
+                if(count - j * grid_size <= block_offset)
+                    break;
+                index_t begin = j * grid_size + block_offset;
+                auto    end   = begin + std::min<index_t>(block_dim, count - begin);
+                for(index_t i = begin; i < end; ++i)
+                {
+                    if constexpr(std::is_invocable_v<F, index_t>)
+                    {
+                        callable(i);
+                    }
+                    else
+                    {
+                        ParallelForDetails details{ParallelForType::GridStrideLoop, i, count};
+                        details.m_total_batch = round;
+                        details.m_batch_i     = j;
+                        if(count - i < block_dim)  // the block may be incomplete in the last round
+                            details.m_active_num_in_block =
+                                static_cast<int>(count - j * grid_size);
+                        else
+                            details.m_active_num_in_block = block_dim;
+                        details.m_is_final_block =
+                            details.m_active_num_in_block == block_dim;
+                        callable(details);
+                    }
+                }
+            }
+        });
+}
+
+MUDA_INLINE void HostParallelFor::check_input(index_t count) const MUDA_NOEXCEPT
+{
+    MUDA_ASSERT(count >= 0, "count must be >= 0");
+    MUDA_ASSERT(m_block_dim > 0, "blockDim must be > 0");
+}
+}  // namespace muda
@@ -0,0 +1,181 @@
+#include <algorithm>
+
+namespace muda
+{
+MUDA_INLINE HostThreadPool::HostThreadPool(size_t worker_count)
+{
+    m_queues.reserve(worker_count + 1);
+    for(size_t i = 0; i < worker_count + 1; ++i)
+        m_queues.emplace_back(std::make_unique<WorkerQueue>());
+
+    m_workers.reserve(worker_count);
+    for(size_t i = 0; i < worker_count; ++i)
+        m_workers.emplace_back([this, i] { worker_main(i); });
+}
+
+MUDA_INLINE HostThreadPool::~HostThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_job_cv.notify_all();
+    for(auto& worker : m_workers)
+        worker.join();
+}
+
+MUDA_INLINE HostThreadPool& HostThreadPool::instance()
+{
+    static HostThreadPool pool;
+    return pool;
+}
+
+MUDA_INLINE size_t HostThreadPool::default_worker_count()
+{
+    auto n = std::thread::hardware_concurrency();
+    return n > 1 ? n - 1 : 0;
+}
+
+template <typename F>
+void HostThreadPool::parallel_for_blocks(int block_count, F&& f, int grain)
+{
+    if(block_count <= 0)
+        return;
+
+    if(grain <= 0)
+    {
+        // 4 tasks per thread leave enough room for stealing
+        auto tasks = static_cast<int>(concurrency() * 4);
+        grain      = std::max(1, (block_count + tasks - 1) / tasks);
+    }
+
+    ChunkBody body = [&f](int begin, int end)
+    {
+        for(int b = begin; b < end; ++b)
+            f(b);
+    };
+    run(block_count, grain, body);
+}
+
+MUDA_INLINE bool& HostThreadPool::is_in_job()
+{
+    thread_local bool in_job = false;
+    return in_job;
+}
+
+MUDA_INLINE void HostThreadPool::run(int block_count, int grain, const ChunkBody& body)
+{
+    // nested call or nothing to share: run on the calling thread
+    if(is_in_job() || m_workers.empty() || block_count <= grain)
+    {
+        body(0, block_count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> job_lock(m_job_mutex);
+
+    auto chunk_count = (block_count + grain - 1) / grain;
+    m_body           = &body;
+    m_exception      = nullptr;
+    m_remaining.store(chunk_count, std::memory_order_relaxed);
+
+    for(int c = 0; c < chunk_count; ++c)
+    {
+        auto& q = *m_queues[c % m_queues.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.chunks.push_back(Chunk{c * grain, std::min(block_count, (c + 1) * grain)});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;
+    }
+    m_job_cv.notify_all();
+
+    // the caller works on the last queue
+    work(m_queues.size() - 1);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [&] { return m_remaining.load() == 0; });
+    }
+
+    m_body = nullptr;
+    if(m_exception)
+        std::rethrow_exception(m_exception);
+}
+
+MUDA_INLINE void HostThreadPool::worker_main(size_t queue_index)
+{
+    uint64_t seen_generation = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_cv.wait(lock,
+                          [&] { return m_stop || m_generation != seen_generation; });
+            if(m_stop)
+                return;
+            seen_generation = m_generation;
+        }
+        work(queue_index);
+    }
+}
+
+MUDA_INLINE void HostThreadPool::work(size_t queue_index)
+{
+    is_in_job() = true;
+    Chunk chunk;
+    while(pop(queue_index, chunk) || steal(queue_index, chunk))
+        execute(chunk);
+    is_in_job() = false;
+}
+
+MUDA_INLINE bool HostThreadPool::pop(size_t queue_index, Chunk& chunk)
+{
+    auto&                       q = *m_queues[queue_index];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if(q.chunks.empty())
+        return false;
+    chunk = q.chunks.back();
+    q.chunks.pop_back();
+    return true;
+}
+
+MUDA_INLINE bool HostThreadPool::steal(size_t queue_index, Chunk& chunk)
+{
+    auto n = m_queues.size();
+    for(size_t i = 1; i < n; ++i)
+    {
+        auto&                       q = *m_queues[(queue_index + i) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if(q.chunks.empty())
+            continue;
+        chunk = q.chunks.front();
+        q.chunks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+MUDA_INLINE void HostThreadPool::execute(const Chunk& chunk)
+{
+    try
+    {
+        (*m_body)(chunk.begin, chunk.end);
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_exception)
+            m_exception = std::current_exception();
+    }
+
+    if(m_remaining.fetch_sub(1) == 1)
+    {
+        // take the lock, so the caller can't miss the notification
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done_cv.notify_all();
+    }
+}
+}  // namespace muda
@@ -104,9 +104,11 @@ MUDA_INLINE MUDA_HOST auto Launch::as_node_parms(const dim3& active_dim, F&& f)
 {
     check_input_with_range();
 
+    using CallableType = raw_type_t<F>;
+    resolve_auto_block((const void*)details::generic_kernel_with_range<CallableType, UserTag>);
+
     auto grid_dim = calculate_grid_dim(active_dim);
 
-    using CallableType = raw_type_t<F>;
     auto parms = std::make_shared<NodeParms<F>>(std::forward<F>(f), active_dim);
 
     parms->func((void*)details::generic_kernel_with_range<CallableType, UserTag>);
@@ -141,9 +143,11 @@ MUDA_HOST void Launch::invoke(const dim3& active_dim, F&& f)
 {
     check_input_with_range();
 
+    using CallableType = raw_type_t<F>;
+    resolve_auto_block((const void*)details::generic_kernel_with_range<CallableType, UserTag>);
+
     dim3 grid_dim = calculate_grid_dim(active_dim);
 
-    using CallableType = raw_type_t<F>;
     auto callable = details::LaunchCallable<CallableType>{std::forward<F>(f), active_dim};
     details::generic_kernel_with_range<CallableType, UserTag>
         <<<grid_dim, m_block_dim, m_shared_mem_size, m_stream>>>(callable);
@@ -210,6 +214,15 @@ MUDA_INLINE MUDA_GENERIC dim3 Launch::calculate_grid_dim(const dim3& active_dim)
     return ret;
 }
 
+MUDA_INLINE MUDA_HOST void Launch::resolve_auto_block(const void* kernel)
+{
+    if(!m_auto_block)
+        return;
+    auto config       = DeviceAutoBlockCache::instance().select(kernel, *m_auto_block);
+    m_block_dim       = dim3(config.block_size, 1, 1);
+    m_shared_mem_size = m_auto_block->dynamic_shared_mem_bytes(config.block_size);
+}
+
 MUDA_INLINE MUDA_GENERIC void Launch::check_input_with_range() const MUDA_NOEXCEPT
 {
     MUDA_ASSERT(m_grid_dim.x == 0, "grid_dim should be `dim3{0}`");
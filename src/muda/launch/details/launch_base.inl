@@ -132,18 +132,15 @@ MUDA_INLINE void LaunchCore::wait(const ComputeGraphVar<cudaEvent_t>& e,
     return wait(e, {static_cast<ComputeGraphVarBase*>(&vars)...});
 }
 
+// the name is kept without MUDA_CHECK_ON too, the LoggerFilter resolves against it
 MUDA_INLINE void LaunchCore::kernel_name(std::string_view name)
 {
-#if MUDA_CHECK_ON
     details::LaunchInfoCache::current_kernel_name(name);
-#endif
 }
 
 MUDA_INLINE MUDA_HOST void LaunchCore::pop_kernel_name()
 {
-#if MUDA_CHECK_ON
     details::LaunchInfoCache::current_kernel_name("");
-#endif
 }
 
 
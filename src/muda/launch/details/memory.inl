@@ -1,5 +1,6 @@
 #pragma once
 #include <muda/compute_graph/compute_graph.h>
+#include <muda/allocator/allocator_base.h>
 #include "memory.h"
 namespace muda
 {
@@ -8,6 +9,13 @@ MUDA_HOST Memory& Memory::alloc_1d(T** ptr, size_t byte_size, bool async)
 {
     MUDA_ASSERT(ComputeGraphBuilder::is_direct_launching(),
                 "alloc must be called in direct launching mode");
+    if(auto allocator = device_allocator())
+    {
+        *ptr = reinterpret_cast<T*>(allocator->allocate(byte_size, stream()));
+        if(*ptr)
+            details::AllocationOwners::instance().insert(*ptr, allocator);
+        return *this;
+    }
 #ifdef MUDA_WITH_ASYNC_MEMORY_ALLOC_FREE
     if(async)
         checkCudaErrors(cudaMallocAsync(ptr, byte_size, stream()));
@@ -27,6 +35,11 @@ MUDA_HOST Memory& Memory::alloc(T** ptr, size_t byte_size, bool async)
 
 MUDA_INLINE MUDA_HOST Memory& Memory::free(void* ptr, bool async)
 {
+    // back to the allocator that owns the block, whatever allocator is installed now.
+    // the pointers from no allocator (e.g. pitched allocations) go to the raw free function
+    if(auto owner = details::AllocationOwners::instance().erase(ptr);
+       owner && owner->deallocate(ptr, stream()))
+        return *this;
 #ifdef MUDA_WITH_ASYNC_MEMORY_ALLOC_FREE
     if(async)
         checkCudaErrors(cudaFreeAsync(ptr, stream()));
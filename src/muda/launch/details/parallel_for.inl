@@ -1,5 +1,6 @@
 #include <muda/compute_graph/compute_graph.h>
 #include <muda/type_traits/always.h>
+#include <limits>
 
 namespace muda
 {
@@ -13,28 +14,31 @@ namespace details
     * UserTag: the tag struct for user to recognize on profiling             *
     **************************************************************************
     */
+    // the thread ids are unsigned: the last block may pass the max of index_t,
+    // and i < count <= max(index_t), grid_size <= max(index_t), so i + grid_size never wraps
+    using parallel_for_uindex_t = std::make_unsigned_t<index_t>;
+
+    MUDA_INLINE MUDA_DEVICE parallel_for_uindex_t parallel_for_tid()
+    {
+        return static_cast<parallel_for_uindex_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    }
+
     template <typename F, typename UserTag = DefaultTag>
     MUDA_GLOBAL void parallel_for_kernel(ParallelForCallable<F> f)
     {
-        if constexpr(std::is_invocable_v<F, int>)
+        auto i = parallel_for_tid();
+        if(i >= static_cast<parallel_for_uindex_t>(f.count))
+            return;
+
+        if constexpr(std::is_invocable_v<F, index_t>)
         {
-            auto tid = blockIdx.x * blockDim.x + threadIdx.x;
-            auto i   = tid;
-            if(i < f.count)
-            {
-                f.callable(i);
-            }
+            f.callable(static_cast<index_t>(i));
         }
         else if constexpr(std::is_invocable_v<F, ParallelForDetails>)
         {
-            ParallelForDetails details{ParallelForType::DynamicBlocks,
-                                       static_cast<int>(blockIdx.x * blockDim.x
-                                                        + threadIdx.x),
-                                       f.count};
-            if(details.i() < details.total_num())
-            {
-                f.callable(details);
-            }
+            ParallelForDetails details{
+                ParallelForType::DynamicBlocks, static_cast<index_t>(i), f.count};
+            f.callable(details);
         }
         else
         {
@@ -45,31 +49,30 @@ namespace details
     template <typename F, typename UserTag = DefaultTag>
     MUDA_GLOBAL void grid_stride_loop_kernel(ParallelForCallable<F> f)
     {
-        if constexpr(std::is_invocable_v<F, int>)
+        if constexpr(std::is_invocable_v<F, index_t>)
         {
-            auto tid       = blockIdx.x * blockDim.x + threadIdx.x;
-            auto grid_size = gridDim.x * blockDim.x;
-            auto i         = tid;
-            for(; i < f.count; i += grid_size)
-                f.callable(i);
+            auto grid_size = static_cast<parallel_for_uindex_t>(gridDim.x) * blockDim.x;
+            auto count     = static_cast<parallel_for_uindex_t>(f.count);
+            for(auto i = parallel_for_tid(); i < count; i += grid_size)
+                f.callable(static_cast<index_t>(i));
         }
         else if constexpr(std::is_invocable_v<F, ParallelForDetails>)
         {
-            auto tid        = blockIdx.x * blockDim.x + threadIdx.x;
-            auto grid_size  = gridDim.x * blockDim.x;
+            auto grid_size  = static_cast<parallel_for_uindex_t>(gridDim.x) * blockDim.x;
             auto block_size = blockDim.x;
-            auto i          = tid;
-            auto count      = f.count;
-            auto round      = (count + grid_size - 1) / grid_size;
-            for(int j = 0; i < count; i += grid_size, ++j)
+            auto count      = static_cast<parallel_for_uindex_t>(f.count);
+            auto round      = count / grid_size + (count % grid_size != 0);
+            auto i          = parallel_for_tid();
+            for(parallel_for_uindex_t j = 0; i < count; i += grid_size, ++j)
             {
-                ParallelForDetails details{
-                    ParallelForType::GridStrideLoop, static_cast<int>(i), count};
+                ParallelForDetails details{ParallelForType::GridStrideLoop,
+                                           static_cast<index_t>(i),
+                                           f.count};
 
-                details.m_total_batch = round;
-                details.m_batch_i     = j;
-                if(i + block_size > details.total_num())  // the block may be incomplete in the last round
-                    details.m_active_num_in_block = count - j * grid_size;
+                details.m_total_batch = static_cast<index_t>(round);
+                details.m_batch_i     = static_cast<index_t>(j);
+                if(i + block_size > count)  // the block may be incomplete in the last round
+                    details.m_active_num_in_block = static_cast<int>(count - j * grid_size);
                 else
                     details.m_active_num_in_block = block_size;
                 f.callable(details);
@@ -84,7 +87,7 @@ namespace details
 
 
 template <typename F, typename UserTag>
-MUDA_HOST ParallelFor& ParallelFor::apply(int count, F&& f)
+MUDA_HOST ParallelFor& ParallelFor::apply(index_t count, F&& f)
 {
     using CallableType = raw_type_t<F>;
 
@@ -96,6 +99,16 @@ MUDA_HOST ParallelFor& ParallelFor::apply(int count, F&& f)
         {
             // as node parms
             auto parms = as_node_parms<F, UserTag>(count, std::forward<F>(f));
+            if constexpr(details::kernel_fusion_supported
+                         && details::is_fusable_callable_v<CallableType>)
+            {
+                if(m_elementwise && m_grid_dim <= 0 && m_shared_mem_size == 0)
+                {
+                    details::ComputeGraphAccessor().set_fusable_kernel_node(
+                        parms, parms->kernelParmData.callable, count, m_block_dim);
+                    return;
+                }
+            }
             details::ComputeGraphAccessor().set_kernel_node(parms);
         },
         [&]
@@ -109,17 +122,20 @@ MUDA_HOST ParallelFor& ParallelFor::apply(int count, F&& f)
 }
 
 template <typename F, typename UserTag>
-MUDA_HOST ParallelFor& ParallelFor::apply(int count, F&& f, Tag<UserTag>)
+MUDA_HOST ParallelFor& ParallelFor::apply(index_t count, F&& f, Tag<UserTag>)
 {
     return apply<F, UserTag>(count, std::forward<F>(f));
 }
 
 template <typename F, typename UserTag>
-MUDA_HOST MUDA_NODISCARD auto ParallelFor::as_node_parms(int count, F&& f)
+MUDA_HOST MUDA_NODISCARD auto ParallelFor::as_node_parms(index_t count, F&& f)
     -> S<NodeParms<F>>
 {
     using CallableType = raw_type_t<F>;
 
+    if(m_grid_dim <= 0)
+        resolve_auto_block((const void*)details::parallel_for_kernel<CallableType, UserTag>);
+
     check_input(count);
 
     auto parms = std::make_shared<NodeParms<F>>(std::forward<F>(f), count);
@@ -145,14 +161,14 @@ MUDA_HOST MUDA_NODISCARD auto ParallelFor::as_node_parms(int count, F&& f)
 }
 
 template <typename F, typename UserTag>
-MUDA_HOST MUDA_NODISCARD auto ParallelFor::as_node_parms(int count, F&& f, Tag<UserTag>)
+MUDA_HOST MUDA_NODISCARD auto ParallelFor::as_node_parms(index_t count, F&& f, Tag<UserTag>)
     -> S<NodeParms<F>>
 {
     return as_node_parms<F, UserTag>(count, std::forward<F>(f));
 }
 
 template <typename F, typename UserTag>
-MUDA_HOST void ParallelFor::invoke(int count, F&& f)
+MUDA_HOST void ParallelFor::invoke(index_t count, F&& f)
 {
     using CallableType = raw_type_t<F>;
     // check_input(count);
@@ -160,6 +176,7 @@ MUDA_HOST void ParallelFor::invoke(int count, F&& f)
     {
         if(m_grid_dim <= 0)  // parallel for
         {
+            resolve_auto_block((const void*)details::parallel_for_kernel<CallableType, UserTag>);
             // calculate the blocks we need
             auto n_blocks = calculate_grid_dim(count);
             auto callable = details::ParallelForCallable<CallableType>{f, count};
@@ -175,26 +192,41 @@ MUDA_HOST void ParallelFor::invoke(int count, F&& f)
     }
 }
 
-MUDA_INLINE MUDA_GENERIC int ParallelFor::calculate_grid_dim(int count) const MUDA_NOEXCEPT
+MUDA_INLINE MUDA_GENERIC int ParallelFor::calculate_grid_dim(index_t count) const MUDA_NOEXCEPT
+{
+    auto min_blocks = round_up_blocks(count, m_block_dim);
+    MUDA_KERNEL_ASSERT(min_blocks <= std::numeric_limits<int>::max(),
+                       "ParallelFor: count=%lld needs %lld blocks of %d threads, more than a grid can hold, use a grid-stride loop (ParallelFor(gridDim, blockDim))",
+                       (long long)count,
+                       (long long)min_blocks,
+                       m_block_dim);
+    return static_cast<int>(min_blocks);
+}
+
+MUDA_INLINE MUDA_HOST void ParallelFor::resolve_auto_block(const void* kernel)
 {
-    auto min_threads = count;
-    auto min_blocks  = (min_threads + m_block_dim - 1) / m_block_dim;
-    return min_blocks;
+    if(!m_auto_block)
+        return;
+    auto config       = DeviceAutoBlockCache::instance().select(kernel, *m_auto_block);
+    m_block_dim       = config.block_size;
+    m_shared_mem_size = m_auto_block->dynamic_shared_mem_bytes(config.block_size);
 }
 
-MUDA_INLINE MUDA_GENERIC void ParallelFor::check_input(int count) const MUDA_NOEXCEPT
+MUDA_INLINE MUDA_GENERIC void ParallelFor::check_input(index_t count) const MUDA_NOEXCEPT
 {
     MUDA_KERNEL_ASSERT(count >= 0, "count must be >= 0");
     MUDA_KERNEL_ASSERT(m_block_dim > 0, "blockDim must be > 0");
 }
 
-MUDA_INLINE MUDA_DEVICE int ParallelForDetails::active_num_in_block() const MUDA_NOEXCEPT
+MUDA_INLINE MUDA_GENERIC int ParallelForDetails::active_num_in_block() const MUDA_NOEXCEPT
 {
+#ifdef __CUDA_ARCH__
     if(m_type == ParallelForType::DynamicBlocks)
     {
-        auto block_id = blockIdx.x;
-        return (blockIdx.x == gridDim.x - 1) ? m_total_num - block_id * blockDim.x :
-                                               blockDim.x;
+        auto block_id = static_cast<index_t>(blockIdx.x);
+        return (blockIdx.x == gridDim.x - 1) ?
+                   static_cast<int>(m_total_num - block_id * blockDim.x) :
+                   blockDim.x;
     }
     else if(m_type == ParallelForType::GridStrideLoop)
     {
@@ -204,10 +236,15 @@ MUDA_INLINE MUDA_DEVICE int ParallelForDetails::active_num_in_block() const MUDA
     {
         MUDA_KERNEL_ERROR("invalid paralell for type");
     }
+#else
+    // host backend: filled by HostParallelFor
+    return m_active_num_in_block;
+#endif
 }
 
-MUDA_INLINE MUDA_DEVICE bool ParallelForDetails::is_final_block() const MUDA_NOEXCEPT
+MUDA_INLINE MUDA_GENERIC bool ParallelForDetails::is_final_block() const MUDA_NOEXCEPT
 {
+#ifdef __CUDA_ARCH__
     if(m_type == ParallelForType::DynamicBlocks)
     {
         return (blockIdx.x == gridDim.x - 1);
@@ -220,5 +257,9 @@ MUDA_INLINE MUDA_DEVICE bool ParallelForDetails::is_final_block() const MUDA_NOE
     {
         MUDA_KERNEL_ERROR("invalid paralell for type");
     }
+#else
+    // host backend: filled by HostParallelFor
+    return m_is_final_block;
+#endif
 }
 }  // namespace muda
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <muda/launch/launch.h>
+#include <muda/launch/host_thread_pool.h>
+
+namespace muda
+{
+/// <summary>
+/// HostLaunch: the host backend of Launch.
+/// Only the ranged `apply(active_dim, f)` is supported, because the callable gets its
+/// index from the argument (int2/int3/uint1/uint2/uint3/dim3) instead of the cuda built-in
+/// variables, which don't exist on the host.
+/// Blocks are distributed to the cores through HostThreadPool, threads in a block run in
+/// x-y-z order on one core.
+/// usage:
+///     HostLaunch(cube(4))
+///         .apply(cube(8), [=] __host__ __device__(const int3 xyz) mutable { res(xyz) = 1; });
+/// Note: the launch is synchronous, shared memory and __syncthreads() are not supported.
+/// </summary>
+class HostLaunch
+{
+    dim3            m_block_dim;
+    HostThreadPool* m_pool;
+
+  public:
+    MUDA_HOST HostLaunch(dim3 blockDim) MUDA_NOEXCEPT
+        : m_block_dim(blockDim),
+          m_pool(&HostThreadPool::instance())
+    {
+    }
+
+    // run on a user provided pool instead of HostThreadPool::instance()
+    MUDA_HOST HostLaunch& pool(HostThreadPool& p) MUDA_NOEXCEPT
+    {
+        m_pool = &p;
+        return *this;
+    }
+
+    template <typename F, typename UserTag = Default>
+    MUDA_HOST HostLaunch& apply(const dim3& active_dim, F&& f);
+
+    template <typename F, typename UserTag = Default>
+    MUDA_HOST HostLaunch& apply(const dim3& active_dim, F&& f, Tag<UserTag>);
+
+    // for the symmetry with Launch, the launch is already finished
+    MUDA_HOST HostLaunch& wait() MUDA_NOEXCEPT { return *this; }
+
+  private:
+    dim3 calculate_grid_dim(const dim3& active_dim) const MUDA_NOEXCEPT;
+};
+}  // namespace muda
+
+#include "details/host_launch.inl"
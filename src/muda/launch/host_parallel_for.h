@@ -0,0 +1,71 @@
+#pragma once
+#include <muda/launch/parallel_for.h>
+#include <muda/launch/host_thread_pool.h>
+
+namespace muda
+{
+/// <summary>
+/// HostParallelFor: the host backend of ParallelFor.
+/// It runs the same callable on the cores of the host (through HostThreadPool),
+/// a block is the unit of scheduling, threads in a block run in order on one core.
+/// The callable must be host-callable (e.g. `[=] __host__ __device__(int i) mutable {...}`).
+/// usage:
+///     HostParallelFor(256)
+///         .apply(N, [=] __host__ __device__(int i) mutable { y(i) = a * x(i) + y(i); });
+/// Note: the launch is synchronous, it's not ordered with any cuda stream.
+/// </summary>
+class HostParallelFor
+{
+    int             m_grid_dim;
+    int             m_block_dim;
+    HostThreadPool* m_pool;
+
+  public:
+    /// <summary>
+    /// calculate grid dim automatically to cover the range
+    /// </summary>
+    MUDA_HOST HostParallelFor(int blockDim) MUDA_NOEXCEPT
+        : m_grid_dim(0),
+          m_block_dim(blockDim),
+          m_pool(&HostThreadPool::instance())
+    {
+    }
+
+    /// <summary>
+    /// use Grid-Stride Loops to cover the range
+    /// </summary>
+    MUDA_HOST HostParallelFor(int gridDim, int blockDim) MUDA_NOEXCEPT
+        : m_grid_dim(gridDim),
+          m_block_dim(blockDim),
+          m_pool(&HostThreadPool::instance())
+    {
+    }
+
+    // run on a user provided pool instead of HostThreadPool::instance()
+    MUDA_HOST HostParallelFor& pool(HostThreadPool& p) MUDA_NOEXCEPT
+    {
+        m_pool = &p;
+        return *this;
+    }
+
+    template <typename F, typename UserTag = Default>
+    MUDA_HOST HostParallelFor& apply(index_t count, F&& f);
+
+    template <typename F, typename UserTag = Default>
+    MUDA_HOST HostParallelFor& apply(index_t count, F&& f, Tag<UserTag>);
+
+    // for the symmetry with ParallelFor, the launch is already finished
+    MUDA_HOST HostParallelFor& wait() MUDA_NOEXCEPT { return *this; }
+
+  private:
+    template <typename F>
+    MUDA_HOST void invoke_dynamic_blocks(index_t count, F& f);
+
+    template <typename F>
+    MUDA_HOST void invoke_grid_stride_loop(index_t count, F& f);
+
+    void check_input(index_t count) const MUDA_NOEXCEPT;
+};
+}  // namespace muda
+
+#include "details/host_parallel_for.inl"
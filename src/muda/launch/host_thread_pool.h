@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <muda/muda_def.h>
+
+namespace muda
+{
+/// <summary>
+/// A work-stealing thread pool used by the host launch backend.
+/// The iteration space is cut into chunks of blocks, the chunks are
+/// distributed round-robin to the per-worker queues, a worker pops from the back of its
+/// own queue and steals from the front of others' queues when it runs dry.
+/// The calling thread takes part in the work, so `parallel_for_blocks()` is blocking.
+/// </summary>
+class HostThreadPool
+{
+  public:
+    // body(block_begin, block_end)
+    using ChunkBody = std::function<void(int, int)>;
+
+    // worker_count = 0 means running everything on the calling thread
+    explicit HostThreadPool(size_t worker_count = default_worker_count());
+    ~HostThreadPool();
+
+    // delete copy
+    HostThreadPool(const HostThreadPool&)            = delete;
+    HostThreadPool& operator=(const HostThreadPool&) = delete;
+
+    // delete move
+    HostThreadPool(HostThreadPool&&)            = delete;
+    HostThreadPool& operator=(HostThreadPool&&) = delete;
+
+    // the process-wide pool, using all hardware threads
+    static HostThreadPool& instance();
+
+    // hardware_concurrency() - 1, because the calling thread also works
+    static size_t default_worker_count();
+
+    // the number of threads that work on a job (including the calling thread)
+    size_t concurrency() const { return m_workers.size() + 1; }
+
+    /// <summary>
+    /// call f(block_i) for block_i in [0, block_count), `grain` blocks make up a task.
+    /// if called from inside a running job (nested), the blocks run on the calling thread.
+    /// the first exception thrown by f is rethrown after all tasks are finished.
+    /// </summary>
+    template <typename F>
+    void parallel_for_blocks(int block_count, F&& f, int grain = 0);
+
+  private:
+    class Chunk
+    {
+      public:
+        int begin;
+        int end;
+    };
+
+    class WorkerQueue
+    {
+      public:
+        std::mutex        mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    void run(int block_count, int grain, const ChunkBody& body);
+    void worker_main(size_t queue_index);
+    void work(size_t queue_index);
+    bool pop(size_t queue_index, Chunk& chunk);
+    bool steal(size_t queue_index, Chunk& chunk);
+    void execute(const Chunk& chunk);
+
+    static bool& is_in_job();
+
+    std::vector<std::thread>                  m_workers;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;  // the last one is for the caller
+
+    std::mutex              m_job_mutex;  // one job at a time
+    std::mutex              m_mutex;
+    std::condition_variable m_job_cv;
+    std::condition_variable m_done_cv;
+    uint64_t                m_generation = 0;
+    bool                    m_stop       = false;
+
+    const ChunkBody*    m_body = nullptr;
+    std::atomic<size_t> m_remaining{0};
+    std::exception_ptr  m_exception;
+};
+}  // namespace muda
+
+#include "details/host_thread_pool.inl"
@@ -2,6 +2,8 @@
 #include <muda/launch/launch_base.h>
 #include <muda/type_traits/always.h>
 #include <muda/launch/kernel_tag.h>
+#include <muda/launch/auto_block.h>
+#include <optional>
 namespace muda
 {
 namespace details
@@ -36,6 +38,8 @@ class Launch : public LaunchBase<Launch>
     dim3   m_grid_dim;
     dim3   m_block_dim;
     size_t m_shared_mem_size;
+    // the block size is picked per kernel when launching
+    std::optional<AutoBlock> m_auto_block;
 
   public:
     template <typename F>
@@ -68,6 +72,16 @@ class Launch : public LaunchBase<Launch>
     {
     }
 
+    // 1D blocks picked by occupancy (see AutoBlock), only for `apply(active_dim, f)`
+    MUDA_HOST Launch(AutoBlock auto_block, cudaStream_t stream = nullptr) MUDA_NOEXCEPT
+        : LaunchBase(stream),
+          m_grid_dim(0),
+          m_block_dim(0),
+          m_shared_mem_size(0),
+          m_auto_block(std::move(auto_block))
+    {
+    }
+
     template <typename F, typename UserTag = Default>
     MUDA_HOST Launch& apply(F&& f);
     template <typename F, typename UserTag = Default>
@@ -104,6 +118,8 @@ class Launch : public LaunchBase<Launch>
 
     MUDA_GENERIC dim3 calculate_grid_dim(const dim3& active_dim) const MUDA_NOEXCEPT;
 
+    MUDA_HOST void resolve_auto_block(const void* kernel);
+
     MUDA_GENERIC void check_input_with_range() const MUDA_NOEXCEPT;
 
     MUDA_GENERIC void check_input() const MUDA_NOEXCEPT;
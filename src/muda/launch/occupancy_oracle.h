@@ -0,0 +1,55 @@
+#pragma once
+#include <functional>
+#include <cuda_runtime.h>
+#include <cuda_runtime_api.h>
+#include <muda/check/check_cuda_errors.h>
+
+namespace muda
+{
+class OccupancySuggestion
+{
+  public:
+    // the block size reaching the max occupancy
+    int block_size = 0;
+    // the min grid size to reach the max occupancy on the whole device
+    int min_grid_size = 0;
+};
+
+/// <summary>
+/// The occupancy source of AutoBlockCache (on device), a thin wrapper of
+/// cudaOccupancyMaxPotentialBlockSize(VariableSMem).
+/// </summary>
+class CudaOccupancyOracle
+{
+  public:
+    int device() const
+    {
+        int d = 0;
+        checkCudaErrors(cudaGetDevice(&d));
+        return d;
+    }
+
+    // shared_mem_bytes: dynamic shared memory of a block of the given size, may be empty
+    OccupancySuggestion suggest(const void*                         func,
+                                const std::function<size_t(int)>& shared_mem_bytes,
+                                int                                 block_size_limit) const
+    {
+        OccupancySuggestion s;
+        if(shared_mem_bytes)
+            checkCudaErrors(cudaOccupancyMaxPotentialBlockSizeVariableSMem(
+                &s.min_grid_size, &s.block_size, func, shared_mem_bytes, block_size_limit));
+        else
+            checkCudaErrors(cudaOccupancyMaxPotentialBlockSize(
+                &s.min_grid_size, &s.block_size, func, 0, block_size_limit));
+        return s;
+    }
+
+    // the max dynamic shared memory of a block of `block_size` threads, so it can still launch
+    size_t available_shared_mem_bytes(const void* func, int block_size) const
+    {
+        size_t bytes = 0;
+        checkCudaErrors(cudaOccupancyAvailableDynamicSMemPerBlock(&bytes, func, 1, block_size));
+        return bytes;
+    }
+};
+}  // namespace muda
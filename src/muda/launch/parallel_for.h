@@ -1,5 +1,7 @@
 #pragma once
 #include <muda/launch/launch_base.h>
+#include <muda/launch/auto_block.h>
+#include <optional>
 #include <stdexcept>
 #include <exception>
 
@@ -11,10 +13,10 @@ namespace details
     class ParallelForCallable
     {
       public:
-        F   callable;
-        int count;
+        F       callable;
+        index_t count;
         template <typename U>
-        MUDA_GENERIC ParallelForCallable(U&& callable, int count) MUDA_NOEXCEPT
+        MUDA_GENERIC ParallelForCallable(U&& callable, index_t count) MUDA_NOEXCEPT
             : callable(std::forward<U>(callable)),
               count(count)
         {
@@ -35,36 +37,38 @@ enum class ParallelForType : uint32_t
     GridStrideLoop
 };
 
+class HostParallelFor;
+
 class ParallelForDetails
 {
   public:
-    MUDA_NODISCARD MUDA_DEVICE int  active_num_in_block() const MUDA_NOEXCEPT;
-    MUDA_NODISCARD MUDA_DEVICE bool is_final_block() const MUDA_NOEXCEPT;
-    MUDA_NODISCARD MUDA_DEVICE auto parallel_for_type() const MUDA_NOEXCEPT
+    MUDA_NODISCARD MUDA_GENERIC int  active_num_in_block() const MUDA_NOEXCEPT;
+    MUDA_NODISCARD MUDA_GENERIC bool is_final_block() const MUDA_NOEXCEPT;
+    MUDA_NODISCARD MUDA_GENERIC auto parallel_for_type() const MUDA_NOEXCEPT
     {
         return m_type;
     }
 
-    MUDA_NODISCARD MUDA_DEVICE int total_num() const MUDA_NOEXCEPT
+    MUDA_NODISCARD MUDA_GENERIC index_t total_num() const MUDA_NOEXCEPT
     {
         return m_total_num;
     }
-    MUDA_NODISCARD MUDA_DEVICE operator int() const MUDA_NOEXCEPT
+    MUDA_NODISCARD MUDA_GENERIC operator index_t() const MUDA_NOEXCEPT
     {
         return m_current_i;
     }
 
-    MUDA_NODISCARD MUDA_DEVICE int i() const MUDA_NOEXCEPT
+    MUDA_NODISCARD MUDA_GENERIC index_t i() const MUDA_NOEXCEPT
     {
         return m_current_i;
     }
 
-    MUDA_NODISCARD MUDA_DEVICE int batch_i() const MUDA_NOEXCEPT
+    MUDA_NODISCARD MUDA_GENERIC index_t batch_i() const MUDA_NOEXCEPT
     {
         return m_batch_i;
     }
 
-    MUDA_NODISCARD MUDA_DEVICE int total_batch() const MUDA_NOEXCEPT
+    MUDA_NODISCARD MUDA_GENERIC index_t total_batch() const MUDA_NOEXCEPT
     {
         return m_total_batch;
     }
@@ -76,7 +80,9 @@ class ParallelForDetails
     template <typename F, typename UserTag>
     friend MUDA_GLOBAL void details::grid_stride_loop_kernel(ParallelForCallable<F> f);
 
-    MUDA_DEVICE ParallelForDetails(ParallelForType type, int i, int total_num) MUDA_NOEXCEPT
+    friend class HostParallelFor;
+
+    MUDA_GENERIC ParallelForDetails(ParallelForType type, index_t i, index_t total_num) MUDA_NOEXCEPT
         : m_type(type),
           m_total_num(total_num),
           m_current_i(i)
@@ -84,11 +90,13 @@ class ParallelForDetails
     }
 
     ParallelForType m_type;
-    int             m_total_num;
-    int             m_total_batch         = 1;
-    int             m_batch_i             = 0;
+    index_t         m_total_num;
+    index_t         m_total_batch         = 1;
+    index_t         m_batch_i             = 0;
     int             m_active_num_in_block = 0;
-    int             m_current_i           = 0;
+    index_t         m_current_i           = 0;
+    // only filled by the host backend, on device we query the built-in variables
+    bool m_is_final_block = false;
 };
 
 using details::grid_stride_loop_kernel;
@@ -99,12 +107,17 @@ using details::parallel_for_kernel;
 /// usage:
 ///		ParallelFor(16)
 ///			.apply(16, [=] __device__(int i) mutable { printf("var=%d, i = %d\n");}, true);
+/// the count and the index are index_t (int by default, int64_t with MUDA_INDEX_64=1),
+/// take `index_t i` in the callable to cover the 64-bit ranges.
 /// </summary>
 class ParallelFor : public LaunchBase<ParallelFor>
 {
     int    m_grid_dim;
     int    m_block_dim;
     size_t m_shared_mem_size;
+    bool   m_elementwise = false;
+    // the block size is picked per kernel when launching
+    std::optional<AutoBlock> m_auto_block;
 
   public:
     template <typename F>
@@ -124,6 +137,22 @@ class ParallelFor : public LaunchBase<ParallelFor>
     {
     }
 
+    /// <summary>
+    /// calculate grid dim automatically to cover the range,
+    /// the block size (and the dynamic shared memory) is picked by occupancy,
+    /// see AutoBlock and DeviceAutoBlockCache
+    /// </summary>
+    /// <param name="auto_block">the block size policy</param>
+    /// <param name="stream"></param>
+    MUDA_HOST ParallelFor(AutoBlock auto_block, cudaStream_t stream = nullptr) MUDA_NOEXCEPT
+        : LaunchBase(stream),
+          m_grid_dim(0),
+          m_block_dim(0),
+          m_shared_mem_size(0),
+          m_auto_block(std::move(auto_block))
+    {
+    }
+
     /// <summary>
     /// use Grid-Stride Loops to cover the range
     /// </summary>
@@ -142,32 +171,46 @@ class ParallelFor : public LaunchBase<ParallelFor>
     {
     }
 
+    /// <summary>
+    /// Promise that thread i only touches element i of the data shared with other closures,
+    /// so a ComputeGraph with kernel_fusion(true) may fuse this kernel with its neighbours.
+    /// Only dynamic-block launches of `void (int)` callables are fused.
+    /// </summary>
+    MUDA_HOST ParallelFor& elementwise(bool enable = true) MUDA_NOEXCEPT
+    {
+        m_elementwise = enable;
+        return *this;
+    }
+
     template <typename F, typename UserTag = Default>
-    MUDA_HOST ParallelFor& apply(int count, F&& f);
+    MUDA_HOST ParallelFor& apply(index_t count, F&& f);
 
     template <typename F, typename UserTag = Default>
-    MUDA_HOST ParallelFor& apply(int count, F&& f, Tag<UserTag>);
+    MUDA_HOST ParallelFor& apply(index_t count, F&& f, Tag<UserTag>);
 
 
     template <typename F, typename UserTag = Default>
-    MUDA_HOST MUDA_NODISCARD auto as_node_parms(int count, F&& f) -> S<NodeParms<F>>;
+    MUDA_HOST MUDA_NODISCARD auto as_node_parms(index_t count, F&& f) -> S<NodeParms<F>>;
 
     template <typename F, typename UserTag = Default>
-    MUDA_HOST MUDA_NODISCARD auto as_node_parms(int count, F&& f, Tag<UserTag>)
+    MUDA_HOST MUDA_NODISCARD auto as_node_parms(index_t count, F&& f, Tag<UserTag>)
         -> S<NodeParms<F>>;
 
-    MUDA_GENERIC MUDA_NODISCARD static int round_up_blocks(int count, int block_dim) MUDA_NOEXCEPT
+    // no overflow even if count is close to the max of index_t
+    MUDA_GENERIC MUDA_NODISCARD static index_t round_up_blocks(index_t count, int block_dim) MUDA_NOEXCEPT
     {
-        return (count + block_dim - 1) / block_dim;
+        return count / block_dim + (count % block_dim != 0);
     }
 
   public:
     template <typename F, typename UserTag>
-    MUDA_HOST void invoke(int count, F&& f);
+    MUDA_HOST void invoke(index_t count, F&& f);
+
+    MUDA_GENERIC int calculate_grid_dim(index_t count) const MUDA_NOEXCEPT;
 
-    MUDA_GENERIC int calculate_grid_dim(int count) const MUDA_NOEXCEPT;
+    MUDA_HOST void resolve_auto_block(const void* kernel);
 
-    MUDA_GENERIC void check_input(int count) const MUDA_NOEXCEPT;
+    MUDA_GENERIC void check_input(index_t count) const MUDA_NOEXCEPT;
 };
 }  // namespace muda
 
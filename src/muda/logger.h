@@ -1,3 +1,4 @@
 #pragma once
 #include <muda/logger/logger.h>
-#include <muda/logger/logger_function.h>
\ No newline at end of file
+#include <muda/logger/logger_function.h>
+#include <muda/logger/streaming_logger.h>
\ No newline at end of file
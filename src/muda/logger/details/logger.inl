@@ -79,6 +79,8 @@ MUDA_INLINE Logger::Logger(Logger&& other) noexcept
     , m_offset(std::move(other.m_offset))
     , m_h_offset(std::move(other.m_h_offset))
     , m_log_viewer_ptr(std::move(other.m_log_viewer_ptr))
+    , m_viewer(std::move(other.m_viewer))
+    , m_filter(std::move(other.m_filter))
 {
     other.m_log_viewer_ptr = nullptr;
     other.m_viewer         = {};
@@ -100,6 +102,8 @@ MUDA_INLINE Logger& Logger::operator=(Logger&& other) noexcept
     m_offset               = std::move(other.m_offset);
     m_h_offset             = std::move(other.m_h_offset);
     m_log_viewer_ptr       = std::move(other.m_log_viewer_ptr);
+    m_viewer               = std::move(other.m_viewer);
+    m_filter               = std::move(other.m_filter);
     other.m_log_viewer_ptr = nullptr;
     other.m_viewer         = {};
 
@@ -141,6 +145,15 @@ MUDA_INLINE void Logger::retrieve(std::ostream& os)
     os << ss.str();
 }
 
+MUDA_INLINE void Logger::retrieve(LoggerCaptureWriter& capture)
+{
+    Logger::_retrieve(
+        [&](const span<details::LoggerMetaData>& meta_data_span)
+        {
+            capture.write_frame(meta_data_span, m_h_buffer.data(), m_h_offset.buffer_offset);
+        });
+}
+
 MUDA_INLINE LoggerDataContainer Logger::retrieve_meta()
 {
     LoggerDataContainer ret;
@@ -165,6 +178,18 @@ MUDA_INLINE LoggerDataContainer Logger::retrieve_meta()
     return ret;
 }
 
+MUDA_INLINE void Logger::filter(const LoggerFilter& filter)
+{
+    m_filter = filter;
+    // the global viewer has no kernel to resolve against
+    m_viewer.m_filter = m_filter.resolve(std::string_view{});
+    if(m_log_viewer_ptr)
+    {
+        checkCudaErrors(cudaMemcpy(
+            m_log_viewer_ptr, &m_viewer, sizeof(m_viewer), cudaMemcpyHostToDevice));
+    }
+}
+
 MUDA_INLINE void Logger::expand_meta_data()
 {
     auto new_size = m_meta_data.size() * 2;
@@ -256,34 +281,7 @@ MUDA_INLINE void Logger::expand_if_needed()
 
 MUDA_INLINE void Logger::put(std::ostream& os, const details::LoggerMetaData& meta_data) const
 {
-    auto buffer = m_h_buffer.data();
-    auto offset = meta_data.offset;
-    auto type   = meta_data.type;
-#define MUDA_PUT_CASE(EnumT, T)                                                \
-    case LoggerBasicType::EnumT:                                               \
-        os << *reinterpret_cast<const T*>(buffer + offset);                    \
-        break;
-
-    switch(type)
-    {
-        case LoggerBasicType::String:
-            os << buffer + offset;
-            break;
-            MUDA_PUT_CASE(Int8, int8_t);
-            MUDA_PUT_CASE(Int16, int16_t);
-            MUDA_PUT_CASE(Int32, int32_t);
-            MUDA_PUT_CASE(Int64, int64_t);
-            MUDA_PUT_CASE(UInt8, uint8_t);
-            MUDA_PUT_CASE(UInt16, uint16_t);
-            MUDA_PUT_CASE(UInt32, uint32_t);
-            MUDA_PUT_CASE(UInt64, uint64_t);
-            MUDA_PUT_CASE(Float, float);
-            MUDA_PUT_CASE(Double, double);
-        default:
-            MUDA_ERROR_WITH_LOCATION("Unknown type");
-            break;
-    }
-#undef MUDA_PUT_CASE
+    LoggerDecoder::put(os, meta_data, m_h_buffer.data());
 }
 
 MUDA_INLINE Logger::~Logger() {}
@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+namespace details
+{
+    MUDA_INLINE span<const LoggerCaptureTypeEntry> logger_capture_types()
+    {
+        auto entry = [](LoggerBasicType type, uint16_t size, const char* name)
+        {
+            LoggerCaptureTypeEntry e;
+            e.type = static_cast<uint16_t>(type);
+            e.size = size;
+            std::strncpy(e.name, name, sizeof(e.name) - 1);
+            return e;
+        };
+        static const LoggerCaptureTypeEntry types[] = {
+            entry(LoggerBasicType::None, 0, "none"),
+            entry(LoggerBasicType::Int8, 1, "int8"),
+            entry(LoggerBasicType::Int16, 2, "int16"),
+            entry(LoggerBasicType::Int32, 4, "int32"),
+            entry(LoggerBasicType::Int64, 8, "int64"),
+            entry(LoggerBasicType::UInt8, 1, "uint8"),
+            entry(LoggerBasicType::UInt16, 2, "uint16"),
+            entry(LoggerBasicType::UInt32, 4, "uint32"),
+            entry(LoggerBasicType::UInt64, 8, "uint64"),
+            entry(LoggerBasicType::Float, 4, "float"),
+            entry(LoggerBasicType::Double, 8, "double"),
+            entry(LoggerBasicType::String, 0, "string"),
+            entry(LoggerBasicType::FmtString, 0, "fmt_str"),
+            entry(LoggerBasicType::Object, 0, "object")};
+        return types;
+    }
+
+    constexpr size_t logger_capture_align(size_t size)
+    {
+        return (size + 15) / 16 * 16;
+    }
+}  // namespace details
+
+MUDA_INLINE LoggerCaptureWriter::LoggerCaptureWriter(const std::string& path)
+    : m_file(path, std::ios::binary | std::ios::trunc)
+{
+    if(!m_file)
+        MUDA_ERROR_WITH_LOCATION("LoggerCaptureWriter: can't open %s", path.c_str());
+
+    auto                         types = details::logger_capture_types();
+    details::LoggerCaptureHeader header;
+    header.type_count = static_cast<uint32_t>(types.size());
+    write(&header, sizeof(header));
+    write(types.data(), types.size_bytes());
+    pad();
+}
+
+MUDA_INLINE LoggerCaptureWriter::~LoggerCaptureWriter()
+{
+    close();
+}
+
+MUDA_INLINE void LoggerCaptureWriter::register_fmt_arg(LoggerFmtArg fmt_arg, std::string name)
+{
+    std::lock_guard lock{m_mutex};
+    m_symbols.emplace_back(fmt_arg, std::move(name));
+}
+
+MUDA_INLINE void LoggerCaptureWriter::write_frame(span<const details::LoggerMetaData> meta_data,
+                                                  const char* buffer,
+                                                  size_t      buffer_size)
+{
+    std::lock_guard lock{m_mutex};
+    MUDA_ASSERT(m_file.is_open(), "LoggerCaptureWriter is closed");
+
+    details::LoggerCaptureFrameHeader header;
+    header.meta_count  = static_cast<uint32_t>(meta_data.size());
+    header.buffer_size = buffer_size;
+    header.index       = m_frame_count++;
+    write(&header, sizeof(header));
+    write(meta_data.data(), meta_data.size_bytes());
+    pad();
+    write(buffer, buffer_size);
+    pad();
+}
+
+MUDA_INLINE void LoggerCaptureWriter::close()
+{
+    std::lock_guard lock{m_mutex};
+    if(!m_file.is_open())
+        return;
+
+    details::LoggerCaptureSymbolHeader header;
+    header.count = static_cast<uint32_t>(m_symbols.size());
+    write(&header, sizeof(header));
+    for(auto& [fmt_arg, name] : m_symbols)
+    {
+        details::LoggerCaptureSymbolEntry entry;
+        entry.address   = reinterpret_cast<uint64_t>(fmt_arg);
+        entry.name_size = static_cast<uint32_t>(name.size());
+        write(&entry, sizeof(entry));
+        write(name.data(), name.size());
+        pad();
+    }
+    m_file.close();
+}
+
+MUDA_INLINE size_t LoggerCaptureWriter::frame_count() const
+{
+    std::lock_guard lock{m_mutex};
+    return m_frame_count;
+}
+
+MUDA_INLINE void LoggerCaptureWriter::write(const void* data, size_t size)
+{
+    if(size == 0)
+        return;
+    m_file.write(reinterpret_cast<const char*>(data), size);
+    m_written += size;
+}
+
+MUDA_INLINE void LoggerCaptureWriter::pad()
+{
+    constexpr char zeros[16] = {};
+    write(zeros, details::logger_capture_align(m_written) - m_written);
+}
+
+MUDA_INLINE LoggerCaptureReader::LoggerCaptureReader(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file)
+        MUDA_ERROR_WITH_LOCATION("LoggerCaptureReader: can't open %s", path.c_str());
+    m_bytes.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(m_bytes.data(), m_bytes.size());
+
+    size_t offset    = 0;
+    // the sections are padded, so the offset may pass the end of a truncated capture
+    auto remaining = [&] { return offset < m_bytes.size() ? m_bytes.size() - offset : 0; };
+    auto   at        = [&](size_t o) { return m_bytes.data() + o; };
+
+    details::LoggerCaptureHeader header;
+    if(remaining() < sizeof(header))
+        MUDA_ERROR_WITH_LOCATION("LoggerCaptureReader: %s is not a muda log capture", path.c_str());
+    std::memcpy(&header, at(0), sizeof(header));
+    if(std::memcmp(header.magic, details::LoggerCaptureHeader{}.magic, sizeof(header.magic)) != 0)
+        MUDA_ERROR_WITH_LOCATION("LoggerCaptureReader: %s is not a muda log capture", path.c_str());
+    if(header.version != details::logger_capture_version
+       || header.meta_data_size != sizeof(details::LoggerMetaData))
+        MUDA_ERROR_WITH_LOCATION("LoggerCaptureReader: %s has an incompatible version(%d) or meta data size(%d)",
+                                 path.c_str(),
+                                 (int)header.version,
+                                 (int)header.meta_data_size);
+    offset += sizeof(header);
+
+    auto type_bytes = size_t{header.type_count} * sizeof(details::LoggerCaptureTypeEntry);
+    if(remaining() < type_bytes)
+        MUDA_ERROR_WITH_LOCATION("LoggerCaptureReader: %s is truncated, %u type entries need %llu bytes, %llu left",
+                                 path.c_str(),
+                                 header.type_count,
+                                 (unsigned long long)type_bytes,
+                                 (unsigned long long)remaining());
+    m_types.resize(header.type_count);
+    std::memcpy(m_types.data(), at(offset), type_bytes);
+    offset = details::logger_capture_align(offset + type_bytes);
+
+    while(remaining() >= 16)
+    {
+        if(std::memcmp(at(offset), "FRAM", 4) == 0)
+        {
+            details::LoggerCaptureFrameHeader frame_header;
+            if(remaining() < sizeof(frame_header))
+                break;  // truncated
+            std::memcpy(&frame_header, at(offset), sizeof(frame_header));
+            auto meta_offset = offset + sizeof(frame_header);
+            auto meta_bytes  = frame_header.meta_count * sizeof(details::LoggerMetaData);
+            auto buffer_offset = details::logger_capture_align(meta_offset + meta_bytes);
+            auto end = details::logger_capture_align(buffer_offset + frame_header.buffer_size);
+            if(end > m_bytes.size())
+                break;  // truncated
+
+            LoggerCaptureFrame frame;
+            frame.index = frame_header.index;
+            frame.meta_data = {reinterpret_cast<const details::LoggerMetaData*>(at(meta_offset)),
+                               frame_header.meta_count};
+            frame.buffer = {at(buffer_offset), frame_header.buffer_size};
+            m_frames.push_back(frame);
+            offset = end;
+        }
+        else if(std::memcmp(at(offset), "SYMB", 4) == 0)
+        {
+            details::LoggerCaptureSymbolHeader symbol_header;
+            if(remaining() < sizeof(symbol_header))
+                break;  // truncated
+            std::memcpy(&symbol_header, at(offset), sizeof(symbol_header));
+            offset += sizeof(symbol_header);
+            for(uint32_t i = 0; i < symbol_header.count; ++i)
+            {
+                details::LoggerCaptureSymbolEntry entry;
+                if(remaining() < sizeof(entry))
+                    break;
+                std::memcpy(&entry, at(offset), sizeof(entry));
+                offset += sizeof(entry);
+                if(remaining() < entry.name_size)
+                    break;
+                m_symbols.emplace_back(entry.address, std::string_view{at(offset), entry.name_size});
+                offset = details::logger_capture_align(offset + entry.name_size);
+            }
+            break;
+        }
+        else
+        {
+            break;  // unknown section, maybe a partial write
+        }
+    }
+}
+
+MUDA_INLINE std::string_view LoggerCaptureReader::fmt_arg_name(LoggerFmtArg fmt_arg) const
+{
+    auto address = reinterpret_cast<uint64_t>(fmt_arg);
+    for(auto& [a, name] : m_symbols)
+        if(a == address)
+            return name;
+    return {};
+}
+
+MUDA_INLINE std::string_view LoggerCaptureReader::type_name(LoggerBasicType type) const
+{
+    for(auto& t : m_types)
+        if(t.type == static_cast<uint16_t>(type))
+        {
+            auto end = std::find(std::begin(t.name), std::end(t.name), '\0');
+            return std::string_view{t.name, static_cast<size_t>(end - t.name)};
+        }
+    return "unknown";
+}
+
+MUDA_INLINE void LoggerCaptureReader::put(std::ostream&                  os,
+                                          const details::LoggerMetaData& meta,
+                                          span<const char>               buffer) const
+{
+    if(meta.exceeded || size_t{meta.offset} + meta.size > buffer.size())
+    {
+        os << "[log_id " << meta.id << ": buffer exceeded]";
+        return;
+    }
+
+    switch(meta.type)
+    {
+        case LoggerBasicType::FmtString:
+            os << buffer.data() + meta.offset;
+            break;
+        case LoggerBasicType::Object: {
+            // the formatter lives in the capturing process, print the name and the bytes
+            auto name = fmt_arg_name(meta.fmt_arg);
+            os << "<" << (name.empty() ? std::string_view{"object"} : name) << ":";
+            auto flags = os.flags();
+            for(uint32_t i = 0; i < meta.size; ++i)
+                os << std::hex << std::setw(2) << std::setfill('0')
+                   << (static_cast<unsigned>(buffer[meta.offset + i]) & 0xffu);
+            os.flags(flags);
+            os << ">";
+        }
+        break;
+        default:
+            LoggerDecoder::put(os, meta, buffer.data());
+            break;
+    }
+}
+
+MUDA_INLINE void LoggerCaptureReader::write_text(std::ostream& os)
+{
+    for(auto& frame : m_frames)
+        for(auto i : m_decoder.order(frame.meta_data))
+            put(os, frame.meta_data[i], frame.buffer);
+}
+
+MUDA_INLINE void LoggerCaptureReader::write_csv(std::ostream& os)
+{
+    os << "frame,log_id,type,value\n";
+    std::stringstream value;
+    for(auto& frame : m_frames)
+    {
+        for(auto i : m_decoder.order(frame.meta_data))
+        {
+            auto& meta = frame.meta_data[i];
+            value.str(std::string{});
+            put(value, meta, frame.buffer);
+
+            // quote the value, double the quotes inside
+            os << frame.index << "," << meta.id << "," << type_name(meta.type) << ",\"";
+            for(auto c : value.str())
+            {
+                if(c == '"')
+                    os << '"';
+                os << c;
+            }
+            os << "\"\n";
+        }
+    }
+}
+}  // namespace muda
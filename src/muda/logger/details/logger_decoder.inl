@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <numeric>
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+MUDA_INLINE void LoggerDecoder::decode(span<const details::LoggerMetaData> meta_data,
+                                       const char*                         buffer,
+                                       size_t                              buffer_size,
+                                       std::ostream&                       os)
+{
+    for(auto i : order(meta_data))
+    {
+        const auto& meta = meta_data[i];
+        if(meta.exceeded || size_t{meta.offset} + meta.size > buffer_size)
+            os << "[log_id " << meta.id << ": buffer exceeded]";
+        else
+            put(os, meta, buffer);
+    }
+}
+
+MUDA_INLINE span<const uint32_t> LoggerDecoder::order(span<const details::LoggerMetaData> meta_data)
+{
+    // a statement may be written in several parts, they share the log id,
+    // so a stable sort by id puts them together in order
+    m_order.resize(meta_data.size());
+    std::iota(m_order.begin(), m_order.end(), 0u);
+    std::stable_sort(m_order.begin(),
+                     m_order.end(),
+                     [&](uint32_t a, uint32_t b)
+                     { return meta_data[a].id < meta_data[b].id; });
+    return m_order;
+}
+
+MUDA_INLINE void LoggerDecoder::put(std::ostream&                  os,
+                                    const details::LoggerMetaData& meta_data,
+                                    const char*                    buffer)
+{
+    auto offset = meta_data.offset;
+    auto type   = meta_data.type;
+#define MUDA_PUT_CASE(EnumT, T)                                                \
+    case LoggerBasicType::EnumT:                                               \
+        os << *reinterpret_cast<const T*>(buffer + offset);                    \
+        break;
+
+    switch(type)
+    {
+        case LoggerBasicType::String:
+            os << buffer + offset;
+            break;
+            MUDA_PUT_CASE(Int8, int8_t);
+            MUDA_PUT_CASE(Int16, int16_t);
+            MUDA_PUT_CASE(Int32, int32_t);
+            MUDA_PUT_CASE(Int64, int64_t);
+            MUDA_PUT_CASE(UInt8, uint8_t);
+            MUDA_PUT_CASE(UInt16, uint16_t);
+            MUDA_PUT_CASE(UInt32, uint32_t);
+            MUDA_PUT_CASE(UInt64, uint64_t);
+            MUDA_PUT_CASE(Float, float);
+            MUDA_PUT_CASE(Double, double);
+        default:
+            MUDA_ERROR_WITH_LOCATION("Unknown type");
+            break;
+    }
+#undef MUDA_PUT_CASE
+}
+}  // namespace muda
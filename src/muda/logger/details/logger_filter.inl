@@ -0,0 +1,41 @@
+#include <algorithm>
+#include <muda/muda_def.h>
+
+namespace muda
+{
+MUDA_INLINE bool LoggerFilter::match(std::string_view pattern, std::string_view name)
+{
+    if(!pattern.empty() && pattern.back() == '*')
+    {
+        pattern.remove_suffix(1);
+        return name.substr(0, pattern.size()) == pattern;
+    }
+    return pattern == name;
+}
+
+MUDA_INLINE bool LoggerFilter::accept_kernel(std::string_view kernel_name) const
+{
+    auto matched = [&](const std::string& pattern)
+    { return match(pattern, kernel_name); };
+
+    if(std::any_of(excluded_kernels.begin(), excluded_kernels.end(), matched))
+        return false;
+    return kernels.empty() || std::any_of(kernels.begin(), kernels.end(), matched);
+}
+
+MUDA_INLINE details::LoggerDeviceFilter LoggerFilter::resolve(std::string_view kernel_name) const
+{
+    details::LoggerDeviceFilter f;
+    f.min_level      = min_level;
+    f.sample_every   = std::max(sample_every, 1u);
+    f.sample_offset  = sample_offset;
+    f.kernel_enabled = accept_kernel(kernel_name);
+    return f;
+}
+
+MUDA_INLINE details::LoggerDeviceFilter LoggerFilter::resolve() const
+{
+    auto name = details::LaunchInfoCache::current_kernel_name().host_string;
+    return resolve(name ? std::string_view{name} : std::string_view{});
+}
+}  // namespace muda
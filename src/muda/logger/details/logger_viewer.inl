@@ -1,14 +1,78 @@
 #include <device_atomic_functions.h>
+#include <muda/tools/warp_reserve.h>
 
 namespace muda
 {
-MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy::Proxy(LoggerViewer& viewer)
+MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy::Proxy(LoggerViewer& viewer, LoggerLevel level)
     : m_viewer(viewer)
+    , m_enabled(viewer.is_enabled(level))
 {
     MUDA_KERNEL_ASSERT(m_viewer.m_buffer.data() && m_viewer.m_meta_data.data(),
                        "LoggerViewer is not initialized");
-    m_log_id = atomicAdd(&(m_viewer.m_offset_view->log_id), 1u);
 }
+
+MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy::Proxy(Proxy&& other)
+    : m_viewer(other.m_viewer)
+    , m_log_id(other.m_log_id)
+    , m_meta_count(other.m_meta_count)
+    , m_byte_count(other.m_byte_count)
+    , m_enabled(other.m_enabled)
+{
+    for(uint32_t i = 0; i < m_meta_count; ++i)
+        m_meta[i] = other.m_meta[i];
+    for(uint32_t i = 0; i < m_byte_count; ++i)
+        m_bytes[i] = other.m_bytes[i];
+    // the content is taken over
+    other.m_meta_count = 0;
+    other.m_byte_count = 0;
+}
+
+MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy::~Proxy()
+{
+    flush();
+}
+
+MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy& LoggerViewer::Proxy::flush()
+{
+    if(m_meta_count == 0)
+        return *this;
+    m_viewer.push_data(m_meta, m_meta_count, m_bytes, m_byte_count, m_log_id);
+    m_meta_count = 0;
+    m_byte_count = 0;
+    return *this;
+}
+
+MUDA_INLINE MUDA_DEVICE void LoggerViewer::Proxy::push(details::LoggerMetaData meta,
+                                                       uint32_t alignment,
+                                                       const void* data)
+{
+    if(!m_enabled)
+        return;
+
+    alignment   = alignment > 16 ? 16 : alignment;
+    auto offset = (m_byte_count + alignment - 1) / alignment * alignment;
+    if(m_meta_count == MaxMetaCount || offset + meta.size > MaxByteCount)
+    {
+        flush();
+        offset = 0;
+    }
+
+    if(meta.size > MaxByteCount)
+    {
+        // too large to stage (e.g. a long string), write it directly
+        meta.offset = 0;
+        m_viewer.push_data(&meta, 1, data, meta.size, m_log_id);
+        return;
+    }
+
+    auto src = reinterpret_cast<const char*>(data);
+    for(uint32_t i = 0; i < meta.size; ++i)
+        m_bytes[offset + i] = src[i];
+    meta.offset            = offset;
+    m_meta[m_meta_count++] = meta;
+    m_byte_count           = offset + meta.size;
+}
+
 template <bool IsFmt>
 MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy& LoggerViewer::Proxy::push_string(const char* str)
 {
@@ -31,8 +95,7 @@ MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy& LoggerViewer::Proxy::push_string(co
         meta.type = LoggerBasicType::String;
     }
     meta.size = size;
-    meta.id   = m_log_id;
-    m_viewer.push_data(meta, str);
+    push(meta, 1, str);
     return *this;
 }
 
@@ -42,9 +105,8 @@ MUDA_DEVICE void LoggerViewer::Proxy::push_fmt_arg(const T& obj, LoggerFmtArg fu
     details::LoggerMetaData meta;
     meta.type    = LoggerBasicType::Object;
     meta.size    = sizeof(T);
-    meta.id      = m_log_id;
     meta.fmt_arg = func;
-    m_viewer.push_data(meta, &obj);
+    push(meta, alignof(T), &obj);
 }
 
 MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy& LoggerViewer::Proxy::operator<<(const char* str)
@@ -75,82 +137,122 @@ MUDA_INLINE MUDA_DEVICE LoggerViewer::Proxy LoggerViewer::operator<<(const char*
     return p;
 }
 
-MUDA_INLINE MUDA_DEVICE uint32_t next_idx(uint32_t* data_offset, uint32_t size, uint32_t total_size)
+MUDA_INLINE MUDA_DEVICE bool LoggerViewer::is_enabled(LoggerLevel level) const
 {
+    if(level < m_filter.min_level || !m_filter.kernel_enabled)
+        return false;
+    if(m_filter.sample_every <= 1)
+        return true;
 
-    uint32_t old = *data_offset;
-    if(old + size >= total_size)
-        return ~0u;
-    uint32_t assumed;
-    do
-    {
-        assumed         = old;
-        auto new_offset = old + size;
-        old             = atomicCAS(data_offset, assumed, new_offset);
-        if(old + size >= total_size)
-        {
-            old = ~0u;
-            break;
-        }
-    } while(assumed != old);
-    return old;
+    // deterministic sampling by the global thread index
+    auto block_size = static_cast<uint64_t>(blockDim.x) * blockDim.y * blockDim.z;
+    auto block_id   = (static_cast<uint64_t>(blockIdx.z) * gridDim.y + blockIdx.y) * gridDim.x
+                    + blockIdx.x;
+    auto thread_id  = (static_cast<uint64_t>(threadIdx.z) * blockDim.y + threadIdx.y) * blockDim.x
+                     + threadIdx.x;
+    auto global_id  = block_id * block_size + thread_id;
+    return (global_id + m_filter.sample_offset) % m_filter.sample_every == 0;
 }
 
-MUDA_INLINE MUDA_DEVICE uint32_t LoggerViewer::next_meta_data_idx() const
+MUDA_INLINE MUDA_DEVICE bool LoggerViewer::reserve(uint32_t  meta_count,
+                                                   uint32_t  byte_count,
+                                                   uint32_t& meta_idx,
+                                                   uint32_t& buffer_idx) const
 {
-    auto idx = next_idx(&(m_offset_view->meta_data_offset), 1u, m_meta_data.total_size());
-    if(idx == ~0u)
+    // low 32 bits: meta_data_offset, high 32 bits: buffer_offset (see LoggerOffset)
+    auto counter = reinterpret_cast<unsigned long long*>(&(m_offset_view->meta_data_offset));
+    auto request = (static_cast<unsigned long long>(byte_count) << 32) | meta_count;
+
+    // which limit the last failed try hit, the flag is only raised when this lane is rejected
+    bool exceed_meta_data = false;
+    auto try_reserve      = [&](unsigned long long size) -> unsigned long long
     {
-        atomicCAS(&(m_offset_view->exceed_meta_data), 0u, 1u);
-        return ~0u;
-    }
-    return idx;
-}
+        auto meta_total   = static_cast<unsigned long long>(m_meta_data.total_size());
+        auto buffer_total = static_cast<unsigned long long>(m_buffer.total_size());
 
-MUDA_INLINE MUDA_DEVICE uint32_t LoggerViewer::next_buffer_idx(uint32_t size) const
-{
-    auto idx = next_idx(&(m_offset_view->buffer_offset), size, m_buffer.total_size());
-    if(idx == ~0u)
+        unsigned long long old = *counter;
+        unsigned long long assumed;
+        do
+        {
+            assumed = old;
+            if((assumed & 0xffffffffull) + (size & 0xffffffffull) > meta_total)
+            {
+                exceed_meta_data = true;
+                return ~0ull;
+            }
+            if((assumed >> 32) + (size >> 32) > buffer_total)
+            {
+                exceed_meta_data = false;
+                return ~0ull;
+            }
+            old = atomicCAS(counter, assumed, assumed + size);
+        } while(assumed != old);
+        return old;
+    };
+
+    auto base = details::warp_aggregated_reserve(counter, request, ~0ull, try_reserve);
+    if(base == ~0ull)
     {
-        atomicCAS(&(m_offset_view->exceed_buffer), 0u, 1u);
-        return ~0u;
+        if(exceed_meta_data)
+            atomicCAS(&(m_offset_view->exceed_meta_data), 0u, 1u);
+        else
+            atomicCAS(&(m_offset_view->exceed_buffer), 0u, 1u);
+        return false;
     }
-    return idx;
+    // no carry from the low part (each lane's part is checked against the meta data size)
+    meta_idx   = static_cast<uint32_t>(base & 0xffffffffull);
+    buffer_idx = static_cast<uint32_t>(base >> 32);
+    return true;
 }
 
-MUDA_INLINE MUDA_DEVICE bool LoggerViewer::push_data(details::LoggerMetaData meta,
-                                                     const void* data)
+MUDA_INLINE MUDA_DEVICE bool LoggerViewer::push_data(details::LoggerMetaData* meta,
+                                                     uint32_t    meta_count,
+                                                     const void* data,
+                                                     uint32_t    byte_count,
+                                                     uint32_t&   log_id)
 {
-    auto meta_idx = next_meta_data_idx();
-    if(meta_idx == ~0u)
+    // keep every reservation 16 bytes aligned, so the copy can use 16-byte stores
+    auto reserved_bytes = (byte_count + 15u) / 16u * 16u;
+
+    uint32_t meta_idx, buffer_idx;
+    if(!reserve(meta_count, reserved_bytes, meta_idx, buffer_idx))
     {
         MUDA_KERNEL_WARN_WITH_LOCATION(
-            "LoggerViewer[%s:%s]: meta data is exceeded, "
+            "LoggerViewer[%s:%s]: log buffer is exceeded, "
             "the content[id=%d] will be discarded.",
             kernel_name(),
             name(),
-            meta.id);
+            log_id);
         return false;
     }
-    auto buffer_idx = next_buffer_idx(meta.size);
-    if(buffer_idx == ~0u)
+
+    // the first reservation of a statement gives its id, the later ones share it
+    if(log_id == ~0u)
+        log_id = meta_idx;
+
+    for(uint32_t i = 0; i < meta_count; ++i)
     {
-        meta.exceeded = true;
-        MUDA_KERNEL_WARN_WITH_LOCATION(
-            "LoggerViewer[%s:%s]: log buffer is exceeded, "
-            "the content[id=%d] will be discarded.",
-            kernel_name(),
-            name(),
-            meta.id);
-        m_meta_data.data()[meta_idx]    = meta;
-        m_meta_data_id.data()[meta_idx] = meta.id;
-        return false;
+        auto m   = meta[i];
+        m.id     = log_id;
+        m.offset = buffer_idx + m.offset;
+        m_meta_data.data()[meta_idx + i]    = m;
+        m_meta_data_id.data()[meta_idx + i] = log_id;
+    }
+
+    auto     dst = m_buffer.data() + buffer_idx;
+    auto     src = reinterpret_cast<const char*>(data);
+    uint32_t i   = 0;
+    if((reinterpret_cast<uintptr_t>(src) & 15u) == 0)
+    {
+        // the staged bytes are 16 bytes aligned, and so is the reserved buffer
+        auto src4 = reinterpret_cast<const uint4*>(src);
+        auto dst4 = reinterpret_cast<uint4*>(dst);
+        for(; i < byte_count / 16u; ++i)
+            dst4[i] = src4[i];
+        i *= 16u;
     }
-    meta.offset                     = buffer_idx;
-    m_meta_data.data()[meta_idx]    = meta;
-    m_meta_data_id.data()[meta_idx] = meta.id;
-    for(int i = 0; i < meta.size; ++i)
-        m_buffer.data()[buffer_idx + i] = reinterpret_cast<const char*>(data)[i];
+    for(; i < byte_count; ++i)
+        dst[i] = src[i];
     return true;
 }
 
@@ -160,8 +262,7 @@ MUDA_INLINE MUDA_DEVICE bool LoggerViewer::push_data(details::LoggerMetaData met
         details::LoggerMetaData meta;                                                 \
         meta.type = LoggerBasicType::enum_name;                                       \
         meta.size = sizeof(T);                                                        \
-        meta.id   = m_log_id;                                                         \
-        m_viewer.push_data(meta, &i);                                                 \
+        push(meta, alignof(T), &i);                                                   \
         return *this;                                                                 \
     }
 
@@ -0,0 +1,212 @@
+#include <muda/tools/debug_log.h>
+
+namespace muda
+{
+MUDA_INLINE StreamingLogger::StreamingLogger(std::ostream& os, size_t meta_size, size_t buffer_size)
+    : m_os(&os)
+{
+    init(meta_size, buffer_size);
+}
+
+MUDA_INLINE StreamingLogger::StreamingLogger(LoggerCaptureWriter& capture,
+                                             size_t               meta_size,
+                                             size_t               buffer_size)
+    : m_capture(&capture)
+{
+    init(meta_size, buffer_size);
+}
+
+MUDA_INLINE void StreamingLogger::init(size_t meta_size, size_t buffer_size)
+{
+    // the frames live on the current device, the decode thread works on it too
+    checkCudaErrors(cudaGetDevice(&m_device));
+    checkCudaErrors(cudaStreamCreateWithFlags(&m_copy_stream, cudaStreamNonBlocking));
+    for(auto& frame : m_frames)
+    {
+        checkCudaErrors(cudaEventCreateWithFlags(&frame.ended, cudaEventDisableTiming));
+        checkCudaErrors(cudaEventCreateWithFlags(&frame.ready, cudaEventDisableTiming));
+        allocate(frame, meta_size, buffer_size);
+    }
+    checkCudaErrors(cudaDeviceSynchronize());
+    m_thread = std::thread([this] { decode_main(); });
+}
+
+MUDA_INLINE StreamingLogger::~StreamingLogger()
+{
+    flush();
+    {
+        std::lock_guard lock{m_mutex};
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+
+    for(auto& frame : m_frames)
+    {
+        free_host(frame);
+        checkCudaErrors(cudaEventDestroy(frame.ended));
+        checkCudaErrors(cudaEventDestroy(frame.ready));
+    }
+    checkCudaErrors(cudaStreamDestroy(m_copy_stream));
+}
+
+MUDA_INLINE void StreamingLogger::swap(cudaStream_t stream)
+{
+    auto& frame = m_frames[m_current];
+    checkCudaErrors(cudaMemcpyAsync(frame.h_offset,
+                                    frame.offset.data(),
+                                    sizeof(details::LoggerOffset),
+                                    cudaMemcpyDeviceToHost,
+                                    stream));
+    checkCudaErrors(cudaEventRecord(frame.ended, stream));
+    {
+        std::lock_guard lock{m_mutex};
+        frame.busy = true;
+        m_queue.push_back(m_current);
+    }
+    m_cv.notify_all();
+
+    m_current  = 1 - m_current;
+    auto& next = m_frames[m_current];
+    {
+        std::unique_lock lock{m_mutex};
+        m_cv.wait(lock, [&] { return !next.busy; });
+    }
+
+    if(next.exceeded)
+    {
+        auto meta_size   = next.meta_data.size() * 2;
+        auto buffer_size = next.buffer.size() * 2;
+        MUDA_KERNEL_WARN_WITH_LOCATION(
+            "StreamingLogger frame expanded: meta data %d => %d, buffer %d => %d",
+            (int)next.meta_data.size(),
+            (int)meta_size,
+            (int)next.buffer.size(),
+            (int)buffer_size);
+        allocate(next, meta_size, buffer_size);
+        next.exceeded = false;
+    }
+
+    // kernels of the new frame run after its reset, without blocking the host
+    checkCudaErrors(cudaStreamWaitEvent(stream, next.ready));
+}
+
+MUDA_INLINE void StreamingLogger::flush(cudaStream_t stream)
+{
+    swap(stream);
+    std::unique_lock lock{m_mutex};
+    m_cv.wait(lock,
+              [&] {
+                  return m_queue.empty() && !m_frames[0].busy && !m_frames[1].busy;
+              });
+    if(m_os)
+        m_os->flush();
+}
+
+MUDA_INLINE size_t StreamingLogger::frame_count() const
+{
+    std::lock_guard lock{m_mutex};
+    return m_frame_count;
+}
+
+MUDA_INLINE size_t StreamingLogger::exceeded_frame_count() const
+{
+    std::lock_guard lock{m_mutex};
+    return m_exceeded_frame_count;
+}
+
+MUDA_INLINE void StreamingLogger::allocate(Frame& frame, size_t meta_size, size_t buffer_size)
+{
+    // the frame is idle here: not current and not being decoded
+    free_host(frame);
+
+    frame.meta_data_id.resize(meta_size);
+    frame.meta_data.resize(meta_size);
+    frame.buffer.resize(buffer_size);
+    frame.offset = details::LoggerOffset{};
+
+    checkCudaErrors(cudaMallocHost(&frame.h_offset, sizeof(details::LoggerOffset)));
+    checkCudaErrors(cudaMallocHost(&frame.h_meta_data,
+                                   meta_size * sizeof(details::LoggerMetaData)));
+    checkCudaErrors(cudaMallocHost(&frame.h_buffer, buffer_size));
+
+    frame.viewer.m_offset_view  = frame.offset.viewer();
+    frame.viewer.m_meta_data_id = frame.meta_data_id.viewer();
+    frame.viewer.m_meta_data    = frame.meta_data.viewer();
+    frame.viewer.m_buffer       = frame.buffer.viewer();
+
+    checkCudaErrors(cudaEventRecord(frame.ready, m_copy_stream));
+}
+
+MUDA_INLINE void StreamingLogger::free_host(Frame& frame)
+{
+    if(frame.h_offset)
+        checkCudaErrors(cudaFreeHost(frame.h_offset));
+    if(frame.h_meta_data)
+        checkCudaErrors(cudaFreeHost(frame.h_meta_data));
+    if(frame.h_buffer)
+        checkCudaErrors(cudaFreeHost(frame.h_buffer));
+    frame.h_offset    = nullptr;
+    frame.h_meta_data = nullptr;
+    frame.h_buffer    = nullptr;
+}
+
+MUDA_INLINE void StreamingLogger::decode_main()
+{
+    // a new thread starts on device 0
+    checkCudaErrors(cudaSetDevice(m_device));
+    while(true)
+    {
+        size_t index;
+        {
+            std::unique_lock lock{m_mutex};
+            m_cv.wait(lock, [&] { return !m_queue.empty() || m_stop; });
+            if(m_queue.empty())
+                return;
+            index = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        auto& frame = m_frames[index];
+        checkCudaErrors(cudaEventSynchronize(frame.ended));
+        auto offset = *frame.h_offset;
+
+        // copy only the used part, then reset the frame for its next turn
+        if(offset.meta_data_offset > 0)
+            checkCudaErrors(cudaMemcpyAsync(frame.h_meta_data,
+                                            frame.meta_data.data(),
+                                            offset.meta_data_offset
+                                                * sizeof(details::LoggerMetaData),
+                                            cudaMemcpyDeviceToHost,
+                                            m_copy_stream));
+        if(offset.buffer_offset > 0)
+            checkCudaErrors(cudaMemcpyAsync(frame.h_buffer,
+                                            frame.buffer.data(),
+                                            offset.buffer_offset,
+                                            cudaMemcpyDeviceToHost,
+                                            m_copy_stream));
+        checkCudaErrors(cudaMemsetAsync(
+            frame.offset.data(), 0, sizeof(details::LoggerOffset), m_copy_stream));
+        checkCudaErrors(cudaEventRecord(frame.ready, m_copy_stream));
+        checkCudaErrors(cudaStreamSynchronize(m_copy_stream));
+
+        span<const details::LoggerMetaData> meta_data{frame.h_meta_data,
+                                                      offset.meta_data_offset};
+        if(m_capture)
+            m_capture->write_frame(meta_data, frame.h_buffer, offset.buffer_offset);
+        else
+            m_decoder.decode(meta_data, frame.h_buffer, offset.buffer_offset, *m_os);
+
+        bool exceeded = offset.exceed_meta_data || offset.exceed_buffer;
+        {
+            std::lock_guard lock{m_mutex};
+            frame.busy     = false;
+            frame.exceeded = exceeded;
+            ++m_frame_count;
+            if(exceeded)
+                ++m_exceeded_frame_count;
+        }
+        m_cv.notify_all();
+    }
+}
+}  // namespace muda
@@ -4,6 +4,9 @@
 #include <cinttypes>
 #include <muda/literal/unit.h>
 #include <muda/logger/logger_viewer.h>
+#include <muda/logger/logger_decoder.h>
+#include <muda/logger/logger_capture.h>
+#include <muda/logger/logger_filter.h>
 #include <vector>
 
 namespace muda
@@ -58,16 +61,25 @@ class Logger
 
     void retrieve(std::ostream& o = std::cout);
 
+    // dump the raw content as a frame of the capture, no formatting
+    void retrieve(LoggerCaptureWriter& capture);
+
     MUDA_NODISCARD LoggerDataContainer retrieve_meta();
 
     bool is_meta_data_full() const { return m_h_offset.exceed_meta_data; }
     bool is_buffer_full() const { return m_h_offset.exceed_buffer; }
 
+    // the filter is resolved against the kernel name of the current launch
     LoggerViewer viewer() const
     {
-        return m_log_viewer_ptr ? *m_log_viewer_ptr : m_viewer;
+        LoggerViewer v = m_log_viewer_ptr ? *m_log_viewer_ptr : m_viewer;
+        v.m_filter     = m_filter.resolve();
+        return v;
     }
 
+    void                filter(const LoggerFilter& filter);
+    const LoggerFilter& filter() const { return m_filter; }
+
   private:
     friend class LaunchCore;
     friend class Debug;
@@ -100,6 +112,7 @@ class Logger
 
     LoggerViewer* m_log_viewer_ptr;
     LoggerViewer  m_viewer;
+    LoggerFilter  m_filter;
     template <typename F>
     void _retrieve(F&&);
     void put(std::ostream& os, const details::LoggerMetaData& meta_data) const;
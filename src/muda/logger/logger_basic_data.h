@@ -28,6 +28,16 @@ enum class LoggerBasicType : uint16_t
 
 using LoggerFmtArg = void (*)(void* formatter, const void* obj);
 
+enum class LoggerLevel : uint32_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off,  // only for LoggerFilter::min_level, mutes everything
+};
+
 namespace details
 {
     class LoggerMetaData
@@ -41,13 +51,24 @@ namespace details
         LoggerFmtArg    fmt_arg  = nullptr;
     };
 
-    class LoggerOffset
+    // LoggerFilter resolved for one viewer, checked before any reservation
+    class LoggerDeviceFilter
     {
       public:
-        uint32_t log_id           = 0;
+        LoggerLevel min_level      = LoggerLevel::Trace;
+        uint32_t    sample_every   = 1;  // keep 1 of N threads
+        uint32_t    sample_offset  = 0;
+        uint32_t    kernel_enabled = 1;  // false if the kernel is filtered out
+    };
+
+    class alignas(8) LoggerOffset
+    {
+      public:
+        // meta_data_offset and buffer_offset are adjacent, so that a log statement
+        // reserves both of them with one 64-bit atomicCAS
         uint32_t meta_data_offset = 0;
-        uint32_t exceed_meta_data = 0;  // false
         uint32_t buffer_offset    = 0;
+        uint32_t exceed_meta_data = 0;  // false
         uint32_t exceed_buffer    = 0;  // false
     };
 }  // namespace details
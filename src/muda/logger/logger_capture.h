@@ -0,0 +1,161 @@
+#pragma once
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <muda/logger/logger_decoder.h>
+
+namespace muda
+{
+namespace details
+{
+    // capture file layout (host byte order), every section is 16 bytes aligned,
+    // so a memory mapped capture can be read in place:
+    //  LoggerCaptureHeader
+    //  LoggerCaptureTypeEntry[type_count]
+    //  { LoggerCaptureFrameHeader, LoggerMetaData[meta_count], payload[buffer_size] } ...
+    //  LoggerCaptureSymbolHeader, { LoggerCaptureSymbolEntry, name } ...
+    // a capture cut by a crash is still readable up to the last complete frame.
+    constexpr uint32_t logger_capture_version = 1;
+
+    class LoggerCaptureHeader
+    {
+      public:
+        char     magic[8]       = {'M', 'U', 'D', 'A', 'L', 'O', 'G', '\0'};
+        uint32_t version        = logger_capture_version;
+        uint32_t meta_data_size = sizeof(LoggerMetaData);
+        uint32_t type_count     = 0;
+        uint32_t reserved       = 0;
+        uint64_t reserved1      = 0;
+    };
+
+    class LoggerCaptureTypeEntry
+    {
+      public:
+        uint16_t type = 0;
+        uint16_t size = 0;  // 0 for the variable sized
+        uint32_t reserved = 0;
+        char     name[8]  = {};
+    };
+
+    class LoggerCaptureFrameHeader
+    {
+      public:
+        char     magic[4]    = {'F', 'R', 'A', 'M'};
+        uint32_t meta_count  = 0;
+        uint64_t buffer_size = 0;
+        uint64_t index       = 0;
+        uint64_t reserved    = 0;
+    };
+
+    class LoggerCaptureSymbolHeader
+    {
+      public:
+        char     magic[4] = {'S', 'Y', 'M', 'B'};
+        uint32_t count    = 0;
+        uint64_t reserved = 0;
+    };
+
+    class LoggerCaptureSymbolEntry
+    {
+      public:
+        uint64_t address   = 0;  // the LoggerFmtArg in the capturing process
+        uint32_t name_size = 0;  // followed by the name, padded to 16 bytes
+        uint32_t reserved  = 0;
+    };
+}  // namespace details
+
+/// <summary>
+/// LoggerCaptureWriter: dumps raw logger frames (meta data + payload) to a binary file.
+/// There is no formatting on the way, writing a frame is two sequential writes.
+/// `LoggerFmtArg`s are process specific, register them with a name to keep them
+/// readable offline. Decode the capture with LoggerCaptureReader or the muda_log_decode tool.
+/// usage:
+///     LoggerCaptureWriter capture("frames.mudalog");
+///     Logger logger;
+///     ... // launch
+///     logger.retrieve(capture);
+/// </summary>
+class LoggerCaptureWriter
+{
+  public:
+    explicit LoggerCaptureWriter(const std::string& path);
+    ~LoggerCaptureWriter();
+
+    // delete copy
+    LoggerCaptureWriter(const LoggerCaptureWriter&)            = delete;
+    LoggerCaptureWriter& operator=(const LoggerCaptureWriter&) = delete;
+
+    void register_fmt_arg(LoggerFmtArg fmt_arg, std::string name);
+
+    // thread safe, frames are numbered in the order they are written
+    void write_frame(span<const details::LoggerMetaData> meta_data,
+                     const char*                         buffer,
+                     size_t                              buffer_size);
+
+    // write the symbol registry and close the file, called by the destructor
+    void close();
+
+    size_t frame_count() const;
+
+  private:
+    void write(const void* data, size_t size);
+    void pad();
+
+    std::ofstream m_file;
+    size_t        m_written     = 0;
+    size_t        m_frame_count = 0;
+    std::vector<std::pair<LoggerFmtArg, std::string>> m_symbols;
+    mutable std::mutex                                m_mutex;
+};
+
+class LoggerCaptureFrame
+{
+  public:
+    uint64_t                            index = 0;
+    span<const details::LoggerMetaData> meta_data;
+    span<const char>                    buffer;
+};
+
+/// <summary>
+/// LoggerCaptureReader: loads a capture written by LoggerCaptureWriter,
+/// the frames refer to the loaded bytes without any copy. Host only.
+/// </summary>
+class LoggerCaptureReader
+{
+  public:
+    explicit LoggerCaptureReader(const std::string& path);
+
+    // delete copy, the frames and the symbols refer to the loaded bytes of this reader
+    LoggerCaptureReader(const LoggerCaptureReader&)            = delete;
+    LoggerCaptureReader& operator=(const LoggerCaptureReader&) = delete;
+    // a moved std::vector keeps its storage, so the views stay valid
+    LoggerCaptureReader(LoggerCaptureReader&&)            = default;
+    LoggerCaptureReader& operator=(LoggerCaptureReader&&) = default;
+
+    size_t                         frame_count() const { return m_frames.size(); }
+    const LoggerCaptureFrame&      frame(size_t i) const { return m_frames[i]; }
+    span<const LoggerCaptureFrame> frames() const { return m_frames; }
+
+    // the registered name of a LoggerFmtArg of the capturing process, empty if unknown
+    std::string_view fmt_arg_name(LoggerFmtArg fmt_arg) const;
+    std::string_view type_name(LoggerBasicType type) const;
+
+    // the same text as Logger::retrieve()
+    void write_text(std::ostream& os);
+    // frame,log_id,type,value
+    void write_csv(std::ostream& os);
+
+  private:
+    void put(std::ostream& os, const details::LoggerMetaData& meta, span<const char> buffer) const;
+
+    std::vector<char>                                  m_bytes;
+    std::vector<LoggerCaptureFrame>                    m_frames;
+    std::vector<details::LoggerCaptureTypeEntry>       m_types;
+    std::vector<std::pair<uint64_t, std::string_view>> m_symbols;
+    LoggerDecoder                                      m_decoder;
+};
+}  // namespace muda
+
+#include "details/logger_capture.inl"
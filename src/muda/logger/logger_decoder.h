@@ -0,0 +1,34 @@
+#pragma once
+#include <ostream>
+#include <vector>
+#include <muda/mstl/span.h>
+#include <muda/logger/logger_basic_data.h>
+
+namespace muda
+{
+/// <summary>
+/// LoggerDecoder: turns the raw meta data and buffer of a logger into text.
+/// It only reads host memory, so the ordering and decoding can be checked with
+/// synthetic meta data.
+/// </summary>
+class LoggerDecoder
+{
+  public:
+    // write the entries ordered by log id, the entries of one statement keep their order
+    void decode(span<const details::LoggerMetaData> meta_data,
+                const char*                         buffer,
+                size_t                              buffer_size,
+                std::ostream&                       os);
+
+    // the entry indices ordered by log id, stable within a log id
+    span<const uint32_t> order(span<const details::LoggerMetaData> meta_data);
+
+    // write a single entry
+    static void put(std::ostream& os, const details::LoggerMetaData& meta_data, const char* buffer);
+
+  private:
+    std::vector<uint32_t> m_order;
+};
+}  // namespace muda
+
+#include "details/logger_decoder.inl"
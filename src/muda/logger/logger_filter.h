@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <muda/logger/logger_basic_data.h>
+#include <muda/tools/launch_info_cache.h>
+
+namespace muda
+{
+/// <summary>
+/// LoggerFilter: drops log statements on the device before they touch the logger buffer.
+/// The kernel filters are resolved on the host when the viewer is created, against the
+/// name given by `Launch().kernel_name(...)` (see LaunchInfoCache), so the device only
+/// checks the level, a flag and the sampling.
+/// usage:
+///     LoggerFilter filter;
+///     filter.min_level    = LoggerLevel::Warn;
+///     filter.kernels      = {"solver*"};  // '*' at the end matches a prefix
+///     filter.sample_every = 32;           // 1 of 32 threads, by the global thread index
+///     logger.filter(filter);
+/// </summary>
+class LoggerFilter
+{
+  public:
+    LoggerLevel min_level = LoggerLevel::Trace;
+
+    // log only in these kernels, empty means all
+    std::vector<std::string> kernels;
+    // never log in these kernels
+    std::vector<std::string> excluded_kernels;
+
+    // keep the threads whose (global thread index + sample_offset) % sample_every == 0
+    uint32_t sample_every  = 1;
+    uint32_t sample_offset = 0;
+
+    bool accept_kernel(std::string_view kernel_name) const;
+
+    details::LoggerDeviceFilter resolve(std::string_view kernel_name) const;
+    // resolve against the kernel name of the current launch
+    details::LoggerDeviceFilter resolve() const;
+
+  private:
+    static bool match(std::string_view pattern, std::string_view name);
+};
+}  // namespace muda
+
+#include "details/logger_filter.inl"
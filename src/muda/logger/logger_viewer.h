@@ -11,19 +11,46 @@ class LoggerViewer : public ViewerBase
     MUDA_VIEWER_COMMON_NAME(LoggerViewer);
 
   public:
+    /// <summary>
+    /// Proxy stages the content of a log statement in the thread,
+    /// the whole statement is reserved in the logger buffer in one shot when the proxy
+    /// is destroyed (or flushed), so `logger << a << b << c;` costs one reservation.
+    /// If the stage is full, the staged content is flushed and the statement goes on
+    /// with the same log id, so the output order is kept.
+    /// A proxy rejected by the LoggerFilter (level, kernel, sampling) is muted, it neither
+    /// stages nor reserves anything.
+    /// </summary>
     class Proxy
     {
-        LoggerViewer& m_viewer;
-        uint32_t      m_log_id;
+      public:
+        constexpr static uint32_t MaxMetaCount = 16;
+        constexpr static uint32_t MaxByteCount = 256;
+
+      private:
+        LoggerViewer&           m_viewer;
+        uint32_t                m_log_id     = ~0u;
+        uint32_t                m_meta_count = 0;
+        uint32_t                m_byte_count = 0;
+        bool                    m_enabled    = true;
+        details::LoggerMetaData m_meta[MaxMetaCount];
+        alignas(16) char        m_bytes[MaxByteCount];
+
+        MUDA_DEVICE void push(details::LoggerMetaData meta, uint32_t alignment, const void* data);
 
       public:
-        MUDA_DEVICE Proxy(LoggerViewer& viewer);
+        MUDA_DEVICE Proxy(LoggerViewer& viewer, LoggerLevel level = LoggerLevel::Info);
+        MUDA_DEVICE Proxy(Proxy&& other);
+        MUDA_DEVICE ~Proxy();
+
+        // the staged content can't be shared
+        Proxy(const Proxy&)            = delete;
+        Proxy& operator=(const Proxy&) = delete;
 
-        MUDA_DEVICE Proxy(const Proxy& other)
-            : m_viewer(other.m_viewer)
-            , m_log_id(other.m_log_id)
-        {
-        }
+        // reserve and write the staged content to the logger
+        MUDA_DEVICE Proxy& flush();
+
+        // false if the statement is dropped by the filter
+        MUDA_DEVICE bool is_enabled() const { return m_enabled; }
 
         template <bool IsFmt>
         MUDA_DEVICE Proxy& push_string(const char* str);
@@ -49,6 +76,7 @@ class LoggerViewer : public ViewerBase
     };
 
     friend class Logger;
+    friend class StreamingLogger;
 
     template <typename T>
     MUDA_DEVICE Proxy operator<<(const T& t);
@@ -56,16 +84,26 @@ class LoggerViewer : public ViewerBase
     template <bool IsFmt>
     MUDA_DEVICE Proxy push_string(const char* str);
     MUDA_DEVICE Proxy proxy() { return Proxy(*this); }
+    MUDA_DEVICE Proxy proxy(LoggerLevel level) { return Proxy(*this, level); }
+    // a statement with a level, e.g. `logger(LoggerLevel::Warn) << "x=" << x;`
+    MUDA_DEVICE Proxy operator()(LoggerLevel level) { return Proxy(*this, level); }
+
+    // check the level, kernel and sampling filters of the current thread
+    MUDA_DEVICE bool is_enabled(LoggerLevel level) const;
 
   private:
     Dense1D<uint32_t>                    m_meta_data_id;
     Dense1D<details::LoggerMetaData>     m_meta_data;
     Dense1D<char>                        m_buffer;
     mutable Dense<details::LoggerOffset> m_offset_view;
-
-    MUDA_DEVICE uint32_t next_meta_data_idx() const;
-    MUDA_DEVICE uint32_t next_buffer_idx(uint32_t size) const;
-    MUDA_DEVICE bool push_data(details::LoggerMetaData meta, const void* data);
+    details::LoggerDeviceFilter          m_filter;
+
+    MUDA_DEVICE bool reserve(uint32_t meta_count, uint32_t byte_count, uint32_t& meta_idx, uint32_t& buffer_idx) const;
+    MUDA_DEVICE bool push_data(details::LoggerMetaData* meta,
+                               uint32_t                 meta_count,
+                               const void*              data,
+                               uint32_t                 byte_count,
+                               uint32_t&                log_id);
 };
 
 using LogProxy = LoggerViewer::Proxy;
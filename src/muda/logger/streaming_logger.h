@@ -0,0 +1,134 @@
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <muda/literal/unit.h>
+#include <muda/buffer/device_buffer.h>
+#include <muda/buffer/device_var.h>
+#include <muda/logger/logger_viewer.h>
+#include <muda/logger/logger_decoder.h>
+#include <muda/logger/logger_capture.h>
+#include <muda/logger/logger_filter.h>
+
+namespace muda
+{
+/// <summary>
+/// StreamingLogger: a Logger that never stalls the GPU.
+/// It has two device frames. Kernels log into the current frame, and `swap(stream)`
+/// ends the frame on `stream` and switches to the other one without any synchronization.
+/// A background thread waits for the ended frame, copies the used part to pinned host
+/// memory on its own stream, resets the frame, then decodes it into the ostream.
+/// usage:
+///     StreamingLogger logger(std::cout);
+///     for(...)  // frames
+///     {
+///         ParallelFor(256).apply(N, [logger = logger.viewer()] __device__(int i) mutable
+///                                { logger << i << "\n"; });
+///         logger.swap();
+///     }
+///     logger.flush();
+/// Note:
+/// 1. the new frame is ready on the stream passed to `swap()`, kernels on other streams
+///    should be ordered after it.
+/// 2. `swap()` blocks the host only if the background thread is still decoding the other
+///    frame (two frames behind).
+/// 3. a frame that is exceeded gets doubled the next time it becomes current.
+/// 4. with a LoggerCaptureWriter, the frames are dumped raw instead of decoded.
+/// </summary>
+class StreamingLogger
+{
+    static constexpr size_t DEFAULT_META_SIZE   = 1_M;
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 16_M;
+
+  public:
+    StreamingLogger(std::ostream& os          = std::cout,
+                    size_t        meta_size   = DEFAULT_META_SIZE,
+                    size_t        buffer_size = DEFAULT_BUFFER_SIZE);
+
+    StreamingLogger(LoggerCaptureWriter& capture,
+                    size_t               meta_size   = DEFAULT_META_SIZE,
+                    size_t               buffer_size = DEFAULT_BUFFER_SIZE);
+
+    ~StreamingLogger();
+
+    // delete copy
+    StreamingLogger(const StreamingLogger&)            = delete;
+    StreamingLogger& operator=(const StreamingLogger&) = delete;
+
+    // delete move, the background thread refers to this
+    StreamingLogger(StreamingLogger&&)            = delete;
+    StreamingLogger& operator=(StreamingLogger&&) = delete;
+
+    // the viewer of the current frame, the filter is resolved against the current kernel name
+    LoggerViewer viewer() const
+    {
+        LoggerViewer v = m_frames[m_current].viewer;
+        v.m_filter     = m_filter.resolve();
+        return v;
+    }
+
+    void                filter(const LoggerFilter& filter) { m_filter = filter; }
+    const LoggerFilter& filter() const { return m_filter; }
+
+    // end the current frame on `stream` and switch to the other one
+    void swap(cudaStream_t stream = nullptr);
+
+    // swap, then wait until all the frames are written to the ostream
+    void flush(cudaStream_t stream = nullptr);
+
+    // the number of frames written to the ostream
+    size_t frame_count() const;
+
+    // the number of frames that lost content because they were full
+    size_t exceeded_frame_count() const;
+
+  private:
+    class Frame
+    {
+      public:
+        DeviceBuffer<uint32_t>                meta_data_id;
+        DeviceBuffer<details::LoggerMetaData> meta_data;
+        DeviceBuffer<char>                    buffer;
+        DeviceVar<details::LoggerOffset>      offset;
+        LoggerViewer                          viewer;
+
+        // pinned host memory
+        details::LoggerOffset*   h_offset    = nullptr;
+        details::LoggerMetaData* h_meta_data = nullptr;
+        char*                    h_buffer    = nullptr;
+
+        cudaEvent_t ended = nullptr;  // the offset has been copied to h_offset
+        cudaEvent_t ready = nullptr;  // the offset has been reset
+
+        bool busy     = false;  // being decoded
+        bool exceeded = false;
+    };
+
+    void init(size_t meta_size, size_t buffer_size);
+    void allocate(Frame& frame, size_t meta_size, size_t buffer_size);
+    void free_host(Frame& frame);
+    void decode_main();
+
+    std::ostream*        m_os      = nullptr;
+    LoggerCaptureWriter* m_capture = nullptr;
+    std::array<Frame, 2> m_frames;
+    size_t               m_current = 0;
+    int                  m_device  = 0;
+    cudaStream_t         m_copy_stream = nullptr;
+    LoggerDecoder        m_decoder;
+    LoggerFilter         m_filter;
+
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_cv;
+    std::deque<size_t>      m_queue;
+    bool                    m_stop                 = false;
+    size_t                  m_frame_count          = 0;
+    size_t                  m_exceeded_frame_count = 0;
+    std::thread             m_thread;
+};
+}  // namespace muda
+
+#include "details/streaming_logger.inl"
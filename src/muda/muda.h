@@ -1,6 +1,7 @@
 #pragma once
 #include <muda/muda_config.h>
 #include <muda/launch.h>
+#include <muda/allocator.h>
 #include <muda/viewer.h>
 #include <muda/print.h>
 #include <muda/profiler.h>
@@ -1,8 +1,16 @@
 #pragma once
+#include <cstdint>
+#include <type_traits>
 #ifndef MUDA_CHECK_ON
 #define MUDA_CHECK_ON 0
 #endif
 
+// 1: the viewers and the launchers index with int64_t, for ranges beyond 2^31 elements (or bytes)
+// 0: index with int, fewer registers
+#ifndef MUDA_INDEX_64
+#define MUDA_INDEX_64 0
+#endif
+
 namespace muda
 {
 constexpr bool RUNTIME_CHECK_ON = MUDA_CHECK_ON;
@@ -17,6 +25,8 @@ namespace config
 constexpr bool DEBUG_VIEWER = config::on(true);
 // trap on error happens
 constexpr bool TRAP_ON_ERROR = config::on(true);
+// the index type of the dense viewers and the launchers (ParallelFor, HostParallelFor)
+using index_t = std::conditional_t<MUDA_INDEX_64, int64_t, int>;
 // light workload block size
 constexpr int LIGHT_WORKLOAD_BLOCK_SIZE = 256;
 // middle workload block size
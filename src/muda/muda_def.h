@@ -32,6 +32,16 @@
 #define MUDA_MAYBE_UNUSED [[maybe_unused]]
 #define MUDA_NORETURN [[noreturn]]
 
+// a kernel parameter read in place from the parameter space, taking its address makes no local copy
+// (CUDA 11.7+, sm_70+), otherwise it's a plain parameter
+#if defined(__CUDACC_VER_MAJOR__)                                                               \
+    && (__CUDACC_VER_MAJOR__ > 11 || (__CUDACC_VER_MAJOR__ == 11 && __CUDACC_VER_MINOR__ >= 7)) \
+    && (!defined(__CUDA_ARCH__) || __CUDA_ARCH__ >= 700)
+#define MUDA_GRID_CONSTANT __grid_constant__
+#else
+#define MUDA_GRID_CONSTANT
+#endif
+
 // Keywords
 #define MUDA_NOEXCEPT noexcept
 #define MUDA_INLINE inline
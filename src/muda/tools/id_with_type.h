@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <limits>
 #include <ostream>
 #include <muda/muda_def.h>
 #undef max
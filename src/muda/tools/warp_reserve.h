@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <muda/muda_def.h>
+
+namespace muda::details
+{
+MUDA_INLINE MUDA_DEVICE uint32_t lane_id()
+{
+    uint32_t lane;
+    asm volatile("mov.u32 %0, %%laneid;" : "=r"(lane));
+    return lane;
+}
+
+/// <summary>
+/// Warp-aggregated reservation from a shared counter, e.g. a buffer offset.
+/// The lanes reserving from the same counter (`key`) elect a leader, the leader reserves the sum
+/// of their requests with one `try_reserve(total)`, then every lane takes its own part.
+/// If the sum doesn't fit, every lane retries with its own request, so a lane whose request
+/// still fits is not rejected together with a large one.
+/// `try_reserve(size)` returns the counter value before the reservation, or `failed`.
+/// </summary>
+template <typename T, typename TryReserve>
+MUDA_INLINE MUDA_DEVICE T warp_aggregated_reserve(const void* key, T request, T failed, TryReserve&& try_reserve)
+{
+#if __CUDA_ARCH__ >= 700
+    auto active = __activemask();
+    auto group  = __match_any_sync(active, reinterpret_cast<unsigned long long>(key));
+    auto lane   = lane_id();
+    auto leader = __ffs(group) - 1;
+
+    T prefix = 0;
+    T total  = 0;
+    for(auto mask = group; mask; mask &= mask - 1)
+    {
+        auto src = __ffs(mask) - 1;
+        auto r   = __shfl_sync(group, request, src);
+        if(src < static_cast<int>(lane))
+            prefix += r;
+        total += r;
+    }
+
+    T base = failed;
+    if(lane == leader)
+        base = try_reserve(total);
+    base = __shfl_sync(group, base, leader);
+    if(base != failed)
+        return base + prefix;
+#endif
+    return try_reserve(request);
+}
+}  // namespace muda::details
@@ -17,69 +17,69 @@ template <typename T>
 class Dense1DBase : public ViewerBase
 {
   protected:
-    T*  m_data;
-    int m_dim;
+    T*      m_data;
+    index_t m_dim;
 
   public:
     using value_type = T;
 
     MUDA_GENERIC Dense1DBase() MUDA_NOEXCEPT : m_data(nullptr) {}
 
-    MUDA_GENERIC Dense1DBase(T* p, int dim) MUDA_NOEXCEPT : m_data(p), m_dim(dim)
+    MUDA_GENERIC Dense1DBase(T* p, index_t dim) MUDA_NOEXCEPT : m_data(p), m_dim(dim)
     {
     }
 
-    MUDA_GENERIC const T& operator()(int x) const MUDA_NOEXCEPT
+    MUDA_GENERIC const T& operator()(index_t x) const MUDA_NOEXCEPT
     {
         check();
         return m_data[map(x)];
     }
 
-    MUDA_GENERIC int map(int x) const MUDA_NOEXCEPT
+    MUDA_GENERIC index_t map(index_t x) const MUDA_NOEXCEPT
     {
         if constexpr(DEBUG_VIEWER)
             if(!(x >= 0 && x < m_dim))
-                MUDA_KERNEL_ERROR("dense1D[%s:%s]: out of range, index=(%d) m_dim=(%d)",
+                MUDA_KERNEL_ERROR("dense1D[%s:%s]: out of range, index=(%lld) m_dim=(%lld)",
                                   this->name(),
                                   this->kernel_name(),
-                                  x,
-                                  m_dim);
+                                  (long long)x,
+                                  (long long)m_dim);
         return x;
     }
 
     MUDA_GENERIC const T* data() const MUDA_NOEXCEPT { return m_data; }
 
-    MUDA_GENERIC int total_size() const MUDA_NOEXCEPT { return m_dim; }
+    MUDA_GENERIC index_t total_size() const MUDA_NOEXCEPT { return m_dim; }
 
-    MUDA_GENERIC int dim() const MUDA_NOEXCEPT { return m_dim; }
+    MUDA_GENERIC index_t dim() const MUDA_NOEXCEPT { return m_dim; }
 
-    MUDA_GENERIC Dense1DBase sub_view(int offset) const MUDA_NOEXCEPT
+    MUDA_GENERIC Dense1DBase sub_view(index_t offset) const MUDA_NOEXCEPT
     {
         auto size = this->m_dim - offset;
         if constexpr(DEBUG_VIEWER)
         {
             if(offset < 0)
-                MUDA_KERNEL_ERROR("dense1D[%s:%s]: sub_view out of range, offset=%d size=%d m_dim=(%d)",
+                MUDA_KERNEL_ERROR("dense1D[%s:%s]: sub_view out of range, offset=%lld size=%lld m_dim=(%lld)",
                                   this->name(),
                                   this->kernel_name(),
-                                  offset,
-                                  size,
-                                  this->m_dim);
+                                  (long long)offset,
+                                  (long long)size,
+                                  (long long)this->m_dim);
         }
         return Dense1DBase{this->m_data + offset, size};
     }
 
-    MUDA_GENERIC Dense1DBase sub_view(int offset, int size) const MUDA_NOEXCEPT
+    MUDA_GENERIC Dense1DBase sub_view(index_t offset, index_t size) const MUDA_NOEXCEPT
     {
         if constexpr(DEBUG_VIEWER)
         {
             if(offset < 0 || offset + size > m_dim)
-                MUDA_KERNEL_ERROR("dense1D[%s:%s]: sub_view out of range, offset=%d size=%d m_dim=(%d)",
+                MUDA_KERNEL_ERROR("dense1D[%s:%s]: sub_view out of range, offset=%lld size=%lld m_dim=(%lld)",
                                   this->name(),
                                   this->kernel_name(),
-                                  offset,
-                                  size,
-                                  this->m_dim);
+                                  (long long)offset,
+                                  (long long)size,
+                                  (long long)this->m_dim);
         }
         return Dense1DBase{this->m_data + offset, size};
     }
@@ -106,17 +106,17 @@ class CDense1D : public Dense1DBase<T>
     using Dense1DBase<T>::operator();
     CDense1D(const Dense1DBase<T>& base) MUDA_NOEXCEPT : Dense1DBase<T>(base) {}
 
-    MUDA_GENERIC CDense1D(const T* p, int dim) MUDA_NOEXCEPT
+    MUDA_GENERIC CDense1D(const T* p, index_t dim) MUDA_NOEXCEPT
         : Dense1DBase<T>(const_cast<T*>(p), dim)
     {
     }
 
-    MUDA_GENERIC this_type sub_view(int offset) const MUDA_NOEXCEPT
+    MUDA_GENERIC this_type sub_view(index_t offset) const MUDA_NOEXCEPT
     {
         return this_type{Dense1DBase<T>::sub_view(offset)};
     }
 
-    MUDA_GENERIC this_type sub_view(int offset, int size) const MUDA_NOEXCEPT
+    MUDA_GENERIC this_type sub_view(index_t offset, index_t size) const MUDA_NOEXCEPT
     {
         return this_type{Dense1DBase<T>::sub_view(offset, size)};
     }
@@ -142,7 +142,7 @@ class Dense1D : public Dense1DBase<T>
         return CDense1D<T>{*this};
     }
 
-    MUDA_GENERIC T& operator()(int x) MUDA_NOEXCEPT
+    MUDA_GENERIC T& operator()(index_t x) MUDA_NOEXCEPT
     {
         this->check();
         return this->m_data[this->map(x)];
@@ -150,12 +150,12 @@ class Dense1D : public Dense1DBase<T>
 
     MUDA_GENERIC T* data() MUDA_NOEXCEPT { return this->m_data; }
 
-    MUDA_GENERIC this_type sub_view(int offset) const MUDA_NOEXCEPT
+    MUDA_GENERIC this_type sub_view(index_t offset) const MUDA_NOEXCEPT
     {
         return this_type{Dense1DBase<T>::sub_view(offset)};
     }
 
-    MUDA_GENERIC this_type sub_view(int offset, int size) const MUDA_NOEXCEPT
+    MUDA_GENERIC this_type sub_view(index_t offset, index_t size) const MUDA_NOEXCEPT
     {
         return this_type{Dense1DBase<T>::sub_view(offset, size)};
     }
@@ -176,14 +176,14 @@ struct read_write_viewer<CDense1D<T>>
 
 // CTAD
 template <typename T>
-CDense1D(T*, int) -> CDense1D<T>;
+CDense1D(T*, index_t) -> CDense1D<T>;
 
 template <typename T>
-Dense1D(T*, int) -> Dense1D<T>;
+Dense1D(T*, index_t) -> Dense1D<T>;
 
 // make functions
 template <typename T>
-MUDA_INLINE MUDA_GENERIC auto make_cdense_1d(const T* data, int dimx) MUDA_NOEXCEPT
+MUDA_INLINE MUDA_GENERIC auto make_cdense_1d(const T* data, index_t dimx) MUDA_NOEXCEPT
 {
     return CDense1D<T>(data, dimx);
 }
@@ -195,7 +195,7 @@ MUDA_INLINE MUDA_GENERIC auto make_cdense_1d(const T (&data)[N]) MUDA_NOEXCEPT
 }
 
 template <typename T>
-MUDA_INLINE MUDA_GENERIC auto make_dense_1d(T* data, int dimx) MUDA_NOEXCEPT
+MUDA_INLINE MUDA_GENERIC auto make_dense_1d(T* data, index_t dimx) MUDA_NOEXCEPT
 {
     return Dense1D<T>(data, dimx);
 }
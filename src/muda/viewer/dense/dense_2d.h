@@ -13,23 +13,24 @@ namespace muda
  * Note:
  *  1) y moves faster than x, which is the same as C/C++ 2d array
  *  2) as for CUDA Memory2D, x index into height, y index into width.
+ *  3) each extent is an int, the pitch, the byte offsets and the flatten index are index_t
  *****************************************************************************/
 
 template <typename T>
 class Dense2DBase : public ViewerBase
 {
   protected:
-    T*   m_data;
-    int2 m_offset;
-    int2 m_dim;
-    int  m_pitch_bytes;
+    T*      m_data;
+    int2    m_offset;
+    int2    m_dim;
+    index_t m_pitch_bytes;
 
   public:
     using value_type = T;
 
     MUDA_GENERIC Dense2DBase() MUDA_NOEXCEPT : m_data(nullptr) {}
 
-    MUDA_GENERIC Dense2DBase(T* p, const int2& offset, const int2& dim, int pitch_bytes) MUDA_NOEXCEPT
+    MUDA_GENERIC Dense2DBase(T* p, const int2& offset, const int2& dim, index_t pitch_bytes) MUDA_NOEXCEPT
         : m_data(p),
           m_offset(offset),
           m_dim(dim),
@@ -49,23 +50,24 @@ class Dense2DBase : public ViewerBase
 
         x += m_offset.x;
         y += m_offset.y;
-        auto height_begin = reinterpret_cast<std::byte*>(m_data) + x * m_pitch_bytes;
+        auto height_begin =
+            reinterpret_cast<std::byte*>(m_data) + static_cast<index_t>(x) * m_pitch_bytes;
         return *(reinterpret_cast<T*>(height_begin) + y);
     }
 
-    MUDA_GENERIC const T& flatten(int i)
+    MUDA_GENERIC const T& flatten(index_t i)
     {
         if constexpr(DEBUG_VIEWER)
         {
             MUDA_KERNEL_ASSERT(i >= 0 && i < total_size(),
-                               "dense2D[%s:%s]: out of range, index=%d, total_size=%d",
+                               "dense2D[%s:%s]: out of range, index=%lld, total_size=%lld",
                                this->name(),
                                this->kernel_name(),
-                               i,
-                               total_size());
+                               (long long)i,
+                               (long long)total_size());
         }
-        auto x = i / m_dim.y;
-        auto y = i % m_dim.y;
+        auto x = static_cast<int>(i / m_dim.y);
+        auto y = static_cast<int>(i % m_dim.y);
         return operator()(x, y);
     }
 
@@ -73,7 +75,7 @@ class Dense2DBase : public ViewerBase
 
     MUDA_GENERIC auto total_size() const MUDA_NOEXCEPT
     {
-        return m_dim.x * m_dim.y;
+        return static_cast<index_t>(m_dim.x) * m_dim.y;
     }
 
     MUDA_GENERIC auto area() const MUDA_NOEXCEPT { return total_size(); }
@@ -129,7 +131,7 @@ class CDense2D : public Dense2DBase<T>
     {
     }
 
-    MUDA_GENERIC CDense2D(const T* p, const int2& offset, const int2& dim, int pitch_bytes) MUDA_NOEXCEPT
+    MUDA_GENERIC CDense2D(const T* p, const int2& offset, const int2& dim, index_t pitch_bytes) MUDA_NOEXCEPT
         : Base(const_cast<T*>(p), offset, dim, pitch_bytes)
     {
     }
@@ -167,7 +169,7 @@ class Dense2D : public Dense2DBase<T>
         return const_cast<T&>(Base::operator()(xy));
     }
 
-    MUDA_GENERIC T& flatten(int i) { return const_cast<T&>(Base::flatten(i)); }
+    MUDA_GENERIC T& flatten(index_t i) { return const_cast<T&>(Base::flatten(i)); }
 
     MUDA_GENERIC T* data() MUDA_NOEXCEPT
     {
@@ -192,13 +194,13 @@ struct read_write_viewer<CDense2D<T>>
 template <typename T>
 MUDA_INLINE MUDA_GENERIC auto make_cdense_2d(const T* data, const int2& dim) MUDA_NOEXCEPT
 {
-    return CDense2D<T>{data, make_int2(0, 0), dim, static_cast<int>(dim.y * sizeof(T))};
+    return CDense2D<T>{data, make_int2(0, 0), dim, static_cast<index_t>(dim.y * sizeof(T))};
 }
 
 template <typename T>
 MUDA_INLINE MUDA_GENERIC auto make_dense_2d(T* data, const int2& dim) MUDA_NOEXCEPT
 {
-    return Dense2D<T>{data, make_int2(0, 0), dim, static_cast<int>(dim.y * sizeof(T))};
+    return Dense2D<T>{data, make_int2(0, 0), dim, static_cast<index_t>(dim.y * sizeof(T))};
 }
 
 template <typename T>
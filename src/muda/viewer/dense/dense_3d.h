@@ -13,24 +13,25 @@ namespace muda
  * Note:
  *  1) z moves faster than y, y moves faster than x, which is the same as C/C++ 2d array
  *  2) as for CUDA Memory3D, x index into depth, y index into height, z index into width
+ *  3) each extent is an int, the pitches, the byte offsets and the flatten index are index_t
  ****************************************************************************************/
 
 template <typename T>
 class Dense3DBase : public ViewerBase
 {
   protected:
-    T*   m_data;
-    int3 m_offset;
-    int3 m_dim;
-    int  m_pitch_bytes;
-    int  m_pitch_bytes_area;
+    T*      m_data;
+    int3    m_offset;
+    int3    m_dim;
+    index_t m_pitch_bytes;
+    index_t m_pitch_bytes_area;
 
   public:
     using value_type = T;
 
     MUDA_GENERIC Dense3DBase() MUDA_NOEXCEPT : m_data(nullptr){};
 
-    MUDA_GENERIC Dense3DBase(T* p, const int3& offset, const int3& dim, int pitch_bytes, int pitch_bytes_area) MUDA_NOEXCEPT
+    MUDA_GENERIC Dense3DBase(T* p, const int3& offset, const int3& dim, index_t pitch_bytes, index_t pitch_bytes_area) MUDA_NOEXCEPT
         : m_data(p),
           m_offset(offset),
           m_dim(dim),
@@ -48,19 +49,20 @@ class Dense3DBase : public ViewerBase
     {
         check();
         check_range(x, y, z);
-        auto depth_begin = reinterpret_cast<std::byte*>(m_data) + x * m_pitch_bytes_area;
-        auto height_begin = depth_begin + y * m_pitch_bytes;
+        auto depth_begin = reinterpret_cast<std::byte*>(m_data)
+                           + static_cast<index_t>(x) * m_pitch_bytes_area;
+        auto height_begin = depth_begin + static_cast<index_t>(y) * m_pitch_bytes;
         return *(reinterpret_cast<T*>(height_begin) + z);
     }
 
-    MUDA_GENERIC const T& flatten(int i) const MUDA_NOEXCEPT
+    MUDA_GENERIC const T& flatten(index_t i) const MUDA_NOEXCEPT
     {
-        auto area       = m_dim.y * m_dim.z;
-        auto x          = i / area;
+        auto area       = this->area();
+        auto x          = static_cast<int>(i / area);
         auto i_in_area  = i % area;
-        auto y          = i_in_area / m_dim.z;
+        auto y          = static_cast<int>(i_in_area / m_dim.z);
         auto i_in_width = i_in_area % m_dim.z;
-        auto z          = i_in_width;
+        auto z          = static_cast<int>(i_in_width);
         return operator()(x, y, z);
     }
 
@@ -68,23 +70,29 @@ class Dense3DBase : public ViewerBase
 
     MUDA_GENERIC auto dim() const MUDA_NOEXCEPT { return m_dim; }
 
-    MUDA_GENERIC int area() const MUDA_NOEXCEPT { return m_dim.y * m_dim.z; }
+    MUDA_GENERIC index_t area() const MUDA_NOEXCEPT
+    {
+        return static_cast<index_t>(m_dim.y) * m_dim.z;
+    }
 
-    MUDA_GENERIC int volume() const MUDA_NOEXCEPT { return total_size(); }
+    MUDA_GENERIC index_t volume() const MUDA_NOEXCEPT { return total_size(); }
 
-    MUDA_GENERIC int total_size() const MUDA_NOEXCEPT
+    MUDA_GENERIC index_t total_size() const MUDA_NOEXCEPT
     {
         return m_dim.x * area();
     }
 
-    MUDA_GENERIC int pitch_bytes() const MUDA_NOEXCEPT { return m_pitch_bytes; }
+    MUDA_GENERIC index_t pitch_bytes() const MUDA_NOEXCEPT
+    {
+        return m_pitch_bytes;
+    }
 
-    MUDA_GENERIC int pitch_bytes_area() const MUDA_NOEXCEPT
+    MUDA_GENERIC index_t pitch_bytes_area() const MUDA_NOEXCEPT
     {
         return m_pitch_bytes_area;
     }
 
-    MUDA_GENERIC int total_bytes() const MUDA_NOEXCEPT
+    MUDA_GENERIC index_t total_bytes() const MUDA_NOEXCEPT
     {
         return m_pitch_bytes_area * m_dim.x;
     }
@@ -130,7 +138,7 @@ class CDense3D : public Dense3DBase<T>
 
     MUDA_GENERIC CDense3D(const Base& base) MUDA_NOEXCEPT : Base(base){};
 
-    MUDA_GENERIC CDense3D(const T* p, const int3& offset, const int3& dim, int pitch_bytes, int pitch_bytes_area) MUDA_NOEXCEPT
+    MUDA_GENERIC CDense3D(const T* p, const int3& offset, const int3& dim, index_t pitch_bytes, index_t pitch_bytes_area) MUDA_NOEXCEPT
         : Base(const_cast<T*>(p), offset, dim, pitch_bytes, pitch_bytes_area)
     {
     }
@@ -165,7 +173,7 @@ class Dense3D : public Dense3DBase<T>
         return const_cast<T&>(Base::operator()(x, y, z));
     }
 
-    MUDA_GENERIC T& flatten(int i) MUDA_NOEXCEPT
+    MUDA_GENERIC T& flatten(index_t i) MUDA_NOEXCEPT
     {
         return const_cast<T&>(Base::flatten(i));
     }
@@ -197,8 +205,8 @@ MUDA_INLINE MUDA_GENERIC auto make_cdense_3d(const T* data, const int3& dim) MUD
     return CDense3D<T>{data,
                        make_int3(0, 0, 0),
                        dim,
-                       static_cast<int>(pitch_bytes),
-                       static_cast<int>(dim.y * pitch_bytes)};
+                       static_cast<index_t>(pitch_bytes),
+                       static_cast<index_t>(dim.y * pitch_bytes)};
 }
 
 template <typename T>
@@ -208,8 +216,8 @@ MUDA_INLINE MUDA_GENERIC auto make_dense_3d(T* data, const int3& dim) MUDA_NOEXC
     return Dense3D<T>{data,
                       make_int3(0, 0, 0),
                       dim,
-                      static_cast<int>(pitch_bytes),
-                      static_cast<int>(dim.y * pitch_bytes)};
+                      static_cast<index_t>(pitch_bytes),
+                      static_cast<index_t>(dim.y * pitch_bytes)};
 }
 
 template <typename T>
@@ -0,0 +1,166 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/allocator.h>
+
+using namespace muda;
+
+// a host resource whose fences are reached only when the test says so
+class ManualFenceResource : public HostMemoryResource
+{
+  public:
+    using Fence = int;
+
+    std::vector<bool> reached;
+
+    Fence record_fence(cudaStream_t)
+    {
+        reached.push_back(false);
+        return static_cast<int>(reached.size()) - 1;
+    }
+    bool query_fence(Fence f) { return reached[f]; }
+    void wait_fence(Fence f) { reached[f] = true; }
+    void release_fence(Fence) {}
+};
+
+void caching_allocator_host_test()
+{
+    auto s0 = reinterpret_cast<cudaStream_t>(0x1);
+
+    HostCachingAllocator allocator;
+
+    REQUIRE(allocator.bin_bytes(1) == 512);
+    REQUIRE(allocator.bin_bytes(513) == 1024);
+    REQUIRE(allocator.bin_bytes((size_t{1} << 30) + 1) == 0);
+
+    auto p = allocator.allocate(1000, s0);
+    REQUIRE(allocator.stats().miss_count == 1);
+    REQUIRE(allocator.stats().in_use_bytes == 1024);
+    REQUIRE(allocator.deallocate(p, s0));
+    REQUIRE(allocator.stats().cached_bytes == 1024);
+
+    // same size class -> hit
+    auto q = allocator.allocate(600, s0);
+    REQUIRE(q == p);
+    REQUIRE(allocator.stats().hit_count == 1);
+
+    // not owned
+    int x;
+    REQUIRE(!allocator.deallocate(&x, s0));
+
+    auto r = allocator.allocate(4096, s0);
+    REQUIRE(allocator.stats().high_water_bytes == 1024 + 4096);
+    allocator.deallocate(q, s0);
+    allocator.deallocate(r, s0);
+    REQUIRE(allocator.stats().in_use_bytes == 0);
+    REQUIRE(allocator.stats().cached_bytes == 1024 + 4096);
+
+    // trim the larger one
+    allocator.trim(1024);
+    REQUIRE(allocator.stats().cached_bytes == 1024);
+    allocator.trim();
+    REQUIRE(allocator.stats().cached_bytes == 0);
+
+    // uncached large request
+    auto big = allocator.allocate((size_t{1} << 30) + 1, s0);
+    allocator.deallocate(big, s0);
+    REQUIRE(allocator.stats().cached_bytes == 0);
+
+    allocator.reset_stats();
+    REQUIRE(allocator.stats().hit_count == 0);
+    REQUIRE(allocator.stats().miss_count == 0);
+}
+
+void caching_allocator_cross_stream_test()
+{
+    auto s0 = reinterpret_cast<cudaStream_t>(0x1);
+    auto s1 = reinterpret_cast<cudaStream_t>(0x2);
+
+    CachingAllocator<ManualFenceResource> allocator;
+
+    auto p = allocator.allocate(100, s0);
+    allocator.deallocate(p, s0);
+
+    // the fence on s0 is not reached, s1 can't reuse the block
+    auto q = allocator.allocate(100, s1);
+    REQUIRE(q != p);
+    REQUIRE(allocator.stats().miss_count == 2);
+
+    // reach the fence, now s1 can reuse it
+    allocator.resource().reached[0] = true;
+    auto r = allocator.allocate(100, s1);
+    REQUIRE(r == p);
+    REQUIRE(allocator.stats().hit_count == 1);
+
+    allocator.deallocate(q, s1);
+    allocator.deallocate(r, s1);
+}
+
+void caching_allocator_device_test()
+{
+    DeviceCachingAllocator allocator;
+    {
+        DeviceAllocatorScope scope{allocator};
+
+        for(int i = 0; i < 10; ++i)
+        {
+            DeviceBuffer<float> buffer(1000);
+            buffer.fill(1.0f);
+            DeviceVar<int> var = 1;
+        }
+        wait_device();
+    }
+    auto stats = allocator.stats();
+    REQUIRE(stats.in_use_bytes == 0);
+    REQUIRE(stats.hit_count > 0);
+    allocator.trim();
+    REQUIRE(allocator.stats().cached_bytes == 0);
+}
+
+void caching_allocator_scope_exit_test()
+{
+    // allocated in a scope, freed after it: the block still goes back to its allocator
+    DeviceCachingAllocator allocator;
+    float*                 ptr = nullptr;
+    {
+        DeviceAllocatorScope scope{allocator};
+        Memory().alloc(&ptr, 1000 * sizeof(float));
+    }
+    REQUIRE(allocator.stats().in_use_bytes > 0);
+    Memory().free(ptr).wait();
+    REQUIRE(allocator.stats().in_use_bytes == 0);
+    REQUIRE(allocator.stats().cached_bytes > 0);
+
+    // freed inside another allocator's scope: still the owner
+    HostCachingAllocator other;
+    {
+        DeviceAllocatorScope scope{allocator};
+        Memory().alloc(&ptr, 1000 * sizeof(float));
+    }
+    {
+        DeviceAllocatorScope scope{other};
+        Memory().free(ptr).wait();
+    }
+    REQUIRE(allocator.stats().in_use_bytes == 0);
+    REQUIRE(allocator.stats().hit_count == 1);
+}
+
+TEST_CASE("caching_allocator_host_test", "[allocator]")
+{
+    caching_allocator_host_test();
+}
+
+TEST_CASE("caching_allocator_cross_stream_test", "[allocator]")
+{
+    caching_allocator_cross_stream_test();
+}
+
+TEST_CASE("caching_allocator_device_test", "[allocator]")
+{
+    caching_allocator_device_test();
+}
+
+TEST_CASE("caching_allocator_scope_exit_test", "[allocator]")
+{
+    caching_allocator_scope_exit_test();
+}
@@ -0,0 +1,203 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <thread>
+#include <atomic>
+#include <numeric>
+
+using namespace muda;
+
+// suggests a fixed block size, counts the queries
+class FakeOccupancyOracle
+{
+  public:
+    int              current_device = 0;
+    int              block_size     = 384;
+    size_t           max_shared_mem = 2048;
+    std::atomic<int> query_count    = 0;
+
+    int device() const { return current_device; }
+
+    OccupancySuggestion suggest(const void*,
+                                const std::function<size_t(int)>& shared_mem_bytes,
+                                int block_size_limit)
+    {
+        ++query_count;
+        OccupancySuggestion s;
+        s.block_size = block_size;
+        if(block_size_limit > 0)
+            s.block_size = std::min(s.block_size, block_size_limit);
+        // halve the block until its shared memory fits
+        while(shared_mem_bytes && shared_mem_bytes(s.block_size) > max_shared_mem)
+            s.block_size /= 2;
+        s.min_grid_size = 80;
+        return s;
+    }
+
+    size_t available_shared_mem_bytes(const void*, int) const { return max_shared_mem; }
+};
+
+void auto_block_host_test()
+{
+    AutoBlockCache<FakeOccupancyOracle> cache;
+
+    int  kernel_a = 0, kernel_b = 0;  // fake kernel function pointers
+    auto a        = reinterpret_cast<const void*>(&kernel_a);
+    auto b        = reinterpret_cast<const void*>(&kernel_b);
+
+    auto config = cache.select(a, AutoBlock{});
+    REQUIRE(config.block_size == 384);
+    REQUIRE(config.min_grid_size == 80);
+    REQUIRE(AutoBlock{}.dynamic_shared_mem_bytes(config.block_size) == 0);
+    REQUIRE(cache.stats().miss_count == 1);
+
+    // cached per kernel
+    cache.oracle().block_size = 128;
+    REQUIRE(cache.select(a, AutoBlock{}).block_size == 384);
+    REQUIRE(cache.stats().hit_count == 1);
+    REQUIRE(cache.select(b, AutoBlock{}).block_size == 128);
+    REQUIRE(cache.oracle().query_count == 2);
+
+    // the limit is part of the key
+    cache.oracle().block_size = 512;
+    REQUIRE(cache.select(a, AutoBlock{256}).block_size == 256);
+
+    // the shared memory callback gets the final block size
+    auto smem = AutoBlock{[](int block_size) { return block_size * sizeof(float) * 2; }};
+    config    = cache.select(a, smem);
+    REQUIRE(config.block_size == 256);
+    REQUIRE(smem.dynamic_shared_mem_bytes(config.block_size) == 256 * sizeof(float) * 2);
+
+    // another callback on the same kernel that fits the cached block size: a hit
+    auto smem1   = AutoBlock{[](int block_size) { return block_size * sizeof(float); }};
+    auto config1 = cache.select(a, smem1);
+    REQUIRE(config1.block_size == config.block_size);
+    REQUIRE(smem1.dynamic_shared_mem_bytes(config1.block_size) == 256 * sizeof(float));
+
+    // one that needs more shared memory than the cached block size gets: asked again, not cached
+    auto query_count = cache.oracle().query_count.load();
+    auto smem4       = AutoBlock{[](int block_size) { return block_size * sizeof(float) * 4; }};
+    auto config4     = cache.select(a, smem4);
+    REQUIRE(cache.oracle().query_count == query_count + 1);
+    REQUIRE(config4.block_size == 128);
+    REQUIRE(smem4.dynamic_shared_mem_bytes(config4.block_size) <= cache.oracle().max_shared_mem);
+    REQUIRE(cache.stats().cached_count == 4);
+    // the cached config is kept for the callbacks that fit
+    REQUIRE(cache.select(a, smem).block_size == 256);
+
+    // another device
+    cache.oracle().current_device = 1;
+    REQUIRE(cache.select(a, AutoBlock{}).block_size == 512);
+    REQUIRE(cache.stats().cached_count == 5);
+
+    cache.clear();
+    cache.reset_stats();
+    REQUIRE(cache.stats().cached_count == 0);
+    REQUIRE(cache.stats().hit_count == 0);
+}
+
+void auto_block_thread_safety_test()
+{
+    AutoBlockCache<FakeOccupancyOracle> cache;
+
+    std::vector<int> kernels(16);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 8; ++t)
+        threads.emplace_back(
+            [&]
+            {
+                for(int r = 0; r < 1000; ++r)
+                    for(auto& k : kernels)
+                        cache.select(&k, AutoBlock{});
+            });
+    for(auto& t : threads)
+        t.join();
+
+    // each kernel is asked only once
+    REQUIRE(cache.oracle().query_count == 16);
+    auto stats = cache.stats();
+    REQUIRE(stats.miss_count == 16);
+    REQUIRE(stats.hit_count == 8 * 1000 * 16 - 16);
+}
+
+void auto_block_device_test()
+{
+    constexpr int     N = 100000;
+    DeviceBuffer<int> buffer(N);
+
+    ParallelFor(AutoBlock{})
+        .apply(N,
+               [b = buffer.viewer()] __device__(int i) mutable { b(i) = i; })
+        .wait();
+
+    std::vector<int> res;
+    buffer.copy_to(res);
+    std::vector<int> gt(N);
+    std::iota(gt.begin(), gt.end(), 0);
+    REQUIRE(res == gt);
+
+    // dynamic shared memory of the picked block size
+    buffer.fill(0);
+    ParallelFor(AutoBlock{[](int block_size) { return block_size * sizeof(int); }})
+        .apply(N,
+               [b = buffer.viewer()] __device__(int i) mutable
+               {
+                   extern __shared__ int smem[];
+                   smem[threadIdx.x] = i;
+                   __syncthreads();
+                   b(i) = smem[threadIdx.x];
+               })
+        .wait();
+    buffer.copy_to(res);
+    REQUIRE(res == gt);
+
+    // the same kernel with two shared memory callbacks: each launch gets its own size
+    auto smem_launch = [&](int ints_per_thread)
+    {
+        buffer.fill(0);
+        ParallelFor(AutoBlock{[=](int block_size)
+                              { return block_size * ints_per_thread * sizeof(int); }})
+            .apply(N,
+                   [b = buffer.viewer(), ints_per_thread] __device__(int i) mutable
+                   {
+                       extern __shared__ int smem[];
+                       // the last int of the part of this thread
+                       auto j  = threadIdx.x * ints_per_thread + ints_per_thread - 1;
+                       smem[j] = i;
+                       __syncthreads();
+                       b(i) = smem[j];
+                   })
+            .wait();
+        buffer.copy_to(res);
+        REQUIRE(res == gt);
+    };
+    smem_launch(1);
+    smem_launch(4);
+
+    // Launch with an active range
+    buffer.fill(0);
+    Launch(AutoBlock{})
+        .apply(dim3(N),
+               [b = buffer.viewer()] __device__(const int2 ij) mutable
+               { b(ij.x) = ij.x; })
+        .wait();
+    buffer.copy_to(res);
+    REQUIRE(res == gt);
+
+    REQUIRE(DeviceAutoBlockCache::instance().stats().cached_count >= 3);
+}
+
+TEST_CASE("auto_block_host_test", "[launch]")
+{
+    auto_block_host_test();
+}
+
+TEST_CASE("auto_block_thread_safety_test", "[launch]")
+{
+    auto_block_thread_safety_test();
+}
+
+TEST_CASE("auto_block_device_test", "[launch]")
+{
+    auto_block_device_test();
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <muda/muda.h>
+
+// the GB/s of `run`, timed with events after a warmup, bytes: the bytes moved by one run
+template <typename F>
+float benchmark_bandwidth(double bytes, F&& run, int repeat = 10)
+{
+    using namespace muda;
+
+    // warmup
+    run();
+
+    Event begin{Event::Bit::eDefault};
+    Event end{Event::Bit::eDefault};
+    Launch().record(begin);
+    for(int k = 0; k < repeat; ++k)
+        run();
+    Launch().record(end).wait();
+
+    auto ms = Event::elapsed_time(begin, end) / repeat;
+    return float(bytes / (ms * 1e6));
+}
@@ -0,0 +1,205 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/buffer.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include "benchmark_common.h"
+
+using namespace muda;
+
+// 12 bytes, too odd for the vector words: stored one by one
+struct BufferFillCopyVec3
+{
+    float        x, y, z;
+    MUDA_GENERIC bool operator==(const BufferFillCopyVec3& rhs) const
+    {
+        return x == rhs.x && y == rhs.y && z == rhs.z;
+    }
+};
+
+template <typename T>
+void buffer_fill_copy_2d_test(const T& a, const T& b)
+{
+    // the sub views start at an odd column, so the rows are not 16 bytes aligned
+    Extent2D extent{40, 37};
+    Offset2D offset{3, 5};
+    Extent2D sub_extent{20, 17};
+    Offset2D copy_offset{10, 1};
+
+    auto in = [](Offset2D o, Extent2D e, size_t i, size_t j)
+    {
+        return i >= o.offset_in_height() && i < o.offset_in_height() + e.height()
+               && j >= o.offset_in_width() && j < o.offset_in_width() + e.width();
+    };
+
+    DeviceBuffer2D<T> buffer;
+    buffer.resize(extent, a);
+    auto sub = buffer.view(offset, sub_extent);
+    BufferLaunch().fill(sub, b).wait();
+
+    std::vector<T> h;
+    buffer.copy_to(h);
+    for(size_t i = 0; i < extent.height(); ++i)
+        for(size_t j = 0; j < extent.width(); ++j)
+            REQUIRE(h[i * extent.width() + j] == (in(offset, sub_extent, i, j) ? b : a));
+
+    DeviceBuffer2D<T> dst;
+    dst.resize(extent, a);
+    BufferLaunch().copy(dst.view(copy_offset, sub_extent), sub).wait();
+    dst.copy_to(h);
+    for(size_t i = 0; i < extent.height(); ++i)
+        for(size_t j = 0; j < extent.width(); ++j)
+            REQUIRE(h[i * extent.width() + j] == (in(copy_offset, sub_extent, i, j) ? b : a));
+
+    // the whole buffer, the rows are aligned
+    BufferLaunch().fill(buffer.view(), b).wait();
+    BufferLaunch().copy(dst.view(), buffer.view()).wait();
+    dst.copy_to(h);
+    REQUIRE(std::all_of(h.begin(), h.end(), [&](const T& v) { return v == b; }));
+}
+
+template <typename T>
+void buffer_fill_copy_3d_test(const T& a, const T& b)
+{
+    Extent3D extent{9, 11, 13};
+    Offset3D offset{1, 2, 3};
+    Extent3D sub_extent{5, 6, 7};
+    Offset3D copy_offset{4, 0, 5};
+
+    auto in = [](Offset3D o, Extent3D e, size_t k, size_t i, size_t j)
+    {
+        return k >= o.offset_in_depth() && k < o.offset_in_depth() + e.depth()
+               && i >= o.offset_in_height() && i < o.offset_in_height() + e.height()
+               && j >= o.offset_in_width() && j < o.offset_in_width() + e.width();
+    };
+    auto at = [&](size_t k, size_t i, size_t j)
+    { return (k * extent.height() + i) * extent.width() + j; };
+
+    DeviceBuffer3D<T> buffer;
+    buffer.resize(extent, a);
+    auto sub = buffer.view(offset, sub_extent);
+    BufferLaunch().fill(sub, b).wait();
+
+    std::vector<T> h;
+    buffer.copy_to(h);
+    for(size_t k = 0; k < extent.depth(); ++k)
+        for(size_t i = 0; i < extent.height(); ++i)
+            for(size_t j = 0; j < extent.width(); ++j)
+                REQUIRE(h[at(k, i, j)] == (in(offset, sub_extent, k, i, j) ? b : a));
+
+    DeviceBuffer3D<T> dst;
+    dst.resize(extent, a);
+    BufferLaunch().copy(dst.view(copy_offset, sub_extent), sub).wait();
+    dst.copy_to(h);
+    for(size_t k = 0; k < extent.depth(); ++k)
+        for(size_t i = 0; i < extent.height(); ++i)
+            for(size_t j = 0; j < extent.width(); ++j)
+                REQUIRE(h[at(k, i, j)] == (in(copy_offset, sub_extent, k, i, j) ? b : a));
+}
+
+template <typename T>
+void buffer_fill_copy_test(const T& a, const T& b)
+{
+    buffer_fill_copy_2d_test(a, b);
+    buffer_fill_copy_3d_test(a, b);
+    // zero bytes: the memset path
+    buffer_fill_copy_2d_test(a, T{});
+    buffer_fill_copy_3d_test(a, T{});
+}
+
+TEST_CASE("buffer_fill_copy_test", "[buffer]")
+{
+    SECTION("char")
+    {
+        buffer_fill_copy_test<char>('a', 'b');
+    }
+    SECTION("float")
+    {
+        buffer_fill_copy_test<float>(1.0f, 2.0f);
+    }
+    SECTION("double")
+    {
+        buffer_fill_copy_test<double>(1.0, -2.0);
+    }
+    SECTION("vec3")
+    {
+        buffer_fill_copy_test<BufferFillCopyVec3>({1, 2, 3}, {4, 5, 6});
+    }
+
+    SECTION("resize")
+    {
+        // the new part of a trivially constructible buffer is zeroed (memset with offset)
+        DeviceBuffer2D<float> buffer;
+        buffer.resize(Extent2D{10, 10}, 1.0f);
+        buffer.resize(Extent2D{20, 30});
+        std::vector<float> h;
+        buffer.copy_to(h);
+        for(size_t i = 0; i < 20; ++i)
+            for(size_t j = 0; j < 30; ++j)
+                REQUIRE(h[i * 30 + j] == (i < 10 && j < 10 ? 1.0f : 0.0f));
+
+        DeviceBuffer3D<float> buffer3;
+        buffer3.resize(Extent3D{2, 3, 4}, 1.0f);
+        buffer3.resize(Extent3D{4, 5, 6});
+        buffer3.copy_to(h);
+        for(size_t k = 0; k < 4; ++k)
+            for(size_t i = 0; i < 5; ++i)
+                for(size_t j = 0; j < 6; ++j)
+                    REQUIRE(h[(k * 5 + i) * 6 + j]
+                            == (k < 2 && i < 3 && j < 4 ? 1.0f : 0.0f));
+    }
+}
+
+template <typename T>
+void buffer_fill_copy_benchmark(const char* type_name, Extent2D extent)
+{
+    DeviceBuffer2D<T> src(extent);
+    DeviceBuffer2D<T> dst(extent);
+    Buffer2DView<T>   src_view = src.view();
+    Buffer2DView<T>   dst_view = dst.view();
+
+    // distinct bytes, so the fill is not turned into a memset (except for char)
+    T val{};
+    for(size_t i = 0; i < sizeof(T); ++i)
+        reinterpret_cast<char*>(&val)[i] = static_cast<char>(i + 1);
+    size_t bytes = extent.height() * extent.width() * sizeof(T);
+
+    // the flattened element-wise kernels (the fill/copy before the row tiled kernels)
+    auto flatten_fill = [&]
+    {
+        ParallelFor(256).apply(dst_view.total_size(),
+                               [dst = dst_view, val] __device__(int i) mutable
+                               { *dst.data(i) = val; });
+    };
+    auto flatten_copy = [&]
+    {
+        ParallelFor(256).apply(dst_view.total_size(),
+                               [dst = dst_view, src = src_view] __device__(int i) mutable
+                               { *dst.data(i) = *src.data(i); });
+    };
+    auto row_fill = [&] { BufferLaunch().fill(dst_view, val); };
+    auto row_copy = [&] { BufferLaunch().copy(dst_view, src_view); };
+    auto zero_fill = [&] { BufferLaunch().fill(dst_view, T{}); };
+
+    std::cout << type_name << " " << extent.height() << "x" << extent.width()
+              << ": fill flatten=" << benchmark_bandwidth(bytes, flatten_fill)
+              << "GB/s, fill row tiled=" << benchmark_bandwidth(bytes, row_fill)
+              << "GB/s, fill zero=" << benchmark_bandwidth(bytes, zero_fill)
+              << "GB/s, copy flatten=" << benchmark_bandwidth(2 * bytes, flatten_copy)
+              << "GB/s, copy row tiled=" << benchmark_bandwidth(2 * bytes, row_copy)
+              << "GB/s" << std::endl;
+}
+
+TEST_CASE("buffer_fill_copy_benchmark", "[.benchmark]")
+{
+    // odd widths break the 16 bytes alignment of the rows
+    for(auto extent : {Extent2D{256, 256}, Extent2D{1024, 1024}, Extent2D{1024, 1023}, Extent2D{4096, 4096}})
+    {
+        buffer_fill_copy_benchmark<char>("char", extent);
+        buffer_fill_copy_benchmark<float>("float", extent);
+        buffer_fill_copy_benchmark<float4>("float4", extent);
+        buffer_fill_copy_benchmark<BufferFillCopyVec3>("vec3", extent);
+    }
+}
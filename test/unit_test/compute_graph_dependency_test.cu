@@ -0,0 +1,160 @@
+#include <catch2/catch.hpp>
+#include <muda/compute_graph/compute_graph_dependency_builder.h>
+
+using namespace muda;
+
+namespace
+{
+constexpr auto R  = ComputeGraphVarUsage::Read;
+constexpr auto RW = ComputeGraphVarUsage::ReadWrite;
+
+using Usages = std::vector<ComputeGraphDependencyBuilder::VarUsage>;
+using Edges  = std::vector<std::pair<size_t, size_t>>;
+
+Edges build_edges(size_t var_count, const std::vector<Usages>& closures, bool reduce = true)
+{
+    ComputeGraphDependencyBuilder builder{var_count};
+    for(size_t i = 0; i < closures.size(); ++i)
+        builder.add_closure(ClosureId{i}, closures[i]);
+
+    std::vector<ComputeGraphDependency>    deps;
+    std::vector<std::pair<size_t, size_t>> ranges;
+    builder.build(deps, ranges, reduce);
+
+    Edges edges;
+    for(size_t i = 0; i < closures.size(); ++i)
+    {
+        auto [begin, count] = ranges[i];
+        for(size_t j = begin; j < begin + count; ++j)
+        {
+            REQUIRE(deps[j].to == ClosureId{i});
+            edges.emplace_back(deps[j].from.value(), deps[j].to.value());
+        }
+    }
+    return edges;
+}
+}  // namespace
+
+void compute_graph_dependency_war_test()
+{
+    // 0 writes x, 1 2 3 read x, 4 writes x: 4 must wait for ALL the readers
+    auto edges = build_edges(1,
+                             {
+                                 {{0, RW}},
+                                 {{0, R}},
+                                 {{0, R}},
+                                 {{0, R}},
+                                 {{0, RW}},
+                             });
+    REQUIRE(edges == Edges{{0, 1}, {0, 2}, {0, 3}, {1, 4}, {2, 4}, {3, 4}});
+
+    // WAW without readers in between
+    edges = build_edges(1, {{{0, RW}}, {{0, RW}}, {{0, R}}});
+    REQUIRE(edges == Edges{{0, 1}, {1, 2}});
+
+    // readers don't depend on each other
+    edges = build_edges(1, {{{0, R}}, {{0, R}}});
+    REQUIRE(edges.empty());
+}
+
+void compute_graph_dependency_reduction_test()
+{
+    // 0 writes x y, 1 reads x writes z, 2 reads y z:
+    // 0 -> 2 (via y) is implied by 0 -> 1 -> 2 (via x, z)
+    std::vector<Usages> closures = {
+        {{0, RW}, {1, RW}},
+        {{0, R}, {2, RW}},
+        {{1, R}, {2, R}},
+    };
+    REQUIRE(build_edges(3, closures, false) == Edges{{0, 1}, {0, 2}, {1, 2}});
+    REQUIRE(build_edges(3, closures) == Edges{{0, 1}, {1, 2}});
+
+    // a chain through many vars: every closure reads all the earlier outputs,
+    // only the chain edges survive
+    constexpr size_t    N = 64;
+    std::vector<Usages> chain(N);
+    for(size_t i = 0; i < N; ++i)
+    {
+        for(size_t j = 0; j < i; ++j)
+            chain[i].emplace_back(j, R);
+        chain[i].emplace_back(i, RW);
+    }
+    auto reduced = build_edges(N, chain);
+    REQUIRE(reduced.size() == N - 1);
+    for(size_t i = 1; i < N; ++i)
+        REQUIRE(reduced[i - 1] == std::pair<size_t, size_t>{i - 1, i});
+    REQUIRE(build_edges(N, chain, false).size() == N * (N - 1) / 2);
+}
+
+void compute_graph_dependency_random_test()
+{
+    // the reduction keeps the reachability and drops every implied edge
+    constexpr size_t closure_count = 200;
+    constexpr size_t var_count     = 16;
+
+    uint32_t seed = 12345;
+    auto     rand = [&]
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+
+    std::vector<Usages> closures(closure_count);
+    for(auto& usages : closures)
+    {
+        for(size_t v = 0; v < var_count; ++v)
+        {
+            auto r = rand() % 8;
+            if(r == 0)
+                usages.emplace_back(v, RW);
+            else if(r < 3)
+                usages.emplace_back(v, R);
+        }
+    }
+
+    auto closure_of = [&](const Edges& edges)
+    {
+        // reach[i][j]: j reaches i
+        std::vector<std::vector<bool>> reach(closure_count,
+                                             std::vector<bool>(closure_count, false));
+        for(auto [from, to] : edges)  // edges are grouped by `to` in order
+        {
+            reach[to][from] = true;
+            for(size_t k = 0; k < closure_count; ++k)
+                if(reach[from][k])
+                    reach[to][k] = true;
+        }
+        return reach;
+    };
+
+    auto full    = build_edges(var_count, closures, false);
+    auto reduced = build_edges(var_count, closures);
+    REQUIRE(reduced.size() <= full.size());
+    REQUIRE(closure_of(full) == closure_of(reduced));
+
+    // minimal: removing any edge breaks the reachability
+    auto reach = closure_of(reduced);
+    for(auto [from, to] : reduced)
+    {
+        bool implied = false;
+        for(auto [other_from, other_to] : reduced)
+            if(other_to == to && other_from != from && reach[other_from][from])
+                implied = true;
+        REQUIRE(!implied);
+    }
+}
+
+TEST_CASE("compute_graph_dependency_war_test", "[compute_graph]")
+{
+    compute_graph_dependency_war_test();
+}
+
+TEST_CASE("compute_graph_dependency_reduction_test", "[compute_graph]")
+{
+    compute_graph_dependency_reduction_test();
+}
+
+TEST_CASE("compute_graph_dependency_random_test", "[compute_graph]")
+{
+    compute_graph_dependency_random_test();
+}
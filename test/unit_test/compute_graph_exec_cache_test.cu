@@ -0,0 +1,157 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/compute_graph/compute_graph_topology_key.h>
+#include <muda/compute_graph/compute_graph_exec_cache.h>
+
+using namespace muda;
+
+static ComputeGraphTopologyKey make_key(const void*                                   func,
+                                        std::vector<std::pair<size_t, size_t>> edges)
+{
+    ComputeGraphTopologyKey key;
+    for(int i = 0; i < 3; ++i)
+    {
+        key.begin_closure();
+        key.add_node(ComputeGraphNodeType::KernelNode, func);
+    }
+    std::vector<ComputeGraphDependency> deps;
+    for(auto [from, to] : edges)
+        deps.push_back(ComputeGraphDependency{ClosureId{from}, ClosureId{to}});
+    key.add_deps(deps);
+    key.add_flags(0);
+    return key;
+}
+
+void compute_graph_topology_key_test()
+{
+    int  f, g;
+    auto a = make_key(&f, {{0, 1}, {1, 2}});
+    auto b = make_key(&f, {{1, 2}, {0, 1}, {0, 1}});  // order and duplicates don't matter
+    REQUIRE(a == b);
+    REQUIRE(a.hash() == b.hash());
+    REQUIRE(std::hash<ComputeGraphTopologyKey>{}(a) == std::hash<ComputeGraphTopologyKey>{}(b));
+
+    // different kernel
+    REQUIRE(a != make_key(&g, {{0, 1}, {1, 2}}));
+    // different deps
+    REQUIRE(a != make_key(&f, {{0, 1}, {0, 2}}));
+
+    // node in another closure
+    ComputeGraphTopologyKey c, d;
+    c.begin_closure();
+    c.add_node(ComputeGraphNodeType::MemcpyNode);
+    c.begin_closure();
+    c.add_node(ComputeGraphNodeType::MemcpyNode);
+    d.begin_closure();
+    d.add_node(ComputeGraphNodeType::MemcpyNode);
+    d.add_node(ComputeGraphNodeType::MemcpyNode);
+    d.begin_closure();
+    REQUIRE(c != d);
+
+    // flags
+    ComputeGraphTopologyKey e = c;
+    e.add_flags(1);
+    REQUIRE(c != e);
+}
+
+void compute_graph_exec_cache_host_test()
+{
+    int  f, g;
+    auto key_f = make_key(&f, {{0, 1}});
+    auto key_g = make_key(&g, {{0, 1}});
+
+    ComputeGraphExecCacheBase<std::shared_ptr<int>> cache{2};
+
+    REQUIRE(!cache.acquire(key_f));
+    REQUIRE(cache.stats().miss_count == 1);
+
+    auto value = std::make_shared<int>(1);
+    cache.release(key_f, std::shared_ptr<int>{value});
+    REQUIRE(cache.stats().cached_count == 1);
+
+    // one owner at a time
+    auto hit = cache.acquire(key_f);
+    REQUIRE(hit);
+    REQUIRE(*hit == value);
+    REQUIRE(!cache.acquire(key_f));
+    REQUIRE(cache.stats().hit_count == 1);
+    REQUIRE(cache.stats().miss_count == 2);
+
+    // LRU eviction
+    cache.release(key_f, std::make_shared<int>(1));
+    cache.release(key_g, std::make_shared<int>(2));
+    cache.release(key_g, std::make_shared<int>(3));
+    REQUIRE(cache.stats().eviction_count == 1);
+    REQUIRE(cache.stats().cached_count == 2);
+    REQUIRE(!cache.acquire(key_f));  // the oldest is evicted
+    REQUIRE(**cache.acquire(key_g) == 3);
+
+    cache.capacity(0);
+    REQUIRE(cache.stats().cached_count == 0);
+    cache.clear();
+    cache.reset_stats();
+    REQUIRE(cache.stats().hit_count == 0);
+}
+
+void compute_graph_exec_cache_device_test()
+{
+    auto& cache = ComputeGraphExecCache::instance();
+    cache.clear();
+    cache.reset_stats();
+
+    constexpr int     n = 100;
+    DeviceBuffer<int> buffers[2] = {DeviceBuffer<int>(n), DeviceBuffer<int>(n)};
+
+    auto run = [&](DeviceBuffer<int>& buffer, int value)
+    {
+        ComputeGraphVarManager manager;
+        ComputeGraph           graph{manager};
+        graph.exec_caching(true);
+
+        auto& x = manager.create_var<Dense1D<int>>("x");
+        auto& v = manager.create_var<int>("v");
+
+        graph.create_node("fill") << [&]
+        {
+            ParallelFor(256).apply(n,
+                                   [x = x.eval(), v = v.eval()] __device__(int i) mutable
+                                   { x(i) = v; });
+        };
+
+        x.update(buffer.viewer());
+        v.update(value);
+        graph.launch();
+        wait_device();
+
+        std::vector<int> res;
+        buffer.copy_to(res);
+        REQUIRE(std::all_of(res.begin(), res.end(), [&](int r) { return r == value; }));
+    };
+
+    run(buffers[0], 1);
+    REQUIRE(cache.stats().miss_count == 1);
+    REQUIRE(cache.stats().cached_count == 1);
+
+    // the same structure with other bindings, the exec is reused
+    run(buffers[1], 2);
+    REQUIRE(cache.stats().hit_count == 1);
+    REQUIRE(cache.stats().cached_count == 1);
+
+    cache.clear();
+}
+
+TEST_CASE("compute_graph_topology_key_test", "[compute_graph]")
+{
+    compute_graph_topology_key_test();
+}
+
+TEST_CASE("compute_graph_exec_cache_host_test", "[compute_graph]")
+{
+    compute_graph_exec_cache_host_test();
+}
+
+TEST_CASE("compute_graph_exec_cache_device_test", "[compute_graph]")
+{
+    compute_graph_exec_cache_device_test();
+}
@@ -0,0 +1,153 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/compute_graph/compute_graph_fusion.h>
+
+using namespace muda;
+
+static ComputeGraphFusionCandidate fusable(int count, int block_dim, size_t bytes = 16, size_t alignment = 8)
+{
+    ComputeGraphFusionCandidate c;
+    c.fusable            = true;
+    c.count              = count;
+    c.block_dim          = block_dim;
+    c.callable_bytes     = bytes;
+    c.callable_alignment = alignment;
+    return c;
+}
+
+void compute_graph_fusion_plan_test()
+{
+    // [0 1 2] [3] [4 5] [6]
+    {
+        std::vector<ComputeGraphFusionCandidate> candidates = {
+            fusable(100, 64),
+            fusable(100, 64),
+            fusable(100, 64),
+            fusable(100, 128),  // another block_dim
+            fusable(200, 64),   // another count
+            fusable(200, 64),
+            ComputeGraphFusionCandidate{},  // not fusable
+        };
+        auto plan = ComputeGraphFusionPlan::build(candidates, 8, 1024);
+        REQUIRE(plan.groups.size() == 4);
+        REQUIRE(plan.groups[0].size() == 3);
+        REQUIRE(plan.groups[1].size() == 1);
+        REQUIRE(plan.groups[2].size() == 2);
+        REQUIRE(plan.groups[3].size() == 1);
+        REQUIRE(plan.saved_launch_count() == 3);
+        REQUIRE(plan.is_fused(ClosureId{1}));
+        REQUIRE(!plan.is_fused(ClosureId{3}));
+        REQUIRE(plan.callable_offset[0] == 0);
+        REQUIRE(plan.callable_offset[1] == 16);
+        REQUIRE(plan.callable_offset[2] == 32);
+        REQUIRE(plan.callable_offset[4] == 0);
+    }
+
+    // a non-fusable closure breaks the chain
+    {
+        std::vector<ComputeGraphFusionCandidate> candidates = {
+            fusable(100, 64), ComputeGraphFusionCandidate{}, fusable(100, 64)};
+        auto plan = ComputeGraphFusionPlan::build(candidates, 8, 1024);
+        REQUIRE(plan.groups.size() == 3);
+    }
+
+    // limits: stage count and argument bytes (with alignment)
+    {
+        std::vector<ComputeGraphFusionCandidate> candidates(5, fusable(100, 64));
+        auto plan = ComputeGraphFusionPlan::build(candidates, 2, 1024);
+        REQUIRE(plan.groups.size() == 3);
+
+        candidates = {fusable(100, 64, 20, 4), fusable(100, 64, 20, 16), fusable(100, 64, 8, 8)};
+        plan = ComputeGraphFusionPlan::build(candidates, 8, 52);
+        // 0: [0, 20), 1: [32, 52), 2 doesn't fit
+        REQUIRE(plan.groups.size() == 2);
+        REQUIRE(plan.callable_offset[1] == 32);
+        REQUIRE(plan.callable_offset[2] == 0);
+    }
+}
+
+void compute_graph_kernel_fusion_test()
+{
+    ComputeGraphVarManager manager;
+    ComputeGraph           graph{manager};
+    graph.kernel_fusion(true);
+
+    auto& N = manager.create_var<int>("N");
+    auto& x = manager.create_var<BufferView<float>>("x");
+    auto& y = manager.create_var<BufferView<float>>("y");
+
+    graph.create_node("reset") << [&]
+    {
+        ParallelFor(64).elementwise().apply(N.eval(),
+                                            [x = x.eval().viewer()] __device__(int i) mutable
+                                            { x(i) = 1.0f; });
+    };
+
+    graph.create_node("scale") << [&]
+    {
+        ParallelFor(64).elementwise().apply(N.eval(),
+                                            [x = x.eval().viewer()] __device__(int i) mutable
+                                            { x(i) *= 3.0f; });
+    };
+
+    graph.create_node("add") << [&]
+    {
+        ParallelFor(64).elementwise().apply(
+            N.eval(),
+            [x = x.ceval().cviewer(), y = y.eval().viewer()] __device__(int i) mutable
+            { y(i) = x(i) + i; });
+    };
+
+    // not elementwise: reads the neighbour
+    graph.create_node("shift") << [&]
+    {
+        ParallelFor(64).apply(N.eval(),
+                              [x = x.eval().viewer(), y = y.ceval().cviewer(), N = N.eval()] __device__(
+                                  int i) mutable { x(i) = y((i + 1) % N); });
+    };
+
+    int                 n = 1000;
+    DeviceBuffer<float> x_buffer(n);
+    DeviceBuffer<float> y_buffer(n);
+    N.update(n);
+    x.update(x_buffer);
+    y.update(y_buffer);
+
+    auto check = [&](int n)
+    {
+        std::vector<float> x_res, y_res;
+        x_buffer.copy_to(x_res);
+        y_buffer.copy_to(y_res);
+        for(int i = 0; i < n; ++i)
+        {
+            REQUIRE(y_res[i] == 3.0f + i);
+            REQUIRE(x_res[i] == 3.0f + (i + 1) % n);
+        }
+    };
+
+    graph.launch();
+    wait_device();
+    check(n);
+
+    auto& plan = graph.fusion_plan();
+    REQUIRE(plan.groups.size() == 2);
+    REQUIRE(plan.saved_launch_count() == 2);
+
+    // a new count for all the fused closures
+    n = 500;
+    N.update(n);
+    graph.launch();
+    wait_device();
+    check(n);
+}
+
+TEST_CASE("compute_graph_fusion_plan_test", "[compute_graph]")
+{
+    compute_graph_fusion_plan_test();
+}
+
+TEST_CASE("compute_graph_kernel_fusion_test", "[compute_graph]")
+{
+    compute_graph_kernel_fusion_test();
+}
@@ -0,0 +1,197 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/compute_graph/compute_graph_memory_plan.h>
+
+using namespace muda;
+
+static std::vector<ComputeGraphDependency> make_deps(std::initializer_list<std::pair<size_t, size_t>> edges)
+{
+    std::vector<ComputeGraphDependency> deps;
+    for(auto [from, to] : edges)
+        deps.push_back(ComputeGraphDependency{ClosureId{from}, ClosureId{to}});
+    return deps;
+}
+
+static bool overlap(const ComputeGraphTransientBuffer& a,
+                    size_t                             a_offset,
+                    const ComputeGraphTransientBuffer& b,
+                    size_t                             b_offset)
+{
+    bool in_time   = a.first <= b.last && b.first <= a.last;
+    bool in_memory = a_offset < b_offset + b.bytes && b_offset < a_offset + a.bytes;
+    return in_time && in_memory;
+}
+
+void compute_graph_memory_plan_test()
+{
+    // disjoint intervals share the same bytes
+    {
+        std::vector<ComputeGraphTransientBuffer> buffers = {
+            {1024, 256, 0, 1}, {1024, 256, 2, 3}, {512, 256, 4, 4}};
+        auto plan = ComputeGraphMemoryPlan::build(buffers);
+        REQUIRE(plan.arena_bytes == 1024);
+        REQUIRE(plan.unaliased_bytes == 1024 + 1024 + 512);
+        REQUIRE(plan.offsets == std::vector<size_t>{0, 0, 0});
+    }
+
+    // overlapping intervals are stacked, the small one fills the gap
+    {
+        std::vector<ComputeGraphTransientBuffer> buffers = {
+            {1000, 256, 0, 2},  // A
+            {2000, 256, 1, 3},  // B
+            {500, 256, 3, 4},   // C: overlaps B only
+        };
+        auto plan = ComputeGraphMemoryPlan::build(buffers);
+        REQUIRE(plan.offsets[1] == 0);
+        REQUIRE(plan.offsets[0] == 2048);
+        REQUIRE(plan.offsets[2] == 2048);
+        REQUIRE(plan.arena_bytes == 3048);
+        REQUIRE(plan.arena_bytes < plan.unaliased_bytes);
+    }
+
+    // random buffers never collide and respect the alignment
+    {
+        std::vector<ComputeGraphTransientBuffer> buffers;
+        uint32_t seed = 7;
+        auto     rand = [&]
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return seed >> 8;
+        };
+        for(int i = 0; i < 64; ++i)
+        {
+            size_t first = rand() % 32;
+            size_t last  = first + rand() % 8;
+            buffers.push_back({1 + rand() % 4096, size_t{1} << (rand() % 9), first, last});
+        }
+        auto plan = ComputeGraphMemoryPlan::build(buffers);
+        for(size_t i = 0; i < buffers.size(); ++i)
+        {
+            REQUIRE(plan.offsets[i] % buffers[i].alignment == 0);
+            REQUIRE(plan.offsets[i] + buffers[i].bytes <= plan.arena_bytes);
+            for(size_t j = i + 1; j < buffers.size(); ++j)
+                REQUIRE(!overlap(buffers[i], plan.offsets[i], buffers[j], plan.offsets[j]));
+        }
+        REQUIRE(plan.arena_bytes <= plan.unaliased_bytes);
+    }
+}
+
+void compute_graph_live_interval_test()
+{
+    // chain: 0 -> 1 -> 2 -> 3
+    {
+        auto deps = make_deps({{0, 1}, {1, 2}, {2, 3}});
+        std::vector<std::vector<ClosureId>> users = {
+            {ClosureId{0}, ClosureId{1}}, {ClosureId{2}, ClosureId{3}}, {}};
+        auto intervals = ComputeGraphMemoryPlan::live_intervals(4, deps, users);
+        REQUIRE(intervals[0] == std::pair<size_t, size_t>{0, 1});
+        REQUIRE(intervals[1] == std::pair<size_t, size_t>{2, 3});
+        REQUIRE(intervals[2] == std::pair<size_t, size_t>{0, 3});
+    }
+
+    // parallel branches: 0 -> 2, 1 -> 2
+    // 0 and 1 may run at the same time, their buffers must not share bytes
+    {
+        auto deps = make_deps({{0, 2}, {1, 2}});
+        std::vector<std::vector<ClosureId>> users = {{ClosureId{0}}, {ClosureId{1}}, {ClosureId{2}}};
+        auto intervals = ComputeGraphMemoryPlan::live_intervals(3, deps, users);
+        REQUIRE(intervals[0] == std::pair<size_t, size_t>{0, 1});
+        REQUIRE(intervals[1] == std::pair<size_t, size_t>{1, 1});
+        // 2 waits for both
+        REQUIRE(intervals[2] == std::pair<size_t, size_t>{2, 2});
+    }
+
+    // a late independent closure keeps the buffer alive: 0 -> 1, 2 (independent)
+    {
+        auto deps = make_deps({{0, 1}});
+        std::vector<std::vector<ClosureId>> users = {{ClosureId{0}}, {ClosureId{2}}};
+        auto intervals = ComputeGraphMemoryPlan::live_intervals(3, deps, users);
+        REQUIRE(intervals[0] == std::pair<size_t, size_t>{0, 2});
+        REQUIRE(intervals[1] == std::pair<size_t, size_t>{2, 2});
+    }
+}
+
+void compute_graph_transient_var_test()
+{
+    ComputeGraphVarManager manager;
+    ComputeGraph           graph{manager};
+
+    constexpr int N = 1000;
+
+    auto& a = manager.create_transient_var<BufferView<int>>("a", N);
+    auto& b = manager.create_transient_var<BufferView<int>>("b", N);
+    auto& r = manager.create_var<BufferView<int>>("r");
+
+    graph.create_node("write_a") << [&]
+    {
+        ParallelFor(256).apply(N,
+                               [a = a.eval().viewer()] __device__(int i) mutable
+                               { a(i) = i; });
+    };
+
+    graph.create_node("copy_a_to_r") << [&]
+    {
+        ParallelFor(256).apply(N,
+                               [a = a.ceval().cviewer(), r = r.eval().viewer()] __device__(
+                                   int i) mutable { r(i) = a(i); });
+    };
+
+    graph.create_node("write_b") << [&]
+    {
+        ParallelFor(256).apply(N,
+                               [b = b.eval().viewer(), r = r.ceval().cviewer()] __device__(
+                                   int i) mutable { b(i) = r(i) + 1; });
+    };
+
+    graph.create_node("scale_b_to_r") << [&]
+    {
+        ParallelFor(256).apply(N,
+                               [b = b.ceval().cviewer(), r = r.eval().viewer()] __device__(
+                                   int i) mutable { r(i) = b(i) * 2; });
+    };
+
+    DeviceBuffer<int> r_buffer(N);
+    r.update(r_buffer);
+
+    REQUIRE(a.is_transient());
+    REQUIRE(!r.is_transient());
+
+    auto& plan = graph.memory_plan();
+    REQUIRE(graph.transient_vars().size() == 2);
+    REQUIRE(plan.arena_bytes == N * sizeof(int));
+    REQUIRE(plan.offsets[0] == plan.offsets[1]);
+    REQUIRE(a.is_valid());
+
+    std::vector<int> gt(N);
+    for(int i = 0; i < N; ++i)
+        gt[i] = 2 * (i + 1);
+
+    for(auto mode : {ComputeGraphLaunchMode::Graph,
+                     ComputeGraphLaunchMode::SingleStream,
+                     ComputeGraphLaunchMode::MultiStream})
+    {
+        r_buffer.fill(0);
+        graph.launch(mode);
+        wait_device();
+
+        std::vector<int> res;
+        r_buffer.copy_to(res);
+        REQUIRE(res == gt);
+    }
+}
+
+TEST_CASE("compute_graph_memory_plan_test", "[compute_graph]")
+{
+    compute_graph_memory_plan_test();
+}
+
+TEST_CASE("compute_graph_live_interval_test", "[compute_graph]")
+{
+    compute_graph_live_interval_test();
+}
+
+TEST_CASE("compute_graph_transient_var_test", "[compute_graph]")
+{
+    compute_graph_transient_var_test();
+}
@@ -0,0 +1,101 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <sstream>
+
+using namespace muda;
+
+void compute_graph_profile_host_test()
+{
+    // 0 -> {1, 2} -> 3, 2 is the expensive branch
+    ComputeGraphProfile profile{{"a", "b", "c", "d\"quoted\""}};
+    std::vector<ComputeGraphDependency> deps = {{ClosureId{0}, ClosureId{1}},
+                                                {ClosureId{0}, ClosureId{2}},
+                                                {ClosureId{1}, ClosureId{3}},
+                                                {ClosureId{2}, ClosureId{3}}};
+
+    profile.add_launch(std::vector<double>{1.0, 2.0, 5.0, 1.0});
+    profile.add_launch(std::vector<double>{3.0, 2.0, 7.0, 1.0});
+    REQUIRE(profile.launch_count() == 2);
+
+    auto& a = profile.timing(ClosureId{0});
+    REQUIRE(a.sample_count == 2);
+    REQUIRE(a.min_ms == 1.0);
+    REQUIRE(a.max_ms == 3.0);
+    REQUIRE(a.mean_ms() == 2.0);
+
+    profile.analyze(deps);
+    REQUIRE(profile.critical_path()
+            == std::vector<ClosureId>{ClosureId{0}, ClosureId{2}, ClosureId{3}});
+    REQUIRE(profile.critical_path_ms() == 2.0 + 6.0 + 1.0);
+    REQUIRE(profile.is_on_critical_path(ClosureId{2}));
+    REQUIRE(!profile.is_on_critical_path(ClosureId{1}));
+    REQUIRE(profile.is_on_critical_path(deps[1]));
+    REQUIRE(!profile.is_on_critical_path(deps[0]));
+
+    // the most expensive one is the hottest
+    REQUIRE(profile.heat_color(ClosureId{2}) == "#F8CECC");
+
+    std::stringstream json;
+    profile.to_json(json);
+    auto str = json.str();
+    REQUIRE(str.find("\"critical_path\": [0, 2, 3]") != std::string::npos);
+    REQUIRE(str.find("d\\\"quoted\\\"") != std::string::npos);
+
+    profile.reset();
+    REQUIRE(profile.timing(ClosureId{0}).sample_count == 0);
+    REQUIRE(profile.timing(ClosureId{0}).name == "a");
+}
+
+void compute_graph_profile_device_test()
+{
+    ComputeGraphVarManager manager;
+    ComputeGraph           graph{manager};
+    graph.profiling(true);
+
+    auto& x = manager.create_var<Dense1D<int>>("x");
+    auto& y = manager.create_var<Dense1D<int>>("y");
+
+    constexpr int n = 1 << 20;
+    graph.create_node("fill_x") << [&]
+    {
+        ParallelFor(256).apply(n, [x = x.eval()] __device__(int i) mutable { x(i) = i; });
+    };
+    graph.create_node("fill_y") << [&]
+    {
+        ParallelFor(256).apply(n, [x = x.ceval(), y = y.eval()] __device__(int i) mutable
+                               { y(i) = x(i); });
+    };
+
+    DeviceBuffer<int> x_buffer(n);
+    DeviceBuffer<int> y_buffer(n);
+    x.update(x_buffer.viewer());
+    y.update(y_buffer.viewer());
+
+    for(int i = 0; i < 3; ++i)
+        graph.launch();
+    graph.launch(true);
+    graph.launch(ComputeGraphLaunchMode::MultiStream);
+
+    auto& profile = graph.profile();
+    REQUIRE(profile.launch_count() == 5);
+    REQUIRE(profile.timing(ClosureId{0}).sample_count == 5);
+    REQUIRE(profile.timing(ClosureId{0}).name == "fill_x");
+    REQUIRE(profile.critical_path().size() == 2);
+
+    ComputeGraphGraphvizOptions options;
+    options.profile = &profile;
+    std::stringstream dot;
+    graph.graphviz(dot, options);
+    REQUIRE(dot.str().find(" ms") != std::string::npos);
+}
+
+TEST_CASE("compute_graph_profile_host_test", "[compute_graph]")
+{
+    compute_graph_profile_host_test();
+}
+
+TEST_CASE("compute_graph_profile_device_test", "[compute_graph]")
+{
+    compute_graph_profile_device_test();
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/compute_graph/compute_graph_stream_schedule.h>
+
+using namespace muda;
+
+static std::vector<ComputeGraphDependency> make_deps(std::initializer_list<std::pair<size_t, size_t>> edges)
+{
+    std::vector<ComputeGraphDependency> deps;
+    for(auto [from, to] : edges)
+        deps.push_back(ComputeGraphDependency{ClosureId{from}, ClosureId{to}});
+    return deps;
+}
+
+void compute_graph_stream_schedule_test()
+{
+    // chain: 0 -> 1 -> 2, one stream, no wait
+    {
+        auto deps = make_deps({{0, 1}, {1, 2}});
+        auto s    = ComputeGraphStreamSchedule::build(3, deps, 4);
+        REQUIRE(s.stream_count == 1);
+        REQUIRE(s.makespan == 3.0);
+        for(auto& w : s.waits)
+            REQUIRE(w.empty());
+    }
+
+    // diamond: 0 -> {1, 2} -> 3
+    {
+        auto deps = make_deps({{0, 1}, {0, 2}, {1, 3}, {2, 3}});
+        auto s    = ComputeGraphStreamSchedule::build(4, deps, 4);
+        REQUIRE(s.stream_count == 2);
+        REQUIRE(s.makespan == 3.0);
+        REQUIRE(s.order.front() == ClosureId{0});
+        REQUIRE(s.order.back() == ClosureId{3});
+        REQUIRE(s.stream_of[1] != s.stream_of[2]);
+
+        // exactly one cross-stream wait for each of the branches
+        size_t wait_count = 0;
+        for(auto& w : s.waits)
+            wait_count += w.size();
+        REQUIRE(wait_count == 2);
+        REQUIRE(s.waits[0].empty());
+        REQUIRE(s.need_record[0]);
+        REQUIRE(!s.need_record[3]);
+    }
+
+    // redundant edge: 0 -> 1 -> 2 and 0 -> 2, the stream order covers it
+    {
+        auto deps = make_deps({{0, 1}, {1, 2}, {0, 2}});
+        auto s    = ComputeGraphStreamSchedule::build(3, deps, 2);
+        REQUIRE(s.stream_count == 1);
+        for(auto& w : s.waits)
+            REQUIRE(w.empty());
+    }
+    {
+        // 0 -> 2, 1 -> 2, 0 -> 3, 2 -> 3: 3 runs after 2 on the same stream,
+        // so the cross-stream wait on 0 (or 1) is only done once by 2
+        std::vector<double> costs = {1.0, 1.0, 1.0, 1.0};
+        auto deps = make_deps({{0, 2}, {1, 2}, {0, 3}, {2, 3}});
+        auto s    = ComputeGraphStreamSchedule::build(4, deps, 2, costs);
+        REQUIRE(s.stream_count == 2);
+        REQUIRE(s.stream_of[2] == s.stream_of[3]);
+        REQUIRE(s.waits[3].empty());
+        REQUIRE(s.waits[2].size() == 1);
+    }
+
+    // max_stream_count = 1 degrades to the serial launch
+    {
+        auto deps = make_deps({{0, 1}, {0, 2}, {1, 3}, {2, 3}});
+        auto s    = ComputeGraphStreamSchedule::build(4, deps, 1);
+        REQUIRE(s.stream_count == 1);
+        REQUIRE(s.makespan == 4.0);
+    }
+
+    // cycle
+    {
+        auto deps = make_deps({{0, 1}, {1, 0}});
+        REQUIRE_THROWS_AS(ComputeGraphStreamSchedule::build(2, deps, 2), logic_error);
+    }
+}
+
+void compute_graph_multi_stream_launch_test()
+{
+    ComputeGraphVarManager manager;
+    ComputeGraph           graph{manager};
+
+    auto& N = manager.create_var<int>("N");
+    auto& x = manager.create_var<Dense1D<int>>("x");
+    auto& y = manager.create_var<Dense1D<int>>("y");
+    auto& z = manager.create_var<Dense1D<int>>("z");
+
+    graph.create_node("fill_x") << [&]
+    {
+        ParallelFor(256).apply(N.eval(),
+                               [x = x.eval()] __device__(int i) mutable { x(i) = i; });
+    };
+
+    graph.create_node("fill_y") << [&]
+    {
+        ParallelFor(256).apply(N.eval(),
+                               [y = y.eval()] __device__(int i) mutable { y(i) = 2 * i; });
+    };
+
+    graph.create_node("z=x+y") << [&]
+    {
+        ParallelFor(256).apply(N.eval(),
+                               [x = x.ceval(), y = y.ceval(), z = z.eval()] __device__(int i) mutable
+                               { z(i) = x(i) + y(i); });
+    };
+
+    constexpr int      n = 1000;
+    DeviceBuffer<int>  x_buffer(n);
+    DeviceBuffer<int>  y_buffer(n);
+    DeviceBuffer<int>  z_buffer(n);
+    N.update(n);
+    x.update(x_buffer.viewer());
+    y.update(y_buffer.viewer());
+    z.update(z_buffer.viewer());
+
+    auto& schedule = graph.stream_schedule();
+    REQUIRE(schedule.stream_count == 2);
+    REQUIRE(schedule.order.back() == ClosureId{2});
+
+    Stream s;
+    graph.launch(ComputeGraphLaunchMode::MultiStream, s);
+    wait_device();
+
+    std::vector<int> res;
+    z_buffer.copy_to(res);
+    std::vector<int> gt(n);
+    for(int i = 0; i < n; ++i)
+        gt[i] = 3 * i;
+    REQUIRE(res == gt);
+}
+
+TEST_CASE("compute_graph_stream_schedule_test", "[compute_graph]")
+{
+    compute_graph_stream_schedule_test();
+}
+
+TEST_CASE("compute_graph_multi_stream_launch_test", "[compute_graph]")
+{
+    compute_graph_multi_stream_launch_test();
+}
@@ -556,4 +556,166 @@ void compute_graph_capture()
 TEST_CASE("compute_graph_capture", "[compute_graph]")
 {
     compute_graph_capture();
-}
\ No newline at end of file
+}
+void compute_graph_kernel_arg_patching()
+{
+    ComputeGraphVarManager manager;
+    ComputeGraph           graph{manager};
+    graph.kernel_arg_patching(true);
+
+    auto& N = manager.create_var<size_t>("N");
+    auto& x = manager.create_var<Dense1D<int>>("x");
+    auto& y = manager.create_var<Dense1D<int>>("y");
+
+    int fill_count = 0;
+    int copy_count = 0;
+
+    graph.create_node("fill_x") << [&]
+    {
+        ++fill_count;
+        ParallelFor(256).apply(N.eval(),
+                               [x = x.eval()] __device__(int i) mutable { x(i) = i; });
+    };
+
+    graph.create_node("y=2x") << [&]
+    {
+        ++copy_count;
+        ParallelFor(256).apply(N.eval(),
+                               [x = x.ceval(), y = y.eval()] __device__(int i) mutable
+                               { y(i) = 2 * x(i); });
+    };
+
+    constexpr int      n = 100;
+    DeviceBuffer<int>  x_buffers[2] = {DeviceBuffer<int>(n), DeviceBuffer<int>(n)};
+    DeviceBuffer<int>  y_buffers[2] = {DeviceBuffer<int>(n), DeviceBuffer<int>(n)};
+    std::vector<int>   gt(n);
+    for(int i = 0; i < n; ++i)
+        gt[i] = 2 * i;
+
+    N.update(n);
+    x.update(x_buffers[0].viewer());
+    y.update(y_buffers[0].viewer());
+    graph.launch();
+    wait_device();
+
+    auto fill_count_after_build = fill_count;
+    auto copy_count_after_build = copy_count;
+
+    // swap the buffers: only the kernel args are patched, no closure is re-run
+    for(int frame = 1; frame < 4; ++frame)
+    {
+        x.update(x_buffers[frame % 2].viewer());
+        y.update(y_buffers[frame % 2].viewer());
+        graph.launch();
+        wait_device();
+        REQUIRE(graph.patched_kernel_node_count() == 2);
+
+        std::vector<int> res;
+        y_buffers[frame % 2].copy_to(res);
+        REQUIRE(res == gt);
+    }
+    REQUIRE(fill_count == fill_count_after_build);
+    REQUIRE(copy_count == copy_count_after_build);
+
+    // a uniform var (launch config) still re-runs the closures
+    N.update(n / 2);
+    graph.launch();
+    wait_device();
+    REQUIRE(fill_count == fill_count_after_build + 1);
+    REQUIRE(copy_count == copy_count_after_build + 1);
+}
+
+void compute_graph_kernel_arg_patching_aliased()
+{
+    ComputeGraphVarManager manager;
+    ComputeGraph           graph{manager};
+    graph.kernel_arg_patching(true);
+
+    auto& N = manager.create_var<size_t>("N");
+    auto& x = manager.create_var<Dense1D<int>>("x");
+    auto& y = manager.create_var<Dense1D<int>>("y");
+
+    int run_count = 0;
+    graph.create_node("y=x+1") << [&]
+    {
+        ++run_count;
+        ParallelFor(256).apply(N.eval(),
+                               [x = x.ceval(), y = y.eval()] __device__(int i) mutable
+                               { y(i) = x(i) + 1; });
+    };
+
+    constexpr int     n = 100;
+    DeviceBuffer<int> a(n);
+    DeviceBuffer<int> b(n);
+    a.fill(1);
+    b.fill(0);
+
+    // in-place: x and y are bound to the same buffer, their slots can't be told apart
+    N.update(n);
+    x.update(a.viewer());
+    y.update(a.viewer());
+    graph.launch();
+    wait_device();
+    auto run_count_after_build = run_count;
+
+    // only y moves: patching both slots would also move x, so the closure re-runs
+    y.update(b.viewer());
+    graph.launch();
+    wait_device();
+    REQUIRE(run_count == run_count_after_build + 1);
+    REQUIRE(graph.patched_kernel_node_count() == 0);
+
+    std::vector<int> res;
+    a.copy_to(res);
+    REQUIRE(res == std::vector<int>(n, 2));
+    b.copy_to(res);
+    REQUIRE(res == std::vector<int>(n, 3));
+}
+
+void compute_graph_var_bytes()
+{
+    int  a = 0, b = 0;
+    auto va = ComputeGraphVarBytes::from(Dense1D<int>(&a, 10));
+    auto vb = ComputeGraphVarBytes::from(Dense1D<int>(&b, 20));
+    REQUIRE(!va.empty());
+    REQUIRE(ComputeGraphVarBytes::from(1.0f).empty());
+
+    struct Args
+    {
+        int          count;
+        Dense1D<int> x;
+        Dense1D<int> y;
+    } args{1, Dense1D<int>(&a, 10), Dense1D<int>(&a, 10)};
+
+    auto data = span<std::byte>{reinterpret_cast<std::byte*>(&args), sizeof(args)};
+    auto offsets = va.find_in(data);
+    REQUIRE(offsets.size() == 2);
+    REQUIRE(vb.find_in(data).empty());
+
+    vb.patch(data, offsets[1]);
+    REQUIRE(args.count == 1);
+    REQUIRE(args.x.data() == &a);
+    REQUIRE(args.y.data() == &b);
+    REQUIRE(args.y.dim() == 20);
+
+    // a derived copy (e.g. a subview) points into the memory of the value
+    int  arr[10];
+    auto varr = ComputeGraphVarBytes::from(Dense1D<int>(arr, 10));
+    REQUIRE(varr.refers_to(reinterpret_cast<uintptr_t>(arr + 2)));
+    REQUIRE(!varr.refers_to(reinterpret_cast<uintptr_t>(arr + 10)));
+}
+
+TEST_CASE("compute_graph_kernel_arg_patching", "[compute_graph]")
+{
+    compute_graph_kernel_arg_patching();
+}
+
+TEST_CASE("compute_graph_kernel_arg_patching_aliased", "[compute_graph]")
+{
+    compute_graph_kernel_arg_patching_aliased();
+}
+
+TEST_CASE("compute_graph_var_bytes", "[compute_graph]")
+{
+    compute_graph_var_bytes();
+}
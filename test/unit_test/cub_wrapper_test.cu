@@ -1366,3 +1366,89 @@ TEST_CASE("device_partition", "[cub]")
         REQUIRE(h_keys_out == gt_keys_out);
     }
 }
+
+// the buffer-less overloads take the temp storage from the scratch arena of the stream,
+// the temp storage sizes are cached per problem size
+void cub_scratch_test(int size, Stream& s, DeviceBuffer<std::byte>& buffer, bool& ok)
+{
+    std::vector<int> h_in(size);
+    std::for_each(h_in.begin(), h_in.end(), [](int& r) { r = std::rand() % 1000; });
+
+    std::vector<int> gt_scan(size);
+    std::exclusive_scan(h_in.begin(), h_in.end(), gt_scan.begin(), 0);
+    std::vector<int> gt_sort = h_in;
+    std::sort(gt_sort.begin(), gt_sort.end());
+
+    DeviceBuffer<int> d_in = h_in;
+    DeviceBuffer<int> d_scan(size);
+    DeviceBuffer<int> d_sort(size);
+    DeviceBuffer<int> d_sort_buffer(size);
+
+    DeviceScan(s).ExclusiveSum(d_in.data(), d_scan.data(), size);
+    DeviceRadixSort(s).SortKeys(d_in.data(), d_sort.data(), size);
+    // the user buffer only grows
+    DeviceRadixSort(s).SortKeys(buffer, d_in.data(), d_sort_buffer.data(), size);
+    wait_stream(s);
+
+    std::vector<int> h_scan, h_sort, h_sort_buffer;
+    d_scan.copy_to(h_scan);
+    d_sort.copy_to(h_sort);
+    d_sort_buffer.copy_to(h_sort_buffer);
+    ok = h_scan == gt_scan && h_sort == gt_sort && h_sort_buffer == gt_sort;
+}
+
+TEST_CASE("cub_scratch", "[cub]")
+{
+    Stream                  s;
+    DeviceBuffer<std::byte> buffer;
+    size_t                  capacity = 0;
+    // grow, shrink and repeat, so both the cached and the new sizes are hit
+    for(int size : {100, 10000, 1000, 100, 100000, 10000})
+    {
+        bool ok = false;
+        cub_scratch_test(size, s, buffer, ok);
+        REQUIRE(ok);
+        REQUIRE(buffer.size() >= capacity);
+        capacity = buffer.size();
+    }
+
+    // the arena of the stream is freed, and allocated again on the next call
+    auto arena_count = details::CubScratch::arena_count();
+    REQUIRE(arena_count >= 1);
+    cub_scratch_release(s);
+    REQUIRE(details::CubScratch::arena_count() == arena_count - 1);
+    bool ok = false;
+    cub_scratch_test(1000, s, buffer, ok);
+    REQUIRE(ok);
+    REQUIRE(details::CubScratch::arena_count() == arena_count);
+    cub_scratch_release(s);
+}
+
+TEST_CASE("cub_temp_size_cache", "[cub]")
+{
+    details::CubTempSizeCache cache;
+    int                       query_count = 0;
+    auto                      get         = [&](const details::CubTempSizeKey& key, size_t size)
+    {
+        return cache.get(key,
+                         [&]
+                         {
+                             ++query_count;
+                             return size;
+                         });
+    };
+
+    int levels_a[3] = {257, 257, 257};
+    int levels_b[3] = {257, 257, 65};
+    using Span      = details::CubTempSizeKeySpan<int>;
+
+    REQUIRE(get(details::cub_temp_size_key(Span{levels_a, 3}, 1000), 1) == 1);
+    // only the level count of the last channel differs
+    REQUIRE(get(details::cub_temp_size_key(Span{levels_b, 3}, 1000), 2) == 2);
+    REQUIRE(get(details::cub_temp_size_key(Span{levels_a, 3}, 1000), 3) == 1);
+    REQUIRE(get(details::cub_temp_size_key(1000, 3), 4) == 4);
+    REQUIRE(get(details::cub_temp_size_key(3, 1000), 5) == 5);
+    // a prefix of another key
+    REQUIRE(get(details::cub_temp_size_key(3), 6) == 6);
+    REQUIRE(query_count == 5);
+}
@@ -0,0 +1,185 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/field/field.h>
+#include <muda/field/field_builder.h>
+#include <muda/field/field_checkpoint.h>
+#include <cstdio>
+
+using namespace muda;
+
+// a host buffer of one vector3<float> entry
+static FieldEntryBaseData field_checkpoint_host_info(FieldEntryLayoutInfo layout, uint32_t count)
+{
+    FieldEntryBaseData info;
+    info.layout_info      = layout;
+    info.type             = FieldEntryType::Vector;
+    info.shape            = make_uint2(3, 1);
+    info.elem_byte_size   = sizeof(float);
+    info.elem_count       = count;
+    info.offset_in_struct = 0;
+    switch(layout.layout())
+    {
+        case FieldEntryLayout::AoS:
+            info.struct_stride = 3 * sizeof(float);
+            break;
+        case FieldEntryLayout::SoA:
+            info.elem_count_based_stride = count * sizeof(float);
+            break;
+        case FieldEntryLayout::AoSoA:
+            info.struct_stride = 3 * sizeof(float) * layout.innermost_array_size();
+            break;
+        default:
+            break;
+    }
+    return info;
+}
+
+void field_checkpoint_host_test()
+{
+    constexpr uint32_t N     = 100;
+    constexpr uint32_t Chunk = 30;
+    std::string        path  = "field_checkpoint_host_test.mudafield";
+
+    // AoS on the host
+    std::vector<float> aos(3 * N);
+    for(uint32_t i = 0; i < N; ++i)
+        for(int c = 0; c < 3; ++c)
+            aos[3 * i + c] = 10.0f * i + c;
+    auto aos_info = field_checkpoint_host_info(FieldEntryLayoutInfo{FieldEntryLayout::AoS}, N);
+    details::FieldRelayoutAccessor aos_view{reinterpret_cast<std::byte*>(aos.data()), aos_info, {}};
+
+    {
+        FieldCheckpointWriter writer{path, 1};
+        writer.begin_sub_field("particle", FieldEntryLayoutInfo{FieldEntryLayout::AoS}, N, 1);
+
+        FieldCheckpointEntryInfo entry;
+        entry.name           = "position";
+        entry.type           = FieldEntryType::Vector;
+        entry.elem_byte_size = sizeof(float);
+        entry.shape          = make_uint2(3, 1);
+        entry.count          = N;
+        writer.begin_entry(entry);
+
+        std::vector<std::byte> packed;
+        for(uint32_t first = 0; first < N; first += Chunk)
+        {
+            auto count = std::min(Chunk, N - first);
+            packed.resize(count * entry.elem_total_byte_size());
+            auto packed_info = details::field_packed_entry_info(aos_info, count);
+            details::FieldRelayoutAccessor packed_view{packed.data(), packed_info, {}};
+            details::field_relayout_entry_host(aos_view, first, packed_view, 0, count);
+            writer.write_chunk(first, count, packed.data(), packed.size());
+        }
+    }
+
+    FieldCheckpointReader reader{path};
+    REQUIRE(reader.sub_fields().size() == 1);
+    auto saved = reader.find_sub_field("particle");
+    REQUIRE(saved);
+    REQUIRE(saved->count == N);
+    auto entry = saved->find_entry("position");
+    REQUIRE(entry);
+    REQUIRE(entry->chunks.size() == (N + Chunk - 1) / Chunk);
+    REQUIRE(entry->info.shape.x == 3);
+
+    // relayout on load: to AoSoA(8) on the host
+    auto layout = FieldEntryLayoutInfo{FieldEntryLayout::AoSoA, 8};
+    auto aosoa_info = field_checkpoint_host_info(layout, N);
+    std::vector<float> aosoa(3 * ((N + 7) / 8 * 8));
+    details::FieldRelayoutAccessor aosoa_view{
+        reinterpret_cast<std::byte*>(aosoa.data()), aosoa_info, {}};
+
+    std::vector<std::byte> packed;
+    for(auto& chunk : entry->chunks)
+    {
+        packed.resize(chunk.size);
+        reader.read_chunk(chunk, packed.data());
+        auto packed_info = details::field_packed_entry_info(aosoa_info, chunk.count);
+        details::FieldRelayoutAccessor packed_view{packed.data(), packed_info, {}};
+        details::field_relayout_entry_host(packed_view, 0, aosoa_view, chunk.first, chunk.count);
+    }
+
+    for(uint32_t i = 0; i < N; ++i)
+        for(int c = 0; c < 3; ++c)
+        {
+            // AoSoA(8): [i / 8][c][i % 8]
+            auto v = aosoa[(i / 8) * 24 + c * 8 + i % 8];
+            REQUIRE(v == 10.0f * i + c);
+        }
+
+    std::remove(path.c_str());
+}
+
+void field_checkpoint_test()
+{
+    using Layout = FieldEntryLayout;
+
+    constexpr int N    = 1000;
+    std::string   path = "field_checkpoint_test.mudafield";
+
+    {
+        Field field;
+        auto& particle = field["particle"];
+        auto  builder  = particle.builder(FieldEntryLayoutInfo{Layout::AoS});
+        auto& m        = builder.entry("mass").scalar<float>();
+        auto& I        = builder.entry("inertia").matrix3x3<float>();
+        builder.build();
+        particle.resize(N);
+
+        ParallelFor(256)
+            .apply(N,
+                   [m = m.viewer(), I = I.viewer()] __device__(int i) mutable
+                   {
+                       m(i) = 1.0f * i;
+                       for(int r = 0; r < 3; ++r)
+                           for(int c = 0; c < 3; ++c)
+                               I(i, r, c) = 100.0f * i + r * 3 + c;
+                   })
+            .wait();
+
+        // 1KB chunks: every entry is written in several chunks
+        field.checkpoint(path, nullptr, 1024);
+    }
+
+    for(auto layout : {FieldEntryLayoutInfo{Layout::SoA}, FieldEntryLayoutInfo{Layout::AoSoA, 16}})
+    {
+        Field field;
+        auto& particle = field["particle"];
+        auto  builder  = particle.builder(layout);
+        auto& I        = builder.entry("inertia").matrix3x3<float>();
+        auto& m        = builder.entry("mass").scalar<float>();
+        builder.build();
+
+        Stream s;
+        field.restore(path, s);
+        REQUIRE(particle.size() == N);
+
+        DeviceVar<int> error = 0;
+        ParallelFor(256)
+            .apply(N,
+                   [m = m.cviewer(), I = I.cviewer(), error = error.viewer()] __device__(int i) mutable
+                   {
+                       int e = m(i) != 1.0f * i;
+                       for(int r = 0; r < 3; ++r)
+                           for(int c = 0; c < 3; ++c)
+                               e += I(i, r, c) != 100.0f * i + r * 3 + c;
+                       if(e)
+                           atomicAdd(error.data(), e);
+                   })
+            .wait();
+        REQUIRE(int(error) == 0);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("field_checkpoint_host_test", "[field]")
+{
+    field_checkpoint_host_test();
+}
+
+TEST_CASE("field_checkpoint_test", "[field]")
+{
+    field_checkpoint_test();
+}
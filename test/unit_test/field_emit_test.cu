@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/field/field.h>
+#include <muda/field/field_builder.h>
+
+using namespace muda;
+
+template <typename MassEntry>
+std::vector<float> field_emit_download(MassEntry& m, int count, cudaStream_t stream)
+{
+    DeviceBuffer<float> buffer(count);
+    ParallelFor(256, 0, stream)
+        .apply(count,
+               [m = m.cviewer(), buffer = buffer.viewer()] __device__(int i) mutable
+               { buffer(i) = m(i); })
+        .wait();
+    std::vector<float> h;
+    buffer.copy_to(h);
+    return h;
+}
+
+void field_emit_test(FieldEntryLayoutInfo layout)
+{
+    constexpr int N = 100;
+    Stream        s;
+
+    Field field;
+    auto& particle = field["particle"];
+    auto  builder  = particle.builder(layout);
+    auto& m        = builder.entry("mass").scalar<float>();
+    auto& pos      = builder.entry("position").vector3<float>();
+    builder.build();
+    particle.resize(N, s);
+
+    ParallelFor(256, 0, s)
+        .apply(N,
+               [m = m.viewer(), pos = pos.viewer()] __device__(int i) mutable
+               {
+                   m(i) = 1.0f * i;
+                   for(int c = 0; c < 3; ++c)
+                       pos(i, c) = 10.0f * i + c;
+               });
+
+    // the even particles spawn a child, the multiples of 5 die
+    auto emitter = particle.begin_emit(N, s);
+    REQUIRE(particle.size() == 2 * N);  // upper bound
+    ParallelFor(256, 0, s)
+        .apply(N,
+               [emitter, m = m.viewer(), pos = pos.viewer()] __device__(int i) mutable
+               {
+                   if(i % 5 == 0)
+                       emitter.kill(i);
+                   if(i % 2 == 0)
+                   {
+                       auto j = emitter.append();
+                       m(j)   = 1000.0f + i;
+                       for(int c = 0; c < 3; ++c)
+                           pos(j, c) = pos(i, c);
+                   }
+               });
+    particle.end_emit(s);
+    REQUIRE(particle.sync_size() == N + N / 2);
+
+    auto before = field_emit_download(m, particle.size(), s);
+
+    // remove the dead, the count stays on the device
+    auto old_to_new = particle.compact_dead(s);
+    REQUIRE(old_to_new.size() == N + N / 2);
+    REQUIRE(particle.sync_size() == N + N / 2 - N / 5);
+    std::vector<int> h_old_to_new(old_to_new.size());
+    old_to_new.copy_to(h_old_to_new.data());
+
+    auto after = field_emit_download(m, particle.size(), s);
+    int  alive = 0;
+    for(int i = 0; i < N + N / 2; ++i)
+    {
+        bool dead = i < N && i % 5 == 0;
+        if(dead)
+        {
+            REQUIRE(h_old_to_new[i] == -1);
+            continue;
+        }
+        // the order is kept
+        REQUIRE(h_old_to_new[i] == alive++);
+        REQUIRE(after[h_old_to_new[i]] == before[i]);
+    }
+
+    // the appends beyond the emit capacity are rejected, the emissions are chained
+    // without reading back the count
+    auto size = static_cast<int>(particle.size());
+    for(int round = 0; round < 2; ++round)
+    {
+        auto emitter = particle.begin_emit(10, s);
+        ParallelFor(256, 0, s)
+            .apply(20,
+                   [emitter, m = m.viewer()] __device__(int i) mutable
+                   {
+                       if(auto j = emitter.append(); j >= 0)
+                           m(j) = -1.0f;
+                   });
+    }
+    REQUIRE(particle.size() == size + 20);
+    REQUIRE(!particle.poll_size());
+    particle.end_emit(s);
+    REQUIRE(particle.sync_size() == size + 20);
+    REQUIRE(particle.poll_size());
+
+    // a request beyond the capacity only rejects its own lane, not the whole warp
+    size = static_cast<int>(particle.size());
+    {
+        auto emitter = particle.begin_emit(40, s);
+        ParallelFor(32, 0, s)
+            .apply(32,
+                   [emitter, m = m.viewer()] __device__(int i) mutable
+                   {
+                       auto n = i == 0 ? 100 : 1;
+                       if(auto j = emitter.append(n); j >= 0)
+                           m(j) = -2.0f;
+                   });
+        particle.end_emit(s);
+    }
+    REQUIRE(particle.sync_size() == size + 31);
+}
+
+TEST_CASE("field_emit_test", "[field]")
+{
+    SECTION("AoS")
+    {
+        field_emit_test(FieldEntryLayoutInfo{FieldEntryLayout::AoS});
+    }
+    SECTION("SoA")
+    {
+        field_emit_test(FieldEntryLayoutInfo{FieldEntryLayout::SoA});
+    }
+    SECTION("AoSoA")
+    {
+        field_emit_test(FieldEntryLayoutInfo{FieldEntryLayout::AoSoA, 32});
+    }
+}
@@ -0,0 +1,132 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/field/field.h>
+#include <muda/field/field_builder.h>
+#include <muda/field/field_layout_autotuner.h>
+
+using namespace muda;
+
+// vector entries are indexed by (i, comp), matrix entries by (i, row, col)
+template <int N, typename Viewer>
+__device__ decltype(auto) field_relayout_at(Viewer& e, int i, int r, int c)
+{
+    if constexpr(N == 1)
+        return e(i, r);
+    else
+        return e(i, r, c);
+}
+
+template <typename T, FieldEntryLayout Layout, int M, int N>
+void field_relayout_fill(FieldEntry<T, Layout, M, N>& e, int count, int seed)
+{
+    ParallelFor(256)
+        .apply(count,
+               [e = e.viewer(), seed] __device__(int i) mutable
+               {
+                   for(int r = 0; r < M; ++r)
+                       for(int c = 0; c < N; ++c)
+                           field_relayout_at<N>(e, i, r, c) = T((i * 7 + r * M + c + seed) % 100);
+               })
+        .wait();
+}
+
+template <typename T, FieldEntryLayout Layout, int M, int N>
+int field_relayout_check(FieldEntry<T, Layout, M, N>& e, int count, int seed)
+{
+    DeviceVar<int> error = 0;
+    ParallelFor(256)
+        .apply(count,
+               [e = e.cviewer(), seed, error = error.viewer()] __device__(int i) mutable
+               {
+                   for(int r = 0; r < M; ++r)
+                       for(int c = 0; c < N; ++c)
+                           if(field_relayout_at<N>(e, i, r, c) != T((i * 7 + r * M + c + seed) % 100))
+                               atomicAdd(error.data(), 1);
+               })
+        .wait();
+    return error;
+}
+
+void field_relayout_test()
+{
+    using Layout = FieldEntryLayout;
+
+    Field field;
+    auto& particle = field["particle"];
+
+    auto  builder = particle.builder(FieldEntryLayoutInfo{Layout::AoS});
+    auto& flag    = builder.entry("flag").matrix<char, 3, 1>();       // byte copy
+    auto& pos     = builder.entry("position").matrix<float, 3, 1>();  // word copy
+    auto& I       = builder.entry("inertia").matrix<double, 4, 4>();  // tiled, 128 bytes
+    auto& K       = builder.entry("stiffness").matrix<float, 9, 9>();  // too large to stage
+    builder.build();
+
+    constexpr int N = 1000;  // not a multiple of the tile size
+    particle.resize(N);
+    field_relayout_fill(flag, N, 1);
+    field_relayout_fill(pos, N, 2);
+    field_relayout_fill(I, N, 3);
+    field_relayout_fill(K, N, 4);
+
+    Stream s;
+    for(auto layout : {FieldEntryLayoutInfo{Layout::SoA},
+                       FieldEntryLayoutInfo{Layout::AoSoA, 32},
+                       FieldEntryLayoutInfo{Layout::AoSoA, 8},
+                       FieldEntryLayoutInfo{Layout::AoS}})
+    {
+        particle.relayout(layout, s);
+        wait_stream(s);
+        REQUIRE(particle.layout_info() == layout);
+        REQUIRE(particle.size() == N);
+        REQUIRE(field_relayout_check(flag, N, 1) == 0);
+        REQUIRE(field_relayout_check(pos, N, 2) == 0);
+        REQUIRE(field_relayout_check(I, N, 3) == 0);
+        REQUIRE(field_relayout_check(K, N, 4) == 0);
+    }
+}
+
+void field_layout_autotuner_test()
+{
+    using Layout = FieldEntryLayout;
+
+    Field field;
+    auto& particle = field["particle"];
+
+    auto  builder = particle.builder(FieldEntryLayoutInfo{Layout::AoS});
+    auto& x       = builder.entry("x").vector3<float>();
+    auto& v       = builder.entry("v").vector3<float>();
+    builder.build();
+
+    constexpr int N = 1 << 16;
+    particle.resize(N);
+    field_relayout_fill(x, N, 0);
+
+    FieldLayoutAutotuner tuner{particle};
+    auto best = tuner.repeat(3).tune(
+        [&](cudaStream_t stream)
+        {
+            ParallelFor(256, 0, stream)
+                .apply(N,
+                       [x = x.viewer(), v = v.viewer()] __device__(int i) mutable
+                       {
+                           for(int c = 0; c < 3; ++c)
+                               x(i, c) += v(i, c);
+                       });
+        });
+
+    REQUIRE(tuner.results().size() == 3);
+    REQUIRE(particle.layout_info() == best);
+    // v == 0, x is untouched by the access and by all the relayouts
+    REQUIRE(field_relayout_check(x, N, 0) == 0);
+}
+
+TEST_CASE("field_relayout_test", "[field]")
+{
+    field_relayout_test();
+}
+
+TEST_CASE("field_layout_autotuner_test", "[field]")
+{
+    field_layout_autotuner_test();
+}
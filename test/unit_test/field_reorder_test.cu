@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/field/field.h>
+#include <muda/field/field_builder.h>
+#include "field_test_common.h"
+
+using namespace muda;
+
+void field_reorder_test(FieldEntryLayoutInfo layout)
+{
+    constexpr int N = 1000;
+    Stream        s;
+
+    Field field;
+    auto& particle = field["particle"];
+    auto  builder  = particle.builder(layout);
+    auto& m        = builder.entry("mass").scalar<float>();
+    auto& pos      = builder.entry("position").vector3<float>();
+    builder.build();
+    particle.resize(N, s);
+
+    ParallelFor(256, 0, s)
+        .apply(N,
+               [m = m.viewer(), pos = pos.viewer()] __device__(int i) mutable
+               {
+                   m(i) = 1.0f * i;
+                   for(int c = 0; c < 3; ++c)
+                       pos(i, c) = 10.0f * i + c;
+               });
+
+    std::vector<int> expected(N);
+
+    // permute: reverse
+    for(int i = 0; i < N; ++i)
+        expected[i] = N - 1 - i;
+    DeviceBuffer<int> perm = expected;
+    particle.permute(perm, s);
+    wait_stream(s);
+    REQUIRE(field_particle_check(m, pos, expected) == 0);
+
+    // sort_by_key: back to the original order, the key of particle i is its original index
+    DeviceBuffer<int> keys = expected;
+    particle.sort_by_key(keys.view(), s);
+    wait_stream(s);
+    for(int i = 0; i < N; ++i)
+        expected[i] = i;
+    REQUIRE(field_particle_check(m, pos, expected) == 0);
+    std::vector<int> h_keys;
+    keys.copy_to(h_keys);
+    REQUIRE(h_keys == expected);
+
+    // compact: delete the particles that are not multiple of 3
+    std::vector<int> mask(N);
+    expected.clear();
+    for(int i = 0; i < N; ++i)
+    {
+        mask[i] = i % 3 == 0;
+        if(mask[i])
+            expected.push_back(i);
+    }
+    DeviceBuffer<int> d_mask = mask;
+    auto              size   = particle.compact(d_mask, s);
+    REQUIRE(size == expected.size());
+    REQUIRE(particle.size() == expected.size());
+    REQUIRE(field_particle_check(m, pos, expected) == 0);
+}
+
+TEST_CASE("field_reorder_test", "[field]")
+{
+    SECTION("AoS")
+    {
+        field_reorder_test(FieldEntryLayoutInfo{FieldEntryLayout::AoS});
+    }
+    SECTION("SoA")
+    {
+        field_reorder_test(FieldEntryLayoutInfo{FieldEntryLayout::SoA});
+    }
+    SECTION("AoSoA")
+    {
+        field_reorder_test(FieldEntryLayoutInfo{FieldEntryLayout::AoSoA, 32});
+    }
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/field/field.h>
+#include <muda/field/field_builder.h>
+#include "field_test_common.h"
+
+using namespace muda;
+
+void field_resize_test(FieldEntryLayout layout)
+{
+    Stream s;
+
+    Field field;
+    auto& particle = field["particle"];
+
+    auto  builder = particle.builder(layout);
+    auto& m       = builder.entry("mass").scalar<float>();
+    auto& pos     = builder.entry("position").vector3<float>();
+    FieldBuildOptions options;
+    options.growth_factor = 2.0f;
+    builder.build(options);
+
+    // emit some particles every frame, the capacity grows geometrically
+    int    count              = 0;
+    size_t reallocation_count = 0;
+    size_t last_capacity      = particle.capacity();
+    for(int frame = 0; frame < 20; ++frame)
+    {
+        int emit = 100;
+        particle.resize(count + emit, s);
+        REQUIRE(particle.size() == count + emit);
+        REQUIRE(particle.capacity() >= particle.size());
+        if(particle.capacity() != last_capacity)
+        {
+            ++reallocation_count;
+            last_capacity = particle.capacity();
+        }
+
+        ParallelFor(256, 0, s)
+            .apply(emit,
+                   [m = m.viewer(), pos = pos.viewer(), count] __device__(int i) mutable
+                   {
+                       auto j = count + i;
+                       m(j)   = 1.0f * j;
+                       for(int c = 0; c < 3; ++c)
+                           pos(j, c) = 10.0f * j + c;
+                   });
+        count += emit;
+    }
+    // 100 -> 2000 with factor 2: 100, 200, 400, 800, 1600, 3200
+    REQUIRE(reallocation_count <= 6);
+    REQUIRE(field_particle_check(m, pos, count, s) == 0);
+
+    // shrinking keeps the capacity
+    auto capacity = particle.capacity();
+    particle.resize(count / 2, s);
+    REQUIRE(particle.capacity() == capacity);
+    REQUIRE(field_particle_check(m, pos, count / 2, s) == 0);
+
+    particle.shrink_to_fit(s);
+    REQUIRE(particle.capacity() < capacity);
+    REQUIRE(particle.capacity() >= particle.size());
+    REQUIRE(field_particle_check(m, pos, count / 2, s) == 0);
+
+    // reserve doesn't change the size
+    particle.reserve(10000, s);
+    REQUIRE(particle.capacity() >= 10000);
+    REQUIRE(particle.size() == count / 2);
+    REQUIRE(field_particle_check(m, pos, count / 2, s) == 0);
+
+    // growing within the capacity doesn't reallocate
+    capacity = particle.capacity();
+    particle.resize(count, s);
+    REQUIRE(particle.capacity() == capacity);
+    REQUIRE(field_particle_check(m, pos, count / 2, s) == 0);
+}
+
+TEST_CASE("field_resize_test", "[field]")
+{
+    using Layout = FieldEntryLayout;
+    field_resize_test(Layout::AoS);
+    field_resize_test(Layout::SoA);
+    field_resize_test(Layout::AoSoA);
+}
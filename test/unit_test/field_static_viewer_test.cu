@@ -0,0 +1,158 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/field/field.h>
+#include <muda/field/field_builder.h>
+#include <iostream>
+#include "benchmark_common.h"
+
+using namespace muda;
+
+template <FieldEntryLayout Layout>
+void field_static_viewer_test()
+{
+    Field field;
+    auto& particle = field["particle"];
+
+    auto  builder = particle.builder<Layout>();
+    auto& m       = builder.entry("mass").template scalar<float>();
+    auto& pos     = builder.entry("position").template vector3<float>();
+    auto& I       = builder.entry("inertia").template matrix3x3<float>();
+    builder.build();
+
+    // not a multiple of the innermost array size
+    constexpr int N = 1000;
+    particle.resize(N);
+
+    // write through the static viewers
+    ParallelFor(256)
+        .apply(N,
+               [m   = m.static_viewer(),
+                pos = pos.static_viewer(),
+                I   = I.static_viewer()] __device__(int i) mutable
+               {
+                   m(i)     = 1.0f * i;
+                   pos.x(i) = 10.0f * i;
+                   pos(i, 1) = 10.0f * i + 1;
+                   pos.z(i) = 10.0f * i + 2;
+                   for(int r = 0; r < 3; ++r)
+                       for(int c = 0; c < 3; ++c)
+                           I(i, r, c) = 100.0f * i + r * 3 + c;
+               })
+        .wait();
+
+    // compare with the runtime viewers, both the address and the value
+    DeviceVar<int> error = 0;
+    ParallelFor(256)
+        .apply(N,
+               [sm    = m.cstatic_viewer(),
+                spos  = pos.cstatic_viewer(),
+                sI    = I.cstatic_viewer(),
+                m     = m.cviewer(),
+                pos   = pos.cviewer(),
+                I     = I.cviewer(),
+                error = error.viewer()] __device__(int i) mutable
+               {
+                   int e = 0;
+                   e += &sm(i) != &m(i);
+                   e += m(i) != 1.0f * i;
+                   for(int c = 0; c < 3; ++c)
+                   {
+                       e += &spos(i, c) != &pos(i, c);
+                       e += pos(i, c) != 10.0f * i + c;
+                   }
+                   auto map = spos(i);
+                   e += map.begin != &pos(i, 0);
+                   e += map.begin + map.inner_stride != &pos(i, 1);
+
+                   for(int r = 0; r < 3; ++r)
+                       for(int c = 0; c < 3; ++c)
+                       {
+                           e += &sI(i, r, c) != &I(i, r, c);
+                           e += I(i, r, c) != 100.0f * i + r * 3 + c;
+                       }
+                   auto Imap = sI(i);
+                   e += Imap.begin + Imap.inner_stride != &I(i, 1, 0);
+                   e += Imap.begin + Imap.outer_stride != &I(i, 0, 1);
+
+                   if(e)
+                       atomicAdd(error.data(), e);
+               })
+        .wait();
+
+    int h_error = error;
+    REQUIRE(h_error == 0);
+}
+
+TEST_CASE("field_static_viewer_test", "[field]")
+{
+    using Layout = FieldEntryLayout;
+    field_static_viewer_test<Layout::AoS>();
+    field_static_viewer_test<Layout::SoA>();
+    field_static_viewer_test<Layout::AoSoA>();
+}
+
+// x += v * dt over all particles, reports the effective bandwidth
+template <typename Builder, typename MakeViewer>
+float field_viewer_bandwidth(Builder&& builder, SubField& particle, MakeViewer&& make)
+{
+    constexpr int N = 1 << 22;
+
+    auto& x = builder.entry("x").template vector3<float>();
+    auto& v = builder.entry("v").template vector3<float>();
+    builder.build();
+    particle.resize(N);
+
+    auto run = [&]
+    {
+        ParallelFor(256).apply(N,
+                               [x = make(x), v = make(v), dt = 0.01f] __device__(int i) mutable
+                               {
+                                   x(i, 0) += v(i, 0) * dt;
+                                   x(i, 1) += v(i, 1) * dt;
+                                   x(i, 2) += v(i, 2) * dt;
+                               });
+    };
+
+    double bytes = double(N) * 3 * sizeof(float) * 3;  // read x, read v, write x
+    return benchmark_bandwidth(bytes, run);
+}
+
+template <FieldEntryLayout Layout>
+void field_static_viewer_benchmark(const char* layout_name)
+{
+    auto runtime_viewer = [](auto& e) { return e.viewer(); };
+    auto static_viewer  = [](auto& e) { return e.static_viewer(); };
+
+    float runtime_layout, compile_time_layout, static_layout;
+    {
+        Field field;
+        auto& particle = field["particle"];
+        runtime_layout =
+            field_viewer_bandwidth(particle.builder(Layout), particle, runtime_viewer);
+    }
+    {
+        Field field;
+        auto& particle = field["particle"];
+        compile_time_layout =
+            field_viewer_bandwidth(particle.builder<Layout>(), particle, runtime_viewer);
+    }
+    {
+        Field field;
+        auto& particle = field["particle"];
+        static_layout =
+            field_viewer_bandwidth(particle.builder<Layout>(), particle, static_viewer);
+    }
+
+    std::cout << layout_name << ": runtime layout=" << runtime_layout
+              << "GB/s, compile-time layout=" << compile_time_layout
+              << "GB/s, static viewer=" << static_layout << "GB/s" << std::endl;
+}
+
+TEST_CASE("field_static_viewer_benchmark", "[.benchmark]")
+{
+    using Layout = FieldEntryLayout;
+    field_static_viewer_benchmark<Layout::AoS>("AoS");
+    field_static_viewer_benchmark<Layout::SoA>("SoA");
+    field_static_viewer_benchmark<Layout::AoSoA>("AoSoA");
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <vector>
+
+// check the first `count` particles hold (j, 10 * j + c), with j = expected[i]
+// if a device array `expected` is given, else j = i
+template <typename MassEntry, typename PosEntry>
+int field_particle_check(MassEntry&   m,
+                         PosEntry&    pos,
+                         int          count,
+                         cudaStream_t stream   = nullptr,
+                         const int*   expected = nullptr)
+{
+    using namespace muda;
+
+    DeviceVar<int> error = 0;
+    ParallelFor(256, 0, stream)
+        .apply(count,
+               [m = m.cviewer(), pos = pos.cviewer(), expected, error = error.viewer()] __device__(int i) mutable
+               {
+                   auto j = expected ? expected[i] : i;
+                   int  e = m(i) != 1.0f * j;
+                   for(int c = 0; c < 3; ++c)
+                       e += pos(i, c) != 10.0f * j + c;
+                   if(e)
+                       atomicAdd(error.data(), e);
+               })
+        .wait();
+    return error;
+}
+
+// check particle i holds the original particle `expected[i]`
+template <typename MassEntry, typename PosEntry>
+int field_particle_check(MassEntry& m, PosEntry& pos, const std::vector<int>& expected)
+{
+    muda::DeviceBuffer<int> d_expected = expected;
+    return field_particle_check(m, pos, expected.size(), nullptr, d_expected.data());
+}
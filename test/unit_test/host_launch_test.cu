@@ -0,0 +1,107 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <numeric>
+
+using namespace muda;
+
+void host_parallel_for_test()
+{
+    constexpr int N = 1000;
+    std::vector<int> res(N, 0);
+    std::vector<int> gt(N);
+    std::iota(gt.begin(), gt.end(), 0);
+
+    // dynamic blocks
+    HostParallelFor(64).apply(N,
+                              [res = res.data()] __host__ __device__(int i) mutable
+                              { res[i] = i; });
+    REQUIRE(res == gt);
+
+    // grid-stride loop
+    std::fill(res.begin(), res.end(), 0);
+    HostParallelFor(4, 32).apply(N,
+                                 [res = res.data()] __host__ __device__(int i) mutable
+                                 { res[i] = i; });
+    REQUIRE(res == gt);
+
+    // details
+    std::vector<int> active(N, 0);
+    std::vector<int> final_block(N, 0);
+    HostParallelFor(64).apply(N,
+                              [active = active.data(), final_block = final_block.data()] __host__ __device__(
+                                  const ParallelForDetails& details) mutable
+                              {
+                                  active[details.i()] = details.active_num_in_block();
+                                  final_block[details.i()] = details.is_final_block();
+                              });
+    // 1000 = 15 * 64 + 40
+    REQUIRE(active.front() == 64);
+    REQUIRE(active.back() == 40);
+    REQUIRE(final_block[15 * 64 - 1] == 0);
+    REQUIRE(final_block[15 * 64] == 1);
+
+    std::vector<int> batch(N, -1);
+    std::vector<int> total_batch(N, -1);
+    HostParallelFor(2, 100).apply(N,
+                                  [batch = batch.data(), total_batch = total_batch.data()] __host__ __device__(
+                                      const ParallelForDetails& details) mutable
+                                  {
+                                      batch[details.i()] = details.batch_i();
+                                      total_batch[details.i()] = details.total_batch();
+                                  });
+    REQUIRE(std::all_of(total_batch.begin(), total_batch.end(), [](int v) { return v == 5; }));
+    REQUIRE(batch[199] == 0);
+    REQUIRE(batch[200] == 1);
+    REQUIRE(batch[999] == 4);
+}
+
+void host_launch_test()
+{
+    std::vector<int> gt(7 * 6 * 5, 1);
+    std::vector<int> res(7 * 6 * 5, 0);
+
+    HostLaunch(cube(4)).apply(dim3{7, 6, 5},
+                              [res = res.data()] __host__ __device__(const int3 xyz) mutable
+                              { res[xyz.x + xyz.y * 7 + xyz.z * 7 * 6] += 1; });
+    REQUIRE(res == gt);
+}
+
+void host_thread_pool_test()
+{
+    HostThreadPool pool(3);
+
+    std::vector<int> res(10007, 0);
+    pool.parallel_for_blocks(10007, [&](int i) { res[i] += 1; });
+    REQUIRE(std::all_of(res.begin(), res.end(), [](int v) { return v == 1; }));
+
+    // nested call runs on the calling thread
+    std::atomic<int> count = 0;
+    pool.parallel_for_blocks(16,
+                             [&](int)
+                             { pool.parallel_for_blocks(16, [&](int) { ++count; }); });
+    REQUIRE(count == 16 * 16);
+
+    // exceptions are rethrown on the calling thread
+    REQUIRE_THROWS(pool.parallel_for_blocks(100,
+                                            [&](int i)
+                                            {
+                                                if(i == 42)
+                                                    throw std::runtime_error("42");
+                                            }));
+}
+
+TEST_CASE("host_parallel_for_test", "[launch]")
+{
+    host_parallel_for_test();
+}
+
+TEST_CASE("host_launch_test", "[launch]")
+{
+    host_launch_test();
+}
+
+TEST_CASE("host_thread_pool_test", "[launch]")
+{
+    host_thread_pool_test();
+}
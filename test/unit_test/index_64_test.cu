@@ -0,0 +1,190 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/viewer/dense.h>
+#include <muda/launch/host_parallel_for.h>
+#include <muda/buffer.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace muda;
+
+// the views are emulated on the host: a fake base address, only the addresses of the
+// elements are computed, nothing is dereferenced, so no memory beyond 2^31 bytes is needed
+static std::uintptr_t index_64_offset(const void* base, const void* elem)
+{
+    return reinterpret_cast<std::uintptr_t>(elem) - reinterpret_cast<std::uintptr_t>(base);
+}
+
+void index_64_viewer_test()
+{
+    auto base = reinterpret_cast<float*>(std::uintptr_t{1} << 40);
+
+#if MUDA_INDEX_64
+    // 1D: 3G elements
+    index_t        n = 3'000'000'000ll;
+    Dense1D<float> v1{base, n};
+    REQUIRE(v1.total_size() == n);
+    REQUIRE(index_64_offset(base, &v1(n - 1)) == (n - 1) * sizeof(float));
+    auto sub = v1.sub_view(n - 10, 10);
+    REQUIRE(sub.dim() == 10);
+    REQUIRE(index_64_offset(base, &sub(9)) == (n - 1) * sizeof(float));
+
+    // 2D: each extent fits in an int, the byte offsets and the flatten index don't
+    index_t        pitch = 1 << 20;
+    Dense2D<float> v2{base, make_int2(0, 0), make_int2(40000, 30000), pitch};
+    REQUIRE(v2.total_size() == 40000ll * 30000);
+    REQUIRE(index_64_offset(base, &v2(39999, 29999)) == 39999ll * pitch + 29999 * sizeof(float));
+    index_t flat = 40000ll * 30000 - 1;
+    REQUIRE(&v2.flatten(flat) == &v2(39999, 29999));
+
+    // 3D
+    index_t        area_pitch = 2000 * pitch;
+    Dense3D<float> v3{base, make_int3(0, 0, 0), make_int3(100, 2000, 30000), pitch, area_pitch};
+    REQUIRE(v3.total_size() == 100ll * 2000 * 30000);
+    REQUIRE(index_64_offset(base, &v3(99, 1999, 29999))
+            == 99 * area_pitch + 1999 * pitch + 29999 * sizeof(float));
+    REQUIRE(&v3.flatten(v3.total_size() - 1) == &v3(99, 1999, 29999));
+#else
+    // 32-bit index: the last int index is still reachable
+    index_t        n = std::numeric_limits<int>::max();
+    Dense1D<float> v1{base, n};
+    REQUIRE(index_64_offset(base, &v1(n - 1)) == std::uintptr_t(n - 1) * sizeof(float));
+#endif
+}
+
+// every index in [0, count) is visited exactly once, checked per block without atomics
+template <bool GridStride>
+void index_64_host_parallel_for_test(index_t count)
+{
+    constexpr int block_dim = 1 << 16;
+    constexpr int grid_dim  = 64;
+
+    auto block_count = ParallelFor::round_up_blocks(count, block_dim);
+
+    // per range of block_dim indices: the visit count and the last index
+    std::vector<index_t> visits(block_count, 0);
+    std::vector<index_t> last(block_count, -1);
+
+    auto f = [visits = visits.data(), last = last.data()] __host__ __device__(
+                 const ParallelForDetails& details) mutable
+    {
+        index_t i = details;
+        auto    b = i / block_dim;
+        if(i != last[b] + 1 && last[b] != -1)
+            return;  // out of order, the visit count won't match
+        visits[b]++;
+        last[b] = i;
+    };
+
+    if constexpr(GridStride)
+        HostParallelFor(grid_dim, block_dim).apply(count, f);
+    else
+        HostParallelFor(block_dim).apply(count, f);
+
+    index_t total = 0;
+    for(index_t b = 0; b < block_count; ++b)
+    {
+        auto expected = std::min<index_t>(block_dim, count - b * block_dim);
+        REQUIRE(visits[b] == expected);
+        REQUIRE(last[b] == b * block_dim + expected - 1);
+        total += visits[b];
+    }
+    REQUIRE(total == count);
+}
+
+// a byte with a default value, so resize constructs it with a kernel instead of a memset
+struct Index64Byte
+{
+    uint8_t v = 7;
+};
+
+// the last `n` bytes before `end`
+static std::vector<uint8_t> index_64_tail(DeviceBuffer<Index64Byte>& buffer, size_t end, size_t n)
+{
+    std::vector<Index64Byte> h(n);
+    buffer.view(end - n, n).copy_to(h.data());
+    std::vector<uint8_t> res(n);
+    std::transform(h.begin(), h.end(), res.begin(), [](Index64Byte b) { return b.v; });
+    return res;
+}
+
+// the 1D buffer agents (construct, fill, copy construct, assign) beyond 2^31 elements
+void index_64_buffer_test()
+{
+#if MUDA_INDEX_64
+    size_t count = (size_t{1} << 31) + 1001;
+    size_t free_bytes, total_bytes;
+    checkCudaErrors(cudaMemGetInfo(&free_bytes, &total_bytes));
+    // the resize below holds the old and the new buffer at once
+    if(free_bytes < 2 * (count + 16) * sizeof(Index64Byte) + (size_t{1} << 28))
+    {
+        WARN("index_64_buffer_test: skipped, not enough device memory");
+        return;
+    }
+
+    constexpr size_t          N = 16;
+    std::vector<uint8_t>      tail;
+    DeviceBuffer<Index64Byte> a;
+    a.resize(count);  // construct
+    REQUIRE(index_64_tail(a, count, N) == std::vector<uint8_t>(N, 7));
+
+    BufferLaunch(1024, 256).fill(a.view(), Index64Byte{9}).wait();  // grid-stride fill
+    REQUIRE(index_64_tail(a, count, N) == std::vector<uint8_t>(N, 9));
+
+    a.resize(count + N);  // copy construct the old part, construct the new one
+    tail = std::vector<uint8_t>(N, 9);
+    tail.resize(2 * N, 7);
+    REQUIRE(index_64_tail(a, count + N, 2 * N) == tail);
+
+    a.resize(N);
+    a.shrink_to_fit();
+    a.resize(count + N, Index64Byte{5});
+    DeviceBuffer<Index64Byte> b = a;  // assign
+    REQUIRE(index_64_tail(b, count + N, N) == std::vector<uint8_t>(N, 5));
+#endif
+}
+
+TEST_CASE("index_64", "[viewer]")
+{
+    SECTION("viewer")
+    {
+        index_64_viewer_test();
+    }
+
+    // beyond 2^31 with MUDA_INDEX_64, the max of int without
+    index_t count = std::numeric_limits<int>::max();
+#if MUDA_INDEX_64
+    count += 1001;
+#endif
+
+    SECTION("round_up_blocks")
+    {
+        REQUIRE(ParallelFor::round_up_blocks(count, 256) == count / 256 + 1);
+    }
+
+    SECTION("buffer")
+    {
+        index_64_buffer_test();
+    }
+}
+
+// hidden, it calls the host lambda count times, run it with `muda_unit_test [index_64_host]`
+TEST_CASE("index_64_host_parallel_for", "[.][index_64_host]")
+{
+    index_t count = std::numeric_limits<int>::max();
+#if MUDA_INDEX_64
+    count += 1001;
+#endif
+
+    SECTION("HostParallelFor")
+    {
+        index_64_host_parallel_for_test<false>(count);
+    }
+
+    SECTION("HostParallelFor GridStride")
+    {
+        index_64_host_parallel_for_test<true>(count);
+    }
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 #include <muda/muda.h>
+#include <muda/container.h>
 using namespace muda;
 
 void log_test()
@@ -26,7 +27,215 @@ void log_test()
     logger.retrieve(std::cout);
 }
 
+void log_statement_test()
+{
+    // every statement is reserved in one shot, so its entries are contiguous
+    constexpr int N = 4096;
+    Logger        logger;
+    ParallelFor(256)
+        .apply(N,
+               [logger = logger.viewer()] __device__(int i) mutable
+               { logger << i << " " << 2.0f * i << "\n"; })
+        .wait();
+
+    auto container = logger.retrieve_meta();
+    auto meta      = container.meta_data();
+    REQUIRE(meta.size() == N * 4);
+
+    std::vector<int> visited(N, 0);
+    for(size_t j = 0; j < meta.size(); j += 4)
+    {
+        REQUIRE(meta[j].id == meta[j + 3].id);
+        REQUIRE(meta[j].type == LoggerBasicType::Int32);
+        REQUIRE(meta[j + 1].type == LoggerBasicType::String);
+        REQUIRE(meta[j + 2].type == LoggerBasicType::Float);
+        REQUIRE(meta[j + 3].type == LoggerBasicType::String);
+        auto i = meta[j].as<int>();
+        REQUIRE(meta[j + 2].as<float>() == 2.0f * i);
+        visited[i] += 1;
+    }
+    REQUIRE(std::all_of(visited.begin(), visited.end(), [](int v) { return v == 1; }));
+
+    // a statement longer than the stage of a proxy keeps its order
+    Launch(1, 32)
+        .apply(
+            [logger = logger.viewer()] __device__() mutable
+            {
+                LogProxy proxy{logger};
+                for(int i = 0; i < 100; ++i)
+                    proxy << i;
+            })
+        .wait();
+    container = logger.retrieve_meta();
+    meta      = container.meta_data();
+    REQUIRE(meta.size() == 32 * 100);
+    for(size_t j = 0; j < meta.size(); ++j)
+        REQUIRE(meta[j].as<int>() == static_cast<int>(j % 100));
+}
+
+void log_partial_warp_test()
+{
+    // lane 0 can't fit its statement in the buffer, the other lanes of the warp still can:
+    // only lane 0 is dropped
+    Logger logger(64, 160);
+    Launch(1, 8)
+        .apply(
+            [logger = logger.viewer()] __device__() mutable
+            {
+                LogProxy proxy{logger};
+                if(threadIdx.x == 0)
+                    proxy << "0123456789012345678901234567890123456789012345678901234567890123456789"
+                             "0123456789012345678901234567890123456789012345678901234567890123456789"
+                             "0123456789012345678901234567890123456789012345678";
+                else
+                    proxy << static_cast<int>(threadIdx.x);
+                // the whole warp reserves together when the proxy is destroyed
+                __syncwarp();
+            })
+        .wait();
+
+    auto container = logger.retrieve_meta();
+    auto meta      = container.meta_data();
+    REQUIRE(meta.size() == 7);
+    std::vector<int> lanes;
+    for(auto& m : meta)
+    {
+        REQUIRE(m.type == LoggerBasicType::Int32);
+        lanes.push_back(m.as<int>());
+    }
+    std::sort(lanes.begin(), lanes.end());
+    REQUIRE(lanes == std::vector<int>{1, 2, 3, 4, 5, 6, 7});
+}
+
+namespace
+{
+// the former LoggerViewer::push_data, kept here as the baseline of the benchmark:
+// two atomicCAS retry loops on the global offsets and a byte-wise copy per entry
+__device__ uint32_t legacy_next_idx(uint32_t* data_offset, uint32_t size, uint32_t total_size)
+{
+    uint32_t old = *data_offset;
+    if(old + size >= total_size)
+        return ~0u;
+    uint32_t assumed;
+    do
+    {
+        assumed = old;
+        old     = atomicCAS(data_offset, assumed, old + size);
+        if(old + size >= total_size)
+            return ~0u;
+    } while(assumed != old);
+    return old;
+}
+
+struct LegacyLogger
+{
+    details::LoggerMetaData* meta;
+    uint32_t                 meta_size;
+    char*                    buffer;
+    uint32_t                 buffer_size;
+    details::LoggerOffset*   offset;
+    uint32_t*                log_id;
+
+    __device__ void push(details::LoggerMetaData m, const void* data)
+    {
+        auto meta_idx = legacy_next_idx(&offset->meta_data_offset, 1u, meta_size);
+        if(meta_idx == ~0u)
+            return;
+        auto buffer_idx = legacy_next_idx(&offset->buffer_offset, m.size, buffer_size);
+        if(buffer_idx == ~0u)
+            return;
+        m.offset       = buffer_idx;
+        meta[meta_idx] = m;
+        for(int i = 0; i < m.size; ++i)
+            buffer[buffer_idx + i] = reinterpret_cast<const char*>(data)[i];
+    }
+};
+}  // namespace
+
+void log_benchmark()
+{
+    constexpr int N = 1 << 20;
+
+    Logger logger;
+    Event  begin{Event::Bit::eDefault};
+    Event  end{Event::Bit::eDefault};
+
+    // warmup
+    ParallelFor(256)
+        .apply(N,
+               [logger = logger.viewer()] __device__(int i) mutable
+               { logger << "i=" << i << " x=" << 0.5f * i << "\n"; })
+        .wait();
+    logger.retrieve_meta();
+
+    Launch().record(begin);
+    ParallelFor(256)
+        .apply(N,
+               [logger = logger.viewer()] __device__(int i) mutable
+               { logger << "i=" << i << " x=" << 0.5f * i << "\n"; })
+        .record(end)
+        .wait();
+    auto statement_ms = Event::elapsed_time(begin, end);
+    logger.retrieve_meta();
+
+    DeviceBuffer<details::LoggerMetaData> meta(N * 5);
+    DeviceBuffer<char>                    buffer(N * 64);
+    DeviceVar<details::LoggerOffset>      offset;
+    DeviceVar<uint32_t>                   log_id = 0;
+    LegacyLogger legacy{meta.data(), N * 5, buffer.data(), N * 64, offset.data(), log_id.data()};
+
+    Launch().record(begin);
+    ParallelFor(256)
+        .apply(N,
+               [legacy] __device__(int i) mutable
+               {
+                   details::LoggerMetaData m;
+                   m.id = atomicAdd(legacy.log_id, 1u);
+                   auto push_string = [&](const char* s, uint32_t size)
+                   {
+                       m.type = LoggerBasicType::String;
+                       m.size = size;
+                       legacy.push(m, s);
+                   };
+                   push_string("i=", 3);
+                   m.type = LoggerBasicType::Int32;
+                   m.size = sizeof(int);
+                   legacy.push(m, &i);
+                   push_string(" x=", 4);
+                   float x = 0.5f * i;
+                   m.type  = LoggerBasicType::Float;
+                   m.size  = sizeof(float);
+                   legacy.push(m, &x);
+                   push_string("\n", 2);
+               })
+        .record(end)
+        .wait();
+    auto legacy_ms = Event::elapsed_time(begin, end);
+
+    std::cout << "log " << N << " statements (5 entries each):\n"
+              << "  per-entry reservation: " << legacy_ms << " ms ("
+              << N / legacy_ms / 1e3 << " M statements/s)\n"
+              << "  statement reservation: " << statement_ms << " ms ("
+              << N / statement_ms / 1e3 << " M statements/s)\n";
+}
+
 TEST_CASE("log_test", "[log]")
 {
     log_test();
 }
+
+TEST_CASE("log_statement_test", "[log]")
+{
+    log_statement_test();
+}
+
+TEST_CASE("log_partial_warp_test", "[log]")
+{
+    log_partial_warp_test();
+}
+
+// hidden, run it with `muda_unit_test [benchmark]`
+TEST_CASE("log_benchmark", "[log][.benchmark]")
+{
+    log_benchmark();
+}
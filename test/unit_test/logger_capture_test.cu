@@ -0,0 +1,126 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/logger.h>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
+using namespace muda;
+
+namespace
+{
+void fmt_point(void*, const void*) {}
+
+details::LoggerMetaData make_meta(LoggerBasicType type, uint32_t id, uint32_t size, uint32_t offset)
+{
+    details::LoggerMetaData meta;
+    meta.type   = type;
+    meta.id     = id;
+    meta.size   = size;
+    meta.offset = offset;
+    return meta;
+}
+}  // namespace
+
+void logger_capture_host_test()
+{
+    auto path = (std::filesystem::temp_directory_path() / "muda_logger_capture_test.mudalog").string();
+
+    // frame 0: [id 1] "b" 7, [id 0] "a"
+    char buffer0[16] = {};
+    int  seven       = 7;
+    std::memcpy(buffer0, "b", 2);
+    std::memcpy(buffer0 + 4, &seven, sizeof(int));
+    std::memcpy(buffer0 + 8, "a", 2);
+    std::vector<details::LoggerMetaData> meta0 = {
+        make_meta(LoggerBasicType::String, 1, 2, 0),
+        make_meta(LoggerBasicType::Int32, 1, 4, 4),
+        make_meta(LoggerBasicType::String, 0, 2, 8)};
+
+    // frame 1: an object with a registered formatter
+    short point[2] = {1, 2};
+    auto  object   = make_meta(LoggerBasicType::Object, 0, sizeof(point), 0);
+    object.fmt_arg = fmt_point;
+    std::vector<details::LoggerMetaData> meta1 = {object};
+
+    {
+        LoggerCaptureWriter capture(path);
+        capture.register_fmt_arg(fmt_point, "point");
+        capture.write_frame(meta0, buffer0, sizeof(buffer0));
+        capture.write_frame(meta1, reinterpret_cast<const char*>(point), sizeof(point));
+        REQUIRE(capture.frame_count() == 2);
+    }
+
+    LoggerCaptureReader reader(path);
+    REQUIRE(reader.frame_count() == 2);
+    REQUIRE(reader.frame(0).meta_data.size() == 3);
+    REQUIRE(reader.frame(1).index == 1);
+    REQUIRE(reader.fmt_arg_name(fmt_point) == "point");
+    REQUIRE(reader.type_name(LoggerBasicType::Int32) == "int32");
+
+    std::stringstream text;
+    reader.write_text(text);
+    REQUIRE(text.str() == "ab7<point:01000200>");
+
+    std::stringstream csv;
+    reader.write_csv(csv);
+    REQUIRE(csv.str()
+            == "frame,log_id,type,value\n"
+               "0,0,string,\"a\"\n"
+               "0,1,string,\"b\"\n"
+               "0,1,int32,\"7\"\n"
+               "1,0,object,\"<point:01000200>\"\n");
+
+    // a capture cut in the middle of the last frame keeps the complete ones
+    auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 60);
+    LoggerCaptureReader truncated(path);
+    REQUIRE(truncated.frame_count() == 1);
+
+    // the frames refer to the bytes of the reader: it moves, but doesn't copy
+    static_assert(!std::is_copy_constructible_v<LoggerCaptureReader>);
+    LoggerCaptureReader moved = std::move(truncated);
+    REQUIRE(moved.frame_count() == 1);
+    REQUIRE(moved.frame(0).meta_data.size() == 3);
+    REQUIRE(moved.type_name(LoggerBasicType::Int32) == "int32");
+
+    std::filesystem::remove(path);
+}
+
+void logger_capture_device_test()
+{
+    auto path = (std::filesystem::temp_directory_path() / "muda_logger_capture_device.mudalog").string();
+    {
+        LoggerCaptureWriter capture(path);
+        Logger              logger;
+        for(int frame = 0; frame < 2; ++frame)
+        {
+            Launch(1, 4)
+                .apply([logger = logger.viewer(), frame] __device__() mutable
+                       { logger << "frame " << frame << ": " << (int)threadIdx.x << "\n"; })
+                .wait();
+            logger.retrieve(capture);
+        }
+    }
+
+    LoggerCaptureReader reader(path);
+    REQUIRE(reader.frame_count() == 2);
+    REQUIRE(reader.frame(0).meta_data.size() == 4 * 5);
+
+    std::stringstream text;
+    reader.write_text(text);
+    auto str = text.str();
+    REQUIRE(std::count(str.begin(), str.end(), '\n') == 8);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("logger_capture_host_test", "[log]")
+{
+    logger_capture_host_test();
+}
+
+TEST_CASE("logger_capture_device_test", "[log]")
+{
+    logger_capture_device_test();
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/logger.h>
+
+using namespace muda;
+
+void logger_filter_host_test()
+{
+    LoggerFilter filter;
+    REQUIRE(filter.accept_kernel(""));
+    REQUIRE(filter.accept_kernel("anything"));
+
+    filter.kernels = {"solver*", "collide"};
+    REQUIRE(filter.accept_kernel("solver"));
+    REQUIRE(filter.accept_kernel("solver_pcg"));
+    REQUIRE(filter.accept_kernel("collide"));
+    REQUIRE(!filter.accept_kernel("collide_ccd"));
+    REQUIRE(!filter.accept_kernel(""));
+
+    filter.excluded_kernels = {"solver_pcg"};
+    REQUIRE(!filter.accept_kernel("solver_pcg"));
+    REQUIRE(filter.accept_kernel("solver_cg"));
+
+    filter.sample_every = 0;
+    filter.min_level    = LoggerLevel::Warn;
+    auto f              = filter.resolve("solver_cg");
+    REQUIRE(f.sample_every == 1);
+    REQUIRE(f.min_level == LoggerLevel::Warn);
+    REQUIRE(f.kernel_enabled);
+    REQUIRE(!filter.resolve("collide_ccd").kernel_enabled);
+}
+
+void logger_filter_device_test()
+{
+    constexpr int N = 1024;
+
+    Logger logger;
+    auto   count = [&]
+    {
+        auto container = logger.retrieve_meta();
+        return container.meta_data().size();
+    };
+
+    auto log = [&](const char* kernel_name)
+    {
+        ParallelFor(128)
+            .kernel_name(kernel_name)
+            .apply(N,
+                   [logger = logger.viewer()] __device__(int i) mutable
+                   {
+                       logger(LoggerLevel::Debug) << i;
+                       logger(LoggerLevel::Warn) << i;
+                   })
+            .wait();
+    };
+
+    log("");
+    REQUIRE(count() == 2 * N);
+
+    // level
+    LoggerFilter filter;
+    filter.min_level = LoggerLevel::Warn;
+    logger.filter(filter);
+    log("");
+    REQUIRE(count() == N);
+
+    // sampling
+    filter.sample_every = 8;
+    logger.filter(filter);
+    log("");
+    REQUIRE(count() == N / 8);
+
+    // kernel name
+    filter.sample_every = 1;
+    filter.kernels      = {"wanted"};
+    logger.filter(filter);
+    log("wanted");
+    REQUIRE(count() == N);
+    log("unwanted");
+    REQUIRE(count() == 0);
+}
+
+TEST_CASE("logger_filter_host_test", "[log]")
+{
+    logger_filter_host_test();
+}
+
+TEST_CASE("logger_filter_device_test", "[log]")
+{
+    logger_filter_device_test();
+}
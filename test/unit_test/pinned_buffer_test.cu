@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/buffer.h>
+#include <numeric>
+using namespace muda;
+
+void pinned_buffer_test()
+{
+    constexpr int N = 10000;
+    Stream        s;
+
+    PinnedBuffer<float> h(N);
+    REQUIRE(h.size() == N);
+    std::iota(h.begin(), h.end(), 0.0f);
+
+    // asynchronous round trip
+    DeviceBuffer<float> d(N);
+    BufferLaunch(s).copy(d.view(), h.data());
+    ParallelFor(256, 0, s).apply(N, [d = d.viewer()] __device__(int i) mutable { d(i) *= 2.0f; });
+
+    PinnedBuffer<float> back(N);
+    auto done = BufferLaunch(s).copy(back.data(), d.view()).completion();
+    done.wait();
+    REQUIRE(done.is_ready());
+    for(int i = 0; i < N; ++i)
+        REQUIRE(back[i] == 2.0f * i);
+
+    // resize keeps the content, the new elements are zero
+    back.resize(2 * N);
+    REQUIRE(back[N - 1] == 2.0f * (N - 1));
+    REQUIRE(back[2 * N - 1] == 0.0f);
+    back.resize(N / 2);
+    back.shrink_to_fit();
+    REQUIRE(back.capacity() == N / 2);
+
+    std::vector<float> v;
+    back.copy_to(v);
+    REQUIRE(v.size() == N / 2);
+    PinnedBuffer<float> from_vector = v;
+    REQUIRE(from_vector[N / 2 - 1] == 2.0f * (N / 2 - 1));
+}
+
+void pinned_staging_test()
+{
+    constexpr int N = 100000;
+    Stream        s;
+
+    std::vector<int> src(N);
+    std::iota(src.begin(), src.end(), 0);
+
+    // small chunks, so the pipeline runs many rounds
+    PinnedStaging     staging(1000);
+    DeviceBuffer<int> d(N);
+    BufferLaunch(s).copy(d.view(), src.data(), staging);
+
+    std::vector<int> dst(N, -1);
+    BufferLaunch(s).copy(dst.data(), d.view(), staging);
+    REQUIRE(dst == src);
+}
+
+TEST_CASE("pinned_buffer_test", "[buffer]")
+{
+    pinned_buffer_test();
+}
+
+TEST_CASE("pinned_staging_test", "[buffer]")
+{
+    pinned_staging_test();
+}
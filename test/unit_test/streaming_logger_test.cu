@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/logger.h>
+#include <sstream>
+#include <cstring>
+
+using namespace muda;
+
+// build a frame by hand: (log id, value) pairs written as int entries
+class SyntheticFrame
+{
+  public:
+    std::vector<details::LoggerMetaData> meta_data;
+    std::vector<char>                    buffer;
+
+    void push(uint32_t id, int value)
+    {
+        details::LoggerMetaData meta;
+        meta.type   = LoggerBasicType::Int32;
+        meta.id     = id;
+        meta.size   = sizeof(int);
+        meta.offset = static_cast<uint32_t>(buffer.size());
+        buffer.resize(buffer.size() + sizeof(int));
+        std::memcpy(buffer.data() + meta.offset, &value, sizeof(int));
+        meta_data.push_back(meta);
+    }
+
+    void push(uint32_t id, const char* str)
+    {
+        details::LoggerMetaData meta;
+        meta.type   = LoggerBasicType::String;
+        meta.id     = id;
+        meta.size   = static_cast<uint32_t>(std::strlen(str) + 1);
+        meta.offset = static_cast<uint32_t>(buffer.size());
+        buffer.insert(buffer.end(), str, str + meta.size);
+        meta_data.push_back(meta);
+    }
+
+    std::string decode()
+    {
+        std::stringstream ss;
+        LoggerDecoder     decoder;
+        decoder.decode(meta_data, buffer.data(), buffer.size(), ss);
+        return ss.str();
+    }
+};
+
+void logger_decoder_test()
+{
+    SyntheticFrame frame;
+    // statement 3 is written in two parts around statement 0
+    frame.push(3, "c");
+    frame.push(3, 1);
+    frame.push(0, "a");
+    frame.push(0, 2);
+    frame.push(3, "d");
+    frame.push(1, "b");
+    REQUIRE(frame.decode() == "a2bc1d");
+
+    // an entry out of the buffer is reported, not read
+    frame.meta_data[5].offset = 1 << 20;
+    REQUIRE(frame.decode() == "a2[log_id 1: buffer exceeded]c1d");
+
+    SyntheticFrame empty;
+    REQUIRE(empty.decode().empty());
+}
+
+void streaming_logger_test()
+{
+    std::stringstream ss;
+    {
+        StreamingLogger logger(ss);
+        for(int frame = 0; frame < 4; ++frame)
+        {
+            ParallelFor(64)
+                .apply(128,
+                       [logger = logger.viewer(), frame] __device__(int i) mutable
+                       {
+                           if(i == 0)
+                               logger << "frame " << frame << "\n";
+                       });
+            logger.swap();
+        }
+        logger.flush();
+        // 4 frames + the empty one ended by flush()
+        REQUIRE(logger.frame_count() == 5);
+        REQUIRE(logger.exceeded_frame_count() == 0);
+    }
+    REQUIRE(ss.str() == "frame 0\nframe 1\nframe 2\nframe 3\n");
+
+    // a full frame is reported and expanded for its next turn
+    std::stringstream big;
+    {
+        StreamingLogger logger(big, 16, 1024);
+        for(int frame = 0; frame < 3; ++frame)
+        {
+            ParallelFor(64)
+                .apply(64,
+                       [logger = logger.viewer()] __device__(int i) mutable
+                       { logger << i << "\n"; });
+            logger.swap();
+        }
+        logger.flush();
+        REQUIRE(logger.exceeded_frame_count() >= 1);
+    }
+}
+
+TEST_CASE("logger_decoder_test", "[log]")
+{
+    logger_decoder_test();
+}
+
+TEST_CASE("streaming_logger_test", "[log]")
+{
+    streaming_logger_test();
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/buffer.h>
+
+using namespace muda;
+
+// object k: buffer[k](i) = value * (k + 1) + i, written through the table
+static void viewer_table_write(ViewerTable<Dense1D<float>>& table,
+                               const std::vector<ViewerTable<Dense1D<float>>::handle_type>& handles,
+                               int   size,
+                               float value)
+{
+    DeviceBuffer<uint32_t> d_handles(handles.size());
+    d_handles.copy_from(std::vector<uint32_t>(handles.begin(), handles.end()));
+    ParallelFor(256)
+        .apply(static_cast<int>(handles.size()) * size,
+               [table = table.cviewer(), handles = d_handles.cviewer(), size, value] __device__(int i) mutable
+               {
+                   auto k = i / size;
+                   auto x = table(handles(k));
+                   x(i % size) = value * (k + 1) + i % size;
+               })
+        .wait();
+}
+
+static void viewer_table_check(std::vector<DeviceBuffer<float>>& buffers, int size, float value)
+{
+    std::vector<float> h;
+    for(size_t k = 0; k < buffers.size(); ++k)
+    {
+        buffers[k].copy_to(h);
+        for(int i = 0; i < size; ++i)
+            REQUIRE(h[i] == value * (k + 1) + i);
+    }
+}
+
+void viewer_table_test()
+{
+    constexpr int Objects = 300;
+    constexpr int Size    = 17;
+
+    std::vector<DeviceBuffer<float>> buffers(Objects);
+    for(auto& b : buffers)
+        b.resize(Size, 0.0f);
+
+    ViewerTable<Dense1D<float>>                           table;
+    std::vector<ViewerTable<Dense1D<float>>::handle_type> handles;
+    for(auto& b : buffers)
+        handles.push_back(table.add(b.viewer()));
+    REQUIRE(table.size() == Objects);
+    REQUIRE(table.dirty_count() == Objects);
+
+    // all dirty: one contiguous upload
+    table.upload();
+    REQUIRE(table.dirty_count() == 0);
+    REQUIRE(table.capacity() >= Objects);
+    viewer_table_write(table, handles, Size, 1.0f);
+    viewer_table_check(buffers, Size, 1.0f);
+
+    // a few slots change: scattered upload, swap object 3 and 7
+    table.set(handles[3], buffers[7].viewer());
+    table.set(handles[7], buffers[3].viewer());
+    REQUIRE(table.dirty_count() == 2);
+    table.upload();
+    viewer_table_write(table, handles, Size, 2.0f);
+    std::swap(buffers[3], buffers[7]);
+    viewer_table_check(buffers, Size, 2.0f);
+
+    // back-to-back scattered uploads: the two stages are used in turn
+    for(int r = 0; r < 4; ++r)
+    {
+        int a = 10 + 2 * r;
+        int b = a + 1;
+        table.set(handles[a], buffers[b].viewer());
+        table.set(handles[b], buffers[a].viewer());
+        table.upload();
+        std::swap(buffers[a], buffers[b]);
+    }
+    viewer_table_write(table, handles, Size, 3.0f);
+    viewer_table_check(buffers, Size, 3.0f);
+
+    // a removed handle is reused
+    table.remove(handles[5]);
+    auto h = table.add(buffers[5].viewer());
+    REQUIRE(h == handles[5]);
+    REQUIRE(table.size() == Objects);
+}
+
+void viewer_table_graph_test()
+{
+    constexpr int Size = 8;
+
+    ComputeGraphVarManager manager;
+    ComputeGraph           graph{manager};
+
+    auto& table_var = manager.create_var<BufferView<Dense1D<float>>>("table");
+    auto& count_var = manager.create_var<int>("count");
+
+    graph.create_node("write") << [&]
+    {
+        ParallelFor(256).apply(count_var.eval() * Size,
+                               [table = table_var.cviewer()] __device__(int i) mutable
+                               {
+                                   auto x = table(i / Size);
+                                   x(i % Size) = 1.0f * i;
+                               });
+    };
+
+    ViewerTable<Dense1D<float>> table(64);
+    REQUIRE(table.capacity() == 64);
+
+    std::vector<DeviceBuffer<float>> buffers;
+    auto run = [&](int count)
+    {
+        while(buffers.size() < count)
+        {
+            buffers.emplace_back(Size);
+            table.add(buffers.back().viewer());
+        }
+        table.upload(table_var);
+        count_var.update(count);
+        graph.launch();
+        wait_device();
+
+        std::vector<float> h;
+        for(int k = 0; k < count; ++k)
+        {
+            buffers[k].copy_to(h);
+            for(int i = 0; i < Size; ++i)
+                REQUIRE(h[i] == 1.0f * (k * Size + i));
+        }
+    };
+
+    run(10);
+    auto data = table_var.ceval().data();
+
+    // more slots within the capacity: the var is not updated
+    run(50);
+    REQUIRE(table_var.ceval().data() == data);
+
+    // beyond the capacity: the table moves, the var follows
+    run(100);
+    REQUIRE(table.capacity() >= 100);
+    REQUIRE(table_var.ceval().data() == table.view().data());
+}
+
+TEST_CASE("viewer_table_test", "[buffer]")
+{
+    viewer_table_test();
+}
+
+TEST_CASE("viewer_table_graph_test", "[buffer]")
+{
+    viewer_table_graph_test();
+}
@@ -0,0 +1,53 @@
+// muda_log_decode: turn a capture of LoggerCaptureWriter into text or csv.
+// usage:
+//     muda_log_decode <capture> [--csv] [-o <output>]
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <muda/logger/logger_capture.h>
+
+int main(int argc, char** argv)
+{
+    std::string input;
+    std::string output;
+    bool        csv = false;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--csv") == 0)
+            csv = true;
+        else if(std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            output = argv[++i];
+        else
+            input = argv[i];
+    }
+
+    if(input.empty())
+    {
+        std::cerr << "usage: muda_log_decode <capture> [--csv] [-o <output>]\n";
+        return 1;
+    }
+
+    muda::LoggerCaptureReader reader(input);
+
+    std::ofstream file;
+    if(!output.empty())
+    {
+        file.open(output);
+        if(!file)
+        {
+            std::cerr << "muda_log_decode: can't open " << output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+
+    if(csv)
+        reader.write_csv(os);
+    else
+        reader.write_text(os);
+
+    std::cerr << "muda_log_decode: " << reader.frame_count() << " frame(s) decoded\n";
+    return 0;
+}
@@ -20,6 +20,9 @@ target("muda")
     if(has_config("with_check")) then
         add_defines("MUDA_CHECK_ON=1", {public = true})
     end
+    if(has_config("with_index_64")) then
+        add_defines("MUDA_INDEX_64=1", {public = true})
+    end
     add_packages("cuda", {public = true})
     -- add_packages("eigen", {public = true})
     add_cuflags("--extended-lambda", {public = true}) -- must be set for muda
@@ -39,12 +42,30 @@ if has_config("test") then
         add_files("test/unit_test/**.cu","test/unit_test/**.cpp")
     target_end()
     
+    -- the index test again in the 64-bit index mode, so the checks beyond 2^31 always run
+    target("muda_index_64_unit_test")
+        muda_app_base("cui")
+        if not has_config("with_index_64") then
+            add_defines("MUDA_INDEX_64=1")
+        end
+        add_files("test/unit_test/index_64_test.cu","test/unit_test/main.cpp")
+    target_end()
+
     target("muda_eigen_test")
         muda_app_base("cui")
         add_files("test/eigen_test/**.cu","test/eigen_test/**.cpp")
     target_end()
 end
 
+if has_config("tools") then
+    -- host only tools, no device code
+    target("muda_log_decode")
+        add_deps("muda")
+        set_kind("binary")
+        add_files("tools/log_decode/main.cpp")
+    target_end()
+end
+
 if has_config("example") then
     target("muda_example")
         muda_app_base("cui")
@@ -35,6 +35,14 @@ option("test")
     option_dev_related()
 option_end()
 
+option("tools")
+    set_default(false)
+    set_showmenu(true)
+    set_description("build muda host tools, e.g. muda_log_decode.")
+    set_category("root menu/dev")
+    option_dev_related()
+option_end()
+
 option("playground")
     set_default(false)
     set_showmenu(true)
@@ -53,4 +61,11 @@ option("with_check")
     set_showmenu(true)
     set_description("turn on all muda runtime check.")
     set_category("root menu/config")
-option_end()
\ No newline at end of file
+option_end()
+
+option("with_index_64")
+    set_default(false)
+    set_showmenu(true)
+    set_description("index the viewers and launchers with int64_t, for ranges beyond 2^31 elements.")
+    set_category("root menu/config")
+option_end()